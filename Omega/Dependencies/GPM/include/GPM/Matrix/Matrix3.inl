@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <string>
 #include <sstream>
 
@@ -22,7 +23,7 @@ Matrix3<T> Matrix3<T>::zero = { 0,0,0,
 template<typename T>
 constexpr Matrix3<T>::Matrix3()
 {
-	memcpy(m_data, identity.m_data, 9 * sizeof(T));
+	std::memcpy(m_data, identity.m_data, 9 * sizeof(T));
 }
 
 template<typename T>
@@ -36,13 +37,13 @@ constexpr Matrix3<T>::Matrix3(const T p_i0, const T p_i1, const T p_i2,
 template<typename T>
 constexpr Matrix3<T>::Matrix3(const T p_data[9])
 {
-	memcpy(m_data, p_data, 9 * sizeof(T));
+	std::memcpy(m_data, p_data, 9 * sizeof(T));
 }
 
 template<typename T>
 constexpr Matrix3<T>::Matrix3(const Matrix3& p_other)
 {
-	memcpy(m_data, p_other.m_data, 9 * sizeof(T));
+	std::memcpy(m_data, p_other.m_data, 9 * sizeof(T));
 }
 
 template<typename T>
@@ -56,7 +57,7 @@ constexpr Matrix3<T>::Matrix3(const Matrix3<U>& p_other)
 template<typename T>
 constexpr Matrix3<T>::Matrix3(Matrix3&& p_other) noexcept
 {
-	memcpy(m_data, p_other.m_data, 9 * sizeof(T));
+	std::memcpy(m_data, p_other.m_data, 9 * sizeof(T));
 }
 
 template<typename T>
@@ -1,5 +1,6 @@
 #pragma once
 #include <GPM/Quaternion/Quaternion.h>
+#include <cstring>
 #include <stdexcept>
 
 // struct GPM::Quaternion;
@@ -23,20 +24,20 @@ Matrix4<T> Matrix4<T>::zero = { 0,0,0,0,
 template<typename T>
 constexpr Matrix4<T>::Matrix4()
 {
-	memcpy_s(m_data, 16 * sizeof(T), identity.m_data, 16 * sizeof(T));
+	std::memcpy(m_data, identity.m_data, 16 * sizeof(T));
 }
 
 template<typename T>
 constexpr Matrix4<T>::Matrix4(const Matrix4<T>& p_matrix)
 {
-	memcpy_s(m_data, 16 * sizeof(T), p_matrix.m_data, 16 * sizeof(T));
+	std::memcpy(m_data, p_matrix.m_data, 16 * sizeof(T));
 }
 
 
 template<typename T>
 Matrix4<T>::Matrix4(Matrix4<T>&& p_matrix) noexcept
 {
-	memcpy_s(m_data, 16 * sizeof(T), p_matrix.m_data, 16 * sizeof(T));
+	std::memcpy(m_data, p_matrix.m_data, 16 * sizeof(T));
 }
 
 template<typename T>
@@ -53,7 +54,7 @@ constexpr Matrix4<T>::Matrix4(const T p_data[16])
 	if (p_data == nullptr)
 		return;
 
-	memcpy_s(m_data, 16 * sizeof(T), p_data, 16 * sizeof(T));
+	std::memcpy(m_data, p_data, 16 * sizeof(T));
 }
 
 template<typename T>
@@ -653,7 +654,7 @@ template<typename T>
 template<typename U>
 void Matrix4<T>::Set(Matrix4<T>& p_matrix, const Matrix4<U>& p_other)
 {
-	memcpy_s(p_matrix.m_data, 16 * sizeof(T), p_other.m_data, sizeof(U) * 16);
+	std::memcpy(p_matrix.m_data, p_other.m_data, sizeof(U) * 16);
 }
 
 #pragma endregion 
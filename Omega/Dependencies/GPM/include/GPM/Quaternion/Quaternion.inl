@@ -524,7 +524,7 @@ namespace GPM
 		if (Tools::Utils::Abs<double>(dot - (-1.0)) < 0.000001)
 		{
 			return Quaternion(Vector3<double>::up.x, Vector3<double>::up.y,
-				Vector3<double>::up.z, static_cast<double>(Tools::M_PI));
+				Vector3<double>::up.z, static_cast<double>(Tools::PI));
 		}
 		if (Tools::Utils::Abs<double>(dot - (1.0)) < 0.000001)
 		{
@@ -737,7 +737,7 @@ namespace GPM
 		float       pitch = 0.0f;
 		const float sinp = static_cast<float>(+2.0 * (w * y - z * x));
 		if (fabs(sinp) >= 1.0f)
-			pitch = static_cast<float>(copysign(Tools::M_PI / 2.0, sinp));
+			pitch = static_cast<float>(copysign(Tools::PI / 2.0, sinp));
 		// use 90 degrees if out of range
 		else
 			pitch = asin(sinp);
@@ -3,9 +3,9 @@
 namespace GPM::Tools
 {
 	/**
-	 * @brief PI alias for maths
+	 * @brief PI alias for maths, not named M_PI which <cmath> defines as a macro on POSIX
 	 */
-	constexpr long double M_PI = 3.141592653589793238462643383279502884L;
+	constexpr long double PI = 3.141592653589793238462643383279502884L;
 
 	/**
 	* Return the square root of a numeric value
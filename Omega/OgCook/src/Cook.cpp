@@ -0,0 +1,527 @@
+#include <OgCore/SceneLoader/SceneLoader.h>
+#include <OgRendering/Managers/Loaders/CookManifest.h>
+#include <OgRendering/Managers/Loaders/LoaderManager.h>
+#include <OgRendering/Managers/Loaders/MeshCache.h>
+#include <OgRendering/Managers/Loaders/TextureCache.h>
+#include <OgRendering/Utils/JobSystem.h>
+#include <OgRendering/Utils/MappedFile.h>
+#include <OgRendering/Utils/PackArchive.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace OgEngine;
+
+namespace
+{
+	/**
+	 * @brief Source file of the dependency graph.
+	 */
+	struct AssetNode
+	{
+		std::string source;
+		ASSET_KIND kind{ ASSET_KIND::NONE };
+		uint64_t hash{ 0u };
+		uint64_t size{ 0u };
+		int64_t writeTime{ 0 };
+		/**
+		 * @brief The nodes a scene uses, its meshes, textures and prefabs.
+		 */
+		std::vector<size_t> dependencies;
+		bool missing{ false };
+		bool dirty{ false };
+		bool failed{ false };
+	};
+
+	struct CookOptions
+	{
+		std::string directory;
+		std::string manifest{ CookManifest::DEFAULT_FILE };
+		/**
+		 * @brief Archive written after the cook, none when empty.
+		 */
+		std::string pack;
+		bool compressPack{ false };
+		bool force{ false };
+		/**
+		 * @brief Print the vertex cache statistics of the imported meshes.
+		 */
+		bool verbose{ false };
+		TextureCache::CookSettings textures;
+	};
+
+	std::string Normalize(const std::string& p_file)
+	{
+		return std::filesystem::path(p_file).lexically_normal().generic_string();
+	}
+
+	/**
+	 * @brief Version and settings written in the manifest, a source cooked with other ones is cooked again.
+	 */
+	uint64_t CookVersion(const ASSET_KIND p_kind, const TextureCache::CookSettings& p_settings)
+	{
+		switch (p_kind)
+		{
+		case ASSET_KIND::MESH:
+			return MeshCache::VERSION;
+		case ASSET_KIND::TEXTURE:
+			return static_cast<uint64_t>(TextureCache::VERSION) | static_cast<uint64_t>(p_settings.compress) << 32u
+				| static_cast<uint64_t>(p_settings.mips.filter) << 33u | static_cast<uint64_t>(p_settings.mips.srgb) << 41u;
+		default:
+			return 0u;
+		}
+	}
+
+	std::string CookedPath(const AssetNode& p_node)
+	{
+		switch (p_node.kind)
+		{
+		case ASSET_KIND::MESH:
+			return MeshCache::CookedPath(p_node.hash);
+		case ASSET_KIND::TEXTURE:
+			return TextureCache::CookedPath(p_node.hash);
+		default:
+			return {};
+		}
+	}
+
+	/**
+	 * @brief Graph of the assets of a directory: the scenes use meshes, textures and prefabs, the meshes and textures are cooked.
+	 */
+	class AssetGraph
+	{
+	public:
+		explicit AssetGraph(const CookOptions& p_options) : m_options(p_options), m_jobs(Utils::JobSystem::Instance())
+		{
+		}
+
+		/**
+		 * @brief Cook the sources that changed since the last cook, then write the manifest.
+		 * @return False if a source couldn't be cooked
+		 */
+		bool Cook()
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			if (!m_manifest.Load(m_options.manifest))
+				std::cout << "No manifest in " << m_options.manifest << ", every asset is cooked.\n";
+
+			Scan();
+			ResolveScenes();
+			HashSources();
+			CookSources();
+			PropagateFailures();
+			const bool saved = WriteManifest() && WritePack();
+
+			uint64_t cooked = 0u, failed = 0u, upToDate = 0u;
+			for (const AssetNode& node : m_nodes)
+			{
+				if (node.failed || node.missing)
+					++failed;
+				else if (node.dirty)
+					++cooked;
+				else
+					++upToDate;
+			}
+
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::cout << m_nodes.size() << " assets: " << cooked << " cooked, " << upToDate << " up to date, " << failed << " failed ("
+				<< elapsed << " s on " << m_jobs.WorkerCount() << " workers).\n";
+
+			return failed == 0u && saved;
+		}
+
+	private:
+		/**
+		 * @brief Add a node for a source, once.
+		 * @return The index of the node
+		 */
+		size_t AddNode(const std::string& p_source, const ASSET_KIND p_kind)
+		{
+			const std::string source = Normalize(p_source);
+			const auto [index, isNew] = m_indices.try_emplace(source, m_nodes.size());
+			if (isNew)
+			{
+				AssetNode& node = m_nodes.emplace_back();
+				node.source = source;
+				node.kind = p_kind;
+			}
+
+			return index->second;
+		}
+
+		void Scan()
+		{
+			std::error_code error;
+			const std::string cacheDirectory = Normalize(std::filesystem::path(MeshCache::DIRECTORY).parent_path().generic_string());
+			for (auto entry = std::filesystem::recursive_directory_iterator(m_options.directory, std::filesystem::directory_options::skip_permission_denied, error);
+				!error && entry != std::filesystem::recursive_directory_iterator(); entry.increment(error))
+			{
+				const std::string path = Normalize(entry->path().generic_string());
+				if (entry->is_directory() && path == cacheDirectory)
+				{
+					entry.disable_recursion_pending();
+					continue;
+				}
+
+				const ASSET_KIND kind = CookManifest::KindOf(path);
+				if (kind != ASSET_KIND::NONE && entry->is_regular_file())
+					AddNode(path, kind);
+			}
+
+			if (error)
+				std::cerr << "omega-cook error: couldn't scan " << m_options.directory << ", " << error.message() << ".\n";
+		}
+
+		/**
+		 * @brief Parse the scenes in parallel and link them to the assets they use, the prefabs found on the way are parsed too.
+		 */
+		void ResolveScenes()
+		{
+			std::vector<size_t> scenes;
+			for (size_t i = 0u; i < m_nodes.size(); ++i)
+			{
+				if (m_nodes[i].kind == ASSET_KIND::SCENE)
+					scenes.emplace_back(i);
+			}
+
+			while (!scenes.empty())
+			{
+				std::vector<std::vector<std::pair<std::string, ASSET_KIND>>> used(scenes.size());
+				m_jobs.ParallelFor(0u, scenes.size(), [this, &scenes, &used](const uint64_t p_index)
+				{
+					AssetNode& scene = m_nodes[scenes[p_index]];
+					try
+					{
+						const SceneDescription description = SceneLoader::Parse(scene.source);
+						for (const SceneNodeDescription& node : description.nodes)
+						{
+							if (node.prefab)
+								used[p_index].emplace_back(*node.prefab, ASSET_KIND::SCENE);
+							if (node.model)
+								used[p_index].emplace_back(node.model->meshFilepath, ASSET_KIND::MESH);
+							if (node.material)
+							{
+								used[p_index].emplace_back(node.material->texturePath, ASSET_KIND::TEXTURE);
+								used[p_index].emplace_back(node.material->normalPath, ASSET_KIND::TEXTURE);
+							}
+						}
+					}
+					catch (const std::exception& p_exception)
+					{
+						std::cerr << "omega-cook error: " << scene.source << ", " << p_exception.what() << '\n';
+						scene.failed = true;
+					}
+				}, 1u);
+
+				// Linked sequentially, the nodes of the assets used outside the directory are added on the way
+				std::vector<size_t> newScenes;
+				for (size_t i = 0u; i < scenes.size(); ++i)
+				{
+					for (const auto& [source, kind] : used[i])
+					{
+						if (source.empty() || source == "NONE")
+							continue;
+
+						const size_t count = m_nodes.size();
+						const size_t dependency = AddNode(source, kind);
+						std::vector<size_t>& dependencies = m_nodes[scenes[i]].dependencies;
+						if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end())
+							dependencies.emplace_back(dependency);
+
+						if (m_nodes.size() != count && kind == ASSET_KIND::SCENE)
+							newScenes.emplace_back(dependency);
+					}
+				}
+
+				scenes = std::move(newScenes);
+			}
+		}
+
+		void HashSources()
+		{
+			m_jobs.ParallelFor(0u, m_nodes.size(), [this](const uint64_t p_index)
+			{
+				AssetNode& node = m_nodes[p_index];
+				if (!CookManifest::Stamp(node.source, node.size, node.writeTime))
+				{
+					node.missing = true;
+					return;
+				}
+
+				// A source with the size and the time of its last cook isn't read
+				const CookedAsset* cooked = m_manifest.Find(node.source);
+				if (cooked && cooked->sourceSize == node.size && cooked->sourceWriteTime == node.writeTime && !m_options.force)
+					node.hash = cooked->sourceHash;
+				else
+					node.hash = Utils::MappedFile(node.source).ContentHash();
+
+				std::error_code error;
+				node.dirty = m_options.force || !cooked || cooked->sourceHash != node.hash
+					|| cooked->cookVersion != CookVersion(node.kind, m_options.textures)
+					|| (node.kind != ASSET_KIND::SCENE && !std::filesystem::exists(CookedPath(node), error));
+			});
+		}
+
+		/**
+		 * @brief Cook the dirty meshes and textures on the pool, the threads without work steal it from the busy ones.
+		 */
+		void CookSources()
+		{
+			std::vector<Utils::TaskHandle> tasks;
+			for (AssetNode& node : m_nodes)
+			{
+				if (node.missing || !node.dirty || node.kind == ASSET_KIND::SCENE)
+					continue;
+
+				tasks.emplace_back(m_jobs.Submit([this, &node]()
+				{
+					MeshImportStatistics statistics;
+					node.failed = !CookSource(node, statistics);
+
+					std::lock_guard<std::mutex> lock(m_outputMutex);
+					std::cout << (node.failed ? "Failed   " : "Cooked   ") << node.source << '\n';
+					if (m_options.verbose && statistics.triangles > 0u)
+					{
+						std::cout << "         ACMR " << statistics.before.acmr << " -> " << statistics.after.acmr << ", ATVR " << statistics.before.atvr
+							<< " -> " << statistics.after.atvr << " for " << statistics.triangles << " triangles in " << statistics.meshlets << " meshlets\n";
+					}
+				}));
+			}
+
+			m_jobs.WaitForAll(tasks);
+		}
+
+		bool CookSource(const AssetNode& p_node, MeshImportStatistics& p_statistics) const
+		{
+			if (p_node.kind == ASSET_KIND::MESH)
+			{
+				// The loader only imports a source without a valid cooked file
+				if (m_options.force)
+				{
+					std::error_code error;
+					std::filesystem::remove(MeshCache::CookedPath(p_node.hash), error);
+				}
+
+				return LoaderManager::LoadMesh(p_node.source, p_node.hash, &p_statistics) != nullptr;
+			}
+
+			Texture texture;
+			return TextureCache::Import(Utils::VirtualFileSystem::Instance().Open(p_node.source), p_node.hash, m_options.textures, texture);
+		}
+
+		/**
+		 * @brief Fail the scenes using a source missing or that failed, through their prefabs.
+		 * A scene that didn't change is recorded again when a source it uses was cooked again.
+		 */
+		void PropagateFailures()
+		{
+			// Visited in depth-first order, a cycle of prefabs is reported as a failure
+			std::vector<uint8_t> state(m_nodes.size(), 0u);
+			const std::function<bool(size_t)> visit = [this, &state, &visit](const size_t p_index)
+			{
+				AssetNode& node = m_nodes[p_index];
+				if (state[p_index] == 2u)
+					return node.failed;
+				if (state[p_index] == 1u)
+				{
+					std::cerr << "omega-cook error: " << node.source << " instantiates itself through its prefabs.\n";
+					return node.failed = true;
+				}
+
+				state[p_index] = 1u;
+				for (const size_t dependency : node.dependencies)
+				{
+					const AssetNode& used = m_nodes[dependency];
+					if (used.missing)
+						std::cerr << "omega-cook error: " << node.source << " uses " << used.source << " which doesn't exist.\n";
+
+					if (visit(dependency) || used.missing)
+						node.failed = true;
+				}
+
+				state[p_index] = 2u;
+				return node.failed;
+			};
+
+			for (size_t i = 0u; i < m_nodes.size(); ++i)
+				visit(i);
+
+			for (AssetNode& node : m_nodes)
+			{
+				if (node.kind == ASSET_KIND::SCENE && !node.dirty)
+				{
+					node.dirty = std::any_of(node.dependencies.begin(), node.dependencies.end(), [this](const size_t p_dependency)
+					{
+						return m_nodes[p_dependency].dirty;
+					});
+				}
+			}
+		}
+
+		bool WriteManifest()
+		{
+			for (const AssetNode& node : m_nodes)
+			{
+				// A failed source keeps the entry of its last successful cook, its cooked file is still there
+				if (node.missing)
+				{
+					m_manifest.Remove(node.source);
+					continue;
+				}
+
+				if (node.failed)
+					continue;
+
+				CookedAsset asset;
+				asset.source = node.source;
+				asset.kind = node.kind;
+				asset.sourceHash = node.hash;
+				asset.sourceSize = node.size;
+				asset.sourceWriteTime = node.writeTime;
+				asset.cooked = CookedPath(node);
+				asset.cookVersion = CookVersion(node.kind, m_options.textures);
+				for (const size_t dependency : node.dependencies)
+					asset.dependencies.emplace_back(m_nodes[dependency].source);
+
+				m_manifest.Set(std::move(asset));
+			}
+
+			// The sources deleted since the last cook
+			std::vector<std::string> removed;
+			for (const auto& [source, asset] : m_manifest.Assets())
+			{
+				std::error_code error;
+				if (m_indices.count(source) == 0u && !std::filesystem::exists(source, error))
+					removed.emplace_back(source);
+			}
+
+			for (const std::string& source : removed)
+				m_manifest.Remove(source);
+
+			return m_manifest.Save(m_options.manifest);
+		}
+
+		/**
+		 * @brief Pack the sources, their cooked files and the manifest, the engine then opens a single file.
+		 * The sources are packed too, the engine takes the hash of a source from the archive to find its cooked file.
+		 */
+		bool WritePack() const
+		{
+			if (m_options.pack.empty())
+				return true;
+
+			std::vector<Utils::PackInput> inputs;
+			for (const AssetNode& node : m_nodes)
+			{
+				if (node.missing)
+					continue;
+
+				inputs.push_back({ node.source, {} });
+
+				// A source that failed keeps the cooked file of its last successful cook, if any
+				std::error_code error;
+				const std::string cooked = CookedPath(node);
+				if (!cooked.empty() && std::filesystem::exists(cooked, error))
+					inputs.push_back({ cooked, {} });
+			}
+
+			inputs.push_back({ m_options.manifest, {} });
+
+			if (!Utils::PackArchive::Write(m_options.pack, inputs, m_options.compressPack))
+				return false;
+
+			std::cout << "Packed " << inputs.size() << " files in " << m_options.pack << ".\n";
+			return true;
+		}
+
+		const CookOptions& m_options;
+		Utils::JobSystem& m_jobs;
+		CookManifest m_manifest;
+		// A deque, the nodes are referenced by the cooking jobs while others are added
+		std::deque<AssetNode> m_nodes;
+		std::unordered_map<std::string, size_t> m_indices;
+		std::mutex m_outputMutex;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: omega-cook [options] <asset directory>   cook the meshes and textures of a directory and of its scenes\n\n"
+			"Run it from the directory holding Resources/, the cooked files go to Resources/cache/ like the ones of the engine.\n\n"
+			"Options:\n"
+			"  --manifest <file>   manifest read then written (default " << CookManifest::DEFAULT_FILE << ")\n"
+			"  --force             cook every asset, even the ones up to date\n"
+			"  --pack <file>       pack the assets, their cooked files and the manifest in an archive (" << Utils::PackArchive::DEFAULT_FILE << " for the engine)\n"
+			"  --lz4               compress the files of the archive in LZ4\n"
+			"  --compress          compress the textures in BC1/BC3\n"
+			"  --kaiser            filter the mip chains with a Kaiser window rather than a box\n"
+			"  --srgb              filter the mip chains in linear space, for the textures stored in sRGB\n"
+			"  --verbose           print the vertex cache statistics of the imported meshes, ACMR and ATVR before and after\n";
+	}
+}
+
+int main(const int p_argc, char** p_argv)
+{
+	CookOptions options;
+	for (int i = 1; i < p_argc; ++i)
+	{
+		const std::string option = p_argv[i];
+		if (option == "--help" || option == "-h")
+		{
+			PrintUsage();
+			return 0;
+		}
+
+		if (option == "--manifest" && i + 1 < p_argc)
+			options.manifest = p_argv[++i];
+		else if (option == "--pack" && i + 1 < p_argc)
+			options.pack = p_argv[++i];
+		else if (option == "--lz4")
+			options.compressPack = true;
+		else if (option == "--force")
+			options.force = true;
+		else if (option == "--compress")
+			options.textures.compress = true;
+		else if (option == "--kaiser")
+			options.textures.mips.filter = Utils::MIP_FILTER::KAISER;
+		else if (option == "--srgb")
+			options.textures.mips.srgb = true;
+		else if (option == "--verbose")
+			options.verbose = true;
+		else if (option.rfind("--", 0) != 0 && options.directory.empty())
+			options.directory = option;
+		else
+		{
+			std::cerr << "omega-cook error: unexpected argument " << option << "\n\n";
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	std::error_code error;
+	if (options.directory.empty() || !std::filesystem::is_directory(options.directory, error))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	try
+	{
+		return AssetGraph(options).Cook() ? 0 : 1;
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "omega-cook error: " << p_exception.what() << '\n';
+		return 1;
+	}
+}
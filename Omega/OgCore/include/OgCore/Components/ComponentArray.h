@@ -26,6 +26,15 @@ namespace OgEngine
 		 */
 		void InsertData(Entity p_entity, T p_component);
 
+		/**
+		 * @brief Insert a component to each of several entities, copied in one block after the components already packed
+		 * @param p_entities The entities to add a component
+		 * @param p_components The components to add, one per entity
+		 * @param p_count The number of entities
+		 * @note The method will fail if a component already exists on one of the entities or if one of the entities doesn't exist
+		 */
+		void InsertData(const Entity* p_entities, const T* p_components, size_t p_count);
+
 		/**
 		 * @brief Remove a component to an entity
 		 * @param p_entity The entity to remove from a component
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 
 
 template<typename T>
@@ -14,6 +15,25 @@ void OgEngine::ComponentArray<T>::InsertData(const OgEngine::Entity p_entity, T
 	++m_size;
 }
 
+template <typename T>
+void OgEngine::ComponentArray<T>::InsertData(const Entity* p_entities, const T* p_components, const size_t p_count)
+{
+	assert(m_size + p_count <= MAX_ENTITIES && "Too many components in existence.");
+
+	std::copy(p_components, p_components + p_count, m_componentArray.begin() + m_size);
+
+	m_entityToIndexMap.reserve(m_size + p_count);
+	m_indexToEntityMap.reserve(m_size + p_count);
+	for (size_t i = 0u; i < p_count; ++i)
+	{
+		assert(m_entityToIndexMap.find(p_entities[i]) == m_entityToIndexMap.end() && "Component added to same p_entity more than once.");
+
+		m_entityToIndexMap[p_entities[i]] = m_size + i;
+		m_indexToEntityMap[m_size + i] = p_entities[i];
+	}
+	m_size += p_count;
+}
+
 template <typename T>
 void OgEngine::ComponentArray<T>::RemoveData(const OgEngine::Entity p_entity)
 {
@@ -23,6 +43,8 @@ void OgEngine::ComponentArray<T>::RemoveData(const OgEngine::Entity p_entity)
 	size_t indexOfRemovedEntity = m_entityToIndexMap[p_entity];
 	size_t indexOfLastElement = m_size - 1;
 	m_componentArray[indexOfRemovedEntity] = m_componentArray[indexOfLastElement];
+	// The slot left keeps no copy, the resources the component references are released with it
+	m_componentArray[indexOfLastElement] = T();
 
 	// Update map to point to moved spot
 	const Entity entityOfLastElement = m_indexToEntityMap[indexOfLastElement];
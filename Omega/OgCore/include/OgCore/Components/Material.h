@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <OgCore/Export.h>
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Resource/Texture.h>
 #include <glm/glm.hpp>
 
 namespace OgEngine
@@ -100,13 +102,13 @@ namespace OgEngine
 		void SetRoughness(const float p_roughness);
 
 		/**
-		 * @brief Define the texture of the material
+		 * @brief Define the texture of the material, it is kept from being evicted while the material uses it
 		 * @param p_texID is the ID of the texture.
 		 */
 		void SetTextureID(const std::string& p_texID, const std::string& p_texPath);
 
 		/**
-		 * @brief Define the normalMap of the material
+		 * @brief Define the normalMap of the material, it is kept from being evicted while the material uses it
 		 * @param p_normID is the ID of the normalMap.
 		 */
 		void SetNormalMapID(const std::string& p_normID, const std::string& p_normPath);
@@ -162,6 +164,9 @@ namespace OgEngine
 		std::string _texPath;
 		std::string _normName;
 		std::string _normPath;
+		// Keep the loaded textures from being evicted, the last material using one releases it
+		ResourceReference<Texture> m_textureReference;
+		ResourceReference<Texture> m_normalMapReference;
 		Transform* m_materialTransform = nullptr;
 
 		[[nodiscard]] static std::string DepthIndent(const int p_depth);
@@ -1,6 +1,7 @@
 #pragma once
 #include <OgCore/Export.h>
 #include <OgRendering/Resource/Mesh.h>
+#include <OgRendering/Managers/ResourceHandle.h>
 
 #include <OgCore/Components/Material.h>
 #include <glm/glm.hpp>
@@ -38,6 +39,8 @@ namespace OgEngine
 	private:
 		OgEngine::Material m_material;
 		OgEngine::Mesh* m_mesh = nullptr;
+		// Keeps the loaded mesh m_mesh belongs to from being evicted
+		ResourceReference<OgEngine::Mesh> m_meshReference;
 		std::string m_meshName;
 		std::string m_parentMeshName;
 		std::string m_meshFilepath;
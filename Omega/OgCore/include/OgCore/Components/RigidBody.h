@@ -31,6 +31,7 @@ namespace OgEngine
 		[[nodiscard]] inline float ShapeSizeY() const;
 		[[nodiscard]] inline float ShapeSizeZ() const;
 		[[nodiscard]] inline float Mass() const;
+		[[nodiscard]] RB_COLLIDER_TYPE ColliderType() const;
 		[[nodiscard]] inline OgEngine::Transform* Transform() const;
 
 		static physx::PxTransform ConvertGPMtoPhysics(OgEngine::Transform* p_transform);
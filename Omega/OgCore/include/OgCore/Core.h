@@ -2,12 +2,22 @@
 #include <OgCore/Export.h>
 #include <OgAudio/Audio/AudioEngine.h>
 #include <OgRendering/Rendering/VulkanContext.h>
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Resource/Texture.h>
 #include <OgCore/Systems/RenderingSystem.h>
 #include <OgCore/Systems/PhysicsSystem.h>
 #include <OgCore/Systems/LightSystem.h>
 #include <OgCore/Systems/ScriptSystem.h>
 #include <OgCore/SceneNode.h>
+#include <OgCore/SceneLoader/SceneDescription.h>
+#include <OgCore/SceneLoader/SceneSaver.h>
+#include <OgCore/SceneLoader/Prefab.h>
+#include <OgCore/SceneLoader/CellStreamer.h>
 #include <OgPhysics/Physics.h>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 
 
@@ -52,7 +62,7 @@ namespace OgEngine
 		 * @brief Remove an entity from the hierarchy.
 		 * @param p_entity The entity to remove
 		 */
-		void DestroyEntityNode(SceneNode* p_entity) const;
+		void DestroyEntityNode(SceneNode* p_entity);
 
 		/**
 		 * @brief Add a component to an entity
@@ -98,14 +108,98 @@ namespace OgEngine
 		/**
 		 * @brief Save the EDITOR_SCENE into a scene file.
 		 * @param p_sceneName Name of the scene
+		 * @note The file is written on a background thread from a copy of the scene. Saving again the file loaded or saved last only writes the entities that changed.
+		 * @note Saving a streamed scene into another file writes its partition next to the new file (see BakeWorldPartition) and reloads the scene from it.
 		 */
 		void SaveScene(const std::string& p_sceneName);
 
 		/**
 		 * @brief Load a scene file into the editor.
 		 * @param p_file The scene file to load
+		 * @param p_async If true, the function returns as soon as the hierarchy is built and the models are attached over the next frames, as their resources finish loading.
+		 * @note All the meshes and textures of the scene that are not in memory yet are loaded at the same time.
 		 */
-		void LoadScene(const std::string& p_file);
+		void LoadScene(const std::string& p_file, const bool p_async = false);
+
+		/**
+		 * @brief Create the nodes of a scene description.
+		 * @param p_scene The description, in depth-first order
+		 * @param p_parent The node receiving the first node of the description, nullptr to create it as a new root
+		 * @param p_createdNodes Receive the node created for each node of the description, filled as they are created so they can be removed if an exception is thrown
+		 */
+		void BuildSceneNodes(const SceneDescription& p_scene, SceneNode* p_parent, std::vector<SceneNode*>& p_createdNodes);
+
+		/**
+		 * @brief Create the components of a freshly created entity from its scene file description.
+		 * @param p_entity The entity to fill
+		 * @param p_node The description of the node read from the scene file
+		 * @note The model and material are only queued, they are attached by UpdateSceneLoading once their resources are loaded.
+		 */
+		void LoadSceneNode(const Entity p_entity, const SceneNodeDescription& p_node);
+
+		/**
+		 * @brief Give a transform the name, position, rotation and scale read from a scene file.
+		 */
+		static void ApplyTransform(Transform& p_transform, const TransformDescription& p_description);
+
+		/**
+		 * @brief Split the EDITOR_SCENE into cells streamed around the camera, then reload it.
+		 * @param p_file The scene file to write, its partition is written next to it (see WorldPartition::DirectoryOf)
+		 * @param p_cellSize The size of a cell on X and Z
+		 * @note The cells of the current partition that are not loaded are read back, so baking again keeps the whole world.
+		 */
+		void BakeWorldPartition(const std::string& p_file, const float p_cellSize);
+
+		/**
+		 * @brief Return the streamer of the cells of the loaded scene, nullptr if the scene has no partition.
+		 */
+		[[nodiscard]] CellStreamer* GetCellStreamer() const;
+
+		/**
+		 * @brief Compile a prefab file, or get it from the prefabs already compiled.
+		 * @param p_file The prefab file (a scene file whose first node is the root of the prefab)
+		 * @return The compiled prefab, nullptr if the file is invalid or contains itself
+		 * @note The resources of the prefab are only requested the first time, its models are built by UpdateSceneLoading once they are loaded.
+		 */
+		const Prefab* LoadPrefab(const std::string& p_file);
+
+		/**
+		 * @brief Create an instance of a prefab.
+		 * @param p_prefab The prefab file
+		 * @param p_parent The node under which the instance is created
+		 * @return The root node of the instance, nullptr if the prefab couldn't be compiled
+		 * @note The scene files only store the prefab and the transform of the instance root, the other changes made to an instance are not saved.
+		 */
+		SceneNode* InstantiatePrefab(const std::string& p_prefab, SceneNode* p_parent);
+
+		/**
+		 * @brief Write a node and its children as a prefab file.
+		 * @param p_node The root of the prefab
+		 * @param p_file The prefab file to write
+		 * @return True if the file was written
+		 */
+		bool SavePrefab(SceneNode* p_node, const std::string& p_file);
+
+		/**
+		 * @brief Ask the ResourceManager for every mesh and texture used by a scene that is not in memory yet, as VISIBLE loads.
+		 * @param p_scene The scene description to look into
+		 */
+		void RequestSceneResources(const SceneDescription& p_scene);
+
+		/**
+		 * @brief Attach the models whose mesh and textures finished loading, without blocking. Called every frame by Run.
+		 */
+		void UpdateSceneLoading();
+
+		/**
+		 * @brief Wait for all the resources of the scene being loaded and attach all the remaining models.
+		 */
+		void FinishSceneLoading();
+
+		/**
+		 * @brief Tell if some models of the last loaded scene are still waiting for their resources.
+		 */
+		[[nodiscard]] bool IsSceneLoading() const;
 
 		/**
 		 * @brief Remove all remaining children recursively from the renderer.
@@ -115,12 +209,12 @@ namespace OgEngine
 
 
 		/**
-		 * @brief Remove all remaining children recursively from the renderer.
-		 * @param p_file The file to write in
-		 * @param p_parent The parent to start recording from
-		 * @param p_depth The depth of the current group of data
+		 * @brief Copy a node and its children into a description, without formatting anything.
+		 * @param p_root The node to start from
+		 * @return The nodes in depth-first order, the key of each node is its entity
+		 * @note The streamed cells below p_root are skipped, they are only written by BakeWorldPartition.
 		 */
-		void SerializeChildren(std::ostream& p_file, SceneNode* p_parent, int& p_depth);
+		[[nodiscard]] SceneDescription CaptureScene(SceneNode* p_root) const;
 
 		/**
 		 * @brief Add a handle to a texture in the current renderer.
@@ -135,12 +229,6 @@ namespace OgEngine
 		 */
 		void AddRigidBodyToPhysics(const Entity p_entity);
 		
-		/**
-		 * @brief Remove all remaining children recursively from the renderer.
-		 * @param p_depth The depth to indent
-		 */
-		[[nodiscard]] static std::string DepthIndent(const int p_depth);
-
 		/**
 		 * @brief Register all Components and Systems in a specific Scene, needed in all scene as ECS is templated and need to allocate everything at compile time.
 		 * @param p_scene The concern scene in which we register the components
@@ -174,6 +262,187 @@ namespace OgEngine
 		std::array<SceneNode*, 2> roots = { nullptr, nullptr };
 
 		SceneNode* inspectorNode = nullptr;
+
+		/**
+		 * @brief Called each time models of the scene being loaded get attached, with the number of attached models and the total number of models.
+		 */
+		std::function<void(uint64_t p_loaded, uint64_t p_total)> onSceneLoadingProgress;
+
+	private:
+		/**
+		 * @brief The mesh and textures of a model not built yet, referenced so they are neither evicted nor cancelled meanwhile.
+		 */
+		struct ModelResources
+		{
+			ResourceReference<Mesh> mesh;
+			std::vector<ResourceReference<Texture>> textures;
+		};
+
+		/**
+		 * @brief A model read from the scene file, waiting for its mesh and textures to be loaded.
+		 */
+		struct PendingModel
+		{
+			Entity entity;
+			ModelDescription model;
+			std::optional<MaterialDescription> material;
+			ModelResources resources;
+		};
+
+		/**
+		 * @brief A compiled prefab whose models are not built yet, holding the resources of its nodes until they are.
+		 */
+		struct PendingPrefab
+		{
+			std::string file;
+			std::vector<ModelResources> resources;
+		};
+
+		/**
+		 * @brief The resources requested by a streamed cell, held until the cell is deactivated so the loads not started by then are cancelled.
+		 */
+		struct CellResources
+		{
+			std::vector<ResourceReference<Mesh>> meshes;
+			std::vector<ResourceReference<Texture>> textures;
+			/**
+			 * @brief Priority of the loads, raised as the camera gets closer to the cell.
+			 */
+			LOAD_PRIORITY priority{ LOAD_PRIORITY::PREFETCH };
+		};
+
+		/**
+		 * @brief Ask the ResourceManager for the meshes and textures of a scene.
+		 * @param p_cell The cell the scene is the content of, its resources are requested as PREFETCH loads and held by it; nullptr for a scene loaded as a whole
+		 */
+		void RequestResources(const SceneDescription& p_scene, CellResources* p_cell);
+
+		/**
+		 * @brief Raise the priority of the loads of the cells the camera is in (CRITICAL) or next to (VISIBLE).
+		 * @param p_position The position of the camera
+		 */
+		void PrioritizeCells(const glm::vec3& p_position);
+
+		/**
+		 * @brief Tell if the mesh and the textures of a model are not loading anymore.
+		 * @param p_model The model description
+		 * @param p_material The material of the model, if any
+		 */
+		[[nodiscard]] static bool IsModelReady(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material);
+
+		/**
+		 * @brief Build the models of the compiled prefabs whose resources finished loading.
+		 */
+		void BuildReadyPrefabs();
+
+		/**
+		 * @brief Create the ModelRS of a pending model, its resources must be loaded.
+		 * @param p_pending The model to attach
+		 */
+		void AttachModel(const PendingModel& p_pending);
+
+		/**
+		 * @brief Reference the mesh and textures of a model, requested beforehand, until the model is built.
+		 */
+		[[nodiscard]] static ModelResources HoldModelResources(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material);
+
+		/**
+		 * @brief Create a model from its description, its resources must be loaded.
+		 * @param p_model The model description
+		 * @param p_material The material of the model, if any
+		 * @return The model, using a cube if the mesh couldn't be loaded and error.png for the textures that couldn't be loaded
+		 */
+		[[nodiscard]] ModelRS BuildModel(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material);
+
+		/**
+		 * @brief Add the rigidBody and the light source of a node description to an entity.
+		 * @param p_entity The entity to fill
+		 * @param p_node The description of the node
+		 */
+		void AddSceneComponents(const Entity p_entity, const SceneNodeDescription& p_node);
+
+		/**
+		 * @brief Create the content of a prefab (components of its root and its children) under an instance node.
+		 * The transforms and the models of the compiled prefab are copied in one block each, only the nested instances apply their own transform.
+		 * @param p_prefab The prefab file
+		 * @param p_instance The root node of the instance, its transform is kept
+		 */
+		void InstantiatePrefabContent(const std::string& p_prefab, SceneNode* p_instance);
+
+		/**
+		 * @brief Stop considering a node and its children as prefab instances, before destroying them.
+		 * @param p_node The node removed
+		 */
+		void ForgetPrefabInstances(SceneNode* p_node);
+
+		/**
+		 * @brief Start streaming the partition of a scene file, if it has one.
+		 * @param p_file The scene file loaded
+		 */
+		void StartStreaming(const std::string& p_file);
+
+		/**
+		 * @brief Add a streamed cell to the EDITOR_SCENE, its models are attached as their resources finish loading.
+		 */
+		void ActivateCell(const CellCoordinates& p_cell, const SceneDescription& p_content);
+
+		/**
+		 * @brief Remove a streamed cell from the EDITOR_SCENE.
+		 */
+		void DeactivateCell(const CellCoordinates& p_cell);
+
+		/**
+		 * @brief Give the rendering the resources reloaded since the last frame: the models take the new meshes, the new textures are uploaded and the shaders rebuilt.
+		 */
+		void ApplyResourceReloads();
+
+		/**
+		 * @brief Evict the resources over budget and destroy the buffers the rendering made from the evicted meshes.
+		 */
+		void TrimResources();
+
+		/**
+		 * @brief Report how large the textures of the current scene are drawn and give the rendering the textures whose mip levels changed.
+		 */
+		void UpdateTextureStreaming();
+
+		/**
+		 * @brief Make the materials of the models and of the compiled prefabs reference the new version of a reloaded or streamed texture.
+		 * @param p_texture The name of the texture
+		 */
+		void ReplaceMaterialTextures(const std::string& p_texture);
+
+		SceneSaver m_sceneSaver;
+		std::unordered_map<std::string, std::unique_ptr<Prefab>> m_prefabs;
+		std::unordered_set<std::string> m_compilingPrefabs;
+		/**
+		 * @brief Compiled prefabs whose models are not built yet, their resources are loading.
+		 */
+		std::vector<PendingPrefab> m_pendingPrefabs;
+		/**
+		 * @brief Prefab file of each instance root.
+		 */
+		std::unordered_map<Entity, std::string> m_prefabInstances;
+		std::vector<PendingModel> m_pendingModels;
+		std::unordered_set<std::string> m_texturesToRegister;
+		/**
+		 * @brief Textures given to the renderer. The materials of the models reference them, the last model destroyed lets them be evicted.
+		 * @note Referenced here as well with the raytracing pipeline, which can't remove an image, and for the fallback textures.
+		 */
+		mutable std::unordered_map<std::string, ResourceReference<Texture>> m_uploadedTextures;
+		uint64_t m_sceneLoadingTotal{ 0u };
+
+		std::unique_ptr<CellStreamer> m_cellStreamer;
+		/**
+		 * @brief Height of the window, the size the textures are drawn at is measured in its pixels.
+		 */
+		float m_viewportHeight{ 0.0f };
+		/**
+		 * @brief Root node of each streamed cell in the scene, and their entities.
+		 */
+		std::unordered_map<CellCoordinates, SceneNode*, CellCoordinatesHash> m_cellNodes;
+		std::unordered_set<Entity> m_cellRoots;
+		std::unordered_map<CellCoordinates, CellResources, CellCoordinatesHash> m_cellResources;
 	};
 }
 
@@ -1,7 +1,12 @@
 #pragma once
+#ifdef _WIN32
 #pragma warning (disable:4251)
+#endif
 
-#ifdef CORE_EXPORT
+// CORE_STATIC: the sources are compiled in the program using them, like the cook tool does
+#if defined(CORE_STATIC) || !defined(_WIN32)
+#define CORE_API
+#elif defined(CORE_EXPORT)
 #define CORE_API __declspec(dllexport)
 #else
 #define CORE_API __declspec(dllimport)
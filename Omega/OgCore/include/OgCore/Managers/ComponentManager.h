@@ -34,6 +34,16 @@ namespace OgEngine
 		template<typename T>
 		void AddComponent(Entity p_entity, T p_component);
 
+		/**
+		 * @brief Add a component to each of several entities, copied in one block
+		 * @param p_entities The entities to which we add a component
+		 * @param p_components The components to add, one per entity
+		 * @param p_count The number of entities
+		 * @note The method will fail if an entity doesn't exist or if the component already exists for one of them
+		 */
+		template<typename T>
+		void AddComponents(const Entity* p_entities, const T* p_components, size_t p_count);
+
 		/**
 		 * @brief Remove a component of an entity
 		 * @param p_entity The entity to which we remove a component
@@ -36,6 +36,12 @@ void OgEngine::ComponentManager::AddComponent(Entity p_entity, T p_component)
 	GetComponentArray<T>()->InsertData(p_entity, p_component);
 }
 
+template <typename T>
+void OgEngine::ComponentManager::AddComponents(const Entity* p_entities, const T* p_components, const size_t p_count)
+{
+	GetComponentArray<T>()->InsertData(p_entities, p_components, p_count);
+}
+
 template <typename T>
 void OgEngine::ComponentManager::RemoveComponent(Entity p_entity)
 {
@@ -2,6 +2,7 @@
 #include <OgCore/Export.h>
 #include <memory>
 #include <array>
+#include <vector>
 #include <OgCore/Entities/Types.h>
 #include <OgCore/Managers/ComponentManager.h>
 #include <OgCore/Managers/EntityManager.h>
@@ -9,6 +10,8 @@
 
 namespace OgEngine
 {
+	struct Transform;
+
 	enum class CORE_API Scene : std::uint8_t
 	{
 		EDITOR_SCENE = 0u,
@@ -41,6 +44,14 @@ namespace OgEngine
 		 */
 		[[nodiscard]] static Entity CreateEntity();
 
+		/**
+		 * @brief Create one entity per transform, the transforms being copied in one block instead of a named default one per entity
+		 * @param p_transforms The transforms of the entities, their names included
+		 * @param p_entities The entities created are added to it, in the order of the transforms
+		 * @note The method will fail if you try to create more entity than the maximum supported AND alive entities (5000)
+		 */
+		static void CreateEntities(const std::vector<Transform>& p_transforms, std::vector<Entity>& p_entities);
+
 		/**
 		 * @brief Destroy an entity and all the components associated. It also remove the entity from the systems who uses the entity
 		 * @param p_entity The entity to destroy
@@ -65,6 +76,16 @@ namespace OgEngine
 		template <typename T>
 		static void AddComponent(const Entity p_entity, T p_component);
 
+		/**
+		 * @brief Add a component to each of several entities, the components are copied in one block
+		 * @param p_entities The entities to which we add a component
+		 * @param p_components The components to add, one per entity
+		 * @param p_count The number of entities
+		 * @note The method will fail if an entity doesn't exist or if the component already exists for one of them
+		 */
+		template <typename T>
+		static void AddComponents(const Entity* p_entities, const T* p_components, const size_t p_count);
+
 		/**
 		 * @brief Remove a component of an entity
 		 * @param p_entity The entity to which we remove a component
@@ -118,6 +139,12 @@ namespace OgEngine
 		static void SetSystemSignature(const Signature p_signature);
 #pragma endregion
 	private:
+		/**
+		 * @brief Bind a component just added to the transform of its entity and update the signature of the entity
+		 */
+		template <typename T>
+		static void OnComponentAdded(const Entity p_entity);
+
 		static std::array<std::unique_ptr<ComponentManager>, 2> m_componentManager;
 		static std::array<std::unique_ptr<EntityManager>, 2>    m_entityManager;
 		static std::array<std::unique_ptr<SystemManager>, 2>    m_systemManager;
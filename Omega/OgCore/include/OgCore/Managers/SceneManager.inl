@@ -14,9 +14,25 @@ inline void OgEngine::SceneManager::RegisterComponent()
 
 template <typename T>
 void OgEngine::SceneManager::AddComponent(Entity p_entity, T p_component)
+{
+	m_componentManager[static_cast<uint8_t>(m_currentScene)]->AddComponent<T>(p_entity, p_component);
+	OnComponentAdded<T>(p_entity);
+}
+
+template <typename T>
+void OgEngine::SceneManager::AddComponents(const Entity* p_entities, const T* p_components, const size_t p_count)
+{
+	m_componentManager[static_cast<uint8_t>(m_currentScene)]->AddComponents<T>(p_entities, p_components, p_count);
+	for (size_t i = 0u; i < p_count; ++i)
+	{
+		OnComponentAdded<T>(p_entities[i]);
+	}
+}
+
+template <typename T>
+void OgEngine::SceneManager::OnComponentAdded(const Entity p_entity)
 {
 	const auto indexScene = static_cast<uint8_t>(m_currentScene);
-	m_componentManager[indexScene]->AddComponent<T>(p_entity, p_component);
 
 	if (typeid(T) == typeid(OgEngine::ModelRS))
 	{
@@ -0,0 +1,130 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <OgCore/SceneLoader/WorldPartition.h>
+#include <OgRendering/Utils/JobSystem.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Limits applied by the cell streamer on each update.
+	 */
+	struct CORE_API StreamingBudget
+	{
+		/**
+		 * @brief Cells closer than this to the camera are streamed in.
+		 */
+		float loadRadius{ 128.0f };
+
+		/**
+		 * @brief Cells further than this from the camera are streamed out, keep it above loadRadius to avoid cells going back and forth.
+		 */
+		float unloadRadius{ 160.0f };
+
+		/**
+		 * @brief Number of cell files read at the same time.
+		 */
+		uint32_t maxLoadsInFlight{ 4u };
+
+		/**
+		 * @brief Number of cells handed to the scene on a single update.
+		 */
+		uint32_t maxActivationsPerFrame{ 2u };
+
+		/**
+		 * @brief Time after which no more cell is handed to the scene on an update.
+		 */
+		double maxActivationMilliseconds{ 4.0 };
+
+		/**
+		 * @brief Cells are not read anymore once the cells resident or being read reach this size.
+		 */
+		uint64_t maxResidentBytes{ 256u * 1024u * 1024u };
+	};
+
+	/**
+	 * @brief Stream the cells of a world partition in and out around a position.
+	 * Cell files are parsed by the jobs of the engine pool, the callbacks are only called from Update so the scene is modified on the calling thread.
+	 * The streamer knows nothing of the scene itself and can be driven without any renderer.
+	 */
+	class CORE_API CellStreamer final
+	{
+	public:
+		using ActivateCallback = std::function<void(const CellCoordinates&, const SceneDescription&)>;
+		using DeactivateCallback = std::function<void(const CellCoordinates&)>;
+
+		/**
+		 * @param p_directory The directory of the partition
+		 * @param p_partition The manifest of the partition
+		 * @param p_onActivate Called when a cell is read and must be added to the scene
+		 * @param p_onDeactivate Called when an active cell must be removed from the scene
+		 */
+		CellStreamer(std::string p_directory, WorldPartition p_partition, ActivateCallback p_onActivate, DeactivateCallback p_onDeactivate);
+		~CellStreamer();
+
+		CellStreamer(const CellStreamer& p_other) = delete;
+		CellStreamer(CellStreamer&& p_other) = delete;
+		CellStreamer& operator=(const CellStreamer& p_other) = delete;
+		CellStreamer& operator=(CellStreamer&& p_other) = delete;
+
+		/**
+		 * @brief Start reading the cells coming in range, activate the ones read and deactivate the ones out of range.
+		 * @param p_position The position the streaming is centered on, usually the camera
+		 */
+		void Update(const glm::vec3& p_position);
+
+		/**
+		 * @brief Tell if a cell is active in the scene.
+		 */
+		[[nodiscard]] bool IsResident(const CellCoordinates& p_cell) const;
+
+		/**
+		 * @brief Return the cells active in the scene.
+		 */
+		[[nodiscard]] std::vector<CellCoordinates> ResidentCells() const;
+
+		/**
+		 * @brief Return the size of the cells active in the scene or being read.
+		 */
+		[[nodiscard]] uint64_t ResidentBytes() const;
+
+		[[nodiscard]] const WorldPartition& Partition() const;
+		[[nodiscard]] const std::string& Directory() const;
+
+		StreamingBudget budget;
+
+	private:
+		enum class CELL_STATE
+		{
+			UNLOADED,
+			READING,
+			READ,
+			RESIDENT,
+			FAILED
+		};
+
+		struct Cell
+		{
+			PartitionCell entry;
+			CELL_STATE state{ CELL_STATE::UNLOADED };
+			Utils::TaskHandle reading;
+			// Written by the reading job, read once it is done
+			SceneDescription content;
+			std::string readError;
+		};
+
+		Utils::JobSystem& m_jobs;
+		std::string m_directory;
+		WorldPartition m_partition;
+		ActivateCallback m_onActivate;
+		DeactivateCallback m_onDeactivate;
+		std::vector<Cell> m_cells;
+		uint64_t m_residentBytes{ 0u };
+		uint32_t m_loadsInFlight{ 0u };
+	};
+}
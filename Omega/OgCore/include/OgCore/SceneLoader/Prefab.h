@@ -0,0 +1,42 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <string>
+#include <vector>
+#include <OgCore/Components/ModelRS.h>
+#include <OgCore/Components/Transform.h>
+#include <OgCore/SceneLoader/SceneDescription.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Compiled subtree template, shared by all its instances and never modified once built.
+	 * A prefab file uses the scene file format, its first node being the root of the prefab.
+	 * The resources are resolved once they are loaded, an instance is made by copying each array of prototypes in one block.
+	 */
+	struct CORE_API Prefab
+	{
+		std::string path;
+
+		/**
+		 * @brief Content of the prefab file, in depth-first order.
+		 */
+		SceneDescription description;
+
+		/**
+		 * @brief Transform of each node but the root (name, position, rotation and scale applied), description.nodes[i + 1] for transforms[i].
+		 * @note The root of an instance keeps its own transform.
+		 */
+		std::vector<Transform> transforms;
+
+		/**
+		 * @brief Index in description.nodes of each node with a model, in depth-first order.
+		 */
+		std::vector<size_t> modelNodes;
+
+		/**
+		 * @brief Model of each node of modelNodes (mesh and material already resolved), models[i] for modelNodes[i].
+		 * @note Empty while the resources of the prefab are loading, the instances made meanwhile wait for them like the models of a scene.
+		 */
+		std::vector<ModelRS> models;
+	};
+}
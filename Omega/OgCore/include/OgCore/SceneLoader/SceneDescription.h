@@ -0,0 +1,148 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Data read from a <Transform> block.
+	 */
+	struct CORE_API TransformDescription
+	{
+		std::string name;
+		glm::vec3 position{ 0.0f };
+		glm::vec4 rotation{ 0.0f, 0.0f, 0.0f, 1.0f };
+		glm::vec3 scale{ 1.0f };
+	};
+
+	/**
+	 * @brief Data read from a <Model> block (the nested <Material> is stored apart).
+	 */
+	struct CORE_API ModelDescription
+	{
+		std::string parentMeshName;
+		std::string meshName;
+		std::string meshFilepath;
+		bool isSubMesh{ false };
+		uint32_t subMeshIndex{ 0u };
+	};
+
+	/**
+	 * @brief Data read from a <Material> block.
+	 */
+	struct CORE_API MaterialDescription
+	{
+		glm::vec4 color{ 1.0f };
+		glm::vec4 specular{ 1.0f };
+		glm::vec4 emissive{ 0.0f };
+		float ior{ 0.0f };
+		float roughness{ 0.0f };
+		int type{ 1 };
+		std::string textureName{ "default.png" };
+		std::string texturePath{ "Resources/textures/default.png" };
+		std::string normalName{ "NONE" };
+		std::string normalPath{ "NONE" };
+	};
+
+	/**
+	 * @brief Data read from a <RigidBody> block.
+	 */
+	struct CORE_API RigidBodyDescription
+	{
+		glm::vec3 shapeSize{ 1.0f };
+		float mass{ 1.0f };
+		int type{ 0 };
+		bool useGravity{ true };
+		bool isStatic{ false };
+	};
+
+	/**
+	 * @brief Data read from a <LightSource> block.
+	 */
+	struct CORE_API LightSourceDescription
+	{
+		glm::vec4 color{ 0.0f };
+		glm::vec4 direction{ 0.0f };
+		int lightType{ 0 };
+	};
+
+	/**
+	 * @brief One <SceneNode> of a scene file with all the components it declares.
+	 */
+	struct CORE_API SceneNodeDescription
+	{
+		/**
+		 * @brief Index of the parent node in SceneDescription::nodes, NO_PARENT for the root.
+		 */
+		uint64_t parent{ NO_PARENT };
+		/**
+		 * @brief Identifier of the node inside its scene file, used by the delta records to refer to it.
+		 */
+		uint64_t key{ 0u };
+		TransformDescription transform;
+		std::optional<ModelDescription> model;
+		std::optional<MaterialDescription> material;
+		std::optional<RigidBodyDescription> rigidBody;
+		std::optional<LightSourceDescription> lightSource;
+		/**
+		 * @brief Path of the prefab instantiated under this node, its transform overrides the transform of the prefab root.
+		 */
+		std::optional<std::string> prefab;
+
+		static constexpr uint64_t NO_PARENT = UINT64_MAX;
+	};
+
+	/**
+	 * @brief Structured, ECS independent content of a scene file.
+	 * @note Nodes are stored in depth-first order, so a parent always comes before its children and nodes[0] is the root.
+	 */
+	struct CORE_API SceneDescription
+	{
+		std::vector<SceneNodeDescription> nodes;
+	};
+
+	inline bool operator==(const TransformDescription& p_left, const TransformDescription& p_right)
+	{
+		return p_left.name == p_right.name && p_left.position == p_right.position
+			&& p_left.rotation == p_right.rotation && p_left.scale == p_right.scale;
+	}
+
+	inline bool operator==(const ModelDescription& p_left, const ModelDescription& p_right)
+	{
+		return p_left.parentMeshName == p_right.parentMeshName && p_left.meshName == p_right.meshName
+			&& p_left.meshFilepath == p_right.meshFilepath && p_left.isSubMesh == p_right.isSubMesh
+			&& p_left.subMeshIndex == p_right.subMeshIndex;
+	}
+
+	inline bool operator==(const MaterialDescription& p_left, const MaterialDescription& p_right)
+	{
+		return p_left.color == p_right.color && p_left.specular == p_right.specular && p_left.emissive == p_right.emissive
+			&& p_left.ior == p_right.ior && p_left.roughness == p_right.roughness && p_left.type == p_right.type
+			&& p_left.textureName == p_right.textureName && p_left.texturePath == p_right.texturePath
+			&& p_left.normalName == p_right.normalName && p_left.normalPath == p_right.normalPath;
+	}
+
+	inline bool operator==(const RigidBodyDescription& p_left, const RigidBodyDescription& p_right)
+	{
+		return p_left.shapeSize == p_right.shapeSize && p_left.mass == p_right.mass && p_left.type == p_right.type
+			&& p_left.useGravity == p_right.useGravity && p_left.isStatic == p_right.isStatic;
+	}
+
+	inline bool operator==(const LightSourceDescription& p_left, const LightSourceDescription& p_right)
+	{
+		return p_left.color == p_right.color && p_left.direction == p_right.direction && p_left.lightType == p_right.lightType;
+	}
+
+	/**
+	 * @brief Compare the components of two nodes, their position in the hierarchy (parent and key) is ignored.
+	 */
+	inline bool HasSameComponents(const SceneNodeDescription& p_left, const SceneNodeDescription& p_right)
+	{
+		return p_left.transform == p_right.transform && p_left.model == p_right.model && p_left.material == p_right.material
+			&& p_left.rigidBody == p_right.rigidBody && p_left.lightSource == p_right.lightSource && p_left.prefab == p_right.prefab;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <cstdint>
+#include <OgCore/SceneLoader/SceneDescription.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Shape of a generated scene, the ratios are probabilities between 0 and 1.
+	 */
+	struct CORE_API SceneGenerationSettings
+	{
+		uint64_t seed{ 0u };
+		/**
+		 * @brief Number of nodes, the root included.
+		 */
+		uint64_t nodeCount{ 1000u };
+		/**
+		 * @brief Maximum depth of a node, the children of the root being at depth 1.
+		 */
+		uint32_t maxDepth{ 8u };
+		float modelRatio{ 0.7f };
+		/**
+		 * @brief Probability for a model to have a material block.
+		 */
+		float materialRatio{ 0.8f };
+		float rigidBodyRatio{ 0.2f };
+		float lightSourceRatio{ 0.05f };
+		/**
+		 * @brief Probability for a model (or a texture) to use an asset already used in the scene rather than a new one.
+		 */
+		float assetReuseRatio{ 0.9f };
+		/**
+		 * @brief Positions are spread in a cube of this size centered on the origin.
+		 */
+		float extent{ 1000.0f };
+	};
+
+	struct CORE_API SceneGenerator
+	{
+		/**
+		 * @brief Build a random scene, always the same for the same settings.
+		 * @param p_settings The shape of the scene
+		 * @return The scene in depth-first order, the key of each node is its index
+		 * @note The assets are named after their index ("Resources/models/generated/mesh_12.obj"), they don't exist on disk:
+		 * the scene is meant to measure the scene files, not the resources.
+		 */
+		[[nodiscard]] static SceneDescription Generate(const SceneGenerationSettings& p_settings);
+	};
+}
@@ -1,30 +1,57 @@
 #pragma once
 #include <OgCore/Export.h>
 #include <string>
-#include <vector>
-#include <OgCore/Export.h>
-#include <glm/glm.hpp>
-#include <sstream>
+#include <string_view>
+#include <OgCore/SceneLoader/SceneDescription.h>
+#include <OgCore/SceneLoader/WorldPartition.h>
 
 namespace OgEngine
 {
 	struct CORE_API SceneLoader
 	{
-		static std::string ExtractNameFromAttribute(const std::string& p_attributeLine);
-		static float ExtractFloatFromAttribute(const std::string& p_attributeLine);
-		static int ExtractIntegerFromAttribute(const std::string& p_attributeLine);
-		static bool ExtractBooleanFromAttribute(const std::string& p_attributeLine);
-		static glm::vec3 ExtractVector3FromAttribute(const std::string& p_attributeLine);
-		static glm::vec4 ExtractVector4FromAttribute(const std::string& p_attributeLine);
-		static bool SceneFileIntegrityCheck(const std::string& p_file);
+		/**
+		 * @brief Read a scene file in one pass and build its structured description.
+		 * @param p_file The scene file to read
+		 * @return The description of every node and component of the scene
+		 * @note The delta journal saved next to the file (p_file + DELTA_EXTENSION) is applied if it exists.
+		 * @note Throw a std::runtime_error (with the faulty line) if the file can't be read, is badly structured or holds invalid values.
+		 */
+		[[nodiscard]] static SceneDescription Parse(const std::string& p_file);
+
+		/**
+		 * @brief Build the description of a scene already in memory.
+		 * @param p_content The content of a scene file
+		 * @return The description of every node and component of the scene
+		 * @note Throw a std::runtime_error (with the faulty line) if the content is badly structured or holds invalid values.
+		 */
+		[[nodiscard]] static SceneDescription ParseFromMemory(std::string_view p_content);
+
+		/**
+		 * @brief Apply the records of a delta journal (nodes updated, added or removed since the base file was written).
+		 * @param p_scene The scene read from the base file, kept in depth-first order
+		 * @param p_delta The content of the delta journal
+		 * @note Throw a std::runtime_error (with the faulty line) if a record is badly structured.
+		 */
+		static void ApplyDelta(SceneDescription& p_scene, std::string_view p_delta);
+
+		/**
+		 * @brief Extension added to a scene file name to get its delta journal.
+		 */
+		static constexpr const char* DELTA_EXTENSION = ".delta";
 
-	private:
-		static int StringToInt(const std::string_view p_stringValue);
-		static float StringToFloat(const std::string_view p_stringValue);
-		static std::string ExtractDataFromAttribute(const std::string& p_attributeLine);
+		/**
+		 * @brief Read the manifest of a world partition.
+		 * @param p_content The content of the manifest
+		 * @return The cell size and the list of cells of the partition
+		 * @note Throw a std::runtime_error (with the faulty line) if the content is badly structured or holds invalid values.
+		 */
+		[[nodiscard]] static WorldPartition ParseManifest(std::string_view p_content);
 
-		static std::vector<std::string> symbolsList;
-		
-		static bool IsPair(const std::string& p_openingSymbol, const std::string& p_closingSymbol);
+		/**
+		 * @brief Tell if a file is a valid Omega scene file.
+		 * @param p_file The scene file to check
+		 * @return True if the file could be parsed entirely
+		 */
+		[[nodiscard]] static bool SceneFileIntegrityCheck(const std::string& p_file);
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <OgCore/SceneLoader/SceneDescription.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Write scene files on a background thread.
+	 * Each save receives an immutable snapshot of the scene. When the file is the one saved (or loaded) last,
+	 * only the nodes that changed since are serialized and appended as delta records to the journal next to it
+	 * (see SceneLoader::DELTA_EXTENSION). The file is rewritten entirely, and the journal removed, once the journal grows too big.
+	 */
+	class CORE_API SceneSaver final
+	{
+	public:
+		SceneSaver();
+		~SceneSaver();
+
+		SceneSaver(const SceneSaver& p_other) = delete;
+		SceneSaver(SceneSaver&& p_other) = delete;
+		SceneSaver& operator=(const SceneSaver& p_other) = delete;
+		SceneSaver& operator=(SceneSaver&& p_other) = delete;
+
+		/**
+		 * @brief Queue the save of a scene, the function returns without touching the disk.
+		 * @param p_file The scene file to write
+		 * @param p_snapshot The scene to save, the key of each node must identify it for the whole session (its entity)
+		 * @note If a save is still waiting for the thread, it is replaced by this one.
+		 */
+		void Save(const std::string& p_file, SceneDescription p_snapshot);
+
+		/**
+		 * @brief Tell the saver that a scene file matches a freshly loaded scene, so the next save of this file is a delta.
+		 * @param p_file The scene file that was loaded
+		 * @param p_loaded The description read from the file, its keys are the ones used in the file
+		 * @param p_sessionKeys The session key (entity) given to each node of p_loaded
+		 */
+		void Track(const std::string& p_file, const SceneDescription& p_loaded, const std::vector<uint64_t>& p_sessionKeys);
+
+		/**
+		 * @brief Block until all the queued saves are written.
+		 */
+		void Wait();
+
+		/**
+		 * @brief Tell if a save is queued or being written.
+		 */
+		[[nodiscard]] bool IsSaving() const;
+
+		/**
+		 * @brief Write a whole scene in the scene file format.
+		 * @param p_scene The scene to serialize, in depth-first order
+		 * @return The content of the scene file
+		 */
+		[[nodiscard]] static std::string Serialize(const SceneDescription& p_scene);
+
+		/**
+		 * @brief The file is compacted when its journal is bigger than this fraction of the file.
+		 */
+		static constexpr uint64_t COMPACTION_RATIO = 2u;
+
+	private:
+		struct SaveRequest
+		{
+			std::string file;
+			SceneDescription snapshot;
+		};
+
+		/**
+		 * @brief Last saved state of a node, its parent is stored as a session key.
+		 */
+		struct SavedNode
+		{
+			SceneNodeDescription node;
+			uint64_t parentKey;
+			uint64_t fileKey;
+		};
+
+		void Work();
+		void Write(const SaveRequest& p_request);
+		void WriteFull(const SaveRequest& p_request);
+
+		/**
+		 * @brief Serialize the nodes that changed since the last save.
+		 * @return The delta records, empty if nothing changed
+		 */
+		[[nodiscard]] std::string SerializeDelta(const SceneDescription& p_snapshot);
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_wakeUp;
+		std::condition_variable m_idle;
+		std::optional<SaveRequest> m_request;
+		bool m_writing{ false };
+		bool m_quit{ false };
+
+		// Only used by the thread writing, or while it is idle
+		std::string m_trackedFile;
+		std::unordered_map<uint64_t, SavedNode> m_savedNodes;
+		uint64_t m_nextFileKey{ 0u };
+		uint64_t m_fileSize{ 0u };
+		uint64_t m_deltaSize{ 0u };
+
+		// Last member, the thread starts once everything it uses is constructed
+		std::thread m_worker;
+	};
+}
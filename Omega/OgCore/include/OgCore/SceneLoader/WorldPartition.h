@@ -0,0 +1,97 @@
+#pragma once
+#include <OgCore/Export.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <OgCore/SceneLoader/SceneDescription.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Position of a cell on the XZ grid of a world partition.
+	 */
+	struct CORE_API CellCoordinates
+	{
+		int32_t x{ 0 };
+		int32_t z{ 0 };
+
+		bool operator==(const CellCoordinates& p_other) const { return x == p_other.x && z == p_other.z; }
+		bool operator!=(const CellCoordinates& p_other) const { return !(*this == p_other); }
+	};
+
+	struct CORE_API CellCoordinatesHash
+	{
+		size_t operator()(const CellCoordinates& p_cell) const
+		{
+			return std::hash<uint64_t>()(static_cast<uint64_t>(static_cast<uint32_t>(p_cell.x)) << 32u | static_cast<uint32_t>(p_cell.z));
+		}
+	};
+
+	/**
+	 * @brief Entry of the partition manifest.
+	 */
+	struct CORE_API PartitionCell
+	{
+		CellCoordinates coordinates;
+		uint64_t nodeCount{ 0u };
+		/**
+		 * @brief Size of the cell file, used as the memory cost of the cell by the streaming budget.
+		 */
+		uint64_t bytes{ 0u };
+	};
+
+	/**
+	 * @brief Grid of cells a scene was split into, each cell being a scene file streamed on its own.
+	 * The partition of "scene.omega" is stored in the directory "scene.omega.cells", next to the scene file which keeps the content that is always loaded.
+	 */
+	struct CORE_API WorldPartition
+	{
+		float cellSize{ 64.0f };
+		std::vector<PartitionCell> cells;
+
+		/**
+		 * @brief Return the cell containing a position.
+		 * @param p_position The position in world space (Y is ignored)
+		 */
+		[[nodiscard]] CellCoordinates CellOf(const glm::vec3& p_position) const;
+
+		/**
+		 * @brief Return the distance on the XZ plane between a position and the closest point of a cell.
+		 * @param p_position The position in world space (Y is ignored)
+		 * @param p_cell The cell to measure
+		 * @return 0 if the position is inside the cell
+		 */
+		[[nodiscard]] float DistanceTo(const glm::vec3& p_position, const CellCoordinates& p_cell) const;
+
+		/**
+		 * @brief Split a scene into cells and write them.
+		 * @param p_scene The whole scene, in depth-first order
+		 * @param p_cellSize The size of a cell on X and Z
+		 * @param p_directory The directory receiving the cell files and the manifest, its previous content is removed
+		 * @return The scene that stays always loaded: the root and the children of the root without any model nor prefab in them
+		 * @note Each child of the root goes as a whole in the cell of its position (relative to the root).
+		 */
+		static SceneDescription Bake(const SceneDescription& p_scene, const float p_cellSize, const std::string& p_directory);
+
+		/**
+		 * @brief Read the manifest of a partition.
+		 * @param p_directory The directory of the partition
+		 * @note Throw a std::runtime_error if the manifest can't be read or is badly structured.
+		 */
+		[[nodiscard]] static WorldPartition Open(const std::string& p_directory);
+
+		/**
+		 * @brief Return the directory of the partition of a scene file.
+		 */
+		[[nodiscard]] static std::string DirectoryOf(const std::string& p_sceneFile);
+
+		/**
+		 * @brief Return the file of a cell in a partition directory.
+		 */
+		[[nodiscard]] static std::string CellFile(const std::string& p_directory, const CellCoordinates& p_cell);
+
+		static constexpr const char* MANIFEST = "partition.manifest";
+	};
+}
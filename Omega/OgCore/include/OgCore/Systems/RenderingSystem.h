@@ -1,10 +1,14 @@
 #pragma once
 #include <OgCore/Export.h>
 #include <OgCore/Systems/System.h>
+#include <OgRendering/Managers/ResourceReload.h>
+#include <OgRendering/Resource/Mesh.h>
+#include <OgRendering/Resource/Texture.h>
 #include <memory>
 
 namespace OgEngine
 {
+	class Camera;
 	class VulkanContext;
 
 	class CORE_API RenderingSystem : public System
@@ -22,5 +26,25 @@ namespace OgEngine
 		 * @param p_context The graphical context that can use specific methods between a raytraced and a rasterized pipeline.
 		 */
 		void Update(const float p_dt, const VulkanContext* p_context);
+
+		/**
+		 * @brief Give the models using a reloaded mesh its new version, their objects are added again to the rendering on the next update.
+		 * @param p_reloaded The mesh reloaded, a model using one of its submeshes takes the submesh with the same index
+		 * @param p_context The graphical context the objects of the models are removed from
+		 */
+		void ReplaceMesh(const ReloadedResource<Mesh>& p_reloaded, const VulkanContext* p_context);
+
+		/**
+		 * @brief Make the materials using a reloaded or streamed texture reference its new version, the previous one is released.
+		 * @param p_name The name of the texture
+		 */
+		void ReplaceTexture(const std::string& p_name);
+
+		/**
+		 * @brief Tell the resource manager how large the textures of the models are drawn, so their mip levels are streamed in or out.
+		 * @param p_camera The camera the scene is drawn from
+		 * @param p_viewportHeight Height of the image drawn, in pixels
+		 */
+		void ReportTextureUsage(const Camera& p_camera, const float p_viewportHeight) const;
 	};
 }
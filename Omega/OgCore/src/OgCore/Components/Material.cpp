@@ -1,4 +1,5 @@
 #include <OgCore/Components/Material.h>
+#include <OgRendering/Managers/ResourceManager.h>
 
 OgEngine::Material::Material()
 	: _color(glm::vec4(1)), _specular(glm::vec4(1)), _emissive(glm::vec4(0)), _ior(0.0f), _roughness(0.0f), _materialType(1), _texName("default.png"), _texPath("Resources/textures/default.png"), _normName("NONE"), _normPath("NONE")
@@ -6,12 +7,12 @@ OgEngine::Material::Material()
 }
 
 OgEngine::Material::Material(const Material& p_other)
-	: _color(p_other._color), _specular(p_other._emissive), _emissive(p_other._emissive), _ior(p_other._ior), _roughness(p_other._roughness), _materialType(p_other._materialType), _texName(p_other._texName), _texPath(p_other._texPath), _normName(p_other._normName), _normPath(p_other._normPath)
+	: _color(p_other._color), _specular(p_other._emissive), _emissive(p_other._emissive), _ior(p_other._ior), _roughness(p_other._roughness), _materialType(p_other._materialType), _texName(p_other._texName), _texPath(p_other._texPath), _normName(p_other._normName), _normPath(p_other._normPath), m_textureReference(p_other.m_textureReference), m_normalMapReference(p_other.m_normalMapReference)
 {
 }
 
 OgEngine::Material::Material(Material&& p_other) noexcept
-	: _color(std::move(p_other._color)), _specular(std::move(p_other._emissive)), _emissive(std::move(p_other._emissive)), _ior(p_other._ior), _roughness(p_other._roughness), _materialType(p_other._materialType), _texName(std::move(p_other._texName)), _texPath(std::move(p_other._texPath)), _normName(std::move(p_other._normName)), _normPath(std::move(p_other._normPath))
+	: _color(std::move(p_other._color)), _specular(std::move(p_other._emissive)), _emissive(std::move(p_other._emissive)), _ior(p_other._ior), _roughness(p_other._roughness), _materialType(p_other._materialType), _texName(std::move(p_other._texName)), _texPath(std::move(p_other._texPath)), _normName(std::move(p_other._normName)), _normPath(std::move(p_other._normPath)), m_textureReference(std::move(p_other.m_textureReference)), m_normalMapReference(std::move(p_other.m_normalMapReference))
 {
 }
 
@@ -125,12 +126,15 @@ void OgEngine::Material::SetTextureID(const std::string& p_texID, const std::str
 {
 	_texName = p_texID;
 	_texPath = p_texPath;
+	// Acquired again by name, a reloaded or streamed texture is a new version
+	m_textureReference = ResourceManager::Acquire<Texture>(_texName);
 }
 
 void OgEngine::Material::SetNormalMapID(const std::string& p_normID, const std::string& p_normPath)
 {
 	_normName = p_normID;
 	_normPath = p_normPath;
+	m_normalMapReference = _normName == "NONE" ? ResourceReference<Texture>() : ResourceManager::Acquire<Texture>(_normName);
 }
 
 void OgEngine::Material::SetIOR(const float p_ior)
@@ -242,6 +246,8 @@ OgEngine::Material& OgEngine::Material::operator=(const Material& p_other)
 	_texPath = p_other._texPath;
 	_normName = p_other._normName;
 	_normPath = p_other._normPath;
+	m_textureReference = p_other.m_textureReference;
+	m_normalMapReference = p_other.m_normalMapReference;
 
 	return *this;
 }
@@ -258,6 +264,8 @@ OgEngine::Material& OgEngine::Material::operator=(Material&& p_other) noexcept
 	_texPath = std::move(p_other._texPath);
 	_normName = std::move(p_other._normName);
 	_normPath = std::move(p_other._normPath);
+	m_textureReference = std::move(p_other.m_textureReference);
+	m_normalMapReference = std::move(p_other.m_normalMapReference);
 
 	return *this;
 }
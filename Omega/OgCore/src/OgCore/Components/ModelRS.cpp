@@ -13,6 +13,7 @@ OgEngine::ModelRS::ModelRS(std::string_view p_meshName)
 	{
 		m_meshFilepath = m_mesh->MeshFilepath();
 		m_parentMeshName = m_mesh->ParentMeshName();
+		m_meshReference = ResourceManager::Acquire<Mesh>(m_parentMeshName);
 	}
 	else
 	{
@@ -29,6 +30,7 @@ OgEngine::ModelRS::ModelRS(OgEngine::Mesh * p_mesh)
 		m_meshName = p_mesh->MeshName();
 		m_parentMeshName = m_mesh->ParentMeshName();
 		m_meshFilepath = p_mesh->MeshFilepath();
+		m_meshReference = ResourceManager::Acquire<Mesh>(m_parentMeshName);
 	}
 	else
 	{
@@ -41,6 +43,7 @@ OgEngine::ModelRS::ModelRS(OgEngine::Mesh * p_mesh)
 OgEngine::ModelRS::ModelRS(const ModelRS & p_other)
 {
 	m_mesh = p_other.m_mesh;
+	m_meshReference = p_other.m_meshReference;
 	m_material = p_other.m_material;
 	m_meshName = p_other.m_meshName;
 	m_parentMeshName = p_other.m_parentMeshName;
@@ -50,6 +53,7 @@ OgEngine::ModelRS::ModelRS(const ModelRS & p_other)
 OgEngine::ModelRS::ModelRS(ModelRS && p_other) noexcept
 {
 	m_mesh = p_other.m_mesh;
+	m_meshReference = std::move(p_other.m_meshReference);
 	m_material = std::move(p_other.m_material);
 	m_meshName = std::move(p_other.m_meshName);
 	m_parentMeshName = std::move(p_other.m_parentMeshName);
@@ -64,12 +68,14 @@ void OgEngine::ModelRS::SetMesh(Mesh * p_mesh)
 		m_meshName = p_mesh->MeshName();
 		m_parentMeshName = p_mesh->ParentMeshName();
 		m_meshFilepath = p_mesh->MeshFilepath();
+		m_meshReference = ResourceManager::Acquire<Mesh>(m_parentMeshName);
 	}
 	else
 	{
 		m_meshName = "";
 		m_parentMeshName = "";
 		m_meshFilepath = "";
+		m_meshReference = ResourceReference<Mesh>();
 	}
 }
 
@@ -81,11 +87,13 @@ void OgEngine::ModelRS::SetMesh(std::string_view p_meshName)
 	{
 		m_parentMeshName = m_mesh->ParentMeshName();
 		m_meshFilepath = m_mesh->MeshFilepath();
+		m_meshReference = ResourceManager::Acquire<Mesh>(m_parentMeshName);
 	}
 	else
 	{
 		m_parentMeshName = "";
 		m_meshFilepath = "";
+		m_meshReference = ResourceReference<Mesh>();
 	}
 }
 
@@ -137,6 +145,7 @@ OgEngine::ModelRS& OgEngine::ModelRS::operator=(const ModelRS & p_other)
 		return *this;
 
 	m_mesh = p_other.m_mesh;
+	m_meshReference = p_other.m_meshReference;
 	m_material = p_other.m_material;
 	m_meshName = p_other.m_meshName;
 	m_parentMeshName = p_other.m_parentMeshName;
@@ -148,6 +157,7 @@ OgEngine::ModelRS& OgEngine::ModelRS::operator=(const ModelRS & p_other)
 OgEngine::ModelRS& OgEngine::ModelRS::operator=(ModelRS && p_other) noexcept
 {
 	m_mesh = p_other.m_mesh;
+	m_meshReference = std::move(p_other.m_meshReference);
 	m_material = p_other.m_material;
 	m_meshName = std::move(p_other.m_meshName);
 	m_parentMeshName = std::move(p_other.m_parentMeshName);
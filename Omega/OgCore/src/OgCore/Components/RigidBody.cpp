@@ -185,6 +185,11 @@ inline float OgEngine::RigidBody::Mass() const
 	return m_mass;
 }
 
+OgEngine::RB_COLLIDER_TYPE OgEngine::RigidBody::ColliderType() const
+{
+	return m_rigidBodyType;
+}
+
 OgEngine::Transform* OgEngine::RigidBody::Transform() const
 {
 	return m_transform;
@@ -1,11 +1,13 @@
-#include <stack>
 #include <OgCore/Core.h>
 #include <OgRendering/Rendering/Renderer.h>
 #include <OgCore/Managers/SceneManager.h>
 #include <OgRendering/Managers/InputManager.h>
 #include <OgCore/SceneLoader/SceneLoader.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 
-OgEngine::Core::Core(const uint64_t p_width, const uint64_t p_height, const char* p_title)
+OgEngine::Core::Core(const uint64_t p_width, const uint64_t p_height, const char* p_title) : m_viewportHeight(static_cast<float>(p_height))
 {
 	OgEngine::Renderer::InitVkRenderer(static_cast<int>(p_width), static_cast<int>(p_height), p_title);
 	m_vulkanContext = Renderer::GetVkContext();
@@ -35,6 +37,19 @@ OgEngine::Core::~Core()
 
 void OgEngine::Core::Run(float p_dt)
 {
+	UpdateSceneLoading();
+	ApplyResourceReloads();
+	UpdateTextureStreaming();
+	TrimResources();
+
+	if (m_cellStreamer && SceneManager::CurrentScene() == Scene::EDITOR_SCENE)
+	{
+		const glm::vec3 cameraPosition = m_vulkanContext->IsRaytracing() ? m_vulkanContext->GetRTPipeline()->m_camera.position
+			: m_vulkanContext->GetRSPipeline()->GetCurrentCamera().position;
+		m_cellStreamer->Update(cameraPosition);
+		PrioritizeCells(cameraPosition);
+	}
+
 	if (m_vulkanContext->IsRaytracing())
 	{
 		if (InputManager::IsKeyPressed(KeyCode::R))
@@ -88,11 +103,12 @@ void OgEngine::Core::AddEntity(SceneNode* p_parent) const
 	}
 }
 
-void OgEngine::Core::DestroyEntityNode(SceneNode* p_entity) const
+void OgEngine::Core::DestroyEntityNode(SceneNode* p_entity)
 {
 	if (p_entity)
 	{
 		RemoveRenderedObjects(p_entity);
+		ForgetPrefabInstances(p_entity);
 		// Removing the node from the scene graph
 		p_entity->GetParent()->RemoveChild(p_entity);
 	}
@@ -100,6 +116,9 @@ void OgEngine::Core::DestroyEntityNode(SceneNode* p_entity) const
 
 void OgEngine::Core::PlayScene()
 {
+	// The play scene is a copy of the editor scene, it must be complete
+	FinishSceneLoading();
+
 	// Copy all the current scene (which is EDITOR_SCENE) into the second scene (PLAY_SCENE)
 	if (m_vulkanContext->IsRaytracing())
 	{
@@ -151,319 +170,757 @@ void OgEngine::Core::EditorScene()
 
 void OgEngine::Core::SaveScene(const std::string& p_sceneName)
 {
-	std::ofstream file;
-	file.open(p_sceneName, std::ios::out | std::ios::trunc);
-	if (file.is_open())
-	{
-		const uint8_t indexScene = static_cast<uint8_t>(Scene::EDITOR_SCENE);
-		int depth = 1;
-		file << "<SceneNode>\n";
-		file << SceneManager::GetComponent<Transform>(roots[indexScene]->GetEntity()).Serialize(depth);
-		SerializeChildren(file, roots[indexScene], depth);
+	// Models still waiting for their resources would be missing from the file
+	FinishSceneLoading();
 
-		file << "</SceneNode>";
+	// The file only keeps the persistent part of a streamed scene, its cells are in the partition of the file loaded
+	if (m_cellStreamer && std::filesystem::weakly_canonical(WorldPartition::DirectoryOf(p_sceneName)) != std::filesystem::weakly_canonical(m_cellStreamer->Directory()))
+	{
+		// Baked again for the new file, with the cells not streamed in read back from the current partition
+		BakeWorldPartition(p_sceneName, m_cellStreamer->Partition().cellSize);
+		return;
 	}
 
-	file.close();
+	m_sceneSaver.Save(p_sceneName, CaptureScene(roots[static_cast<uint8_t>(Scene::EDITOR_SCENE)]));
 }
 
-void OgEngine::Core::LoadScene(const std::string& p_file)
+void OgEngine::Core::LoadScene(const std::string& p_file, const bool p_async)
 {
-	if (!OgEngine::SceneLoader::SceneFileIntegrityCheck(p_file))
+	// The whole file is parsed and validated before touching the current scene
+	SceneDescription scene;
+	try
+	{
+		scene = SceneLoader::Parse(p_file);
+	}
+	catch (const std::exception& p_exception)
 	{
-		std::cerr << "File: " << p_file << " is not a valid Omega scene file or may be corrupted.\n";
+		std::cerr << "File: " << p_file << " is not a valid Omega scene file or may be corrupted (" << p_exception.what() << ").\n";
 		return;
 	}
-	std::ifstream file;
-	file.open(p_file, std::ios::in);
 
-	int nbLines = 0;
-	std::string line;
-	if (file.is_open())
+	SceneManager::ChangeScene(Scene::EDITOR_SCENE);
+	const auto sceneIndexEditor = static_cast<uint8_t>(OgEngine::Scene::EDITOR_SCENE);
+	RemoveRenderedObjects(roots[sceneIndexEditor]);
+	inspectorNode = nullptr;
+	delete roots[sceneIndexEditor];
+	roots[sceneIndexEditor] = nullptr;
+
+	const auto sceneIndexPlay = static_cast<uint8_t>(OgEngine::Scene::EDITOR_SCENE);
+	RemoveRenderedObjects(roots[sceneIndexPlay]);
+	delete roots[sceneIndexPlay];
+	roots[sceneIndexPlay] = nullptr;
+
+	// Models still waiting from a previous load belong to entities that don't exist anymore
+	m_pendingModels.clear();
+	m_texturesToRegister.clear();
+	m_prefabInstances.clear();
+	m_cellStreamer.reset();
+	m_cellNodes.clear();
+	m_cellRoots.clear();
+	m_cellResources.clear();
+
+	// Every resource is requested before building the hierarchy, so they are all loaded at the same time
+	RequestSceneResources(scene);
+
+	std::vector<SceneNode*> createdNodes;
+
+	try
+	{
+		BuildSceneNodes(scene, nullptr, createdNodes);
+		roots[sceneIndexEditor] = createdNodes.empty() ? nullptr : createdNodes.front();
+
+		// The next saves of this file only write the entities modified since
+		std::vector<uint64_t> entities(createdNodes.size());
+		std::transform(createdNodes.begin(), createdNodes.end(), entities.begin(), [](SceneNode* p_node) { return p_node->GetEntity(); });
+		m_sceneSaver.Track(p_file, scene, entities);
+	}
+	catch (const std::exception& p_exception)
 	{
-		SceneManager::ChangeScene(Scene::EDITOR_SCENE);
-		const auto sceneIndexEditor = static_cast<uint8_t>(OgEngine::Scene::EDITOR_SCENE);
+		// In case of thrown exception at creation time, we will remove everything we added previously
+		// and make the root node again
+		std::cerr << "File corrupted: " << p_exception.what() << '\n';
+		m_pendingModels.clear();
+		// The root is not set yet if the exception was thrown while building the nodes
+		if (!createdNodes.empty())
+			roots[sceneIndexEditor] = createdNodes.front();
 		RemoveRenderedObjects(roots[sceneIndexEditor]);
-		inspectorNode = nullptr;
 		delete roots[sceneIndexEditor];
 		roots[sceneIndexEditor] = nullptr;
-		
-		const auto sceneIndexPlay = static_cast<uint8_t>(OgEngine::Scene::EDITOR_SCENE);
-		RemoveRenderedObjects(roots[sceneIndexPlay]);
-		delete roots[sceneIndexPlay];
-		roots[sceneIndexPlay] = nullptr;
+	}
+
+	// Happenned in case of empty scene, should not happen but if a user remove everything, it will crash if no roots exists
+	if (roots[sceneIndexEditor] == nullptr)
+	{
+		roots[sceneIndexEditor] = new SceneNode(SceneManager::CreateEntity());
+	}
+	else
+	{
+		StartStreaming(p_file);
+	}
 
-		std::stack<SceneNode*> latestNodes;
+	m_sceneLoadingTotal = m_pendingModels.size();
+	if (p_async)
+	{
+		UpdateSceneLoading();
+	}
+	else
+	{
+		FinishSceneLoading();
+	}
+}
+
+void OgEngine::Core::BuildSceneNodes(const SceneDescription& p_scene, SceneNode* p_parent, std::vector<SceneNode*>& p_createdNodes)
+{
+	// Nodes are in depth-first order, a parent is always created before its children
+	p_createdNodes.assign(p_scene.nodes.size(), nullptr);
 
-		try
+	for (size_t i = 0u; i < p_scene.nodes.size(); ++i)
+	{
+		const SceneNodeDescription& node = p_scene.nodes[i];
+		if (node.parent == SceneNodeDescription::NO_PARENT && !p_parent)
 		{
-			while (!file.eof())
-			{
-				std::getline(file, line);
-				// Add a scene to the scenegraph
-				if (line.find("<SceneNode>") != std::string::npos)
-				{
-					// Starting point, always there
-					if (roots[sceneIndexEditor] == nullptr)
-					{
-						roots[sceneIndexEditor] = new SceneNode(SceneManager::CreateEntity());
-						latestNodes.push(roots[sceneIndexEditor]);
-					}
-					else
-					{
-						AddEntity(latestNodes.top());
-						latestNodes.push(latestNodes.top()->LastChild());
-						auto& trans = SceneManager::GetComponent<Transform>(latestNodes.top()->GetEntity());
-					}
-				}
-				else if (line.find("<Transform>") != std::string::npos)
-				{
-					std::getline(file, line);
-					const std::string name = SceneLoader::ExtractNameFromAttribute(line);
-					std::getline(file, line);
-					const glm::vec3 position = SceneLoader::ExtractVector3FromAttribute(line);
-					std::getline(file, line);
-					const glm::vec4 rotation = SceneLoader::ExtractVector4FromAttribute(line);
-					std::getline(file, line);
-					const glm::vec3 scale = SceneLoader::ExtractVector3FromAttribute(line);
-
-					if (SceneManager::HasComponent<Transform>(latestNodes.top()->GetEntity()))
-					{
-						auto* transform = &SceneManager::GetComponent<Transform>(latestNodes.top()->GetEntity());
-						transform->SetName(name);
-						transform->SetPosition(position);
-						transform->SetRotation(glm::quat(rotation.x, rotation.y, rotation.z, rotation.w));
-						transform->SetScale(scale);
-					}
-				}
-				else if (line.find("<Model>") != std::string::npos)
-				{
-					std::getline(file, line);
-					const std::string parentMeshName = SceneLoader::ExtractNameFromAttribute(line);
-					std::getline(file, line);
-					const std::string meshName = SceneLoader::ExtractNameFromAttribute(line);
-					std::getline(file, line);
-					const std::string meshFilepath = SceneLoader::ExtractNameFromAttribute(line);
-					std::getline(file, line);
-					const bool isSubMesh = SceneLoader::ExtractIntegerFromAttribute(line);
-					std::getline(file, line);
-					const uint32_t subMeshIndex = SceneLoader::ExtractIntegerFromAttribute(line);
-
-					if (!SceneManager::HasComponent<ModelRS>(latestNodes.top()->GetEntity()))
-					{
-						// Try to get the mesh:
-						// 1 - Check if it exists in resource manager
-						Mesh* meshToLink = ResourceManager::Get<Mesh>(parentMeshName);
-						if (meshToLink)
-						{
-							// Mesh exists we can add directly
-							if (!isSubMesh)
-							{
-								SceneManager::AddComponent(latestNodes.top()->GetEntity(), ModelRS(meshToLink));
-							}
-							else
-							{
-								meshToLink = meshToLink->SubMeshes()[subMeshIndex].get();
-								SceneManager::AddComponent(latestNodes.top()->GetEntity(), ModelRS(meshToLink));
-							}
-						}
-						else
-						{
-							// Mesh not in resource manager yet, try to add it
-							ResourceManager::Add<Mesh>(meshFilepath);
-							ResourceManager::WaitForResource<Mesh>(parentMeshName);
-							meshToLink = ResourceManager::Get<Mesh>(parentMeshName);
-							if (meshToLink)
-							{
-								if (!isSubMesh)
-								{
-									SceneManager::AddComponent(latestNodes.top()->GetEntity(), ModelRS(meshToLink));
-								}
-								else
-								{
-									meshToLink = meshToLink->SubMeshes()[subMeshIndex].get();
-									SceneManager::AddComponent(latestNodes.top()->GetEntity(), ModelRS(meshToLink));
-								}
-							}
-							else
-							{
-								// meshFilepath points to a faulty path or corrupted 3D mesh. We replace it by a cube as default
-								SceneManager::AddComponent(latestNodes.top()->GetEntity(), ModelRS("cube.obj"));
-							}
-						}
-					}
-				}
-				else if (line.find("<Material>") != std::string::npos)
-				{
-					std::getline(file, line);
-					const glm::vec3 color = SceneLoader::ExtractVector3FromAttribute(line);
-
-					std::getline(file, line);
-					const glm::vec4 specular = SceneLoader::ExtractVector4FromAttribute(line);
-
-					std::getline(file, line);
-					const glm::vec4 emissive = SceneLoader::ExtractVector4FromAttribute(line);
-
-					std::getline(file, line);
-					const float ior = SceneLoader::ExtractFloatFromAttribute(line);
-
-					std::getline(file, line);
-					const float roughness = SceneLoader::ExtractFloatFromAttribute(line);
-
-					std::getline(file, line);
-					const int type = SceneLoader::ExtractIntegerFromAttribute(line);
-
-					std::getline(file, line);
-					std::string textureName = SceneLoader::ExtractNameFromAttribute(line);
-
-					std::getline(file, line);
-					std::string texturePath = SceneLoader::ExtractNameFromAttribute(line);
-
-					std::getline(file, line);
-					std::string normalName = SceneLoader::ExtractNameFromAttribute(line);
-
-					std::getline(file, line);
-					std::string normalPath = SceneLoader::ExtractNameFromAttribute(line);
-
-					if (SceneManager::HasComponent<ModelRS>(latestNodes.top()->GetEntity()))
-					{
-						auto& material = SceneManager::GetComponent<ModelRS>(latestNodes.top()->GetEntity());
-
-						// Check if both texture and normal exist
-						Texture* tex = ResourceManager::Get<Texture>(textureName);
-						if (!tex)
-						{
-							ResourceManager::Add<Texture>(texturePath);
-							ResourceManager::WaitForResource<Texture>(textureName);
-							tex = ResourceManager::Get<Texture>(textureName);
-							if (!tex)
-							{
-								textureName = "error.png";
-								texturePath = "Resources/textures/error.png";
-								AddTexture(textureName, TEXTURE);
-							}
-							else
-							{
-								AddTexture(textureName, TEXTURE);
-							}
-						}
-						if (normalName != "NONE")
-						{
-							Texture* norm = ResourceManager::Get<Texture>(normalName);
-							if (!norm)
-							{
-								ResourceManager::Add<Texture>(normalPath);
-								ResourceManager::WaitForResource<Texture>(normalName);
-								norm = ResourceManager::Get<Texture>(normalName);
-								if (!norm)
-								{
-									normalName = "error.png";
-									normalPath = "Resources/textures/error.png";
-									AddTexture(normalName, TEXTURE);
-								}
-								else
-								{
-									AddTexture(normalName, TEXTURE);
-								}
-							}
-						}
-
-						Material mat;
-						mat.SetColor(glm::vec4(color, 1));
-						mat.SetSpecular(specular);
-						mat.SetEmissive(emissive);
-						mat.SetIOR(ior);
-						mat.SetRoughness(roughness);
-						mat.SetType(type);
-						mat.SetTextureID(textureName, texturePath);
-						mat.SetNormalMapID(normalName, normalPath);
-
-						material.SetMaterial(mat);
-					}
-				}
-				else if (line.find("<RigidBody>") != std::string::npos)
-				{
-					std::getline(file, line);
-					const float shapeSizeX = SceneLoader::ExtractFloatFromAttribute(line);
-
-					std::getline(file, line);
-					const float shapeSizeY = SceneLoader::ExtractFloatFromAttribute(line);
-
-					std::getline(file, line);
-					const float shapeSizeZ = SceneLoader::ExtractFloatFromAttribute(line);
-					
-					std::getline(file, line);
-					const float mass = SceneLoader::ExtractFloatFromAttribute(line);
-
-					std::getline(file, line);
-					const int type = SceneLoader::ExtractIntegerFromAttribute(line);
-
-					std::getline(file, line);
-					const bool useGravity = SceneLoader::ExtractBooleanFromAttribute(line);
-
-					std::getline(file, line);
-					const bool isStatic = SceneLoader::ExtractBooleanFromAttribute(line);
-
-					if (!SceneManager::HasComponent<RigidBody>(latestNodes.top()->GetEntity()))
-					{
-						SceneManager::AddComponent(latestNodes.top()->GetEntity(), RigidBody(static_cast<RB_COLLIDER_TYPE>(type), isStatic));
-						auto& rigidBody = SceneManager::GetComponent<RigidBody>(latestNodes.top()->GetEntity());
-						rigidBody.Initialize(m_physicsEngine, shapeSizeX, shapeSizeY, shapeSizeZ);
-						m_physicsEngine.AddRigidBodyToScene(&rigidBody.GetRigidBody(), RigidBody::ConvertGPMtoPhysics(rigidBody.Transform()), isStatic);
-						// give the new values
-						rigidBody.SetMass(mass);
-						rigidBody.SetShapeSize(shapeSizeX, shapeSizeY, shapeSizeZ);
-						rigidBody.EnableGravity(useGravity);
-					}
-				}
-				else if (line.find("<LightSource>") != std::string::npos)
-				{
-					std::getline(file, line);
-					const glm::vec4 color = SceneLoader::ExtractVector4FromAttribute(line);
+			p_createdNodes[i] = new SceneNode(SceneManager::CreateEntity());
+		}
+		else
+		{
+			SceneNode* parent = node.parent == SceneNodeDescription::NO_PARENT ? p_parent : p_createdNodes[node.parent];
+			AddEntity(parent);
+			p_createdNodes[i] = parent->LastChild();
+		}
+
+		LoadSceneNode(p_createdNodes[i]->GetEntity(), node);
+
+		if (node.prefab)
+		{
+			InstantiatePrefabContent(*node.prefab, p_createdNodes[i]);
+		}
+	}
+}
+
+void OgEngine::Core::LoadSceneNode(const Entity p_entity, const SceneNodeDescription& p_node)
+{
+	if (SceneManager::HasComponent<Transform>(p_entity))
+	{
+		ApplyTransform(SceneManager::GetComponent<Transform>(p_entity), p_node.transform);
+	}
+
+	// The renderers upload a mesh the first time they see its ModelRS, so the model waits for its resources instead of using a placeholder mesh
+	if (p_node.model && !SceneManager::HasComponent<ModelRS>(p_entity))
+	{
+		m_pendingModels.push_back({ p_entity, *p_node.model, p_node.material, HoldModelResources(*p_node.model, p_node.material) });
+	}
+
+	AddSceneComponents(p_entity, p_node);
+}
+
+void OgEngine::Core::ApplyTransform(Transform& p_transform, const TransformDescription& p_description)
+{
+	p_transform.SetName(p_description.name);
+	p_transform.SetPosition(p_description.position);
+	p_transform.SetRotation(glm::quat(p_description.rotation.x, p_description.rotation.y, p_description.rotation.z, p_description.rotation.w));
+	p_transform.SetScale(p_description.scale);
+}
+
+void OgEngine::Core::AddSceneComponents(const Entity p_entity, const SceneNodeDescription& p_node)
+{
+	if (p_node.rigidBody && !SceneManager::HasComponent<RigidBody>(p_entity))
+	{
+		const RigidBodyDescription& description = *p_node.rigidBody;
+		const glm::vec3& shapeSize = description.shapeSize;
+
+		SceneManager::AddComponent(p_entity, RigidBody(static_cast<RB_COLLIDER_TYPE>(description.type), description.isStatic));
+		auto& rigidBody = SceneManager::GetComponent<RigidBody>(p_entity);
+		rigidBody.Initialize(m_physicsEngine, shapeSize.x, shapeSize.y, shapeSize.z);
+		m_physicsEngine.AddRigidBodyToScene(&rigidBody.GetRigidBody(), RigidBody::ConvertGPMtoPhysics(rigidBody.Transform()), description.isStatic);
+		// give the new values
+		rigidBody.SetMass(description.mass);
+		rigidBody.SetShapeSize(shapeSize.x, shapeSize.y, shapeSize.z);
+		rigidBody.EnableGravity(description.useGravity);
+	}
+
+	if (p_node.lightSource && !SceneManager::HasComponent<LightSource>(p_entity))
+	{
+		SceneManager::AddComponent(p_entity, LightSource());
+
+		auto& lightSource = SceneManager::GetComponent<LightSource>(p_entity);
+		lightSource.color = p_node.lightSource->color;
+		lightSource.direction = p_node.lightSource->direction;
+		lightSource.lightType = static_cast<LIGHT_TYPE>(p_node.lightSource->lightType);
+	}
+}
+
+void OgEngine::Core::RequestSceneResources(const SceneDescription& p_scene)
+{
+	RequestResources(p_scene, nullptr);
+}
+
+void OgEngine::Core::RequestResources(const SceneDescription& p_scene, CellResources* p_cell)
+{
+	std::unordered_set<std::string> requestedMeshes;
+
+	const auto requestTexture = [this, p_cell](const std::string& p_name, const std::string& p_path)
+	{
+		if (p_name == "NONE")
+			return;
+
+		const bool isRequested = m_texturesToRegister.count(p_name) != 0u
+			|| ResourceManager::Get<Texture>(p_name) || ResourceManager::IsLoading<Texture>(p_name);
+
+		// A cell references its textures even when another one already asked for them, they stay loaded while any of the cells is active
+		if (p_cell)
+			p_cell->textures.emplace_back(ResourceManager::Request<Texture>(p_path, p_cell->priority));
+		else if (!isRequested)
+			// The smallest levels first so the material shows at once, the larger ones follow as the models get closer
+			ResourceManager::StreamTexture(p_path, LOAD_PRIORITY::VISIBLE);
+
+		// Only the textures loaded by this scene have to be sent to the renderer once ready
+		if (!isRequested)
+			m_texturesToRegister.insert(p_name);
+	};
+
+	for (const SceneNodeDescription& node : p_scene.nodes)
+	{
+		if (node.prefab)
+		{
+			// Compiled once, its resources are requested with the ones of the scene
+			[[maybe_unused]] const Prefab* prefab = LoadPrefab(*node.prefab);
+		}
+
+		if (!node.model)
+			continue;
+
+		const ModelDescription& model = *node.model;
+		if (requestedMeshes.insert(model.parentMeshName).second)
+		{
+			if (p_cell)
+				p_cell->meshes.emplace_back(ResourceManager::Request<Mesh>(model.meshFilepath, p_cell->priority));
+			else if (!ResourceManager::Get<Mesh>(model.parentMeshName) && !ResourceManager::IsLoading<Mesh>(model.parentMeshName))
+				ResourceManager::Add<Mesh>(model.meshFilepath, LOAD_PRIORITY::VISIBLE);
+		}
+
+		if (node.material)
+		{
+			requestTexture(node.material->textureName, node.material->texturePath);
+			requestTexture(node.material->normalName, node.material->normalPath);
+		}
+	}
+}
+
+void OgEngine::Core::PrioritizeCells(const glm::vec3& p_position)
+{
+	const WorldPartition& partition = m_cellStreamer->Partition();
+	for (auto& [coordinates, resources] : m_cellResources)
+	{
+		const float distance = partition.DistanceTo(p_position, coordinates);
+		const LOAD_PRIORITY priority = distance <= 0.0f ? LOAD_PRIORITY::CRITICAL
+			: distance <= partition.cellSize ? LOAD_PRIORITY::VISIBLE : LOAD_PRIORITY::PREFETCH;
+
+		// A lower value is more urgent, the loads are never made to wait longer
+		if (priority >= resources.priority)
+			continue;
+
+		resources.priority = priority;
+		for (const ResourceReference<Mesh>& mesh : resources.meshes)
+			mesh.Handle().Prioritize(priority);
+		for (const ResourceReference<Texture>& texture : resources.textures)
+			texture.Handle().Prioritize(priority);
+	}
+}
+
+void OgEngine::Core::UpdateSceneLoading()
+{
+	BuildReadyPrefabs();
+
+	// Components are only patched into the editor scene, the remaining models are attached once back from play mode
+	if (m_pendingModels.empty() || SceneManager::CurrentScene() != Scene::EDITOR_SCENE)
+		return;
+
+	const size_t pendingCount = m_pendingModels.size();
+	size_t kept = 0u;
+	for (size_t i = 0u; i < pendingCount; ++i)
+	{
+		if (IsModelReady(m_pendingModels[i].model, m_pendingModels[i].material))
+		{
+			AttachModel(m_pendingModels[i]);
+		}
+		else
+		{
+			if (kept != i)
+				m_pendingModels[kept] = std::move(m_pendingModels[i]);
+			++kept;
+		}
+	}
+	m_pendingModels.resize(kept);
+
+	if (kept != pendingCount && onSceneLoadingProgress)
+	{
+		onSceneLoadingProgress(m_sceneLoadingTotal - kept, m_sceneLoadingTotal);
+	}
+}
+
+void OgEngine::Core::FinishSceneLoading()
+{
+	if (m_pendingModels.empty() && m_pendingPrefabs.empty())
+		return;
+
+	ResourceManager::WaitForAll();
+	UpdateSceneLoading();
+}
+
+bool OgEngine::Core::IsModelReady(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material)
+{
+	if (ResourceManager::IsLoading<Mesh>(p_model.parentMeshName))
+		return false;
+
+	return !p_material || (!ResourceManager::IsLoading<Texture>(p_material->textureName)
+		&& (p_material->normalName == "NONE" || !ResourceManager::IsLoading<Texture>(p_material->normalName)));
+}
+
+void OgEngine::Core::BuildReadyPrefabs()
+{
+	const auto isBuilt = [this](const PendingPrefab& p_pending)
+	{
+		const auto found = m_prefabs.find(p_pending.file);
+		// Saved again since, the next instances compile the new content
+		if (found == m_prefabs.end())
+			return true;
+
+		Prefab& prefab = *found->second;
+		const std::vector<SceneNodeDescription>& nodes = prefab.description.nodes;
+		for (const SceneNodeDescription& node : nodes)
+		{
+			if (node.model && !IsModelReady(*node.model, node.material))
+				return false;
+		}
+
+		prefab.models.reserve(prefab.modelNodes.size());
+		for (const size_t node : prefab.modelNodes)
+		{
+			prefab.models.push_back(BuildModel(*nodes[node].model, nodes[node].material));
+		}
+		return true;
+	};
+
+	m_pendingPrefabs.erase(std::remove_if(m_pendingPrefabs.begin(), m_pendingPrefabs.end(), isBuilt), m_pendingPrefabs.end());
+}
+
+bool OgEngine::Core::IsSceneLoading() const
+{
+	return !m_pendingModels.empty();
+}
+
+void OgEngine::Core::AttachModel(const PendingModel& p_pending)
+{
+	const Entity entity = p_pending.entity;
+	// The entity may have been destroyed or given a model while its resources were loading
+	if (!SceneManager::HasComponent<Transform>(entity) || SceneManager::HasComponent<ModelRS>(entity))
+		return;
+
+	SceneManager::AddComponent(entity, BuildModel(p_pending.model, p_pending.material));
+}
+
+OgEngine::Core::ModelResources OgEngine::Core::HoldModelResources(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material)
+{
+	ModelResources resources;
+	resources.mesh = ResourceManager::Acquire<Mesh>(p_model.parentMeshName);
+	if (p_material)
+	{
+		resources.textures.emplace_back(ResourceManager::Acquire<Texture>(p_material->textureName));
+		if (p_material->normalName != "NONE")
+			resources.textures.emplace_back(ResourceManager::Acquire<Texture>(p_material->normalName));
+	}
+
+	return resources;
+}
+
+OgEngine::ModelRS OgEngine::Core::BuildModel(const ModelDescription& p_model, const std::optional<MaterialDescription>& p_material)
+{
+	Mesh* meshToLink = ResourceManager::Get<Mesh>(p_model.parentMeshName);
+	if (meshToLink && p_model.isSubMesh)
+	{
+		// The file may have been changed (or cooked again) since the scene was saved
+		const auto& subMeshes = meshToLink->SubMeshes();
+		meshToLink = p_model.subMeshIndex < subMeshes.size() ? subMeshes[p_model.subMeshIndex].get() : nullptr;
+		if (!meshToLink)
+			std::cerr << "Warning: " << p_model.parentMeshName << " has no submesh " << p_model.subMeshIndex << ", a cube is used instead.\n";
+	}
+
+	// meshFilepath points to a faulty path or corrupted 3D mesh. We replace it by a cube as default
+	ModelRS model = meshToLink ? ModelRS(meshToLink) : ModelRS("cube.obj");
+
+	if (!p_material)
+		return model;
+
+	const MaterialDescription& material = *p_material;
+
+	// Resolve a texture of the material, falling back on error.png if it couldn't be loaded
+	const auto resolveTexture = [this](std::string& p_name, std::string& p_path)
+	{
+		if (p_name == "NONE")
+			return;
+
+		const bool loadedByScene = m_texturesToRegister.erase(p_name) != 0u;
+		if (!ResourceManager::Get<Texture>(p_name))
+		{
+			p_name = "error.png";
+			p_path = "Resources/textures/error.png";
+		}
+
+		if (loadedByScene)
+		{
+			AddTexture(p_name, TEXTURE);
+		}
+	};
+
+	std::string textureName = material.textureName;
+	std::string texturePath = material.texturePath;
+	resolveTexture(textureName, texturePath);
+
+	std::string normalName = material.normalName;
+	std::string normalPath = material.normalPath;
+	resolveTexture(normalName, normalPath);
+
+	Material mat;
+	mat.SetColor(glm::vec4(glm::vec3(material.color), 1));
+	mat.SetSpecular(material.specular);
+	mat.SetEmissive(material.emissive);
+	mat.SetIOR(material.ior);
+	mat.SetRoughness(material.roughness);
+	mat.SetType(material.type);
+	mat.SetTextureID(textureName, texturePath);
+	mat.SetNormalMapID(normalName, normalPath);
+
+	model.SetMaterial(mat);
+	return model;
+}
+
+const OgEngine::Prefab* OgEngine::Core::LoadPrefab(const std::string& p_file)
+{
+	if (const auto found = m_prefabs.find(p_file); found != m_prefabs.end())
+		return found->second.get();
+
+	// A prefab containing itself, directly or not, can't be instantiated
+	if (!m_compilingPrefabs.insert(p_file).second)
+	{
+		std::cerr << "Prefab " << p_file << " contains itself.\n";
+		return nullptr;
+	}
+
+	auto prefab = std::make_unique<Prefab>();
+	prefab->path = p_file;
+	try
+	{
+		prefab->description = SceneLoader::Parse(p_file);
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "File: " << p_file << " is not a valid Omega prefab file (" << p_exception.what() << ").\n";
+		m_compilingPrefabs.erase(p_file);
+		return nullptr;
+	}
+
+	// Nested prefabs are compiled as well, their resources loading along with this one
+	RequestSceneResources(prefab->description);
+	m_compilingPrefabs.erase(p_file);
+
+	const std::vector<SceneNodeDescription>& nodes = prefab->description.nodes;
+	prefab->transforms.reserve(nodes.empty() ? 0u : nodes.size() - 1u);
+	for (size_t i = 1u; i < nodes.size(); ++i)
+	{
+		ApplyTransform(prefab->transforms.emplace_back(), nodes[i].transform);
+	}
+
+	// The models are built once the resources are loaded, without blocking the frame
+	PendingPrefab& pending = m_pendingPrefabs.emplace_back();
+	pending.file = p_file;
+	for (size_t i = 0u; i < nodes.size(); ++i)
+	{
+		if (nodes[i].model)
+		{
+			prefab->modelNodes.push_back(i);
+			pending.resources.emplace_back(HoldModelResources(*nodes[i].model, nodes[i].material));
+		}
+	}
+
+	return m_prefabs.emplace(p_file, std::move(prefab)).first->second.get();
+}
+
+OgEngine::SceneNode* OgEngine::Core::InstantiatePrefab(const std::string& p_prefab, SceneNode* p_parent)
+{
+	const Prefab* prefab = LoadPrefab(p_prefab);
+	if (!prefab || !p_parent)
+		return nullptr;
+
+	AddEntity(p_parent);
+	SceneNode* instance = p_parent->LastChild();
 
-					std::getline(file, line);
-					const glm::vec4 direction = SceneLoader::ExtractVector4FromAttribute(line);
+	if (m_pendingModels.empty())
+		m_sceneLoadingTotal = 0u;
+	const size_t pendingCount = m_pendingModels.size();
 
-					std::getline(file, line);
-					const LIGHT_TYPE lightType = static_cast<LIGHT_TYPE>(SceneLoader::ExtractIntegerFromAttribute(line));
+	// The instance starts where the prefab root was saved, its transform is the only thing it stores
+	SceneNodeDescription root;
+	root.transform = prefab->description.nodes.front().transform;
+	LoadSceneNode(instance->GetEntity(), root);
+	InstantiatePrefabContent(p_prefab, instance);
 
-					if (!SceneManager::HasComponent<LightSource>(latestNodes.top()->GetEntity()))
-					{
-						SceneManager::AddComponent(latestNodes.top()->GetEntity(), LightSource());
+	m_sceneLoadingTotal += m_pendingModels.size() - pendingCount;
 
-						auto& lightSource = SceneManager::GetComponent<LightSource>(
-							latestNodes.top()->GetEntity());
+	return instance;
+}
+
+void OgEngine::Core::InstantiatePrefabContent(const std::string& p_prefab, SceneNode* p_instance)
+{
+	const Prefab* prefab = LoadPrefab(p_prefab);
+	if (!prefab)
+		return;
+
+	const std::vector<SceneNodeDescription>& nodes = prefab->description.nodes;
+
+	// The entities of the children are created with the compiled transforms in one block, the root keeps the transform of the instance
+	std::vector<Entity> entities;
+	entities.reserve(nodes.size());
+	entities.push_back(p_instance->GetEntity());
+	SceneManager::CreateEntities(prefab->transforms, entities);
+
+	std::vector<SceneNode*> createdNodes;
+	createdNodes.reserve(nodes.size());
+	createdNodes.push_back(p_instance);
+	for (size_t i = 1u; i < nodes.size(); ++i)
+	{
+		createdNodes.push_back(new SceneNode(entities[i]));
+		createdNodes[nodes[i].parent]->AddChild(createdNodes.back());
+	}
+
+	// Copy of the shared prototypes, no parsing nor resource lookup per instance
+	if (prefab->models.size() == prefab->modelNodes.size())
+	{
+		// The root of a nested instance may already have a model, the other nodes are new
+		const size_t first = !prefab->modelNodes.empty() && prefab->modelNodes.front() == 0u && SceneManager::HasComponent<ModelRS>(entities[0]) ? 1u : 0u;
+
+		std::vector<Entity> modelEntities;
+		modelEntities.reserve(prefab->modelNodes.size());
+		for (size_t i = first; i < prefab->modelNodes.size(); ++i)
+		{
+			modelEntities.push_back(entities[prefab->modelNodes[i]]);
+		}
+		SceneManager::AddComponents(modelEntities.data(), prefab->models.data() + first, modelEntities.size());
+	}
+	else
+	{
+		// Prototypes not built yet, the models are attached like the ones of a scene once their resources are loaded
+		m_pendingModels.reserve(m_pendingModels.size() + prefab->modelNodes.size());
+		for (const size_t node : prefab->modelNodes)
+		{
+			m_pendingModels.push_back({ entities[node], *nodes[node].model, nodes[node].material, HoldModelResources(*nodes[node].model, nodes[node].material) });
+		}
+	}
+
+	// The rigid bodies and lights are set up per instance, and the nested prefabs apply the transform of their node over their own root
+	for (size_t i = 0u; i < nodes.size(); ++i)
+	{
+		AddSceneComponents(entities[i], nodes[i]);
+
+		if (nodes[i].prefab)
+		{
+			InstantiatePrefabContent(*nodes[i].prefab, createdNodes[i]);
+		}
+	}
+
+	// Set last, a prefab whose root is itself an instance registers the root as an instance of the nested prefab
+	m_prefabInstances[p_instance->GetEntity()] = p_prefab;
+}
 
-						lightSource.color = color;
-						lightSource.direction = direction;
-						lightSource.lightType = lightType;
-					}
+bool OgEngine::Core::SavePrefab(SceneNode* p_node, const std::string& p_file)
+{
+	if (!p_node)
+		return false;
+
+	std::ofstream file(p_file, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Couldn't write the prefab " << p_file << ".\n";
+		return false;
+	}
+
+	file << SceneSaver::Serialize(CaptureScene(p_node));
+	file.close();
+
+	// The next instances use the new content, the existing ones keep what they were built from
+	m_prefabs.erase(p_file);
+	return true;
+}
+
+void OgEngine::Core::ForgetPrefabInstances(SceneNode* p_node)
+{
+	m_prefabInstances.erase(p_node->GetEntity());
+	for (auto* child : p_node->GetChildren())
+	{
+		ForgetPrefabInstances(child);
+	}
+}
+
+void OgEngine::Core::BakeWorldPartition(const std::string& p_file, const float p_cellSize)
+{
+	FinishSceneLoading();
+
+	SceneDescription scene = CaptureScene(roots[static_cast<uint8_t>(Scene::EDITOR_SCENE)]);
+
+	// The cells of the current partition go back in the scene, read from the scene when streamed in and from their file otherwise
+	if (m_cellStreamer)
+	{
+		for (const PartitionCell& cell : m_cellStreamer->Partition().cells)
+		{
+			SceneDescription content;
+			if (const auto node = m_cellNodes.find(cell.coordinates); node != m_cellNodes.end())
+			{
+				content = CaptureScene(node->second);
+			}
+			else
+			{
+				try
+				{
+					content = SceneLoader::Parse(WorldPartition::CellFile(m_cellStreamer->Directory(), cell.coordinates));
 				}
-				else if (line.find("</SceneNode>") != std::string::npos)
+				catch (const std::exception& p_exception)
 				{
-					latestNodes.pop();
+					std::cerr << "Cell " << cell.coordinates.x << ";" << cell.coordinates.z << " is lost, it couldn't be read (" << p_exception.what() << ").\n";
+					continue;
 				}
-				nbLines++;
 			}
-		}
-		catch (const std::exception& p_exception)
-		{
-			// In case of thrown exception at reading time, we will remove everything we added previously
-			// and make the root node again
-			std::cerr << "File corrupted: " << p_exception.what() << '\n';
-			RemoveRenderedObjects(roots[sceneIndexEditor]);
-			delete roots[sceneIndexEditor];
-			roots[sceneIndexEditor] = nullptr;
+
+			// Whole subtrees are appended so the depth-first order is kept, the children of the cell root go under the scene root
+			const uint64_t offset = scene.nodes.size() - 1u;
+			for (size_t i = 1u; i < content.nodes.size(); ++i)
+			{
+				SceneNodeDescription& node = scene.nodes.emplace_back(std::move(content.nodes[i]));
+				node.parent = node.parent == 0u ? 0u : node.parent + offset;
+			}
 		}
 	}
+
+	// Its reads must end before the partition directory is rewritten
+	m_cellStreamer.reset();
+
+	SceneDescription persistent;
+	try
+	{
+		persistent = WorldPartition::Bake(scene, p_cellSize, WorldPartition::DirectoryOf(p_file));
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "Couldn't bake the world partition of " << p_file << " (" << p_exception.what() << ").\n";
+		return;
+	}
+
+	// A queued save of the scene must not overwrite the file written here
+	m_sceneSaver.Wait();
+	std::ofstream file(p_file, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Couldn't write the scene " << p_file << ".\n";
+		return;
+	}
+	file << SceneSaver::Serialize(persistent);
 	file.close();
+	std::filesystem::remove(p_file + SceneLoader::DELTA_EXTENSION);
 
-	// Happenned in case of empty scene, should not happen but if a user remove everything, it will crash if no roots exists
-	const auto sceneIndex = static_cast<uint8_t>(OgEngine::Scene::EDITOR_SCENE);
-	if (roots[sceneIndex] == nullptr)
+	LoadScene(p_file, true);
+}
+
+OgEngine::CellStreamer* OgEngine::Core::GetCellStreamer() const
+{
+	return m_cellStreamer.get();
+}
+
+void OgEngine::Core::StartStreaming(const std::string& p_file)
+{
+	const std::string directory = WorldPartition::DirectoryOf(p_file);
+	if (!std::filesystem::exists(directory + "/" + WorldPartition::MANIFEST))
+		return;
+
+	WorldPartition partition;
+	try
 	{
-		roots[sceneIndex] = new SceneNode(SceneManager::CreateEntity());
+		partition = WorldPartition::Open(directory);
 	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "The world partition of " << p_file << " is corrupted, its cells won't be streamed (" << p_exception.what() << ").\n";
+		return;
+	}
+
+	m_cellStreamer = std::make_unique<CellStreamer>(directory, std::move(partition),
+		[this](const CellCoordinates& p_cell, const SceneDescription& p_content) { ActivateCell(p_cell, p_content); },
+		[this](const CellCoordinates& p_cell) { DeactivateCell(p_cell); });
+}
+
+void OgEngine::Core::ActivateCell(const CellCoordinates& p_cell, const SceneDescription& p_content)
+{
+	SceneNode* root = roots[static_cast<uint8_t>(Scene::EDITOR_SCENE)];
+	if (!root || p_content.nodes.empty())
+		return;
+
+	if (m_pendingModels.empty())
+		m_sceneLoadingTotal = 0u;
+	const size_t pendingCount = m_pendingModels.size();
+
+	CellResources& resources = m_cellResources[p_cell];
+	RequestResources(p_content, &resources);
+
+	std::vector<SceneNode*> createdNodes;
+	try
+	{
+		BuildSceneNodes(p_content, root, createdNodes);
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "Cell " << p_cell.x << ";" << p_cell.z << " couldn't be created (" << p_exception.what() << ").\n";
+		m_pendingModels.resize(pendingCount);
+		m_cellResources.erase(p_cell);
+		if (!createdNodes.empty() && createdNodes.front())
+			DestroyEntityNode(createdNodes.front());
+		return;
+	}
+
+	m_cellNodes[p_cell] = createdNodes.front();
+	m_cellRoots.insert(createdNodes.front()->GetEntity());
+	m_sceneLoadingTotal += m_pendingModels.size() - pendingCount;
+}
+
+void OgEngine::Core::DeactivateCell(const CellCoordinates& p_cell)
+{
+	const auto cell = m_cellNodes.find(p_cell);
+	if (cell == m_cellNodes.end())
+		return;
+
+	SceneNode* cellNode = cell->second;
+	std::unordered_set<Entity> entities;
+	std::vector<SceneNode*> toVisit{ cellNode };
+	while (!toVisit.empty())
+	{
+		SceneNode* node = toVisit.back();
+		toVisit.pop_back();
+		entities.insert(node->GetEntity());
+		if (node == inspectorNode)
+			inspectorNode = nullptr;
+
+		for (auto* child : node->GetChildren())
+			toVisit.emplace_back(child);
+	}
+
+	// Models of the cell still waiting for their resources are not attached anymore
+	const size_t pendingCount = m_pendingModels.size();
+	m_pendingModels.erase(std::remove_if(m_pendingModels.begin(), m_pendingModels.end(),
+		[&entities](const PendingModel& p_pending) { return entities.count(p_pending.entity) != 0u; }), m_pendingModels.end());
+	m_sceneLoadingTotal -= pendingCount - m_pendingModels.size();
+
+	m_cellRoots.erase(cellNode->GetEntity());
+	m_cellNodes.erase(cell);
+	DestroyEntityNode(cellNode);
+
+	// The loads still queued for the cell alone are cancelled, the loaded resources can be evicted again
+	m_cellResources.erase(p_cell);
 }
 
 void OgEngine::Core::RemoveRenderedObjects(SceneNode* p_parent) const
@@ -504,51 +961,157 @@ void OgEngine::Core::RemoveRenderedObjects(SceneNode* p_parent) const
 	}
 }
 
-void OgEngine::Core::SerializeChildren(std::ostream& p_file, SceneNode* p_parent, int& p_depth)
+void OgEngine::Core::AddTexture(const std::string& p_texture, const TEXTURE_TYPE p_textureType) const
 {
-	if (p_parent)
+	if (m_vulkanContext->IsRaytracing())
+		m_vulkanContext->GetRTPipeline()->AddTexture(p_texture, p_textureType);
+	else
+		m_vulkanContext->GetRSPipeline()->CreateTexture(p_texture, p_textureType);
+
+	// The pipelines copy the fallback textures again every time a texture is missing, they keep their pixels
+	const bool isFallback = p_texture == "error.png" || p_texture == "default.png";
+	// Otherwise the materials using the texture reference it, the rasterizer destroys its image once it is evicted
+	m_uploadedTextures.try_emplace(p_texture, m_vulkanContext->IsRaytracing() || isFallback
+		? ResourceManager::Acquire<Texture>(p_texture) : ResourceReference<Texture>());
+	if (!isFallback)
+		ResourceManager::ReleaseCpuData<Texture>(p_texture);
+}
+
+void OgEngine::Core::ApplyResourceReloads()
+{
+	ReloadedResources reloaded = ResourceManager::ApplyReloads();
+	if (reloaded.Empty())
+		return;
+
+	for (const ReloadedResource<Mesh>& mesh : reloaded.meshes)
 	{
-		for (auto* node : p_parent->GetChildren())
+		for (const auto& renderSystem : m_renderSystem)
 		{
-			p_file << DepthIndent(p_depth) << "<SceneNode>\n";
-			++p_depth;
-			p_file << SceneManager::GetComponent<Transform>(node->GetEntity()).Serialize(p_depth);
-			if (SceneManager::HasComponent<ModelRS>(node->GetEntity()))
-			{
-				// Call ModelRS Serialize
-				p_file << SceneManager::GetComponent<ModelRS>(node->GetEntity()).Serialize(p_depth);
-			}
-			if (SceneManager::HasComponent<RigidBody>(node->GetEntity()))
-			{
-				// Call RigidBody Serialize
-				p_file << SceneManager::GetComponent<RigidBody>(node->GetEntity()).Serialize(p_depth);
-			}
-			// TODO: Material component is under discussion as getting removed from being a component
-			if (SceneManager::HasComponent<Material>(node->GetEntity()))
-			{
-				// Call Mateial Serialize
-				p_file << SceneManager::GetComponent<Material>(node->GetEntity()).Serialize(p_depth);
-			}
-			if (SceneManager::HasComponent<LightSource>(node->GetEntity()))
-			{
-				// Call LightSource Serialize
-				p_file << SceneManager::GetComponent<LightSource>(node->GetEntity()).Serialize(p_depth);
-			}
-
-			SerializeChildren(p_file, node, p_depth);
+			if (renderSystem)
+				renderSystem->ReplaceMesh(mesh, m_vulkanContext);
+		}
 
-			--p_depth;
-			p_file << DepthIndent(p_depth) << "</SceneNode>\n";
+		// The raytracing pipeline finds the meshes by name, it keeps using the acceleration structure built for the previous version
+		if (!m_vulkanContext->IsRaytracing() && mesh.previous)
+		{
+			m_vulkanContext->GetRSPipeline()->DestroyMeshBuffers(mesh.previous.get());
+			for (const auto& subMesh : mesh.previous->SubMeshes())
+				m_vulkanContext->GetRSPipeline()->DestroyMeshBuffers(subMesh.get());
 		}
 	}
+
+	for (const ReloadedResource<Texture>& texture : reloaded.textures)
+	{
+		const auto uploaded = m_uploadedTextures.find(texture.name);
+		if (uploaded == m_uploadedTextures.end())
+			continue;
+
+		// Waits for the frames in flight and destroys the image of the previous version, which is released right after
+		if (m_vulkanContext->IsRaytracing())
+			m_vulkanContext->GetRTPipeline()->ReplaceTexture(texture.name);
+		else
+			m_vulkanContext->GetRSPipeline()->ReplaceTexture(texture.previous.get(), texture.current.get());
+		ReplaceMaterialTextures(texture.name);
+
+		if (uploaded->second.Handle().IsValid())
+			uploaded->second = ResourceManager::Acquire<Texture>(texture.name);
+		if (texture.name != "error.png" && texture.name != "default.png")
+			ResourceManager::ReleaseCpuData<Texture>(texture.name);
+	}
+
+	if (!reloaded.shaders.empty())
+	{
+		if (m_vulkanContext->IsRaytracing())
+			m_vulkanContext->GetRTPipeline()->ReloadShaders();
+		else
+			m_vulkanContext->GetRSPipeline()->ReloadShaders();
+	}
 }
 
-void OgEngine::Core::AddTexture(const std::string& p_texture, const TEXTURE_TYPE p_textureType) const
+void OgEngine::Core::TrimResources()
 {
+	// Only does something once a budget is exceeded
+	const EvictedResources evicted = ResourceManager::Trim();
+
+	// The meshes and textures are freed with the handles, their address mustn't be found in the pipeline anymore when it is reused.
+	// The textures given to the raytracing pipeline are referenced by m_uploadedTextures, they are never evicted
 	if (m_vulkanContext->IsRaytracing())
-		m_vulkanContext->GetRTPipeline()->AddTexture(p_texture, p_textureType);
-	else
-		m_vulkanContext->GetRSPipeline()->CreateTexture(p_texture, p_textureType);
+		return;
+
+	for (const ResourceHandle<Mesh>& handle : evicted.meshes)
+	{
+		const std::shared_ptr<Mesh> mesh = handle.Get();
+		if (!mesh)
+			continue;
+
+		m_vulkanContext->GetRSPipeline()->DestroyMeshBuffers(mesh.get());
+		for (const auto& subMesh : mesh->SubMeshes())
+			m_vulkanContext->GetRSPipeline()->DestroyMeshBuffers(subMesh.get());
+	}
+
+	if (evicted.textures.empty())
+		return;
+
+	for (const ResourceHandle<Texture>& handle : evicted.textures)
+	{
+		if (const std::shared_ptr<Texture> texture = handle.Get())
+			m_vulkanContext->GetRSPipeline()->DestroyTexture(texture.get());
+	}
+
+	// Uploaded again when a model uses them again
+	for (auto uploaded = m_uploadedTextures.begin(); uploaded != m_uploadedTextures.end();)
+	{
+		if (ResourceManager::GetHandle<Texture>(uploaded->first).IsValid())
+			++uploaded;
+		else
+			uploaded = m_uploadedTextures.erase(uploaded);
+	}
+}
+
+void OgEngine::Core::ReplaceMaterialTextures(const std::string& p_texture)
+{
+	for (const auto& renderSystem : m_renderSystem)
+	{
+		if (renderSystem)
+			renderSystem->ReplaceTexture(p_texture);
+	}
+
+	for (const auto& [file, prefab] : m_prefabs)
+	{
+		for (ModelRS& model : prefab->models)
+		{
+			Material& material = model.Material();
+			if (material.texName == p_texture)
+				material.SetTextureID(material.texName, material.texPath);
+			if (material.normName == p_texture)
+				material.SetNormalMapID(material.normName, material.normPath);
+		}
+	}
+}
+
+void OgEngine::Core::UpdateTextureStreaming()
+{
+	const Camera& camera = m_vulkanContext->IsRaytracing() ? m_vulkanContext->GetRTPipeline()->m_camera
+		: m_vulkanContext->GetRSPipeline()->GetCurrentCamera();
+	m_renderSystem[static_cast<uint8_t>(SceneManager::CurrentScene())]->ReportTextureUsage(camera, m_viewportHeight);
+
+	for (const ReloadedResource<Texture>& texture : ResourceManager::UpdateTextureStreaming())
+	{
+		// The image of the previous levels is destroyed, the pipelines never use its address again
+		if (m_vulkanContext->IsRaytracing())
+			m_vulkanContext->GetRTPipeline()->ReplaceTexture(texture.name);
+		else
+			m_vulkanContext->GetRSPipeline()->ReplaceTexture(texture.previous.get(), texture.current.get());
+		ReplaceMaterialTextures(texture.name);
+
+		const auto uploaded = m_uploadedTextures.find(texture.name);
+		if (uploaded == m_uploadedTextures.end())
+			continue;
+
+		if (uploaded->second.Handle().IsValid())
+			uploaded->second = ResourceManager::Acquire<Texture>(texture.name);
+		ResourceManager::ReleaseCpuData<Texture>(texture.name);
+	}
 }
 
 void OgEngine::Core::AddRigidBodyToPhysics(const Entity p_entity)
@@ -560,15 +1123,89 @@ void OgEngine::Core::AddRigidBodyToPhysics(const Entity p_entity)
 	m_physicsEngine.AddRigidBodyToScene(&rigidBody.GetRigidBody(), RigidBody::ConvertGPMtoPhysics(rigidBody.Transform()), rigidBody.IsStatic());
 }
 
-std::string OgEngine::Core::DepthIndent(const int p_depth)
+OgEngine::SceneDescription OgEngine::Core::CaptureScene(SceneNode* p_root) const
 {
-	std::string depthCode;
-	for (auto i = 0; i < p_depth; ++i)
+	SceneDescription scene;
+	std::vector<std::pair<SceneNode*, uint64_t>> toVisit{ { p_root, SceneNodeDescription::NO_PARENT } };
+	while (!toVisit.empty())
 	{
-		depthCode += "\t";
+		const auto [sceneNode, parent] = toVisit.back();
+		toVisit.pop_back();
+
+		const Entity entity = sceneNode->GetEntity();
+		const uint64_t index = scene.nodes.size();
+		SceneNodeDescription& node = scene.nodes.emplace_back();
+		node.parent = parent;
+		node.key = entity;
+
+		const auto& transform = SceneManager::GetComponent<Transform>(entity);
+		node.transform.name = transform.name;
+		node.transform.position = transform.localPosition;
+		node.transform.rotation = glm::vec4(transform.localRotation.x, transform.localRotation.y, transform.localRotation.z, transform.localRotation.w);
+		node.transform.scale = transform.localScale;
+
+		// The content of a prefab instance comes from the prefab file, only its transform is stored
+		if (const auto instance = m_prefabInstances.find(entity); instance != m_prefabInstances.end())
+		{
+			node.prefab = instance->second;
+			continue;
+		}
+
+		if (SceneManager::HasComponent<ModelRS>(entity))
+		{
+			auto& model = SceneManager::GetComponent<ModelRS>(entity);
+			ModelDescription& description = node.model.emplace();
+			description.parentMeshName = model.ParentMeshName();
+			description.meshName = model.MeshName();
+			description.meshFilepath = model.MeshFilepath();
+			description.isSubMesh = model.GetMesh() ? model.GetMesh()->IsSubMesh() : false;
+			description.subMeshIndex = model.GetMesh() ? model.GetMesh()->SubMeshIndex() : 0u;
+
+			// A Material component is read after the material of the model when loading, so it takes precedence
+			const Material& material = SceneManager::HasComponent<Material>(entity) ? SceneManager::GetComponent<Material>(entity) : model.Material();
+			MaterialDescription& materialDescription = node.material.emplace();
+			materialDescription.color = material.color;
+			materialDescription.specular = material.specular;
+			materialDescription.emissive = material.emissive;
+			materialDescription.ior = material.ior;
+			materialDescription.roughness = material.roughness;
+			materialDescription.type = material.type;
+			materialDescription.textureName = material.texName;
+			materialDescription.texturePath = material.texPath;
+			materialDescription.normalName = material.normName;
+			materialDescription.normalPath = material.normPath;
+		}
+
+		if (SceneManager::HasComponent<RigidBody>(entity))
+		{
+			const auto& rigidBody = SceneManager::GetComponent<RigidBody>(entity);
+			RigidBodyDescription& description = node.rigidBody.emplace();
+			description.shapeSize = glm::vec3(rigidBody.ShapeSizeX(), rigidBody.ShapeSizeY(), rigidBody.ShapeSizeZ());
+			description.mass = rigidBody.Mass();
+			description.type = rigidBody.ColliderType();
+			description.useGravity = rigidBody.UseGravity();
+			description.isStatic = rigidBody.IsStatic();
+		}
+
+		if (SceneManager::HasComponent<LightSource>(entity))
+		{
+			const auto& lightSource = SceneManager::GetComponent<LightSource>(entity);
+			LightSourceDescription& description = node.lightSource.emplace();
+			description.color = lightSource.color;
+			description.direction = lightSource.direction;
+			description.lightType = lightSource.lightType;
+		}
+
+		// Pushed in reverse so the children keep their order, streamed cells are written by BakeWorldPartition only
+		auto& children = sceneNode->GetChildren();
+		for (auto child = children.rbegin(); child != children.rend(); ++child)
+		{
+			if (m_cellRoots.count((*child)->GetEntity()) == 0u)
+				toVisit.emplace_back(*child, index);
+		}
 	}
 
-	return depthCode;
+	return scene;
 }
 
 void OgEngine::Core::RegisterComponentsAndSystems(const Scene& p_scene)
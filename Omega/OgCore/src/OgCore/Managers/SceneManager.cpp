@@ -29,6 +29,24 @@ OgEngine::Entity OgEngine::SceneManager::CreateEntity()
 	return idEntity;
 }
 
+void OgEngine::SceneManager::CreateEntities(const std::vector<Transform>& p_transforms, std::vector<Entity>& p_entities)
+{
+	const auto indexScene = static_cast<uint8_t>(m_currentScene);
+
+	const size_t first = p_entities.size();
+	p_entities.reserve(first + p_transforms.size());
+	for (size_t i = 0u; i < p_transforms.size(); ++i)
+	{
+		p_entities.push_back(m_entityManager[indexScene]->CreateEntity());
+	}
+
+	m_componentManager[indexScene]->AddComponents(p_entities.data() + first, p_transforms.data(), p_transforms.size());
+	for (size_t i = first; i < p_entities.size(); ++i)
+	{
+		OnComponentAdded<Transform>(p_entities[i]);
+	}
+}
+
 void OgEngine::SceneManager::DestroyEntity(const Entity p_entity)
 {
 	m_entityManager[static_cast<uint8_t>(m_currentScene)]->DestroyEntity(p_entity);
@@ -0,0 +1,138 @@
+#include <OgCore/SceneLoader/CellStreamer.h>
+#include <OgCore/SceneLoader/SceneLoader.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+OgEngine::CellStreamer::CellStreamer(std::string p_directory, WorldPartition p_partition, ActivateCallback p_onActivate, DeactivateCallback p_onDeactivate)
+	: m_jobs(Utils::JobSystem::Instance()), m_directory(std::move(p_directory)), m_partition(std::move(p_partition)), m_onActivate(std::move(p_onActivate)), m_onDeactivate(std::move(p_onDeactivate))
+{
+	m_cells.resize(m_partition.cells.size());
+	for (size_t i = 0u; i < m_cells.size(); ++i)
+		m_cells[i].entry = m_partition.cells[i];
+}
+
+OgEngine::CellStreamer::~CellStreamer()
+{
+	for (Cell& cell : m_cells)
+	{
+		cell.reading.Wait();
+	}
+}
+
+void OgEngine::CellStreamer::Update(const glm::vec3& p_position)
+{
+	std::vector<std::pair<float, Cell*>> candidates;
+
+	for (Cell& cell : m_cells)
+	{
+		const float distance = m_partition.DistanceTo(p_position, cell.entry.coordinates);
+
+		if (cell.state == CELL_STATE::READING && cell.reading.IsDone())
+		{
+			--m_loadsInFlight;
+			cell.reading = Utils::TaskHandle();
+			if (cell.readError.empty())
+			{
+				cell.state = CELL_STATE::READ;
+			}
+			else
+			{
+				std::cerr << "Cell " << WorldPartition::CellFile(m_directory, cell.entry.coordinates) << " couldn't be read (" << cell.readError << ").\n";
+				cell.state = CELL_STATE::FAILED;
+				m_residentBytes -= cell.entry.bytes;
+			}
+		}
+
+		if (distance > budget.unloadRadius)
+		{
+			if (cell.state == CELL_STATE::RESIDENT)
+				m_onDeactivate(cell.entry.coordinates);
+
+			// A cell still being read is dropped once the read completes
+			if (cell.state == CELL_STATE::RESIDENT || cell.state == CELL_STATE::READ)
+			{
+				cell.content = SceneDescription();
+				cell.state = CELL_STATE::UNLOADED;
+				m_residentBytes -= cell.entry.bytes;
+			}
+		}
+		else if ((cell.state == CELL_STATE::UNLOADED && distance <= budget.loadRadius)
+			|| cell.state == CELL_STATE::READ)
+		{
+			candidates.emplace_back(distance, &cell);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](const auto& p_a, const auto& p_b) { return p_a.first < p_b.first; });
+
+	// Closest cells first, both for reading and for activation
+	const auto start = std::chrono::steady_clock::now();
+	uint32_t activations = 0u;
+	for (auto& [distance, cell] : candidates)
+	{
+		if (cell->state == CELL_STATE::UNLOADED)
+		{
+			if (m_loadsInFlight >= budget.maxLoadsInFlight || (m_residentBytes + cell->entry.bytes > budget.maxResidentBytes && m_residentBytes > 0u))
+				continue;
+
+			cell->reading = m_jobs.Submit([cell, file = WorldPartition::CellFile(m_directory, cell->entry.coordinates)]()
+			{
+				try
+				{
+					cell->content = SceneLoader::Parse(file);
+				}
+				catch (const std::exception& p_exception)
+				{
+					cell->readError = p_exception.what();
+				}
+			});
+			cell->state = CELL_STATE::READING;
+			m_residentBytes += cell->entry.bytes;
+			++m_loadsInFlight;
+		}
+		else if (activations < budget.maxActivationsPerFrame
+			&& std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < budget.maxActivationMilliseconds)
+		{
+			m_onActivate(cell->entry.coordinates, cell->content);
+			cell->content = SceneDescription();
+			cell->state = CELL_STATE::RESIDENT;
+			++activations;
+		}
+	}
+}
+
+bool OgEngine::CellStreamer::IsResident(const CellCoordinates& p_cell) const
+{
+	return std::any_of(m_cells.begin(), m_cells.end(), [&p_cell](const Cell& p_other)
+	{
+		return p_other.entry.coordinates == p_cell && p_other.state == CELL_STATE::RESIDENT;
+	});
+}
+
+std::vector<OgEngine::CellCoordinates> OgEngine::CellStreamer::ResidentCells() const
+{
+	std::vector<CellCoordinates> cells;
+	for (const Cell& cell : m_cells)
+	{
+		if (cell.state == CELL_STATE::RESIDENT)
+			cells.emplace_back(cell.entry.coordinates);
+	}
+
+	return cells;
+}
+
+uint64_t OgEngine::CellStreamer::ResidentBytes() const
+{
+	return m_residentBytes;
+}
+
+const OgEngine::WorldPartition& OgEngine::CellStreamer::Partition() const
+{
+	return m_partition;
+}
+
+const std::string& OgEngine::CellStreamer::Directory() const
+{
+	return m_directory;
+}
@@ -0,0 +1,134 @@
+#include <OgCore/SceneLoader/SceneGenerator.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+	/**
+	 * @brief Random values drawn from the raw output of mt19937_64, which is the same on every standard library
+	 * (the std distributions are not, they would break the determinism between platforms).
+	 */
+	class Random
+	{
+	public:
+		explicit Random(const uint64_t p_seed) : m_engine(p_seed) {}
+
+		/**
+		 * @return A value in [0, 1)
+		 */
+		float Unit()
+		{
+			return static_cast<float>(static_cast<double>(m_engine() >> 11u) * (1.0 / 9007199254740992.0));
+		}
+
+		float Range(const float p_min, const float p_max)
+		{
+			return p_min + (p_max - p_min) * Unit();
+		}
+
+		/**
+		 * @return A value in [0, p_count)
+		 */
+		uint64_t Index(const uint64_t p_count)
+		{
+			return m_engine() % p_count;
+		}
+
+		bool Chance(const float p_ratio)
+		{
+			return Unit() < p_ratio;
+		}
+
+	private:
+		std::mt19937_64 m_engine;
+	};
+
+	/**
+	 * @brief Pick an asset already used, or a new one.
+	 * @param p_used Number of different assets used so far, incremented when a new one is picked
+	 * @return The index of the asset
+	 */
+	uint64_t PickAsset(Random& p_random, uint64_t& p_used, const float p_reuseRatio)
+	{
+		if (p_used != 0u && p_random.Chance(p_reuseRatio))
+			return p_random.Index(p_used);
+
+		return p_used++;
+	}
+}
+
+OgEngine::SceneDescription OgEngine::SceneGenerator::Generate(const SceneGenerationSettings& p_settings)
+{
+	Random random(p_settings.seed);
+	SceneDescription scene;
+	if (p_settings.nodeCount == 0u)
+		return scene;
+
+	scene.nodes.reserve(p_settings.nodeCount);
+	SceneNodeDescription& root = scene.nodes.emplace_back();
+	root.transform.name = "Root";
+
+	// Path from the root to the last node created, a new node goes under one of them so the depth-first order holds
+	std::vector<uint64_t> path{ 0u };
+	uint64_t meshCount = 0u;
+	uint64_t textureCount = 0u;
+	const float halfExtent = p_settings.extent * 0.5f;
+
+	for (uint64_t i = 1u; i < p_settings.nodeCount; ++i)
+	{
+		const uint64_t depth = 1u + random.Index(std::min<uint64_t>(path.size(), std::max(p_settings.maxDepth, 1u)));
+		path.resize(depth);
+
+		SceneNodeDescription& node = scene.nodes.emplace_back();
+		node.parent = path.back();
+		node.key = i;
+		path.push_back(i);
+
+		node.transform.name = "Node_" + std::to_string(i);
+		node.transform.position = glm::vec3(random.Range(-halfExtent, halfExtent), random.Range(-halfExtent, halfExtent), random.Range(-halfExtent, halfExtent));
+		glm::vec4 rotation(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f));
+		const float length = std::sqrt(rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w);
+		node.transform.rotation = length > 0.0f ? glm::vec4(rotation.x / length, rotation.y / length, rotation.z / length, rotation.w / length) : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		node.transform.scale = glm::vec3(random.Range(0.5f, 2.0f));
+
+		if (random.Chance(p_settings.modelRatio))
+		{
+			const std::string mesh = "mesh_" + std::to_string(PickAsset(random, meshCount, p_settings.assetReuseRatio)) + ".obj";
+			ModelDescription& model = node.model.emplace();
+			model.parentMeshName = mesh;
+			model.meshName = mesh;
+			model.meshFilepath = "Resources/models/generated/" + mesh;
+
+			if (random.Chance(p_settings.materialRatio))
+			{
+				const std::string texture = "texture_" + std::to_string(PickAsset(random, textureCount, p_settings.assetReuseRatio)) + ".png";
+				MaterialDescription& material = node.material.emplace();
+				material.color = glm::vec4(random.Unit(), random.Unit(), random.Unit(), 1.0f);
+				material.roughness = random.Unit();
+				material.ior = random.Range(1.0f, 2.0f);
+				material.textureName = texture;
+				material.texturePath = "Resources/textures/generated/" + texture;
+			}
+		}
+
+		if (random.Chance(p_settings.rigidBodyRatio))
+		{
+			RigidBodyDescription& rigidBody = node.rigidBody.emplace();
+			rigidBody.shapeSize = node.transform.scale;
+			rigidBody.mass = random.Range(0.1f, 100.0f);
+			rigidBody.type = static_cast<int>(random.Index(3u));
+			rigidBody.isStatic = random.Chance(0.5f);
+		}
+
+		if (random.Chance(p_settings.lightSourceRatio))
+		{
+			LightSourceDescription& lightSource = node.lightSource.emplace();
+			lightSource.color = glm::vec4(random.Unit(), random.Unit(), random.Unit(), 1.0f);
+			lightSource.direction = glm::vec4(random.Range(-1.0f, 1.0f), -1.0f, random.Range(-1.0f, 1.0f), 0.0f);
+			lightSource.lightType = static_cast<int>(random.Index(2u));
+		}
+	}
+
+	return scene;
+}
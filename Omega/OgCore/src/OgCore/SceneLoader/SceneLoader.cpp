@@ -1,187 +1,678 @@
-#include <stack>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
+#include <unordered_map>
 #include <OgCore/SceneLoader/SceneLoader.h>
+#include <OgRendering/Utils/MappedFile.h>
 
-std::vector<std::string> OgEngine::SceneLoader::symbolsList = {
-	"<SceneNode>", "<Transform>", "<Model>", "<Material>", "<RigidBody>", "<LightSource>",
-		"</SceneNode>", "</Transform>", "</Model>", "</Material>", "</RigidBody>", "</LightSource>"
-};
-
-std::string OgEngine::SceneLoader::ExtractNameFromAttribute(const std::string& p_attributeLine)
+namespace
 {
-	return ExtractDataFromAttribute(p_attributeLine);
-}
+	/**
+	 * @brief Single-pass tokenizer over a whole scene buffer.
+	 * Tags are read as views into the buffer, values are converted with std::from_chars, and the
+	 * opening/closing structure is validated on the way, so nothing is copied besides the string attributes.
+	 */
+	class SceneParser
+	{
+	public:
+		explicit SceneParser(const std::string_view p_buffer)
+			: m_buffer(p_buffer)
+		{
+		}
 
-float OgEngine::SceneLoader::ExtractFloatFromAttribute(const std::string& p_attributeLine)
-{
-	return StringToFloat(ExtractDataFromAttribute(p_attributeLine));
-}
+		OgEngine::SceneDescription Parse()
+		{
+			OgEngine::SceneDescription scene;
+			// Grown from the size of the first nodes read, see ReserveNodes
+			scene.nodes.reserve(m_buffer.size() / FIRST_RESERVE_BYTES + 1u);
 
-int OgEngine::SceneLoader::ExtractIntegerFromAttribute(const std::string& p_attributeLine)
-{
-	return StringToInt(ExtractDataFromAttribute(p_attributeLine));
-}
+			std::string_view tag;
+			if (!NextTag(tag) || tag != "SceneNode")
+				Error("the scene must start with a <SceneNode>");
 
-bool OgEngine::SceneLoader::ExtractBooleanFromAttribute(const std::string& p_attributeLine)
-{
-	return StringToInt(ExtractDataFromAttribute(p_attributeLine));
-}
+			ParseSceneNode(scene, OgEngine::SceneNodeDescription::NO_PARENT);
 
-glm::vec3 OgEngine::SceneLoader::ExtractVector3FromAttribute(const std::string& p_attributeLine)
-{
-	const std::string data = ExtractDataFromAttribute(p_attributeLine);
+			SkipWhitespaces();
+			if (m_cursor != m_buffer.size())
+				Error("unexpected content after the root </SceneNode>");
 
-	glm::vec3 returnedVector;
-	std::istringstream valueStream(data);
-	std::string readValue;
+			return scene;
+		}
+
+		/**
+		 * @brief Apply a journal of delta records to a scene and put it back in depth-first order.
+		 * @param p_scene The scene read from the base file, its nodes are updated, added or removed
+		 */
+		void ParseDelta(OgEngine::SceneDescription& p_scene)
+		{
+			// The records refer to the nodes by key, parents are handled as keys until the hierarchy is rebuilt
+			std::unordered_map<uint64_t, size_t> indexOfKey;
+			indexOfKey.reserve(p_scene.nodes.size());
+			std::vector<uint64_t> parentKeys(p_scene.nodes.size(), OgEngine::SceneNodeDescription::NO_PARENT);
+			std::vector<bool> removed(p_scene.nodes.size(), false);
+			for (size_t i = 0u; i < p_scene.nodes.size(); ++i)
+			{
+				indexOfKey.emplace(p_scene.nodes[i].key, i);
+				if (p_scene.nodes[i].parent != OgEngine::SceneNodeDescription::NO_PARENT)
+					parentKeys[i] = p_scene.nodes[p_scene.nodes[i].parent].key;
+			}
 
-	// Read x
-	std::getline(valueStream, readValue, ';');
-	returnedVector.x = StringToFloat(readValue);
+			// Reused by every record, its node is moved out each time
+			OgEngine::SceneDescription record;
+			record.nodes.reserve(1u);
 
-	// Read y
-	std::getline(valueStream, readValue, ';');
-	returnedVector.y = StringToFloat(readValue);
+			std::string_view tag;
+			while (NextTag(tag))
+			{
+				if (tag == "Delta")
+				{
+					uint64_t key = 0u;
+					uint64_t parentKey = OgEngine::SceneNodeDescription::NO_PARENT;
+					record.nodes.clear();
+					ParseBlock("Delta", [this, &key, &parentKey, &record](const std::string_view p_tag)
+					{
+						if (p_tag == "SceneNode")
+							ParseSceneNode(record, OgEngine::SceneNodeDescription::NO_PARENT);
+						else if (p_tag == "key")
+							key = ToKey(ReadValue(p_tag));
+						else if (p_tag == "parent")
+							parentKey = ToKey(ReadValue(p_tag));
+						else
+							Error("unknown block <" + std::string(p_tag) + "> in <Delta>");
+					});
 
-	// Read z
-	std::getline(valueStream, readValue);
-	returnedVector.z = StringToFloat(readValue);
+					if (record.nodes.size() != 1u)
+						Error("a <Delta> must hold exactly one <SceneNode> without children");
 
-	return returnedVector;
-}
+					OgEngine::SceneNodeDescription& node = record.nodes.front();
+					node.key = key;
+					const auto [found, inserted] = indexOfKey.emplace(key, p_scene.nodes.size());
+					if (inserted)
+					{
+						p_scene.nodes.emplace_back(std::move(node));
+						parentKeys.emplace_back(parentKey);
+						removed.emplace_back(false);
+					}
+					else
+					{
+						p_scene.nodes[found->second] = std::move(node);
+						parentKeys[found->second] = parentKey;
+						removed[found->second] = false;
+					}
+				}
+				else if (tag == "Remove")
+				{
+					ParseBlock("Remove", [this, &indexOfKey, &removed](const std::string_view p_tag)
+					{
+						if (p_tag != "key")
+							Error("unknown block <" + std::string(p_tag) + "> in <Remove>");
 
-glm::vec4 OgEngine::SceneLoader::ExtractVector4FromAttribute(const std::string& p_attributeLine)
-{
-	const std::string data = ExtractDataFromAttribute(p_attributeLine);
+						const auto found = indexOfKey.find(ToKey(ReadValue(p_tag)));
+						if (found != indexOfKey.end())
+							removed[found->second] = true;
+					});
+				}
+				else
+				{
+					Error("unknown record <" + std::string(tag) + ">");
+				}
+			}
+
+			// Rebuild the depth-first order, removed nodes and the nodes under them are dropped
+			std::vector<std::vector<size_t>> children(p_scene.nodes.size());
+			size_t root = p_scene.nodes.size();
+			for (size_t i = 0u; i < p_scene.nodes.size(); ++i)
+			{
+				if (removed[i])
+					continue;
+
+				if (parentKeys[i] == OgEngine::SceneNodeDescription::NO_PARENT)
+				{
+					if (root != p_scene.nodes.size())
+						Error("the delta records define several roots");
+					root = i;
+				}
+				else if (const auto parent = indexOfKey.find(parentKeys[i]); parent != indexOfKey.end())
+				{
+					children[parent->second].emplace_back(i);
+				}
+			}
+
+			if (root == p_scene.nodes.size())
+				Error("the delta records removed the root");
+
+			std::vector<OgEngine::SceneNodeDescription> ordered;
+			ordered.reserve(p_scene.nodes.size());
+			std::vector<std::pair<size_t, uint64_t>> toVisit{ { root, OgEngine::SceneNodeDescription::NO_PARENT } };
+			while (!toVisit.empty())
+			{
+				const auto [index, parent] = toVisit.back();
+				toVisit.pop_back();
+
+				const uint64_t newIndex = ordered.size();
+				ordered.emplace_back(std::move(p_scene.nodes[index])).parent = parent;
+
+				// Pushed in reverse so the children keep their order
+				for (auto child = children[index].rbegin(); child != children[index].rend(); ++child)
+					toVisit.emplace_back(*child, newIndex);
+			}
+
+			p_scene.nodes = std::move(ordered);
+		}
+
+		OgEngine::WorldPartition ParseManifest()
+		{
+			OgEngine::WorldPartition partition;
+
+			std::string_view tag;
+			if (!NextTag(tag) || tag != "WorldPartition")
+				Error("the manifest must start with a <WorldPartition>");
+
+			ParseBlock("WorldPartition", [this, &partition](const std::string_view p_tag)
+			{
+				if (p_tag == "cellSize")
+				{
+					partition.cellSize = ToFloat(ReadValue(p_tag));
+				}
+				else if (p_tag == "Cell")
+				{
+					OgEngine::PartitionCell& cell = partition.cells.emplace_back();
+					ParseBlock("Cell", [this, &cell](const std::string_view p_cellTag)
+					{
+						const std::string_view value = ReadValue(p_cellTag);
+						if (p_cellTag == "x")
+							cell.coordinates.x = ToInt(value);
+						else if (p_cellTag == "z")
+							cell.coordinates.z = ToInt(value);
+						else if (p_cellTag == "nodes")
+							cell.nodeCount = ToKey(value);
+						else if (p_cellTag == "bytes")
+							cell.bytes = ToKey(value);
+					});
+				}
+				else
+				{
+					Error("unknown block <" + std::string(p_tag) + "> in <WorldPartition>");
+				}
+			});
+
+			if (partition.cellSize <= 0.0f)
+				Error("the cell size must be positive");
+
+			return partition;
+		}
+
+	private:
+		/**
+		 * @brief Bytes per node of the first reserve, larger than any node so the estimate is made early on.
+		 */
+		static constexpr size_t FIRST_RESERVE_BYTES = 64u * 1024u;
+
+		std::string_view m_buffer;
+		size_t m_cursor{ 0u };
+
+		[[noreturn]] void Error(const std::string& p_message) const
+		{
+			// Lines are only counted when something goes wrong
+			const auto line = std::count(m_buffer.begin(), m_buffer.begin() + std::min(m_cursor, m_buffer.size()), '\n') + 1;
+			throw std::runtime_error("line " + std::to_string(line) + ": " + p_message);
+		}
+
+		void SkipWhitespaces()
+		{
+			while (m_cursor < m_buffer.size() && IsWhitespace(m_buffer[m_cursor]))
+				++m_cursor;
+		}
+
+		static bool IsWhitespace(const char p_character)
+		{
+			return p_character == ' ' || p_character == '\t' || p_character == '\r' || p_character == '\n';
+		}
+
+		/**
+		 * @brief Read the next tag, an opening tag returns its name, a closing tag returns its name prefixed by '/'.
+		 * @return False at the end of the buffer
+		 */
+		bool NextTag(std::string_view& p_tag)
+		{
+			SkipWhitespaces();
+			if (m_cursor >= m_buffer.size())
+				return false;
+
+			if (m_buffer[m_cursor] != '<')
+				Error("expected a tag");
+
+			const char* const data = m_buffer.data();
+			const auto* end = static_cast<const char*>(std::memchr(data + m_cursor, '>', m_buffer.size() - m_cursor));
+			if (!end)
+				Error("unterminated tag");
 
-	glm::vec4 returnedVector;
-	std::istringstream valueStream(data);
-	std::string readValue;
+			p_tag = std::string_view(data + m_cursor + 1u, static_cast<size_t>(end - data) - m_cursor - 1u);
+			m_cursor = static_cast<size_t>(end - data) + 1u;
 
-	// Read x
-	std::getline(valueStream, readValue, ';');
-	returnedVector.x = StringToFloat(readValue);
+			if (p_tag.empty() || p_tag == "/")
+				Error("empty tag");
+
+			return true;
+		}
+
+		/**
+		 * @brief Read the value of an attribute and consume its closing tag.
+		 * @param p_attribute The name of the attribute opened just before
+		 * @return The raw text between the opening and the closing tags
+		 */
+		std::string_view ReadValue(const std::string_view p_attribute)
+		{
+			const char* const data = m_buffer.data();
+			const auto* end = static_cast<const char*>(std::memchr(data + m_cursor, '<', m_buffer.size() - m_cursor));
+			if (!end)
+				Error("unterminated attribute <" + std::string(p_attribute) + ">");
+
+			const std::string_view value(data + m_cursor, static_cast<size_t>(end - data) - m_cursor);
+			m_cursor = static_cast<size_t>(end - data);
+
+			// The closing tag directly follows the value: "</" + attribute + ">"
+			const size_t closingSize = p_attribute.size() + 3u;
+			if (m_buffer.size() - m_cursor < closingSize || end[1] != '/'
+				|| std::memcmp(end + 2, p_attribute.data(), p_attribute.size()) != 0 || end[closingSize - 1u] != '>')
+				Error("<" + std::string(p_attribute) + "> is not closed properly");
+			m_cursor += closingSize;
+
+			return value;
+		}
+
+		static std::string_view Trim(std::string_view p_value)
+		{
+			while (!p_value.empty() && IsWhitespace(p_value.front()))
+				p_value.remove_prefix(1u);
+			while (!p_value.empty() && IsWhitespace(p_value.back()))
+				p_value.remove_suffix(1u);
+
+			return p_value;
+		}
+
+		float ToFloat(std::string_view p_value) const
+		{
+			p_value = Trim(p_value);
+			float value = 0.0f;
+			if (ReadDecimal(p_value.data(), p_value.data() + p_value.size(), value) == p_value.data() + p_value.size())
+				return value;
+
+			const auto [end, error] = std::from_chars(p_value.data(), p_value.data() + p_value.size(), value);
+			if (error != std::errc() || end != p_value.data() + p_value.size())
+				Error("'" + std::string(p_value) + "' is not a valid float");
+
+			return value;
+		}
+
+		/**
+		 * @brief Read a float written as [-]digits[.digits], the way the scenes are saved, without std::from_chars.
+		 * The decimal is rounded once to a double, which is exact while its digits fit in 53 bits, then to a float.
+		 * @return Where the number ends, nullptr for any other form or when the double falls halfway between two floats and rounding it again could differ
+		 */
+		static const char* ReadDecimal(const char* p_current, const char* const p_end, float& p_result)
+		{
+			// Powers of ten that are exact doubles
+			static constexpr double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+			constexpr size_t MAX_DIGITS = 15u;
+
+			const bool isNegative = p_current != p_end && *p_current == '-';
+			if (isNegative)
+				++p_current;
+
+			const char* const start = p_current;
+			uint64_t digits = 0u;
+			for (; p_current != p_end && static_cast<unsigned>(*p_current - '0') <= 9u; ++p_current)
+				digits = digits * 10u + static_cast<unsigned>(*p_current - '0');
+			size_t digitCount = static_cast<size_t>(p_current - start);
+			if (digitCount == 0u)
+				return nullptr;
+
+			size_t decimals = 0u;
+			if (p_current != p_end && *p_current == '.')
+			{
+				const char* const point = ++p_current;
+				for (; p_current != p_end && static_cast<unsigned>(*p_current - '0') <= 9u; ++p_current)
+					digits = digits * 10u + static_cast<unsigned>(*p_current - '0');
+				decimals = static_cast<size_t>(p_current - point);
+				digitCount += decimals;
+				if (decimals == 0u)
+					return nullptr;
+			}
 
-	// Read y
-	std::getline(valueStream, readValue, ';');
-	returnedVector.y = StringToFloat(readValue);
+			if (digitCount > MAX_DIGITS)
+				return nullptr;
 
-	// Read z
-	std::getline(valueStream, readValue, ';');
-	returnedVector.z = StringToFloat(readValue);
+			const double value = static_cast<double>(digits) / POWERS_OF_TEN[decimals];
+			uint64_t bits = 0u;
+			std::memcpy(&bits, &value, sizeof(bits));
+			// The 29 bits a float drops are exactly half of its last bit: a tie the first rounding may have made
+			if ((bits & 0x1FFFFFFFu) == 0x10000000u)
+				return nullptr;
 
-	// Read w
-	std::getline(valueStream, readValue);
-	returnedVector.w = StringToFloat(readValue);
+			const float rounded = static_cast<float>(value);
+			// Subnormal floats lose more bits, std::from_chars handles them
+			if (rounded != 0.0f && !std::isnormal(rounded))
+				return nullptr;
 
-	return returnedVector;
+			p_result = isNegative ? -rounded : rounded;
+			return p_current;
+		}
+
+		int ToInt(std::string_view p_value) const
+		{
+			p_value = Trim(p_value);
+			int value = 0;
+			const auto [end, error] = std::from_chars(p_value.data(), p_value.data() + p_value.size(), value);
+			if (error != std::errc() || end != p_value.data() + p_value.size())
+				Error("'" + std::string(p_value) + "' is not a valid integer");
+
+			return value;
+		}
+
+		uint64_t ToKey(std::string_view p_value) const
+		{
+			p_value = Trim(p_value);
+			uint64_t value = 0u;
+			const auto [end, error] = std::from_chars(p_value.data(), p_value.data() + p_value.size(), value);
+			if (error != std::errc() || end != p_value.data() + p_value.size())
+				Error("'" + std::string(p_value) + "' is not a valid key");
+
+			return value;
+		}
+
+		/**
+		 * @brief Read a list of float separated by ';' into a vector.
+		 * @note Components missing at the end keep their previous value, extra components are ignored (a vec3 may be written as a vec4).
+		 */
+		template<typename Vector>
+		Vector ToVector(std::string_view p_value, Vector p_defaultValue) const
+		{
+			for (int i = 0; i < Vector::length(); ++i)
+			{
+				// The components are read in place as long as they are written the way the scenes are saved
+				const char* const end = p_value.data() + p_value.size();
+				if (const char* read = ReadDecimal(p_value.data(), end, p_defaultValue[i]); read && (read == end || *read == ';'))
+				{
+					if (read == end)
+						break;
+					p_value.remove_prefix(static_cast<size_t>(read - p_value.data()) + 1u);
+					continue;
+				}
+
+				const size_t separator = p_value.find(';');
+				p_defaultValue[i] = ToFloat(p_value.substr(0u, separator));
+
+				if (separator == std::string_view::npos)
+					break;
+				p_value.remove_prefix(separator + 1u);
+			}
+
+			return p_defaultValue;
+		}
+
+		/**
+		 * @brief Iterate over the attributes of a component until its closing tag.
+		 * @param p_component The name of the component being read
+		 * @param p_onAttribute Called with the name of each opened tag, in charge of reading it up to its own closing tag
+		 */
+		template<typename Callback>
+		void ParseBlock(const std::string_view p_component, Callback&& p_onAttribute)
+		{
+			std::string_view tag;
+			while (NextTag(tag))
+			{
+				if (tag[0] == '/')
+				{
+					if (tag.substr(1u) != p_component)
+						Error("expected </" + std::string(p_component) + "> but found <" + std::string(tag) + ">");
+					return;
+				}
+
+				p_onAttribute(tag);
+			}
+
+			Error("<" + std::string(p_component) + "> is never closed");
+		}
+
+		/**
+		 * @brief Make room for the nodes left in the buffer, estimated from the bytes the nodes read so far took.
+		 * A node takes 300 bytes without components and about 1KB with a model, a reserve fitting the scene avoids moving the nodes
+		 * and the pages of a capacity never used (the nodes are 512 bytes, their allocation costs as much as reading them).
+		 */
+		void ReserveNodes(std::vector<OgEngine::SceneNodeDescription>& p_nodes) const
+		{
+			const size_t bytesPerNode = std::max<size_t>(m_cursor / std::max<size_t>(p_nodes.size(), 1u), 1u);
+			const size_t estimated = p_nodes.size() + (m_buffer.size() - m_cursor) / bytesPerNode;
+			// A margin for the scenes whose nodes get larger further on, the vector doubles past it
+			p_nodes.reserve(std::max(estimated + estimated / 16u + 16u, p_nodes.size() * 2u));
+		}
+
+		void ParseSceneNode(OgEngine::SceneDescription& p_scene, const uint64_t p_parent)
+		{
+			if (p_scene.nodes.size() == p_scene.nodes.capacity())
+				ReserveNodes(p_scene.nodes);
+
+			const uint64_t index = p_scene.nodes.size();
+			auto& node = p_scene.nodes.emplace_back();
+			node.parent = p_parent;
+			// The nodes of a base file are identified by their depth-first index
+			node.key = index;
+
+			ParseBlock("SceneNode", [this, &p_scene, index](const std::string_view p_tag)
+			{
+				if (p_tag == "SceneNode")
+					ParseSceneNode(p_scene, index);
+				else if (p_tag == "Transform")
+					ParseTransform(p_scene.nodes[index].transform);
+				else if (p_tag == "Model")
+					ParseModel(p_scene.nodes[index]);
+				else if (p_tag == "Material")
+					ParseMaterial(p_scene.nodes[index].material);
+				else if (p_tag == "RigidBody")
+					ParseRigidBody(p_scene.nodes[index].rigidBody.emplace());
+				else if (p_tag == "LightSource")
+					ParseLightSource(p_scene.nodes[index].lightSource.emplace());
+				else if (p_tag == "Prefab")
+					ParsePrefab(p_scene.nodes[index].prefab.emplace());
+				else
+					Error("unknown block <" + std::string(p_tag) + "> in <SceneNode>");
+			});
+		}
+
+		void ParseTransform(OgEngine::TransformDescription& p_transform)
+		{
+			ParseBlock("Transform", [this, &p_transform](const std::string_view p_tag)
+			{
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "name")
+					p_transform.name = value;
+				else if (p_tag == "position")
+					p_transform.position = ToVector(value, p_transform.position);
+				else if (p_tag == "rotation")
+					p_transform.rotation = ToVector(value, p_transform.rotation);
+				else if (p_tag == "scale")
+					p_transform.scale = ToVector(value, p_transform.scale);
+			});
+		}
+
+		void ParseModel(OgEngine::SceneNodeDescription& p_node)
+		{
+			auto& model = p_node.model.emplace();
+			ParseBlock("Model", [this, &p_node, &model](const std::string_view p_tag)
+			{
+				if (p_tag == "Material")
+				{
+					ParseMaterial(p_node.material);
+					return;
+				}
+
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "parentMeshName")
+					model.parentMeshName = value;
+				else if (p_tag == "meshName")
+					model.meshName = value;
+				else if (p_tag == "meshFilepath")
+					model.meshFilepath = value;
+				else if (p_tag == "subMesh")
+					model.isSubMesh = ToInt(value) != 0;
+				else if (p_tag == "indexSubMesh")
+					model.subMeshIndex = static_cast<uint32_t>(ToInt(value));
+			});
+		}
+
+		/**
+		 * @brief Read a <Material> block, its strings are copied once the block is read.
+		 * A default material holds a texture path too long to be stored inline, assigning the one read over it allocated it twice.
+		 */
+		void ParseMaterial(std::optional<OgEngine::MaterialDescription>& p_material)
+		{
+			static const OgEngine::MaterialDescription defaults;
+			OgEngine::MaterialDescription read{ defaults.color, defaults.specular, defaults.emissive, defaults.ior, defaults.roughness, defaults.type, {}, {}, {}, {} };
+			std::string_view textureName = defaults.textureName;
+			std::string_view texturePath = defaults.texturePath;
+			std::string_view normalName = defaults.normalName;
+			std::string_view normalPath = defaults.normalPath;
+
+			ParseBlock("Material", [&](const std::string_view p_tag)
+			{
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "color")
+					read.color = ToVector(value, read.color);
+				else if (p_tag == "specular")
+					read.specular = ToVector(value, read.specular);
+				else if (p_tag == "emissive")
+					read.emissive = ToVector(value, read.emissive);
+				else if (p_tag == "ior")
+					read.ior = ToFloat(value);
+				else if (p_tag == "roughness")
+					read.roughness = ToFloat(value);
+				else if (p_tag == "type")
+					read.type = ToInt(value);
+				else if (p_tag == "textureName")
+					textureName = value;
+				else if (p_tag == "texturePath")
+					texturePath = value;
+				else if (p_tag == "normalName")
+					normalName = value;
+				else if (p_tag == "normalPath")
+					normalPath = value;
+			});
+
+			read.textureName = textureName;
+			read.texturePath = texturePath;
+			read.normalName = normalName;
+			read.normalPath = normalPath;
+			p_material.emplace(std::move(read));
+		}
+
+		void ParseRigidBody(OgEngine::RigidBodyDescription& p_rigidBody)
+		{
+			ParseBlock("RigidBody", [this, &p_rigidBody](const std::string_view p_tag)
+			{
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "shapeSizeX")
+					p_rigidBody.shapeSize.x = ToFloat(value);
+				else if (p_tag == "shapeSizeY")
+					p_rigidBody.shapeSize.y = ToFloat(value);
+				else if (p_tag == "shapeSizeZ")
+					p_rigidBody.shapeSize.z = ToFloat(value);
+				else if (p_tag == "mass")
+					p_rigidBody.mass = ToFloat(value);
+				else if (p_tag == "type")
+					p_rigidBody.type = ToInt(value);
+				else if (p_tag == "gravity")
+					p_rigidBody.useGravity = ToInt(value) != 0;
+				else if (p_tag == "static")
+					p_rigidBody.isStatic = ToInt(value) != 0;
+			});
+		}
+
+		void ParseLightSource(OgEngine::LightSourceDescription& p_lightSource)
+		{
+			ParseBlock("LightSource", [this, &p_lightSource](const std::string_view p_tag)
+			{
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "color")
+					p_lightSource.color = ToVector(value, p_lightSource.color);
+				else if (p_tag == "direction")
+					p_lightSource.direction = ToVector(value, p_lightSource.direction);
+				else if (p_tag == "lightType")
+					p_lightSource.lightType = ToInt(value);
+			});
+		}
+
+		void ParsePrefab(std::string& p_prefab)
+		{
+			ParseBlock("Prefab", [this, &p_prefab](const std::string_view p_tag)
+			{
+				const std::string_view value = ReadValue(p_tag);
+				if (p_tag == "path")
+					p_prefab = value;
+			});
+
+			if (p_prefab.empty())
+				Error("<Prefab> without <path>");
+		}
+	};
 }
 
-float OgEngine::SceneLoader::StringToFloat(const std::string_view p_stringValue)
+OgEngine::SceneDescription OgEngine::SceneLoader::Parse(const std::string& p_file)
 {
-	float value;
-	try
-	{
-		value = std::stof(p_stringValue.data());
-	}
-	catch (const std::invalid_argument& p_exception)
+	// Mapped rather than read, the parser only works on views of the file and copying it took as long as parsing a third of it
+	const Utils::MappedFile file(p_file);
+	// An empty file is never mapped, it exists but isn't a scene
+	if (!file.IsOpen() && !std::ifstream(p_file).is_open())
 	{
-		throw std::runtime_error(p_exception.what());
+		throw std::runtime_error("couldn't open " + p_file);
 	}
-	catch (const std::out_of_range& p_exception)
+
+	SceneDescription scene = ParseFromMemory(std::string_view(reinterpret_cast<const char*>(file.Data()), file.Size()));
+
+	const Utils::MappedFile deltaFile(p_file + DELTA_EXTENSION);
+	if (deltaFile.IsOpen())
 	{
-		throw std::runtime_error(p_exception.what());
+		ApplyDelta(scene, std::string_view(reinterpret_cast<const char*>(deltaFile.Data()), deltaFile.Size()));
 	}
 
-	return value;
+	return scene;
+}
+
+OgEngine::SceneDescription OgEngine::SceneLoader::ParseFromMemory(const std::string_view p_content)
+{
+	return SceneParser(p_content).Parse();
 }
 
-int OgEngine::SceneLoader::StringToInt(const std::string_view p_stringValue)
+void OgEngine::SceneLoader::ApplyDelta(SceneDescription& p_scene, const std::string_view p_delta)
 {
-	int value;
 	try
 	{
-		value = std::stoi(p_stringValue.data());
-	}
-	catch (const std::invalid_argument& p_exception)
-	{
-		throw std::runtime_error(p_exception.what());
+		SceneParser(p_delta).ParseDelta(p_scene);
 	}
-	catch (const std::out_of_range& p_exception)
+	catch (const std::runtime_error& p_exception)
 	{
-		throw std::runtime_error(p_exception.what());
+		throw std::runtime_error(std::string("delta journal, ") + p_exception.what());
 	}
-
-	return value;
-}
-
-std::string OgEngine::SceneLoader::ExtractDataFromAttribute(const std::string& p_attributeLine)
-{
-	const size_t index = p_attributeLine.find_first_of('>') + 1u;
-	std::string data = p_attributeLine.substr(index);
-	std::istringstream valueStream(data);
-
-	std::getline(valueStream, data, '<'); // Went all the way to the key marker
-
-	return data;
 }
 
-bool OgEngine::SceneLoader::IsPair(const std::string& p_openingSymbol, const std::string& p_closingSymbol)
+OgEngine::WorldPartition OgEngine::SceneLoader::ParseManifest(const std::string_view p_content)
 {
-	return (p_openingSymbol == "<SceneNode>" && p_closingSymbol == "</SceneNode>")
-		|| (p_openingSymbol == "<Transform>" && p_closingSymbol == "</Transform>")
-		|| (p_openingSymbol == "<Model>" && p_closingSymbol == "</Model>")
-		|| (p_openingSymbol == "<Material>" && p_closingSymbol == "</Material>")
-		|| (p_openingSymbol == "<RigidBody>" && p_closingSymbol == "</RigidBody>")
-		|| (p_openingSymbol == "<LightSource>" && p_closingSymbol == "</LightSource>");
+	return SceneParser(p_content).ParseManifest();
 }
 
 bool OgEngine::SceneLoader::SceneFileIntegrityCheck(const std::string& p_file)
 {
-	std::ifstream file;
-	file.open(p_file, std::ios::in);
-	std::stack<std::string>  s;
-
-	if (file.is_open())
+	try
 	{
-		std::string line;
-		while (!file.eof())
-		{
-			std::getline(file, line);
-			
-			// Remove all useless indentation
-			const size_t indexBegin = line.find_first_of('<');
-			const size_t indexEnd = line.find_first_of('>') + 1u;
-			std::string data;
-			if (indexBegin != std::string::npos && indexEnd != std::string::npos)
-			{
-				data = line.substr(indexBegin, indexEnd - indexBegin);
-			}
-			else
-			{
-				data = line;
-			}
-
-			// If found in symbol lists, then we check if it's opening and closing correctly
-			if (std::find(symbolsList.begin(), symbolsList.end(), data) != symbolsList.end())
-			{
-				if (data == "<SceneNode>" || data == "<Transform>" || data == "<Model>" || data == "<Material>" || data == "<RigidBody>" || data == "<LightSource>")
-					s.push(data);
-				else if (data == "</SceneNode>" || data == "</Transform>" || data == "</Model>" || data == "</Material>" || data == "</RigidBody>" || data == "</LightSource>")
-				{
-					if (s.empty() || !IsPair(s.top(), data))
-						return false;
-					else
-						s.pop();
-				}
-			}
-		}
+		[[maybe_unused]] const SceneDescription scene = Parse(p_file);
 	}
-	else
+	catch (const std::exception&)
 	{
-		// File couldn't be read, therefore wrong file
 		return false;
 	}
 
-	return s.empty();
-}
\ No newline at end of file
+	return true;
+}
@@ -0,0 +1,390 @@
+#include <OgCore/SceneLoader/SceneSaver.h>
+#include <OgCore/SceneLoader/SceneLoader.h>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	void AppendIndent(std::string& p_out, const int p_depth)
+	{
+		p_out.append(static_cast<size_t>(p_depth), '\t');
+	}
+
+	void AppendFloat(std::string& p_out, const float p_value)
+	{
+		// Same output as std::to_string (printf "%f"), without the temporary strings
+		char buffer[64];
+		const auto result = std::to_chars(buffer, buffer + sizeof(buffer), p_value, std::chars_format::fixed, 6);
+		p_out.append(buffer, result.ptr);
+	}
+
+	template<typename Vector>
+	void AppendVector(std::string& p_out, const Vector& p_vector)
+	{
+		for (int i = 0; i < Vector::length(); ++i)
+		{
+			if (i != 0)
+				p_out += ';';
+			AppendFloat(p_out, p_vector[i]);
+		}
+	}
+
+	/**
+	 * @brief Append "<p_tag>value</p_tag>\n" at the given depth.
+	 */
+	template<typename Writer>
+	void AppendAttribute(std::string& p_out, const int p_depth, const std::string_view p_tag, Writer&& p_writeValue)
+	{
+		AppendIndent(p_out, p_depth);
+		p_out.append("<").append(p_tag).append(">");
+		p_writeValue();
+		p_out.append("</").append(p_tag).append(">\n");
+	}
+
+	void AppendText(std::string& p_out, const int p_depth, const std::string_view p_tag, const std::string_view p_value)
+	{
+		AppendAttribute(p_out, p_depth, p_tag, [&p_out, p_value] { p_out.append(p_value); });
+	}
+
+	void AppendInt(std::string& p_out, const int p_depth, const std::string_view p_tag, const int64_t p_value)
+	{
+		AppendAttribute(p_out, p_depth, p_tag, [&p_out, p_value] { p_out.append(std::to_string(p_value)); });
+	}
+
+	void AppendFloat(std::string& p_out, const int p_depth, const std::string_view p_tag, const float p_value)
+	{
+		AppendAttribute(p_out, p_depth, p_tag, [&p_out, p_value] { AppendFloat(p_out, p_value); });
+	}
+
+	template<typename Vector>
+	void AppendVector(std::string& p_out, const int p_depth, const std::string_view p_tag, const Vector& p_value)
+	{
+		AppendAttribute(p_out, p_depth, p_tag, [&p_out, &p_value] { AppendVector(p_out, p_value); });
+	}
+
+	void AppendMaterial(std::string& p_out, const int p_depth, const OgEngine::MaterialDescription& p_material)
+	{
+		AppendIndent(p_out, p_depth);
+		p_out.append("<Material>\n");
+		AppendVector(p_out, p_depth + 1, "color", p_material.color);
+		AppendVector(p_out, p_depth + 1, "specular", p_material.specular);
+		AppendVector(p_out, p_depth + 1, "emissive", p_material.emissive);
+		AppendFloat(p_out, p_depth + 1, "ior", p_material.ior);
+		AppendFloat(p_out, p_depth + 1, "roughness", p_material.roughness);
+		AppendInt(p_out, p_depth + 1, "type", p_material.type);
+		AppendText(p_out, p_depth + 1, "textureName", p_material.textureName);
+		AppendText(p_out, p_depth + 1, "texturePath", p_material.texturePath);
+		AppendText(p_out, p_depth + 1, "normalName", p_material.normalName);
+		AppendText(p_out, p_depth + 1, "normalPath", p_material.normalPath);
+		AppendIndent(p_out, p_depth);
+		p_out.append("</Material>\n");
+	}
+
+	/**
+	 * @brief Append the component blocks of a node, in the same order and format as the components Serialize.
+	 */
+	void AppendComponents(std::string& p_out, const int p_depth, const OgEngine::SceneNodeDescription& p_node)
+	{
+		const OgEngine::TransformDescription& transform = p_node.transform;
+		AppendIndent(p_out, p_depth);
+		p_out.append("<Transform>\n");
+		AppendText(p_out, p_depth + 1, "name", transform.name);
+		AppendVector(p_out, p_depth + 1, "position", transform.position);
+		AppendVector(p_out, p_depth + 1, "rotation", transform.rotation);
+		AppendVector(p_out, p_depth + 1, "scale", transform.scale);
+		AppendIndent(p_out, p_depth);
+		p_out.append("</Transform>\n");
+
+		if (p_node.prefab)
+		{
+			// An instance only stores its prefab, the content comes from the prefab file
+			AppendIndent(p_out, p_depth);
+			p_out.append("<Prefab>\n");
+			AppendText(p_out, p_depth + 1, "path", *p_node.prefab);
+			AppendIndent(p_out, p_depth);
+			p_out.append("</Prefab>\n");
+		}
+
+		if (p_node.model)
+		{
+			const OgEngine::ModelDescription& model = *p_node.model;
+			AppendIndent(p_out, p_depth);
+			p_out.append("<Model>\n");
+			AppendText(p_out, p_depth + 1, "parentMeshName", model.parentMeshName);
+			AppendText(p_out, p_depth + 1, "meshName", model.meshName);
+			AppendText(p_out, p_depth + 1, "meshFilepath", model.meshFilepath);
+			AppendInt(p_out, p_depth + 1, "subMesh", model.isSubMesh);
+			AppendInt(p_out, p_depth + 1, "indexSubMesh", model.subMeshIndex);
+			if (p_node.material)
+				AppendMaterial(p_out, p_depth + 1, *p_node.material);
+			AppendIndent(p_out, p_depth);
+			p_out.append("</Model>\n");
+		}
+
+		if (p_node.rigidBody)
+		{
+			const OgEngine::RigidBodyDescription& rigidBody = *p_node.rigidBody;
+			AppendIndent(p_out, p_depth);
+			p_out.append("<RigidBody>\n");
+			AppendFloat(p_out, p_depth + 1, "shapeSizeX", rigidBody.shapeSize.x);
+			AppendFloat(p_out, p_depth + 1, "shapeSizeY", rigidBody.shapeSize.y);
+			AppendFloat(p_out, p_depth + 1, "shapeSizeZ", rigidBody.shapeSize.z);
+			AppendFloat(p_out, p_depth + 1, "mass", rigidBody.mass);
+			AppendInt(p_out, p_depth + 1, "type", rigidBody.type);
+			AppendInt(p_out, p_depth + 1, "gravity", rigidBody.useGravity);
+			AppendInt(p_out, p_depth + 1, "static", rigidBody.isStatic);
+			AppendIndent(p_out, p_depth);
+			p_out.append("</RigidBody>\n");
+		}
+
+		if (p_node.lightSource)
+		{
+			const OgEngine::LightSourceDescription& lightSource = *p_node.lightSource;
+			AppendIndent(p_out, p_depth);
+			p_out.append("<LightSource>\n");
+			AppendVector(p_out, p_depth + 1, "color", lightSource.color);
+			AppendVector(p_out, p_depth + 1, "direction", lightSource.direction);
+			AppendInt(p_out, p_depth + 1, "lightType", lightSource.lightType);
+			AppendIndent(p_out, p_depth);
+			p_out.append("</LightSource>\n");
+		}
+	}
+
+	void WriteFile(const std::string& p_file, const std::string& p_content, const std::ios::openmode p_mode)
+	{
+		std::ofstream file(p_file, std::ios::out | std::ios::binary | p_mode);
+		if (!file.is_open())
+			throw std::runtime_error("couldn't open " + p_file);
+
+		file.write(p_content.data(), static_cast<std::streamsize>(p_content.size()));
+		file.close();
+		if (file.fail())
+			throw std::runtime_error("couldn't write " + p_file);
+	}
+}
+
+OgEngine::SceneSaver::SceneSaver()
+{
+	m_worker = std::thread(&SceneSaver::Work, this);
+}
+
+OgEngine::SceneSaver::~SceneSaver()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_wakeUp.notify_one();
+
+	// The queued save is still written before leaving
+	if (m_worker.joinable())
+		m_worker.join();
+}
+
+void OgEngine::SceneSaver::Save(const std::string& p_file, SceneDescription p_snapshot)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_request = SaveRequest{ p_file, std::move(p_snapshot) };
+	}
+	m_wakeUp.notify_one();
+}
+
+void OgEngine::SceneSaver::Track(const std::string& p_file, const SceneDescription& p_loaded, const std::vector<uint64_t>& p_sessionKeys)
+{
+	Wait();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_trackedFile = p_file;
+	m_savedNodes.clear();
+	m_savedNodes.reserve(p_loaded.nodes.size());
+	m_nextFileKey = 0u;
+
+	for (size_t i = 0u; i < p_loaded.nodes.size(); ++i)
+	{
+		const SceneNodeDescription& node = p_loaded.nodes[i];
+		const uint64_t parentKey = node.parent == SceneNodeDescription::NO_PARENT ? SceneNodeDescription::NO_PARENT : p_sessionKeys[node.parent];
+		m_savedNodes.emplace(p_sessionKeys[i], SavedNode{ node, parentKey, node.key });
+		m_nextFileKey = std::max(m_nextFileKey, node.key + 1u);
+	}
+
+	std::error_code error;
+	m_fileSize = std::filesystem::file_size(p_file, error);
+	if (error)
+		m_trackedFile.clear();
+
+	m_deltaSize = std::filesystem::file_size(p_file + SceneLoader::DELTA_EXTENSION, error);
+	if (error)
+		m_deltaSize = 0u;
+}
+
+void OgEngine::SceneSaver::Wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this] { return !m_request && !m_writing; });
+}
+
+bool OgEngine::SceneSaver::IsSaving() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_request || m_writing;
+}
+
+std::string OgEngine::SceneSaver::Serialize(const SceneDescription& p_scene)
+{
+	std::string content;
+	// Rough guess (a serialized node with a model takes about 1KB)
+	content.reserve(p_scene.nodes.size() * 1024u);
+
+	// Nodes are in depth-first order, the stack holds the nodes still open
+	std::vector<uint64_t> openNodes;
+	for (uint64_t i = 0u; i < p_scene.nodes.size(); ++i)
+	{
+		const SceneNodeDescription& node = p_scene.nodes[i];
+		while (!openNodes.empty() && openNodes.back() != node.parent)
+		{
+			openNodes.pop_back();
+			AppendIndent(content, static_cast<int>(openNodes.size()));
+			content.append("</SceneNode>\n");
+		}
+
+		AppendIndent(content, static_cast<int>(openNodes.size()));
+		content.append("<SceneNode>\n");
+		openNodes.emplace_back(i);
+		AppendComponents(content, static_cast<int>(openNodes.size()), node);
+	}
+
+	while (!openNodes.empty())
+	{
+		openNodes.pop_back();
+		AppendIndent(content, static_cast<int>(openNodes.size()));
+		content.append(openNodes.empty() ? "</SceneNode>" : "</SceneNode>\n");
+	}
+
+	return content;
+}
+
+void OgEngine::SceneSaver::Work()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_wakeUp.wait(lock, [this] { return m_quit || m_request; });
+		if (!m_request)
+			return;
+
+		const SaveRequest request = std::move(*m_request);
+		m_request.reset();
+		m_writing = true;
+		lock.unlock();
+
+		try
+		{
+			Write(request);
+		}
+		catch (const std::exception& p_exception)
+		{
+			std::cerr << "Couldn't save the scene " << request.file << ": " << p_exception.what() << '\n';
+			// The file state is unknown, the next save rewrites it entirely
+			m_trackedFile.clear();
+		}
+
+		lock.lock();
+		m_writing = false;
+		m_idle.notify_all();
+	}
+}
+
+void OgEngine::SceneSaver::Write(const SaveRequest& p_request)
+{
+	if (p_request.file != m_trackedFile || !std::filesystem::exists(p_request.file))
+	{
+		WriteFull(p_request);
+		return;
+	}
+
+	const std::string delta = SerializeDelta(p_request.snapshot);
+	if (delta.empty())
+		return;
+
+	if ((m_deltaSize + delta.size()) * COMPACTION_RATIO > m_fileSize)
+	{
+		WriteFull(p_request);
+		return;
+	}
+
+	WriteFile(p_request.file + SceneLoader::DELTA_EXTENSION, delta, std::ios::app);
+	m_deltaSize += delta.size();
+}
+
+void OgEngine::SceneSaver::WriteFull(const SaveRequest& p_request)
+{
+	const std::string content = Serialize(p_request.snapshot);
+
+	// Written aside then renamed, a crash while writing never leaves a truncated scene
+	const std::string temporaryFile = p_request.file + ".tmp";
+	WriteFile(temporaryFile, content, std::ios::trunc);
+	std::filesystem::rename(temporaryFile, p_request.file);
+	std::filesystem::remove(p_request.file + SceneLoader::DELTA_EXTENSION);
+
+	m_trackedFile = p_request.file;
+	m_savedNodes.clear();
+	m_savedNodes.reserve(p_request.snapshot.nodes.size());
+	for (uint64_t i = 0u; i < p_request.snapshot.nodes.size(); ++i)
+	{
+		const SceneNodeDescription& node = p_request.snapshot.nodes[i];
+		const uint64_t parentKey = node.parent == SceneNodeDescription::NO_PARENT ? SceneNodeDescription::NO_PARENT : p_request.snapshot.nodes[node.parent].key;
+		// In a base file, a node is identified by its depth-first index
+		m_savedNodes.emplace(node.key, SavedNode{ node, parentKey, i });
+	}
+	m_nextFileKey = p_request.snapshot.nodes.size();
+	m_fileSize = content.size();
+	m_deltaSize = 0u;
+}
+
+std::string OgEngine::SceneSaver::SerializeDelta(const SceneDescription& p_snapshot)
+{
+	std::string records;
+	std::unordered_map<uint64_t, SavedNode> savedNodes;
+	savedNodes.reserve(p_snapshot.nodes.size());
+
+	for (const SceneNodeDescription& node : p_snapshot.nodes)
+	{
+		const uint64_t parentKey = node.parent == SceneNodeDescription::NO_PARENT ? SceneNodeDescription::NO_PARENT : p_snapshot.nodes[node.parent].key;
+
+		const auto previous = m_savedNodes.find(node.key);
+		const bool isNew = previous == m_savedNodes.end();
+		const uint64_t fileKey = isNew ? m_nextFileKey++ : previous->second.fileKey;
+
+		if (isNew || previous->second.parentKey != parentKey || !HasSameComponents(previous->second.node, node))
+		{
+			records.append("<Delta>\n");
+			AppendInt(records, 1, "key", static_cast<int64_t>(fileKey));
+			// The parent was visited first (depth-first order), the root has no parent
+			if (parentKey != SceneNodeDescription::NO_PARENT)
+				AppendInt(records, 1, "parent", static_cast<int64_t>(savedNodes.at(parentKey).fileKey));
+			records.append("\t<SceneNode>\n");
+			AppendComponents(records, 2, node);
+			records.append("\t</SceneNode>\n</Delta>\n");
+		}
+
+		savedNodes.emplace(node.key, SavedNode{ node, parentKey, fileKey });
+	}
+
+	for (const auto& [key, saved] : m_savedNodes)
+	{
+		if (savedNodes.find(key) == savedNodes.end())
+		{
+			records.append("<Remove>\n");
+			AppendInt(records, 1, "key", static_cast<int64_t>(saved.fileKey));
+			records.append("</Remove>\n");
+		}
+	}
+
+	m_savedNodes = std::move(savedNodes);
+	return records;
+}
@@ -0,0 +1,121 @@
+#include <OgCore/SceneLoader/WorldPartition.h>
+#include <OgCore/SceneLoader/SceneLoader.h>
+#include <OgCore/SceneLoader/SceneSaver.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+OgEngine::CellCoordinates OgEngine::WorldPartition::CellOf(const glm::vec3& p_position) const
+{
+	return { static_cast<int32_t>(std::floor(p_position.x / cellSize)), static_cast<int32_t>(std::floor(p_position.z / cellSize)) };
+}
+
+float OgEngine::WorldPartition::DistanceTo(const glm::vec3& p_position, const CellCoordinates& p_cell) const
+{
+	const float minX = static_cast<float>(p_cell.x) * cellSize;
+	const float minZ = static_cast<float>(p_cell.z) * cellSize;
+	const float dx = std::max({ minX - p_position.x, 0.0f, p_position.x - (minX + cellSize) });
+	const float dz = std::max({ minZ - p_position.z, 0.0f, p_position.z - (minZ + cellSize) });
+
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+OgEngine::SceneDescription OgEngine::WorldPartition::Bake(const SceneDescription& p_scene, const float p_cellSize, const std::string& p_directory)
+{
+	WorldPartition partition;
+	partition.cellSize = p_cellSize;
+
+	SceneDescription persistent;
+	if (p_scene.nodes.empty())
+		return persistent;
+
+	// A child of the root and everything under it stay together, streamed only if they hold something to display
+	const size_t nodeCount = p_scene.nodes.size();
+	std::vector<size_t> topLevel(nodeCount, 0u);
+	std::vector<bool> isStreamed(nodeCount, false);
+	for (size_t i = 1u; i < nodeCount; ++i)
+	{
+		const SceneNodeDescription& node = p_scene.nodes[i];
+		topLevel[i] = node.parent == 0u ? i : topLevel[node.parent];
+		if (node.model || node.prefab)
+			isStreamed[topLevel[i]] = true;
+	}
+
+	persistent.nodes.emplace_back(p_scene.nodes.front());
+
+	std::unordered_map<CellCoordinates, SceneDescription, CellCoordinatesHash> cells;
+	std::vector<uint64_t> newIndex(nodeCount, 0u);
+	for (size_t i = 1u; i < nodeCount; ++i)
+	{
+		const SceneNodeDescription& node = p_scene.nodes[i];
+		SceneDescription* target = &persistent;
+		if (isStreamed[topLevel[i]])
+		{
+			const CellCoordinates cell = partition.CellOf(p_scene.nodes[topLevel[i]].transform.position);
+			target = &cells[cell];
+			if (target->nodes.empty())
+			{
+				// Each cell has its own root, under which the cell is attached to the scene when streamed in
+				target->nodes.emplace_back().transform.name = "Cell " + std::to_string(cell.x) + ";" + std::to_string(cell.z);
+			}
+		}
+
+		newIndex[i] = target->nodes.size();
+		SceneNodeDescription& copy = target->nodes.emplace_back(node);
+		copy.parent = node.parent == 0u ? 0u : newIndex[node.parent];
+	}
+
+	std::filesystem::remove_all(p_directory);
+	std::filesystem::create_directories(p_directory);
+
+	std::string manifest = "<WorldPartition>\n\t<cellSize>" + std::to_string(p_cellSize) + "</cellSize>\n";
+	for (const auto& [coordinates, content] : cells)
+	{
+		const std::string cellContent = SceneSaver::Serialize(content);
+		std::ofstream file(CellFile(p_directory, coordinates), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+			throw std::runtime_error("couldn't write " + CellFile(p_directory, coordinates));
+		file.write(cellContent.data(), static_cast<std::streamsize>(cellContent.size()));
+		file.close();
+
+		manifest += "\t<Cell>\n\t\t<x>" + std::to_string(coordinates.x) + "</x>\n\t\t<z>" + std::to_string(coordinates.z) + "</z>\n"
+			"\t\t<nodes>" + std::to_string(content.nodes.size()) + "</nodes>\n\t\t<bytes>" + std::to_string(cellContent.size()) + "</bytes>\n\t</Cell>\n";
+	}
+	manifest += "</WorldPartition>";
+
+	std::ofstream file(p_directory + "/" + MANIFEST, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		throw std::runtime_error("couldn't write the manifest of " + p_directory);
+	file << manifest;
+	file.close();
+
+	return persistent;
+}
+
+OgEngine::WorldPartition OgEngine::WorldPartition::Open(const std::string& p_directory)
+{
+	std::ifstream file(p_directory + "/" + MANIFEST, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+		throw std::runtime_error("couldn't open the manifest of " + p_directory);
+
+	std::string buffer;
+	buffer.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios::beg);
+	file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	file.close();
+
+	return SceneLoader::ParseManifest(buffer);
+}
+
+std::string OgEngine::WorldPartition::DirectoryOf(const std::string& p_sceneFile)
+{
+	return p_sceneFile + ".cells";
+}
+
+std::string OgEngine::WorldPartition::CellFile(const std::string& p_directory, const CellCoordinates& p_cell)
+{
+	return p_directory + "/cell_" + std::to_string(p_cell.x) + "_" + std::to_string(p_cell.z) + ".omega";
+}
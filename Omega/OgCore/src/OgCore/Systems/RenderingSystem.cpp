@@ -2,6 +2,11 @@
 #include <OgCore/Components/Transform.h>
 #include <OgCore/Managers/SceneManager.h>
 #include <OgRendering/Rendering/VulkanContext.h>
+#include <OgRendering/Managers/ResourceManager.h>
+#include <OgRendering/Resource/Camera.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 void OgEngine::RenderingSystem::Init()
 {
@@ -44,3 +49,72 @@ void OgEngine::RenderingSystem::Update(const float p_dt, const VulkanContext* p_
 		}
 	}
 }
+
+void OgEngine::RenderingSystem::ReplaceMesh(const ReloadedResource<Mesh>& p_reloaded, const VulkanContext* p_context)
+{
+	if (!p_reloaded.current)
+		return;
+
+	for (const auto& entity : m_entities)
+	{
+		auto& model = SceneManager::GetComponent<ModelRS>(entity);
+		if (model.ParentMeshName() != p_reloaded.name)
+			continue;
+
+		// The previous version is kept alive by the reference of the model until it is given the new one
+		Mesh* mesh = p_reloaded.current.get();
+		const Mesh* previous = model.GetMesh();
+		if (previous && previous->IsSubMesh())
+		{
+			auto& subMeshes = p_reloaded.current->SubMeshes();
+			const auto index = static_cast<size_t>(previous->SubMeshIndex());
+			// A submesh removed from the file is replaced by the whole mesh
+			if (index < subMeshes.size())
+				mesh = subMeshes[index].get();
+		}
+
+		if (p_context->IsRaytracing())
+			p_context->GetRTPipeline()->DestroyObject(entity);
+		else
+			p_context->GetRSPipeline()->DestroyObject(entity);
+
+		model.SetMesh(mesh);
+	}
+}
+
+void OgEngine::RenderingSystem::ReplaceTexture(const std::string& p_name)
+{
+	for (const auto& entity : m_entities)
+	{
+		Material& material = SceneManager::GetComponent<ModelRS>(entity).Material();
+		if (material.texName == p_name)
+			material.SetTextureID(material.texName, material.texPath);
+		if (material.normName == p_name)
+			material.SetNormalMapID(material.normName, material.normPath);
+	}
+}
+
+void OgEngine::RenderingSystem::ReportTextureUsage(const Camera& p_camera, const float p_viewportHeight) const
+{
+	// Pixels covered by a unit of length seen from a unit of distance
+	const float pixelsPerUnit = p_camera.matrices.perspective[1][1] * p_viewportHeight * 0.5f;
+
+	for (const auto& entity : m_entities)
+	{
+		const auto& model = SceneManager::GetComponent<ModelRS>(entity);
+		const Mesh* mesh = model.GetMesh();
+		if (!mesh || mesh->LocalSphere().Empty())
+			continue;
+
+		// The texture is taken as covering the model once, it is drawn as large as the sphere around the model
+		const auto& transform = SceneManager::GetComponent<Transform>(entity);
+		const float radius = mesh->LocalSphere().radius
+			* std::max({ std::abs(transform.scale.x), std::abs(transform.scale.y), std::abs(transform.scale.z) });
+		const float distance = glm::length(p_camera.position - transform.position) - radius;
+		const float screenSize = distance > 0.0f ? 2.0f * radius * pixelsPerUnit / distance : std::numeric_limits<float>::max();
+
+		const auto& material = model.Material();
+		ResourceManager::ReportTextureUsage(material.texName, screenSize);
+		ResourceManager::ReportTextureUsage(material.normName, screenSize);
+	}
+}
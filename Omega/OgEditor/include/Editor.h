@@ -72,8 +72,15 @@ namespace OgEngine
 		char m_addTextureInput[128]{ "" };
 		bool showAllFiles;
 		bool worldRotation;
+		/** @brief  Ratio of models attached in the scene being loaded. */
+		float m_sceneLoadingProgress{ 1.0f };
+		/** @brief  The file dialog is choosing the scene file of a world partition bake. */
+		bool m_bakingPartition{ false };
+		static constexpr float WORLD_PARTITION_CELL_SIZE = 64.0f;
 
 		[[nodiscard]] std::string TrimName(std::string p_name) const;
 		[[nodiscard]] bool HasSpecialChar(const std::string& p_stringToCheck) const;
+		/** @brief  Name of the prefab file saved from a node: its name up to the first NUL, without the characters forbidden in a file name. */
+		[[nodiscard]] static std::string PrefabFileName(const std::string& p_nodeName);
 	};
 }
@@ -24,6 +24,13 @@ OgEngine::Editor::Editor(const uint64_t p_width, const uint64_t p_height, const
 	: currentRotationEntity(UINT64_MAX), worldRotation(true)
 {
 	memset(currentEulers, 0.0f, sizeof(currentEulers));
+	// A build ships its resources in the archive written by omega-cook. With the files of the resources at hand they are
+	// edited and watched instead: the archive would keep giving the packed copies and hide the changes
+	const bool watchResources = std::filesystem::is_directory("Resources");
+	if (!watchResources)
+		OgEngine::ResourceManager::MountPack();
+	// Written by omega-cook, the sources it cooked are found in the cache without being hashed
+	OgEngine::ResourceManager::LoadManifest();
 	OgEngine::ResourceManager::Add<OgEngine::Mesh>("Resources/models/cube.obj");
 	m_modelNames.emplace_back("cube.obj");
 	OgEngine::ResourceManager::Add<OgEngine::Mesh>("Resources/models/sphere.obj");
@@ -36,10 +43,18 @@ OgEngine::Editor::Editor(const uint64_t p_width, const uint64_t p_height, const
 	OgEngine::ResourceManager::WaitForAll();
 
 	m_engine = std::make_unique<OgEngine::Core>(p_width, p_height, p_title);
+	m_engine->onSceneLoadingProgress = [this](const uint64_t p_loaded, const uint64_t p_total)
+	{
+		m_sceneLoadingProgress = static_cast<float>(p_loaded) / static_cast<float>(p_total);
+	};
 	m_path = std::filesystem::current_path();
 	PrepareIcons();
 	fileDialog.SetTitle("Save scene");
 	fileDialog.SetTypeFilters({ ".omega" });
+
+	// The meshes, textures and shaders edited while the editor runs are reloaded
+	if (watchResources)
+		OgEngine::ResourceManager::WatchResources("Resources");
 }
 
 OgEngine::Editor::~Editor()
@@ -71,16 +86,25 @@ void OgEngine::Editor::UpdateEditor(float p_dt)
 
 			if (ImGui::MenuItem("Save Scene", "Ctrl+S"))
 			{
+				m_bakingPartition = false;
 				fileDialog.SetTitle("Save scene");
 				fileDialog.EnableSaveMode(true);
 				fileDialog.Open();
 			}
 			if (ImGui::MenuItem("Load Scene", nullptr, false, SceneManager::CurrentScene() == Scene::EDITOR_SCENE))
 			{
+				m_bakingPartition = false;
 				fileDialog.SetTitle("Load scene");
 				fileDialog.EnableSaveMode(false);
 				fileDialog.Open();
 			}
+			if (ImGui::MenuItem("Bake World Partition", nullptr, false, SceneManager::CurrentScene() == Scene::EDITOR_SCENE))
+			{
+				m_bakingPartition = true;
+				fileDialog.SetTitle("Bake world partition");
+				fileDialog.EnableSaveMode(true);
+				fileDialog.Open();
+			}
 
 			ImGui::EndMenu();
 		}
@@ -192,17 +216,31 @@ void OgEngine::Editor::UpdateEditor(float p_dt)
 	{
 		ImGui::Text(fileDialog.GetSelected().string().c_str());
 		std::cout << "Selected filename" << fileDialog.GetSelected().string() << std::endl;
-		if (fileDialog.SavingMode())
+		if (m_bakingPartition)
+		{
+			m_sceneLoadingProgress = 0.0f;
+			m_engine->BakeWorldPartition(fileDialog.GetSelected().string(), WORLD_PARTITION_CELL_SIZE);
+			m_bakingPartition = false;
+		}
+		else if (fileDialog.SavingMode())
 		{
 			m_engine->SaveScene(fileDialog.GetSelected().string());
 		}
 		else
 		{
-			m_engine->LoadScene(fileDialog.GetSelected().string());
+			m_sceneLoadingProgress = 0.0f;
+			m_engine->LoadScene(fileDialog.GetSelected().string(), true);
 		}
 		fileDialog.ClearSelected();
 	}
 	fileDialog.Display();
+
+	if (m_engine->IsSceneLoading())
+	{
+		ImGui::Begin("Loading scene");
+		ImGui::ProgressBar(m_sceneLoadingProgress);
+		ImGui::End();
+	}
 	RenderUI();
 }
 bool OgEngine::Editor::LoopOnChild(OgEngine::SceneNode* p_node)
@@ -232,6 +270,20 @@ bool OgEngine::Editor::LoopOnChild(OgEngine::SceneNode* p_node)
 				DestroyObject(p_node);
 			}
 
+			if (ImGui::Button("Save as Prefab"))
+			{
+				const std::string fileName = PrefabFileName(m_engine->GetComponent<Transform>(p_node->GetEntity()).name);
+				if (fileName.empty())
+				{
+					std::cerr << "A prefab needs a node with a name to be saved.\n";
+				}
+				else
+				{
+					std::filesystem::create_directories("Resources/prefabs");
+					m_engine->SavePrefab(p_node, "Resources/prefabs/" + fileName + ".omega");
+				}
+			}
+
 			if (ImGui::BeginMenu("Add Component"))
 			{
 				if (ImGui::BeginMenu("RigidBody"))
@@ -353,6 +405,18 @@ void OgEngine::Editor::OpenAddMenu(SceneNode* p_node)
 				}
 			}
 		}
+
+		if (std::filesystem::is_directory("Resources/prefabs") && ImGui::BeginMenu("Prefab"))
+		{
+			for (const auto& prefab : std::filesystem::directory_iterator("Resources/prefabs"))
+			{
+				if (prefab.path().extension() == ".omega" && ImGui::MenuItem(prefab.path().stem().string().c_str()))
+				{
+					m_engine->InstantiatePrefab("Resources/prefabs/" + prefab.path().filename().string(), p_node);
+				}
+			}
+			ImGui::EndMenu();
+		}
 		ImGui::EndMenu();
 	}
 }
@@ -993,6 +1057,18 @@ std::string OgEngine::Editor::TrimName(std::string p_name) const
 	return p_name;
 }
 
+std::string OgEngine::Editor::PrefabFileName(const std::string& p_nodeName)
+{
+	// The names edited in the inspector are padded with NULs up to the size of the input
+	std::string fileName = p_nodeName.c_str();
+	fileName.erase(std::remove_if(fileName.begin(), fileName.end(), [](const char p_character)
+		{
+			return std::strchr("/\\:*?\"<>|", p_character) != nullptr;
+		}), fileName.end());
+
+	return fileName;
+}
+
 bool OgEngine::Editor::HasSpecialChar(const std::string& p_stringToCheck) const
 {
 	return std::find_if(p_stringToCheck.begin(), p_stringToCheck.end(),
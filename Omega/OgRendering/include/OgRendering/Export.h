@@ -1,7 +1,12 @@
 #pragma once
+#ifdef _WIN32
 #pragma warning (disable:4251)
+#endif
 
-#ifdef RENDERING_EXPORT
+// RENDERING_STATIC: the sources are compiled in the program using them, like the cook tool does
+#if defined(RENDERING_STATIC) || !defined(_WIN32)
+#define RENDERING_API
+#elif defined(RENDERING_EXPORT)
 #define RENDERING_API __declspec(dllexport)
 #else
 #define RENDERING_API __declspec(dllimport)
@@ -0,0 +1,20 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <assimp/IOSystem.hpp>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Files of Assimp read through the VirtualFileSystem, a packed model finds its materials and buffers in the archive too.
+	 * Read-only, the importers never write.
+	 */
+	class RENDERING_API AssimpIOSystem final : public Assimp::IOSystem
+	{
+	public:
+		bool Exists(const char* p_file) const override;
+		char getOsSeparator() const override;
+		Assimp::IOStream* Open(const char* p_file, const char* p_mode = "rb") override;
+		void Close(Assimp::IOStream* p_file) override;
+	};
+}
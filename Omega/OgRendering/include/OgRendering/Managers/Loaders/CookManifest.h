@@ -0,0 +1,103 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace OgEngine
+{
+	enum class ASSET_KIND : uint8_t
+	{
+		NONE,
+		MESH,
+		TEXTURE,
+		SCENE
+	};
+
+	/**
+	 * @brief Source file cooked by omega-cook.
+	 */
+	struct CookedAsset
+	{
+		std::string source;
+		ASSET_KIND kind{ ASSET_KIND::NONE };
+		uint64_t sourceHash{ 0u };
+		/**
+		 * @brief Size and modification time of the source when it was hashed, a source they still match isn't hashed again.
+		 */
+		uint64_t sourceSize{ 0u };
+		int64_t sourceWriteTime{ 0 };
+		/**
+		 * @brief The cooked file, empty for a scene which is read as is.
+		 */
+		std::string cooked;
+		/**
+		 * @brief Version and settings of the cook that wrote the cooked file, the source is cooked again when they change.
+		 */
+		uint64_t cookVersion{ 0u };
+		/**
+		 * @brief Sources used by this one (the meshes, textures and prefabs of a scene).
+		 */
+		std::vector<std::string> dependencies;
+	};
+
+	/**
+	 * @brief List of the cooked assets (.ogcook), written by omega-cook and read back by the next cook to only cook the sources that changed.
+	 * The engine loads it to find the cooked file of a source without reading the whole source to hash it.
+	 *
+	 * Text file: a header line, then one tab-separated line per asset ("A", kind, hash, size, write time, cook version, source, cooked file)
+	 * followed by one line per dependency ("D", source).
+	 */
+	class RENDERING_API CookManifest final
+	{
+	public:
+		inline static const std::string DEFAULT_FILE = "Resources/cache/manifest.ogcook";
+		/**
+		 * @brief Increased when the layout changes, a manifest of another version is ignored and everything is cooked again.
+		 */
+		static constexpr uint32_t VERSION = 1u;
+
+		/**
+		 * @brief Tell what a file holds from its extension.
+		 * @return ASSET_KIND::NONE for a file that isn't cooked
+		 */
+		[[nodiscard]] static ASSET_KIND KindOf(std::string_view p_file);
+
+		/**
+		 * @brief Read a manifest, packed or on the disk, the assets already known are replaced.
+		 * @return False if the file is missing, of another version or badly structured, the manifest is then left empty
+		 */
+		bool Load(const std::string& p_file);
+
+		/**
+		 * @brief Write the manifest, through a temporary file so a cook interrupted never leaves half a manifest.
+		 * @return False if the file couldn't be written
+		 */
+		bool Save(const std::string& p_file) const;
+
+		[[nodiscard]] const CookedAsset* Find(std::string_view p_source) const;
+		void Set(CookedAsset p_asset);
+		void Remove(std::string_view p_source);
+
+		/**
+		 * @brief Return the hash recorded for a source if the file on disk still has the size and modification time it had when hashed.
+		 */
+		[[nodiscard]] std::optional<uint64_t> TrustedHash(std::string_view p_source) const;
+
+		[[nodiscard]] const std::unordered_map<std::string, CookedAsset>& Assets() const;
+		[[nodiscard]] bool Empty() const;
+
+		/**
+		 * @brief Read the size and the modification time of a file.
+		 * @return False if the file doesn't exist
+		 */
+		static bool Stamp(const std::string& p_file, uint64_t& p_size, int64_t& p_writeTime);
+
+	private:
+		std::unordered_map<std::string, CookedAsset> m_assets;
+	};
+}
@@ -1,7 +1,13 @@
 #pragma once
 #include <OgRendering/Export.h>
+#include <algorithm>
 #include <string_view>
 #include <OgRendering/Resource/Mesh.h>
+#include <OgRendering/Managers/Loaders/MeshCache.h>
+#include <OgRendering/Utils/JobSystem.h>
+#include <OgRendering/Utils/MeshletBuilder.h>
+#include <OgRendering/Utils/MeshOptimizer.h>
+#include <OgRendering/Utils/MeshSimplifier.h>
 #include <OgRendering/Utils/TemplateTypename.h>
 
 #include <assimp/Importer.hpp>
@@ -10,19 +16,38 @@
 
 namespace OgEngine
 {
+	/**
+	 * @brief What the import of a mesh did to its triangle lists, filled only when the source is imported rather than read cooked.
+	 */
+	struct MeshImportStatistics
+	{
+		Utils::CacheStatistics before;
+		Utils::CacheStatistics after;
+		size_t triangles{ 0u };
+		size_t meshlets{ 0u };
+	};
+
 	class RENDERING_API LoaderManager
 	{
 	public:
 		template<typename ResourceType>
 		static inline std::shared_ptr<ResourceType> Load(std::string_view p_file);
 
+		/**
+		 * @brief Load a mesh whose source was already hashed, from its cooked file or by importing and cooking the source.
+		 * @param p_sourceHash Hash of the source file given by MeshCache::HashFile
+		 * @param p_statistics Receives the vertex cache statistics of the import, if the source is imported
+		 */
+		static inline std::shared_ptr<Mesh> LoadMesh(std::string_view p_file, const uint64_t p_sourceHash,
+			MeshImportStatistics* p_statistics = nullptr);
+
 		static inline bool CheckValidMesh(const std::string_view p_file);
 
 	private:
 		LoaderManager() = default;
 		
 		template<typename ResourceType>
-		static inline std::shared_ptr<ResourceType> AssimpLoad(const std::string_view p_file);
+		static inline std::shared_ptr<ResourceType> AssimpLoad(const std::string_view p_file, MeshImportStatistics* p_statistics = nullptr);
 
 		template<typename ResourceType>
 		static inline std::shared_ptr<ResourceType> GltfLoad(const std::string_view p_file);
@@ -1,6 +1,7 @@
 #pragma once
 #include <OgRendering/Resource/Mesh.h>
 #include <OgRendering/Managers/ResourceManager.h>
+#include <OgRendering/Managers/Loaders/AssimpIOSystem.h>
 
 template <typename ResourceType>
 inline std::shared_ptr<ResourceType> OgEngine::LoaderManager::Load(std::string_view p_file)
@@ -11,6 +12,13 @@ inline std::shared_ptr<ResourceType> OgEngine::LoaderManager::Load(std::string_v
 
 template <>
 inline std::shared_ptr<OgEngine::Mesh> OgEngine::LoaderManager::Load<OgEngine::Mesh>(std::string_view p_file)
+{
+	// The import is only done once per version of the source file, the next loads read the cooked mesh
+	return LoadMesh(p_file, MeshCache::HashFile(p_file));
+}
+
+inline std::shared_ptr<OgEngine::Mesh> OgEngine::LoaderManager::LoadMesh(std::string_view p_file, const uint64_t p_sourceHash,
+	MeshImportStatistics* p_statistics)
 {
 	const auto index = p_file.find_last_of(".");
 	if (index == std::string::npos)
@@ -19,22 +27,39 @@ inline std::shared_ptr<OgEngine::Mesh> OgEngine::LoaderManager::Load<OgEngine::M
 		return nullptr;
 	}
 
+	if (std::shared_ptr<Mesh> cookedMesh = MeshCache::Read(p_sourceHash))
+	{
+		return cookedMesh;
+	}
+
+	std::shared_ptr<Mesh> mesh;
 	const std::string_view extension = p_file.data() + index;
 	if (extension == "gltf")
 	{
-		return AssimpLoad<OgEngine::Mesh>(p_file);
+		mesh = AssimpLoad<OgEngine::Mesh>(p_file, p_statistics);
+	}
+	else
+	{
+		// Assimp by default
+		mesh = AssimpLoad<OgEngine::Mesh>(p_file, p_statistics);
 	}
 
-	// Assimp by default
-	return AssimpLoad<OgEngine::Mesh>(p_file);
+	if (mesh)
+	{
+		MeshCache::Write(p_sourceHash, mesh);
+	}
 
+	return mesh;
 }
 
 template<typename ResourceType>
-inline std::shared_ptr<ResourceType> OgEngine::LoaderManager::AssimpLoad(const std::string_view p_file)
+inline std::shared_ptr<ResourceType> OgEngine::LoaderManager::AssimpLoad(const std::string_view p_file, MeshImportStatistics* p_statistics)
 {
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(p_file.data(), aiProcessPreset_TargetRealtime_Quality & ~aiProcess_SplitLargeMeshes);
+	// Read from the pack archives, or from the disk when the model isn't packed
+	importer.SetIOHandler(new AssimpIOSystem());
+	// The cache locality of Assimp is replaced by Utils::MeshOptimizer below
+	const aiScene* scene = importer.ReadFile(p_file.data(), aiProcessPreset_TargetRealtime_Quality & ~aiProcess_SplitLargeMeshes & ~aiProcess_ImproveCacheLocality);
 
 	if (!scene)
 	{
@@ -42,70 +67,133 @@ inline std::shared_ptr<ResourceType> OgEngine::LoaderManager::AssimpLoad(const s
 		return nullptr;
 	}
 
-	std::vector<Vertex> vertices;
-	std::vector<uint32_t> indices;
-	std::shared_ptr<Mesh> mainMesh = nullptr;
-
-	for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+	// Read, optimized, split in meshlets and simplified in parallel, the scene is only read once imported
+	struct ImportedMesh
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MeshletData meshlets;
+		std::vector<MeshLod> lods;
+		BoundingBox box;
+		BoundingSphere sphere;
+		std::string name;
+		bool isTriangleList{ false };
+		// Transformed vertices before and after the optimization
+		float missesBefore{ 0.0f }, missesAfter{ 0.0f };
+	};
+	std::vector<ImportedMesh> importedMeshes(scene->mNumMeshes);
+
+	// The loading job takes part, the meshes of a big scene are processed by every worker
+	Utils::JobSystem::Instance().ParallelFor(0u, importedMeshes.size(), [scene, &importedMeshes](const uint64_t p_index)
 	{
-		aiMesh* mesh = scene->mMeshes[i];
+		const aiMesh* source = scene->mMeshes[p_index];
+		ImportedMesh& mesh = importedMeshes[p_index];
 
-		for (unsigned int j = 0; j < mesh->mNumVertices; ++j)
-		{
-			Vertex vertex = {};
+		// The buffers are allocated once at their final size and written in place, then moved up to the loaded mesh
+		size_t indexCount = 0u;
+		for (unsigned int j = 0; j < source->mNumFaces; ++j)
+			indexCount += source->mFaces[j].mNumIndices;
+
+		mesh.vertices.resize(source->mNumVertices);
+		mesh.indices.resize(indexCount);
 
-			if (mesh->HasPositions())
-				vertex.position = { mesh->mVertices[j].x, mesh->mVertices[j].y, mesh->mVertices[j].z };
+		const bool hasPositions = source->HasPositions(), hasNormals = source->HasNormals();
+		const bool hasTexCoords = source->HasTextureCoords(0), hasTangents = source->HasTangentsAndBitangents();
+		Vertex* vertex = mesh.vertices.data();
+		for (unsigned int j = 0; j < source->mNumVertices; ++j, ++vertex)
+		{
+			if (hasPositions)
+				vertex->position = { source->mVertices[j].x, source->mVertices[j].y, source->mVertices[j].z };
 			else
-				vertex.position = { 0.0f, 0.0f, 0.0f };
+				vertex->position = { 0.0f, 0.0f, 0.0f };
 
-			if (mesh->HasNormals())
-				vertex.normal = { mesh->mNormals[j].x, mesh->mNormals[j].y, mesh->mNormals[j].z };
+			if (hasNormals)
+				vertex->normal = { source->mNormals[j].x, source->mNormals[j].y, source->mNormals[j].z };
 			else
-				vertex.normal = { 1.0f, 1.0f, 1.0f };
+				vertex->normal = { 1.0f, 1.0f, 1.0f };
 
-			if (mesh->HasTextureCoords(0))
+			if (hasTexCoords)
 			{
-				const aiVector3D uv = mesh->mTextureCoords[0][j];
+				const aiVector3D uv = source->mTextureCoords[0][j];
 
-				vertex.texCoord = { uv.x, uv.y };
+				vertex->texCoord = { uv.x, uv.y };
 			}
 			else
-				vertex.texCoord = { 1.0f, 1.0 };
+				vertex->texCoord = { 1.0f, 1.0 };
 
-			if (mesh->HasTangentsAndBitangents())
+			if (hasTangents)
 			{
-				vertex.tangent = { mesh->mTangents[j].x, mesh->mTangents[j].y, mesh->mTangents[j].z };
+				vertex->tangent = { source->mTangents[j].x, source->mTangents[j].y, source->mTangents[j].z };
 			}
 			else
 			{
-				vertex.tangent = { 1.0f, 1.0f, 1.0f };
+				vertex->tangent = { 1.0f, 1.0f, 1.0f };
 			}
-
-			vertices.emplace_back(vertex);
 		}
 
-		for (unsigned int j = 0; j < mesh->mNumFaces; ++j)
+		uint32_t* index = mesh.indices.data();
+		for (unsigned int j = 0; j < source->mNumFaces; ++j)
 		{
-			for (unsigned int k = 0; k < mesh->mFaces[j].mNumIndices; ++k)
-			{
-				indices.emplace_back(mesh->mFaces[j].mIndices[k]);
-			}
+			const aiFace& face = source->mFaces[j];
+			index = std::copy(face.mIndices, face.mIndices + face.mNumIndices, index);
 		}
 
-		if (mainMesh == nullptr)
+		mesh.name = source->mName.C_Str();
+		mesh.isTriangleList = source->mPrimitiveTypes == aiPrimitiveType_TRIANGLE;
+
+		// Only the triangle lists are reordered, the points and lines keep their order
+		if (mesh.isTriangleList)
 		{
-			mainMesh = std::make_shared<Mesh>(vertices, indices);
-			mainMesh->SetMeshName(mesh->mName.C_Str());
+			const auto triangles = static_cast<float>(mesh.indices.size() / 3u);
+			mesh.missesBefore = Utils::MeshOptimizer::Analyze(mesh.indices, mesh.vertices.size()).acmr * triangles;
+			Utils::MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+			// Stores the triangles meshlet after meshlet, the cache order is kept within the meshlets
+			mesh.meshlets = Utils::MeshletBuilder::Build(mesh.vertices, mesh.indices);
+			mesh.missesAfter = Utils::MeshOptimizer::Analyze(mesh.indices, mesh.vertices.size()).acmr * triangles;
+			// The levels index the final vertices, they are built last
+			mesh.lods = Utils::MeshSimplifier::BuildLods(mesh.vertices, mesh.indices);
 		}
-		else
+
+		// Once the vertices no triangle uses are removed
+		mesh.box = BoundingBox::FromVertices(mesh.vertices);
+		mesh.sphere = BoundingSphere::FromVertices(mesh.vertices, mesh.box);
+	}, 1u);
+
+	std::shared_ptr<Mesh> mainMesh = nullptr;
+	float missesBefore = 0.0f, missesAfter = 0.0f;
+	size_t optimizedTriangles = 0u, optimizedVertices = 0u, meshletCount = 0u;
+
+	for (ImportedMesh& importedMesh : importedMeshes)
+	{
+		if (importedMesh.isTriangleList)
 		{
-			mainMesh->AddSubMesh(std::make_shared<Mesh>(vertices, indices));
-			mainMesh->SubMeshes().back()->SetMeshName(mesh->mName.C_Str());
+			missesBefore += importedMesh.missesBefore;
+			missesAfter += importedMesh.missesAfter;
+			optimizedTriangles += importedMesh.indices.size() / 3u;
+			// The vertices no triangle uses were removed by the optimization
+			optimizedVertices += importedMesh.vertices.size();
+			meshletCount += importedMesh.meshlets.meshlets.size();
 		}
 
-		vertices.clear();
-		indices.clear();
+		auto mesh = std::make_shared<Mesh>(std::move(importedMesh.vertices), std::move(importedMesh.indices));
+		mesh->SetMeshName(importedMesh.name);
+		mesh->SetMeshlets(std::move(importedMesh.meshlets));
+		mesh->SetLods(std::move(importedMesh.lods));
+		mesh->SetBounds(importedMesh.box, importedMesh.sphere);
+
+		if (mainMesh == nullptr)
+			mainMesh = std::move(mesh);
+		else
+			mainMesh->AddSubMesh(mesh);
+	}
+
+	// Printed by the cook tool when asked, the loads of the engine stay quiet
+	if (p_statistics && optimizedTriangles > 0u && optimizedVertices > 0u)
+	{
+		p_statistics->before = { missesBefore / static_cast<float>(optimizedTriangles), missesBefore / static_cast<float>(optimizedVertices) };
+		p_statistics->after = { missesAfter / static_cast<float>(optimizedTriangles), missesAfter / static_cast<float>(optimizedVertices) };
+		p_statistics->triangles = optimizedTriangles;
+		p_statistics->meshlets = meshletCount;
 	}
 
 	return mainMesh;
@@ -0,0 +1,97 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <OgRendering/Resource/Mesh.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Cooked meshes (.ogmesh): the vertices and indices as imported by Assimp, so a mesh is only imported once.
+	 * A cooked file is named after the hash of the content of its source file, a modified source is cooked again.
+	 *
+	 * Layout, in the byte order of the machine:
+	 * - MeshFileHeader
+	 * - one MeshFileEntry per mesh, the first one is the main mesh and the other ones its submeshes
+	 * - the names of the meshes
+	 * - the vertices, the indices, the meshlets with their vertices and triangles, then one MeshFileLod per level
+ *   and the indices of the levels of each mesh, aligned on 16 bytes
+	 */
+	class RENDERING_API MeshCache final
+	{
+	public:
+		inline static const std::string DIRECTORY = "Resources/cache/meshes/";
+		inline static const std::string EXTENSION = ".ogmesh";
+		/**
+		 * @brief Increased when the layout or the import settings change, the files of another version are cooked again.
+		 */
+		static constexpr uint32_t VERSION = 5u;
+
+		struct MeshFileHeader
+		{
+			char magic[4];
+			uint32_t version;
+			uint64_t sourceHash;
+			uint32_t vertexSize;
+			uint32_t meshCount;
+		};
+
+		struct MeshFileEntry
+		{
+			uint64_t vertexOffset;
+			uint64_t vertexCount;
+			uint64_t indexOffset;
+			uint64_t indexCount;
+			uint64_t meshletOffset;
+			uint64_t meshletCount;
+			uint64_t meshletVertexOffset;
+			uint64_t meshletVertexCount;
+			uint64_t meshletTriangleOffset;
+			uint64_t meshletTriangleCount;
+			uint64_t lodOffset;
+			uint64_t lodCount;
+			uint64_t nameOffset;
+			uint64_t nameLength;
+			float boundsMin[3];
+			float boundsMax[3];
+			float sphereCenter[3];
+			float sphereRadius;
+		};
+
+		struct MeshFileLod
+		{
+			uint64_t indexOffset;
+			uint64_t indexCount;
+			float error;
+			uint32_t padding;
+		};
+
+		/**
+		 * @brief Hash the content of a file, a packed file gives the hash stored by its archive without being read.
+		 * @return The hash, 0 if the file couldn't be read
+		 */
+		[[nodiscard]] static uint64_t HashFile(std::string_view p_file);
+
+		[[nodiscard]] static std::string CookedPath(const uint64_t p_sourceHash);
+
+		/**
+		 * @brief Build a mesh from its cooked file.
+		 * @param p_sourceHash Hash of the source file given by HashFile
+		 * @return The mesh, nullptr if there is no valid cooked file for this source
+		 */
+		[[nodiscard]] static std::shared_ptr<Mesh> Read(const uint64_t p_sourceHash);
+
+		/**
+		 * @brief Write the cooked file of a mesh imported from a source file.
+		 * @return False if the file couldn't be written
+		 */
+		static bool Write(const uint64_t p_sourceHash, const std::shared_ptr<Mesh>& p_mesh);
+
+	private:
+		MeshCache() = default;
+	};
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 #include <vulkan/vulkan.h>
 
 class ShaderLoader final
@@ -9,4 +10,17 @@ public:
     ~ShaderLoader() = default;
 
     static VkShaderModule LoadShader(const char* p_fileName, VkDevice p_device);
+
+    /**
+     * @brief Compile a GLSL shader to SPIR-V like compileShaders.bat, with the glslangValidator found in the PATH.
+     * @param p_source The GLSL file, its stage is given by its extension
+     * @param p_binary The SPIR-V file to write
+     * @return False if the shader couldn't be compiled, the errors are printed by the compiler
+     */
+    static bool CompileShader(const std::string& p_source, const std::string& p_binary);
+
+    /**
+     * @brief Return the SPIR-V file loaded for a GLSL file, in the bin folder next to it.
+     */
+    static std::string BinaryPath(const std::string& p_source);
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <string>
+
+#include <OgRendering/Resource/Texture.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+#include <OgRendering/Utils/MipGenerator.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Cooked textures (.ogtex): the decoded pixels with their whole mip chain, optionally block compressed,
+	 * so an image is only decoded and downsampled once. A cooked file is named after the hash of the content of its source file.
+	 *
+	 * Layout, in the byte order of the machine:
+	 * - TextureFileHeader
+	 * - one MipLevel per level, from the largest one, their offsets are relative to the data
+	 * - the levels one after the other, from dataOffset aligned on 16 bytes
+	 */
+	class RENDERING_API TextureCache final
+	{
+	public:
+		inline static const std::string DIRECTORY = "Resources/cache/textures/";
+		inline static const std::string EXTENSION = ".ogtex";
+		/**
+		 * @brief Increased when the layout or the cooking changes, the files of another version are cooked again.
+		 */
+		static constexpr uint32_t VERSION = 3u;
+
+		struct CookSettings
+		{
+			/**
+			 * @brief Compress the levels of the 8 bits images in BC1, or in BC3 if any pixel is translucent.
+			 */
+			bool compress{ false };
+			Utils::MipSettings mips;
+		};
+
+		struct TextureFileHeader
+		{
+			char magic[4];
+			uint32_t version;
+			uint64_t sourceHash;
+			uint32_t format;
+			uint32_t width;
+			uint32_t height;
+			uint32_t levelCount;
+			uint32_t mipFilter;
+			uint32_t srgb;
+			uint32_t padding;
+			uint64_t dataOffset;
+		};
+
+		/**
+		 * @brief Return the bytes of a level, a block compressed level is made of 4x4 blocks.
+		 */
+		[[nodiscard]] static uint64_t LevelSize(const TEXTURE_FORMAT p_format, const uint32_t p_width, const uint32_t p_height);
+
+		[[nodiscard]] static std::string CookedPath(const uint64_t p_sourceHash);
+
+		/**
+		 * @brief Tell if the images of a format are block compressed with these settings.
+		 */
+		[[nodiscard]] static bool IsCompressible(const TEXTURE_FORMAT p_format, const CookSettings& p_settings);
+
+		/**
+		 * @brief Build the mip chain of decoded pixels and fill a texture with it.
+		 * @param p_format The uncompressed format of the pixels
+		 * @return False if the levels couldn't be allocated or the format is compressed
+		 */
+		static bool Cook(const uint8_t* p_pixels, const uint32_t p_width, const uint32_t p_height, const TEXTURE_FORMAT p_format,
+			const CookSettings& p_settings, Texture& p_texture);
+
+		/**
+		 * @brief Decode a source image with its own channels and bit depth, cook it and write its cooked file.
+		 * @param p_source The source file, opened through the Utils::VirtualFileSystem
+		 * @param p_sourceHash Hash of the source file given by Utils::FileView::ContentHash
+		 * @return False if the image couldn't be decoded or cooked, the cooked file not being written is only reported
+		 */
+		static bool Import(const Utils::FileView& p_source, const uint64_t p_sourceHash, const CookSettings& p_settings, Texture& p_texture);
+
+		/**
+		 * @brief Fill a texture from its cooked file, packed or on the disk.
+		 * @param p_sourceHash Hash of the source file given by Utils::FileView::ContentHash
+		 * @param p_settings The settings expected, a file cooked with other settings is ignored
+		 * @param p_maxSize Largest width or height of the levels read, the larger levels are left in the file, 0 to read them all
+		 * @return False if there is no valid cooked file for this source
+		 */
+		[[nodiscard]] static bool Read(const uint64_t p_sourceHash, const CookSettings& p_settings, Texture& p_texture,
+			const uint32_t p_maxSize = 0u);
+
+		/**
+		 * @brief Write the cooked file of a texture filled by Cook.
+		 * @param p_settings The settings given to Cook
+		 * @return False if the file couldn't be written
+		 */
+		static bool Write(const uint64_t p_sourceHash, const CookSettings& p_settings, const Texture& p_texture);
+
+	private:
+		TextureCache() = default;
+	};
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Managers/ResourceRegistry.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Limits of the CPU memory kept by a resource service.
+	 */
+	struct ResourceBudget
+	{
+		/**
+		 * @brief Bytes above which the least recently used resources without any reference are evicted by Trim, 0 for no limit.
+		 */
+		uint64_t maxResidentBytes{ 0u };
+
+		/**
+		 * @brief Free the CPU copy of a resource once the renderer tells it is uploaded to the GPU.
+		 * @note Only for resources the renderer never uploads again from their CPU copy.
+		 */
+		bool releaseCpuDataAfterUpload{ false };
+	};
+
+	/**
+	 * @brief Evict the least recently used resources until the resident bytes fit in the budget.
+	 * Only the completed resources without any ResourceReference are evicted, the other ones are skipped.
+	 * @param p_registry The resources of a service
+	 * @param p_residentBytes The counter of the service, decreased by the bytes of the evicted resources
+	 * @param p_maxResidentBytes The budget, 0 for no limit
+	 * @return The resources evicted, they are freed when the handles returned are released
+	 * @note Call it from the thread using the raw pointers given by the service, the GPU copies keyed by the address of an evicted resource must be destroyed before releasing its handle.
+	 */
+	template<typename ResourceType>
+	std::vector<ResourceHandle<ResourceType>> TrimToBudget(ResourceRegistry<ResourceHandle<ResourceType>>& p_registry, std::atomic<uint64_t>& p_residentBytes, const uint64_t p_maxResidentBytes)
+	{
+		if (p_maxResidentBytes == 0u || p_residentBytes.load() <= p_maxResidentBytes)
+			return {};
+
+		struct Candidate
+		{
+			std::string name;
+			uint64_t lastUse;
+		};
+
+		std::vector<Candidate> candidates;
+		p_registry.ForEach([&candidates](const std::string& p_name, const ResourceHandle<ResourceType>& p_handle)
+		{
+			if (!p_handle.IsPending() && p_handle.References() == 0u)
+				candidates.push_back({ p_name, p_handle.LastUse() });
+		});
+
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& p_left, const Candidate& p_right)
+		{
+			return p_left.lastUse < p_right.lastUse;
+		});
+
+		std::vector<ResourceHandle<ResourceType>> evicted;
+		for (const Candidate& candidate : candidates)
+		{
+			if (p_residentBytes.load() <= p_maxResidentBytes)
+				break;
+
+			// Checked again under the lock of the entry, it may have been referenced or reloaded meanwhile
+			ResourceHandle<ResourceType> erasedHandle;
+			const bool erased = p_registry.EraseIf(candidate.name, [&erasedHandle](const ResourceHandle<ResourceType>& p_handle)
+			{
+				if (p_handle.IsPending() || p_handle.References() != 0u)
+					return false;
+
+				erasedHandle = p_handle;
+				return true;
+			});
+
+			if (erased)
+			{
+				p_residentBytes.fetch_sub(erasedHandle.ResidentBytes());
+				evicted.emplace_back(std::move(erasedHandle));
+			}
+		}
+
+		return evicted;
+	}
+}
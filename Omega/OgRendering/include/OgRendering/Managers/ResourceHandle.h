@@ -0,0 +1,362 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <OgRendering/Utils/JobSystem.h>
+
+namespace OgEngine
+{
+	enum class LOAD_STATE : uint8_t
+	{
+		PENDING,
+		READY,
+		FAILED
+	};
+
+	/**
+	 * @brief Order in which the queued resources are loaded.
+	 */
+	enum class LOAD_PRIORITY : uint8_t
+	{
+		/**
+		 * @brief Needed right away, loaded before anything else.
+		 */
+		CRITICAL,
+		VISIBLE,
+		/**
+		 * @brief Not needed yet, loaded once nothing else is queued.
+		 */
+		PREFETCH
+	};
+
+	[[nodiscard]] constexpr Utils::JOB_PRIORITY ToJobPriority(const LOAD_PRIORITY p_priority)
+	{
+		switch (p_priority)
+		{
+		case LOAD_PRIORITY::CRITICAL:
+			return Utils::JOB_PRIORITY::HIGH;
+		case LOAD_PRIORITY::PREFETCH:
+			return Utils::JOB_PRIORITY::LOW;
+		default:
+			return Utils::JOB_PRIORITY::NORMAL;
+		}
+	}
+
+	/**
+	 * @brief Shared access to a resource being loaded, cheap to copy.
+	 * The resource is only given once it is completely loaded, never while a worker is still filling it.
+	 */
+	template<typename ResourceType>
+	class ResourceHandle
+	{
+	public:
+		using Callback = std::function<void(const ResourceHandle<ResourceType>&)>;
+
+		ResourceHandle() = default;
+
+		/**
+		 * @brief Create a pending handle.
+		 * @param p_resource The object the loader fills, given by Get once the handle is completed
+		 */
+		explicit ResourceHandle(std::shared_ptr<ResourceType> p_resource) : m_state(std::make_shared<SharedState>())
+		{
+			m_state->resource = std::move(p_resource);
+		}
+
+		/**
+		 * @brief Tell if the handle refers to a resource.
+		 */
+		[[nodiscard]] bool IsValid() const { return m_state != nullptr; }
+
+		/**
+		 * @brief Tell if two handles refer to the same load.
+		 */
+		[[nodiscard]] bool operator==(const ResourceHandle& p_other) const { return m_state == p_other.m_state; }
+		[[nodiscard]] bool operator!=(const ResourceHandle& p_other) const { return m_state != p_other.m_state; }
+
+		/**
+		 * @brief Return the load state without blocking, FAILED for an invalid handle.
+		 */
+		[[nodiscard]] LOAD_STATE State() const
+		{
+			return m_state ? m_state->state.load(std::memory_order_acquire) : LOAD_STATE::FAILED;
+		}
+
+		[[nodiscard]] bool IsPending() const { return State() == LOAD_STATE::PENDING; }
+		[[nodiscard]] bool IsReady() const { return State() == LOAD_STATE::READY; }
+		[[nodiscard]] bool IsFailed() const { return State() == LOAD_STATE::FAILED; }
+
+		/**
+		 * @brief Return the resource without blocking.
+		 * @return The resource, nullptr if it is still loading or failed to load
+		 */
+		[[nodiscard]] std::shared_ptr<ResourceType> Get() const
+		{
+			return IsReady() ? m_state->resource : nullptr;
+		}
+
+		/**
+		 * @brief Block until the resource is loaded.
+		 * @return The resource, nullptr if it failed to load
+		 * @note If the loading job is still queued, the calling thread runs jobs of the pool until it is done.
+		 */
+		std::shared_ptr<ResourceType> Wait() const
+		{
+			if (!m_state)
+				return nullptr;
+
+			LoadingTask().Wait();
+
+			std::unique_lock<std::mutex> lock(m_state->mutex);
+			m_state->completed.wait(lock, [this]() { return m_state->state.load(std::memory_order_acquire) != LOAD_STATE::PENDING; });
+			lock.unlock();
+
+			return Get();
+		}
+
+		/**
+		 * @brief Call a function once the resource is loaded or failed to load.
+		 * @param p_callback The function, called right away if the handle is already completed, otherwise from the thread completing it
+		 */
+		void OnComplete(Callback p_callback) const
+		{
+			if (!m_state)
+				return;
+
+			{
+				std::lock_guard<std::mutex> lock(m_state->mutex);
+				if (m_state->state.load(std::memory_order_acquire) == LOAD_STATE::PENDING)
+				{
+					m_state->callbacks.emplace_back(std::move(p_callback));
+					return;
+				}
+			}
+
+			p_callback(*this);
+		}
+
+		/**
+		 * @brief Return the number of ResourceReference pinning the resource, a resource without any can be evicted.
+		 */
+		[[nodiscard]] uint32_t References() const
+		{
+			return m_state ? m_state->references.load(std::memory_order_acquire) : 0u;
+		}
+
+		/**
+		 * @brief Mark the resource as used, for the eviction of the least recently used ones.
+		 * @param p_tick Value of the clock of the owner, greater on every use
+		 */
+		void Touch(const uint64_t p_tick) const
+		{
+			if (m_state)
+				m_state->lastUse.store(p_tick, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] uint64_t LastUse() const
+		{
+			return m_state ? m_state->lastUse.load(std::memory_order_relaxed) : 0u;
+		}
+
+		/**
+		 * @brief Set the CPU memory used by the resource, to be called by the owner when the resource is loaded or releases its data.
+		 */
+		void SetResidentBytes(const uint64_t p_bytes) const
+		{
+			if (m_state)
+				m_state->residentBytes.store(p_bytes, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] uint64_t ResidentBytes() const
+		{
+			return m_state ? m_state->residentBytes.load(std::memory_order_relaxed) : 0u;
+		}
+
+		/**
+		 * @brief Give the job loading the resource, so waiting for the handle can help the pool instead of sleeping.
+		 */
+		void SetTask(Utils::TaskHandle p_task) const
+		{
+			if (!m_state)
+				return;
+
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			m_state->task = std::move(p_task);
+		}
+
+		/**
+		 * @brief Load the resource sooner if its job is still queued, a lower or equal priority is ignored.
+		 * @return False if the loading has already started or is done
+		 */
+		bool Prioritize(const LOAD_PRIORITY p_priority) const
+		{
+			return IsPending() && LoadingTask().Prioritize(ToJobPriority(p_priority));
+		}
+
+		/**
+		 * @brief Drop the loading job if it hasn't started, to be called by the owner which then completes the handle as FAILED.
+		 * @return False if the loading has already started or is done
+		 */
+		bool CancelTask() const
+		{
+			return IsPending() && LoadingTask().Cancel();
+		}
+
+		/**
+		 * @brief Call a function when the last ResourceReference is released while the resource is still pending, nullptr to stop.
+		 * @note The function is called from the thread releasing the reference, it must not hold a copy of the handle.
+		 */
+		void OnUnreferenced(Callback p_callback) const
+		{
+			if (!m_state)
+				return;
+
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			m_state->unreferenced = std::move(p_callback);
+		}
+
+		/**
+		 * @brief Mark the resource as loaded, to be called by the loader once it is done writing the resource.
+		 * @param p_success False if the resource couldn't be loaded
+		 */
+		void Complete(const bool p_success) const
+		{
+			if (!m_state)
+				return;
+
+			std::vector<Callback> callbacks;
+			{
+				std::lock_guard<std::mutex> lock(m_state->mutex);
+				m_state->state.store(p_success ? LOAD_STATE::READY : LOAD_STATE::FAILED, std::memory_order_release);
+				callbacks.swap(m_state->callbacks);
+				m_state->unreferenced = nullptr;
+			}
+			m_state->completed.notify_all();
+
+			for (const auto& callback : callbacks)
+				callback(*this);
+		}
+
+	private:
+		template<typename>
+		friend class ResourceReference;
+
+		[[nodiscard]] Utils::TaskHandle LoadingTask() const
+		{
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			return m_state->task;
+		}
+
+		void Unreferenced() const
+		{
+			Callback callback;
+			{
+				std::lock_guard<std::mutex> lock(m_state->mutex);
+				if (m_state->state.load(std::memory_order_acquire) != LOAD_STATE::PENDING)
+					return;
+
+				callback = m_state->unreferenced;
+			}
+
+			if (callback)
+				callback(*this);
+		}
+
+		struct SharedState
+		{
+			std::atomic<LOAD_STATE> state{ LOAD_STATE::PENDING };
+			std::atomic<uint32_t> references{ 0u };
+			std::atomic<uint64_t> lastUse{ 0u };
+			std::atomic<uint64_t> residentBytes{ 0u };
+			std::shared_ptr<ResourceType> resource;
+
+			std::mutex mutex;
+			std::condition_variable completed;
+			std::vector<Callback> callbacks;
+			Callback unreferenced;
+			Utils::TaskHandle task;
+		};
+
+		std::shared_ptr<SharedState> m_state;
+	};
+
+	/**
+	 * @brief Handle that keeps its resource from being evicted while it exists.
+	 * Hold one for as long as a raw pointer to the resource is used, the handles alone don't prevent the eviction.
+	 */
+	template<typename ResourceType>
+	class ResourceReference
+	{
+	public:
+		ResourceReference() = default;
+
+		explicit ResourceReference(ResourceHandle<ResourceType> p_handle) : m_handle(std::move(p_handle))
+		{
+			Acquire();
+		}
+
+		ResourceReference(const ResourceReference& p_other) : m_handle(p_other.m_handle)
+		{
+			Acquire();
+		}
+
+		ResourceReference(ResourceReference&& p_other) noexcept : m_handle(std::move(p_other.m_handle))
+		{
+			p_other.m_handle = ResourceHandle<ResourceType>();
+		}
+
+		~ResourceReference()
+		{
+			Release();
+		}
+
+		ResourceReference& operator=(const ResourceReference& p_other)
+		{
+			if (&p_other == this)
+				return *this;
+
+			Release();
+			m_handle = p_other.m_handle;
+			Acquire();
+
+			return *this;
+		}
+
+		ResourceReference& operator=(ResourceReference&& p_other) noexcept
+		{
+			if (&p_other == this)
+				return *this;
+
+			Release();
+			m_handle = std::move(p_other.m_handle);
+			p_other.m_handle = ResourceHandle<ResourceType>();
+
+			return *this;
+		}
+
+		[[nodiscard]] const ResourceHandle<ResourceType>& Handle() const { return m_handle; }
+		[[nodiscard]] std::shared_ptr<ResourceType> Get() const { return m_handle.Get(); }
+
+	private:
+		void Acquire() const
+		{
+			if (m_handle.m_state)
+				m_handle.m_state->references.fetch_add(1u, std::memory_order_acq_rel);
+		}
+
+		void Release() const
+		{
+			// The last reference to a resource still loading may cancel it
+			if (m_handle.m_state && m_handle.m_state->references.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+				m_handle.Unreferenced();
+		}
+
+		ResourceHandle<ResourceType> m_handle;
+	};
+}
@@ -1,37 +1,194 @@
 #pragma once
 #include <OgRendering/Export.h>
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <OgRendering/Managers/Services/MeshService.h>
 #include <OgRendering/Managers/Services/TextureService.h>
 
+#include <OgRendering/Utils/FileWatcher.h>
+#include <OgRendering/Utils/PackArchive.h>
 #include <OgRendering/Utils/TemplateTypename.h>
 
 
 namespace OgEngine
 {
+	/**
+	 * @brief Resources replaced by ResourceManager::ApplyReloads.
+	 */
+	struct ReloadedResources
+	{
+		std::vector<ReloadedResource<Mesh>> meshes;
+		std::vector<ReloadedResource<Texture>> textures;
+		/**
+		 * @brief SPIR-V files written since the last call, the pipelines using them must be created again.
+		 */
+		std::vector<std::string> shaders;
+
+		[[nodiscard]] bool Empty() const { return meshes.empty() && textures.empty() && shaders.empty(); }
+	};
+
+	/**
+	 * @brief Resources evicted by ResourceManager::Trim, each one is freed when its handle is released.
+	 */
+	struct EvictedResources
+	{
+		std::vector<ResourceHandle<Mesh>> meshes;
+		std::vector<ResourceHandle<Texture>> textures;
+
+		[[nodiscard]] bool Empty() const { return meshes.empty() && textures.empty(); }
+	};
+
 	class RENDERING_API ResourceManager final
 	{
 	public:
 		static ResourceManager& Instance();
 
+		/**
+		 * @brief Load a resource on the job system, the CRITICAL ones first and the PREFETCH ones once nothing else is queued.
+		 * A resource already queued is moved to p_priority if it is higher.
+		 */
+		template<typename ResourceType>
+		static inline ResourceHandle<ResourceType> Add(std::string_view p_resourceName, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load a resource for as long as a reference to it is held.
+		 * If the last reference is released before the loading starts, the loading is cancelled, unless the resource was also given to Add.
+		 */
+		template<typename ResourceType>
+		[[nodiscard]] static inline ResourceReference<ResourceType> Request(std::string_view p_resourceName, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load sooner a resource whose loading is still queued, when it becomes urgent.
+		 * @return False if the resource is unknown or its loading has already started
+		 */
 		template<typename ResourceType>
-		static inline void Add(std::string_view p_resourceName);
+		static inline bool Prioritize(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
 
 		template<typename ResourceType>
 		[[nodiscard]] static inline ResourceType* Get(std::string_view p_resourceName);
 
+		template<typename ResourceType>
+		[[nodiscard]] static inline ResourceHandle<ResourceType> GetHandle(std::string_view p_resourceName);
+
 		template<typename ResourceType>
 		static inline void WaitForResource(std::string_view p_resourceName);
 
+		template<typename ResourceType>
+		[[nodiscard]] static inline bool IsLoading(std::string_view p_resourceName);
+
+		/**
+		 * @brief Return a reference keeping the resource from being evicted, hold it as long as the raw pointer given by Get is used.
+		 */
+		template<typename ResourceType>
+		[[nodiscard]] static inline ResourceReference<ResourceType> Acquire(std::string_view p_resourceName);
+
+		template<typename ResourceType>
+		static inline void SetBudget(const ResourceBudget& p_budget);
+
+		/**
+		 * @brief Return the CPU memory used by the loaded resources of a type.
+		 */
+		template<typename ResourceType>
+		[[nodiscard]] static inline uint64_t ResidentBytes();
+
+		/**
+		 * @brief Free the CPU copy of a resource uploaded to the GPU, if its budget asks for it.
+		 */
+		template<typename ResourceType>
+		static inline void ReleaseCpuData(std::string_view p_resourceName);
+
 		static inline std::vector<Texture*>& GetAllTextures();
+
+		/**
+		 * @brief Cook the textures loaded from now on in BC1/BC3 rather than RGBA8.
+		 */
+		static inline void SetTextureCompression(const bool p_compress);
+
+		/**
+		 * @brief Filter the mip chains of the textures loaded from now on, gamma-corrected if p_srgb.
+		 */
+		static inline void SetTextureMipFilter(const Utils::MIP_FILTER p_filter, const bool p_srgb);
+
+		/**
+		 * @brief Load the smallest mip levels of a texture, its larger levels are streamed in as it is drawn larger.
+		 */
+		static inline ResourceHandle<Texture> StreamTexture(std::string_view p_resourceName, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Tell how large a streamed texture is drawn this frame, in pixels along its largest side.
+		 */
+		static inline void ReportTextureUsage(std::string_view p_textureName, const float p_screenSize);
+
+		/**
+		 * @brief Read the mip levels the streamed textures need within the budget and swap in the textures whose levels were read.
+		 * @note Call it from the main thread once per frame, after the usages are reported.
+		 * @return The textures replaced, for the renderer to replace their images
+		 */
+		static inline std::vector<ReloadedResource<Texture>> UpdateTextureStreaming();
+
+		static inline void SetTextureStreamingBudget(const TextureStreamingBudget& p_budget);
+
+		/**
+		 * @brief Give the meshes loaded from now on a vertex layout, Mesh::SetVertexLayout changes the layout of one mesh.
+		 */
+		static inline void SetMeshVertexLayout(const VERTEX_LAYOUT p_layout);
 		
 		static inline void WaitForAll() {
 			m_textureService.WaitForAll();
 			m_meshService.WaitForAll();
 		}
 
+		/**
+		 * @brief Evict the least recently used resources nobody references until every budget is met.
+		 * @note Call it from the main thread, the raw pointers of the evicted resources become invalid once the handles returned are released.
+		 * The renderer keys the GPU copies of the resources by their address: destroy them before, or a new resource allocated there would be drawn with them.
+		 */
+		[[nodiscard]] static inline EvictedResources Trim() {
+			return { m_meshService.Trim(), m_textureService.Trim() };
+		}
+
+		/**
+		 * @brief Reload the resources of a directory when their files change, until StopWatching is called.
+		 * The meshes and textures in use are cooked and loaded again on the job system, the GLSL shaders are compiled again.
+		 * @param p_debounce Time a file must be left alone before it is reloaded
+		 * @return False if the directory can't be watched
+		 */
+		static bool WatchResources(std::string_view p_directory, const std::chrono::milliseconds p_debounce = Utils::FileWatcher::DEFAULT_DEBOUNCE);
+		static void StopWatching();
+
+		/**
+		 * @brief Reload the resources of changed files, what the watcher does for the files it sees change.
+		 * The files of resources that aren't loaded are ignored.
+		 */
+		static void ReloadFiles(const std::vector<std::string>& p_files);
+
+		/**
+		 * @brief Swap the reloaded resources in, Get gives their new version from now on.
+		 * @note Call it from the main thread once per frame, the previous versions stay alive while a ResourceReference holds them.
+		 * @return The resources replaced, for the renderer to upload them and the entities to use them
+		 */
+		static ReloadedResources ApplyReloads();
+
+		/**
+		 * @brief Use the manifest written by omega-cook to find the cooked files of the resources added from now on.
+		 * A source it lists with the same size and modification time isn't read to be hashed, the other ones are hashed as usual.
+		 * @return False if the manifest couldn't be read
+		 */
+		static bool LoadManifest(const std::string& p_file = CookManifest::DEFAULT_FILE);
+
+		/**
+		 * @brief Read the resources from a pack archive written by omega-cook, the files it doesn't hold are still read from the disk.
+		 * Mount it before loading the manifest, which the archive holds as well.
+		 * Don't mount it while watching the resources: their changed files would be reloaded from the packed copies.
+		 * @return False if the archive is missing or invalid, the resources are then all read from the disk
+		 */
+		static bool MountPack(const std::string& p_file = Utils::PackArchive::DEFAULT_FILE);
+
 		ResourceManager(ResourceManager const&) = delete;
 		void operator=(ResourceManager const&) = delete;
 
@@ -45,28 +202,78 @@ namespace OgEngine
 		static Services::MeshService m_meshService;
 		static Services::TextureService m_textureService;
 		static bool m_raytracingEnable;
+
+		// Destroyed before the services, its thread reloads resources
+		static Utils::FileWatcher m_watcher;
+		static std::vector<std::string> m_changedShaders;
+		static std::mutex m_changedShadersMutex;
 	};
 
 #pragma region Mesh
 	template<>
-	inline void ResourceManager::Add<Mesh>(std::string_view p_resourceName);
+	inline ResourceHandle<Mesh> ResourceManager::Add<Mesh>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
+
+	template<>
+	[[nodiscard]] inline ResourceReference<Mesh> ResourceManager::Request<Mesh>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
+
+	template<>
+	inline bool ResourceManager::Prioritize<Mesh>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
 
 	template<>
 	[[nodiscard]] inline Mesh* ResourceManager::Get(std::string_view p_resourceName);
 
+	template<>
+	[[nodiscard]] inline ResourceHandle<Mesh> ResourceManager::GetHandle<Mesh>(std::string_view p_resourceName);
+
 	template<>
 	inline void ResourceManager::WaitForResource<Mesh>(std::string_view p_resourceName);
+
+	template<>
+	[[nodiscard]] inline bool ResourceManager::IsLoading<Mesh>(std::string_view p_resourceName);
+
+	template<>
+	[[nodiscard]] inline ResourceReference<Mesh> ResourceManager::Acquire<Mesh>(std::string_view p_resourceName);
+
+	template<>
+	inline void ResourceManager::SetBudget<Mesh>(const ResourceBudget& p_budget);
+
+	template<>
+	[[nodiscard]] inline uint64_t ResourceManager::ResidentBytes<Mesh>();
 #pragma endregion
 
 #pragma region Texture
 	template<>
-	inline void ResourceManager::Add<Texture>(std::string_view p_resourceName);
+	inline ResourceHandle<Texture> ResourceManager::Add<Texture>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
+
+	template<>
+	[[nodiscard]] inline ResourceReference<Texture> ResourceManager::Request<Texture>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
+
+	template<>
+	inline bool ResourceManager::Prioritize<Texture>(std::string_view p_resourceName, const LOAD_PRIORITY p_priority);
 
 	template<>
 	[[nodiscard]] inline Texture* ResourceManager::Get(std::string_view p_resourceName);
 
+	template<>
+	[[nodiscard]] inline ResourceHandle<Texture> ResourceManager::GetHandle<Texture>(std::string_view p_resourceName);
+
 	template<>
 	inline void ResourceManager::WaitForResource<Texture>(std::string_view p_resourceName);
+
+	template<>
+	[[nodiscard]] inline bool ResourceManager::IsLoading<Texture>(std::string_view p_resourceName);
+
+	template<>
+	[[nodiscard]] inline ResourceReference<Texture> ResourceManager::Acquire<Texture>(std::string_view p_resourceName);
+
+	template<>
+	inline void ResourceManager::SetBudget<Texture>(const ResourceBudget& p_budget);
+
+	template<>
+	[[nodiscard]] inline uint64_t ResourceManager::ResidentBytes<Texture>();
+
+	template<>
+	inline void ResourceManager::ReleaseCpuData<Texture>(std::string_view p_resourceName);
 #pragma endregion 
 }
 
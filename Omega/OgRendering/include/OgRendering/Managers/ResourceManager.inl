@@ -1,23 +1,70 @@
 #pragma once
 template <typename ResourceType>
-inline void OgEngine::ResourceManager::Add(std::string_view p_resourceName)
+inline OgEngine::ResourceHandle<ResourceType> OgEngine::ResourceManager::Add(std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
 {
 	std::cerr << "Warning: Unable to add the resource with type " << type_name<ResourceType>() << ".\n";
+	return ResourceHandle<ResourceType>();
 }
 
 #pragma region Mesh
 template <>
-inline void OgEngine::ResourceManager::Add<OgEngine::Mesh>(const std::string_view p_resourceName)
+inline OgEngine::ResourceHandle<OgEngine::Mesh> OgEngine::ResourceManager::Add<OgEngine::Mesh>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
 {
-	m_meshService.Add(p_resourceName);
+	return m_meshService.Add(p_resourceName, p_priority);
 }
 #pragma endregion
 
 #pragma region Texture
 template <>
-inline void OgEngine::ResourceManager::Add<OgEngine::Texture>(const std::string_view p_resourceName)
+inline OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::ResourceManager::Add<OgEngine::Texture>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
 {
-	m_textureService.Add(p_resourceName);
+	return m_textureService.Add(p_resourceName, p_priority);
+}
+#pragma endregion
+
+template <typename ResourceType>
+inline OgEngine::ResourceReference<ResourceType> OgEngine::ResourceManager::Request(std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	std::cerr << "Warning: Unable to request the resource with type " << type_name<ResourceType>() << ".\n";
+	return ResourceReference<ResourceType>();
+}
+
+#pragma region Mesh
+template <>
+inline OgEngine::ResourceReference<OgEngine::Mesh> OgEngine::ResourceManager::Request<OgEngine::Mesh>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	return m_meshService.Request(p_resourceName, p_priority);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline OgEngine::ResourceReference<OgEngine::Texture> OgEngine::ResourceManager::Request<OgEngine::Texture>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	return m_textureService.Request(p_resourceName, p_priority);
+}
+#pragma endregion
+
+template <typename ResourceType>
+inline bool OgEngine::ResourceManager::Prioritize(std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	std::cerr << "Warning: Unable to prioritize the resource of type '" << type_name<ResourceType>() << "'.\n";
+	return false;
+}
+
+#pragma region Mesh
+template <>
+inline bool OgEngine::ResourceManager::Prioritize<OgEngine::Mesh>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	return m_meshService.Prioritize(p_resourceName, p_priority);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline bool OgEngine::ResourceManager::Prioritize<OgEngine::Texture>(const std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	return m_textureService.Prioritize(p_resourceName, p_priority);
 }
 #pragma endregion
 
@@ -46,6 +93,31 @@ inline OgEngine::Texture* OgEngine::ResourceManager::Get<OgEngine::Texture>(
 }
 #pragma endregion
 
+template <typename ResourceType>
+inline OgEngine::ResourceHandle<ResourceType> OgEngine::ResourceManager::GetHandle(std::string_view p_resourceName)
+{
+	std::cerr << "Warning: Unable to return the handle of the resource of type '" << type_name<ResourceType>() << "'.\n";
+	return ResourceHandle<ResourceType>();
+}
+
+#pragma region Mesh
+template <>
+inline OgEngine::ResourceHandle<OgEngine::Mesh> OgEngine::ResourceManager::GetHandle<OgEngine::Mesh>(
+		const std::string_view p_resourceName)
+{
+	return m_meshService.GetHandle(p_resourceName);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::ResourceManager::GetHandle<OgEngine::Texture>(
+		const std::string_view p_resourceName)
+{
+	return m_textureService.GetHandle(p_resourceName);
+}
+#pragma endregion
+
 template <typename ResourceType>
 inline void OgEngine::ResourceManager::WaitForResource(std::string_view p_resourceName)
 {
@@ -66,9 +138,152 @@ inline void OgEngine::ResourceManager::WaitForResource<OgEngine::Texture>(const
 {
 	m_textureService.WaitForResource(p_resourceName);
 }
+#pragma endregion
+
+template <typename ResourceType>
+inline bool OgEngine::ResourceManager::IsLoading(std::string_view p_resourceName)
+{
+	std::cerr << "Warning: Unable to check the loading of the resource of type '" << type_name<ResourceType>() << "'.\n";
+	return false;
+}
+
+#pragma region Mesh
+template <>
+inline bool OgEngine::ResourceManager::IsLoading<OgEngine::Mesh>(const std::string_view p_resourceName)
+{
+	return m_meshService.IsLoading(p_resourceName);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline bool OgEngine::ResourceManager::IsLoading<OgEngine::Texture>(const std::string_view p_resourceName)
+{
+	return m_textureService.IsLoading(p_resourceName);
+}
+
+#pragma endregion
+
+template <typename ResourceType>
+inline OgEngine::ResourceReference<ResourceType> OgEngine::ResourceManager::Acquire(std::string_view p_resourceName)
+{
+	std::cerr << "Warning: Unable to acquire the resource of type '" << type_name<ResourceType>() << "'.\n";
+	return ResourceReference<ResourceType>();
+}
+
+#pragma region Mesh
+template <>
+inline OgEngine::ResourceReference<OgEngine::Mesh> OgEngine::ResourceManager::Acquire<OgEngine::Mesh>(const std::string_view p_resourceName)
+{
+	return m_meshService.Acquire(p_resourceName);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline OgEngine::ResourceReference<OgEngine::Texture> OgEngine::ResourceManager::Acquire<OgEngine::Texture>(const std::string_view p_resourceName)
+{
+	return m_textureService.Acquire(p_resourceName);
+}
+#pragma endregion
+
+template <typename ResourceType>
+inline void OgEngine::ResourceManager::SetBudget(const ResourceBudget& p_budget)
+{
+	std::cerr << "Warning: Unable to set the budget of the resources of type '" << type_name<ResourceType>() << "'.\n";
+}
+
+#pragma region Mesh
+template <>
+inline void OgEngine::ResourceManager::SetBudget<OgEngine::Mesh>(const ResourceBudget& p_budget)
+{
+	m_meshService.SetBudget(p_budget);
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline void OgEngine::ResourceManager::SetBudget<OgEngine::Texture>(const ResourceBudget& p_budget)
+{
+	m_textureService.SetBudget(p_budget);
+}
+#pragma endregion
+
+template <typename ResourceType>
+inline uint64_t OgEngine::ResourceManager::ResidentBytes()
+{
+	std::cerr << "Warning: Unable to count the memory of the resources of type '" << type_name<ResourceType>() << "'.\n";
+	return 0u;
+}
+
+#pragma region Mesh
+template <>
+inline uint64_t OgEngine::ResourceManager::ResidentBytes<OgEngine::Mesh>()
+{
+	return m_meshService.ResidentBytes();
+}
+#pragma endregion
+
+#pragma region Texture
+template <>
+inline uint64_t OgEngine::ResourceManager::ResidentBytes<OgEngine::Texture>()
+{
+	return m_textureService.ResidentBytes();
+}
+#pragma endregion
+
+template <typename ResourceType>
+inline void OgEngine::ResourceManager::ReleaseCpuData(std::string_view p_resourceName)
+{
+	// The other types keep their CPU copy, the renderer builds its buffers again from it
+}
+
+#pragma region Texture
+template <>
+inline void OgEngine::ResourceManager::ReleaseCpuData<OgEngine::Texture>(const std::string_view p_resourceName)
+{
+	m_textureService.ReleaseCpuData(p_resourceName);
+}
 
 inline std::vector<OgEngine::Texture*>& OgEngine::ResourceManager::GetAllTextures()
 {
 	return m_textureService.GetAllTextures();
 }
+
+inline void OgEngine::ResourceManager::SetTextureCompression(const bool p_compress)
+{
+	m_textureService.SetBlockCompression(p_compress);
+}
+
+inline void OgEngine::ResourceManager::SetTextureMipFilter(const Utils::MIP_FILTER p_filter, const bool p_srgb)
+{
+	m_textureService.SetMipFilter(p_filter, p_srgb);
+}
+
+inline OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::ResourceManager::StreamTexture(std::string_view p_resourceName, const LOAD_PRIORITY p_priority)
+{
+	return m_textureService.Stream(p_resourceName, p_priority);
+}
+
+inline void OgEngine::ResourceManager::ReportTextureUsage(std::string_view p_textureName, const float p_screenSize)
+{
+	m_textureService.ReportUsage(p_textureName, p_screenSize);
+}
+
+inline std::vector<OgEngine::ReloadedResource<OgEngine::Texture>> OgEngine::ResourceManager::UpdateTextureStreaming()
+{
+	return m_textureService.UpdateStreaming();
+}
+
+inline void OgEngine::ResourceManager::SetTextureStreamingBudget(const TextureStreamingBudget& p_budget)
+{
+	m_textureService.SetStreamingBudget(p_budget);
+}
+#pragma endregion
+
+#pragma region Mesh
+inline void OgEngine::ResourceManager::SetMeshVertexLayout(const VERTEX_LAYOUT p_layout)
+{
+	m_meshService.SetVertexLayout(p_layout);
+}
 #pragma endregion
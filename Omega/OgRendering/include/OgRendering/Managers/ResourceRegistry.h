@@ -0,0 +1,224 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Map from resource names to values, safe to use from any thread.
+	 * The entries are spread over shards each one with its own lock, so threads working on different resources rarely wait for each other.
+	 * @note The name is hashed once per call, the hash picks the shard and keys its entries, and the names are only compared.
+	 * A lookup never allocates, the name is copied only when an entry is inserted.
+	 */
+	template<typename ValueType, size_t ShardCount = 16u>
+	class ResourceRegistry final
+	{
+	public:
+		/**
+		 * @brief Return a copy of the value of a resource.
+		 * @return The value, a default constructed one if the name is unknown
+		 */
+		[[nodiscard]] ValueType Find(std::string_view p_name) const
+		{
+			const size_t hash = Hash(p_name);
+			const Shard& shard = ShardOf(hash);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			const auto found = shard.Find(hash, p_name);
+			return found != shard.entries.end() ? found->second.value : ValueType();
+		}
+
+		[[nodiscard]] bool Contains(std::string_view p_name) const
+		{
+			const size_t hash = Hash(p_name);
+			const Shard& shard = ShardOf(hash);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			return shard.Find(hash, p_name) != shard.entries.end();
+		}
+
+		/**
+		 * @brief Call a function on the value of a resource while its shard is locked, the value is default constructed if the name is unknown.
+		 * @param p_function Called with the value and true if it was just inserted, it must not use the registry
+		 * @return What the function returns
+		 */
+		template<typename Function>
+		decltype(auto) Update(std::string_view p_name, Function&& p_function)
+		{
+			const size_t hash = Hash(p_name);
+			Shard& shard = ShardOf(hash);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			auto entry = shard.Find(hash, p_name);
+			const bool inserted = entry == shard.entries.end();
+			if (inserted)
+				entry = shard.entries.emplace(hash, Entry{ std::string(p_name), ValueType() });
+
+			return p_function(entry->second.value, inserted);
+		}
+
+		/**
+		 * @return True if the resource was found and removed
+		 */
+		bool Erase(std::string_view p_name)
+		{
+			const size_t hash = Hash(p_name);
+			Shard& shard = ShardOf(hash);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			const auto found = shard.Find(hash, p_name);
+			if (found == shard.entries.end())
+				return false;
+
+			shard.entries.erase(found);
+			return true;
+		}
+
+		/**
+		 * @brief Remove a resource if a function returns true for its value.
+		 * @param p_predicate Called with the value while its shard is locked, it must not use the registry
+		 * @return True if the resource was found and removed
+		 */
+		template<typename Predicate>
+		bool EraseIf(std::string_view p_name, Predicate&& p_predicate)
+		{
+			const size_t hash = Hash(p_name);
+			Shard& shard = ShardOf(hash);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			const auto found = shard.Find(hash, p_name);
+			if (found == shard.entries.end() || !p_predicate(found->second.value))
+				return false;
+
+			shard.entries.erase(found);
+			return true;
+		}
+
+		/**
+		 * @brief Call a function on every entry, one shard locked at a time.
+		 * @param p_function Called with the name and the value, it must not use the registry
+		 * @note Entries added or removed meanwhile in a shard not visited yet may or may not be seen.
+		 */
+		template<typename Function>
+		void ForEach(Function&& p_function) const
+		{
+			for (const Shard& shard : m_shards)
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				for (const auto& [hash, entry] : shard.entries)
+					p_function(entry.name, entry.value);
+			}
+		}
+
+		/**
+		 * @brief Remove the entries a function returns true for, one shard locked at a time.
+		 * @param p_predicate Called with the name and the value, it must not use the registry
+		 * @return The number of entries removed
+		 */
+		template<typename Predicate>
+		size_t EraseIf(Predicate&& p_predicate)
+		{
+			size_t erased = 0u;
+			for (Shard& shard : m_shards)
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				for (auto entry = shard.entries.begin(); entry != shard.entries.end();)
+				{
+					if (p_predicate(entry->second.name, entry->second.value))
+					{
+						entry = shard.entries.erase(entry);
+						++erased;
+					}
+					else
+						++entry;
+				}
+			}
+
+			return erased;
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			size_t size = 0u;
+			for (const Shard& shard : m_shards)
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				size += shard.entries.size();
+			}
+
+			return size;
+		}
+
+		void Clear()
+		{
+			for (Shard& shard : m_shards)
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				shard.entries.clear();
+			}
+		}
+
+	private:
+		struct Entry
+		{
+			std::string name;
+			ValueType value;
+		};
+
+		// The hashes are computed before the shard is picked, the map uses them as they are
+		struct IdentityHash
+		{
+			size_t operator()(const size_t p_hash) const { return p_hash; }
+		};
+
+		struct Shard
+		{
+			using Entries = std::unordered_multimap<size_t, Entry, IdentityHash>;
+
+			mutable std::mutex mutex;
+			Entries entries;
+
+			// Names sharing a hash are told apart by comparing them with the string_view, without building a string
+			[[nodiscard]] typename Entries::iterator Find(const size_t p_hash, std::string_view p_name)
+			{
+				auto [entry, end] = entries.equal_range(p_hash);
+				while (entry != end && entry->second.name != p_name)
+					++entry;
+
+				return entry != end ? entry : entries.end();
+			}
+
+			[[nodiscard]] typename Entries::const_iterator Find(const size_t p_hash, std::string_view p_name) const
+			{
+				auto [entry, end] = entries.equal_range(p_hash);
+				while (entry != end && entry->second.name != p_name)
+					++entry;
+
+				return entry != end ? entry : entries.end();
+			}
+		};
+
+		[[nodiscard]] static size_t Hash(std::string_view p_name)
+		{
+			return std::hash<std::string_view>()(p_name);
+		}
+
+		// The low bits pick the bucket inside the shard, the high ones pick the shard
+		[[nodiscard]] Shard& ShardOf(const size_t p_hash)
+		{
+			return m_shards[(p_hash >> 24u) % ShardCount];
+		}
+
+		[[nodiscard]] const Shard& ShardOf(const size_t p_hash) const
+		{
+			return m_shards[(p_hash >> 24u) % ShardCount];
+		}
+
+		std::array<Shard, ShardCount> m_shards;
+	};
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Managers/ResourceRegistry.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief New version of a resource being loaded, not registered until it is swapped in.
+	 */
+	template<typename ResourceType>
+	struct PendingReload
+	{
+		std::string name;
+		ResourceHandle<ResourceType> handle;
+	};
+
+	/**
+	 * @brief Resource replaced by the new version of its file.
+	 */
+	template<typename ResourceType>
+	struct ReloadedResource
+	{
+		std::string name;
+		/**
+		 * @brief The version replaced, still used by whoever took a ResourceReference to it before the swap.
+		 */
+		std::shared_ptr<ResourceType> previous;
+		std::shared_ptr<ResourceType> current;
+	};
+
+	/**
+	 * @brief Register the reloaded resources in place of their previous version, each one in a single update of the registry.
+	 * The reloads still loading are kept for a later call, the failed ones are dropped and their previous version stays registered.
+	 * @param p_registry The resources of a service
+	 * @param p_residentBytes The counter of the service, the loader already added the bytes of the new versions
+	 * @param p_reloads The reloads of the service, guarded by p_mutex
+	 * @return The resources replaced
+	 */
+	template<typename ResourceType>
+	std::vector<ReloadedResource<ResourceType>> SwapReloaded(ResourceRegistry<ResourceHandle<ResourceType>>& p_registry,
+		std::atomic<uint64_t>& p_residentBytes, std::vector<PendingReload<ResourceType>>& p_reloads, std::mutex& p_mutex)
+	{
+		std::vector<PendingReload<ResourceType>> completed;
+		{
+			std::lock_guard<std::mutex> lock(p_mutex);
+			for (auto reload = p_reloads.begin(); reload != p_reloads.end();)
+			{
+				if (reload->handle.IsPending())
+				{
+					++reload;
+					continue;
+				}
+
+				completed.emplace_back(std::move(*reload));
+				reload = p_reloads.erase(reload);
+			}
+		}
+
+		std::vector<ReloadedResource<ResourceType>> swapped;
+		for (PendingReload<ResourceType>& reload : completed)
+		{
+			if (!reload.handle.IsReady())
+			{
+				std::cerr << "Warning: Couldn't reload " << reload.name << ", the previous version is kept.\n";
+				continue;
+			}
+
+			ResourceHandle<ResourceType> previous;
+			p_registry.Update(reload.name, [&reload, &previous](ResourceHandle<ResourceType>& p_handle, bool)
+			{
+				previous = p_handle;
+				p_handle = reload.handle;
+				return true;
+			});
+
+			p_residentBytes.fetch_sub(previous.ResidentBytes());
+			swapped.push_back({ std::move(reload.name), previous.Get(), reload.handle.Get() });
+		}
+
+		return swapped;
+	}
+}
@@ -1,15 +1,20 @@
 #pragma once
 #include <OgRendering/Export.h>
 
-#include <concurrent_unordered_map.h>
 #include <memory>
 
 #include <OgRendering/Resource/Mesh.h>
 #include <optional>
 #include <unordered_map>
-#include <OgRendering/Utils/ThreadPool.h>
+#include <OgRendering/Managers/ResourceBudget.h>
+#include <OgRendering/Managers/Loaders/CookManifest.h>
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Managers/ResourceRegistry.h>
+#include <OgRendering/Managers/ResourceReload.h>
+#include <OgRendering/Utils/JobSystem.h>
 #include <functional>
-#include <list>
+#include <atomic>
+#include <mutex>
 
 namespace OgEngine::Services
 {
@@ -19,19 +24,110 @@ namespace OgEngine::Services
 		MeshService();
 		~MeshService();
 
-		inline void Add(std::string_view p_filePath);
+		/**
+		 * @brief Load a mesh on the job system, a mesh already queued is moved to p_priority if it is higher.
+		 */
+		ResourceHandle<Mesh> Add(std::string_view p_filePath, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load a mesh that is no longer needed once the references given are all released.
+		 * If nobody else added the mesh, releasing the last reference before its job starts cancels the loading and forgets the mesh.
+		 */
+		[[nodiscard]] ResourceReference<Mesh> Request(std::string_view p_filePath, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load a queued mesh sooner.
+		 * @return False if the mesh is unknown or its loading has already started
+		 */
+		bool Prioritize(std::string_view p_meshName, const LOAD_PRIORITY p_priority);
 		
-		[[nodiscard]] inline std::shared_ptr<Mesh> Get(std::string_view p_meshName) const;
-		inline void WaitForAll() { m_pool.WaitForWorkers(); }
-		inline void WaitForResource(std::string_view p_meshName);
+		[[nodiscard]] std::shared_ptr<Mesh> Get(std::string_view p_meshName) const;
+		[[nodiscard]] ResourceHandle<Mesh> GetHandle(std::string_view p_meshName) const;
+		void WaitForAll();
+		void WaitForResource(std::string_view p_meshName);
+		[[nodiscard]] bool IsLoading(std::string_view p_meshName) const;
+
+		/**
+		 * @brief Return a reference keeping the mesh from being evicted, empty if the name is unknown.
+		 */
+		[[nodiscard]] ResourceReference<Mesh> Acquire(std::string_view p_meshName) const;
+
+		void SetBudget(const ResourceBudget& p_budget);
+		[[nodiscard]] const ResourceBudget& Budget() const;
+
+		/**
+		 * @brief Return the CPU memory used by the meshes loaded.
+		 */
+		[[nodiscard]] uint64_t ResidentBytes() const;
+
+		/**
+		 * @brief Evict the least recently used meshes nobody references until the budget is met.
+		 * @return The meshes evicted, the buffers the renderer made from them must be destroyed before the handles are released
+		 */
+		std::vector<ResourceHandle<Mesh>> Trim();
+
+		/**
+		 * @brief Load again a mesh in use, its file is cooked and loaded on the job system while the current version stays in use.
+		 * @return False if no mesh of this file is loaded
+		 */
+		bool Reload(std::string_view p_filePath);
+
+		/**
+		 * @brief Replace the meshes reloaded since the last call by their new version, the handles given before keep the previous one.
+		 * @note Call it from the main thread, a mesh that failed to reload keeps its current version.
+		 * @return The meshes replaced
+		 */
+		std::vector<ReloadedResource<Mesh>> SwapReloaded();
+
+		/**
+		 * @brief Find the cooked files of the meshes loaded from now on through a cook manifest, a source it lists unchanged isn't hashed.
+		 */
+		void SetManifest(std::shared_ptr<const CookManifest> p_manifest);
+
+		/**
+		 * @brief Give the meshes loaded from now on a vertex layout, FULL by default.
+		 * The PACKED vertices are encoded by the loading threads.
+		 */
+		void SetVertexLayout(const VERTEX_LAYOUT p_layout);
+		[[nodiscard]] VERTEX_LAYOUT VertexLayout() const;
 
 	private:
-		inline void MultithreadedLoading(std::string_view p_filePath);
+		/**
+		 * @brief Register a mesh and queue its loading, or return the mesh already registered.
+		 * @param p_cancellable True if the loading may be cancelled once the references are released, an Add makes it false for good
+		 * @param p_reference Set to a reference to the mesh if not nullptr
+		 */
+		ResourceHandle<Mesh> Load(std::string_view p_filePath, const LOAD_PRIORITY p_priority, const bool p_cancellable, ResourceReference<Mesh>* p_reference);
+
+		/**
+		 * @brief Forget a mesh whose references were all released before its loading started.
+		 */
+		void CancelUnreferenced(const std::string& p_meshName, const ResourceHandle<Mesh>& p_handle);
+
+		void MultithreadedLoading(const std::string& p_filePath, const std::shared_ptr<Mesh>& p_mesh, const ResourceHandle<Mesh>& p_handle);
 
-		Concurrency::concurrent_unordered_map<std::string, std::shared_ptr<Mesh>> m_meshes;
-		Utils::ThreadPool m_pool;
+		/**
+		 * @brief Return the hash the manifest gives to a source if it lists it unchanged, or the one its pack archive stores.
+		 */
+		[[nodiscard]] std::optional<uint64_t> TrustedHash(const std::string& p_filePath) const;
 
 		std::hash<std::string> m_hashValueFromName;
-		std::list<std::pair<uint64_t, std::string>> m_workerToMesh;
+
+		// Shared engine pool, obtained by the constructor so it is destroyed after the service
+		Utils::JobSystem& m_jobs;
+
+		ResourceRegistry<ResourceHandle<Mesh>> m_meshes;
+		// New versions of the meshes being loaded, swapped in by SwapReloaded
+		std::vector<PendingReload<Mesh>> m_reloads;
+		std::mutex m_reloadsMutex;
+
+		std::shared_ptr<const CookManifest> m_manifest;
+		mutable std::mutex m_manifestMutex;
+
+		ResourceBudget m_budget;
+		std::atomic<uint64_t> m_residentBytes{ 0u };
+		// Incremented on every Get, orders the meshes from the least recently used
+		mutable std::atomic<uint64_t> m_useClock{ 0u };
+		std::atomic<VERTEX_LAYOUT> m_vertexLayout{ VERTEX_LAYOUT::FULL };
 	};
 }
@@ -1,10 +1,20 @@
 #pragma once
 
-#include <concurrent_unordered_map.h>
-#include <list>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <OgRendering/Export.h>
 #include <string>
-#include <OgRendering/Utils/ThreadPool.h>
+#include <OgRendering/Managers/ResourceBudget.h>
+#include <OgRendering/Managers/Loaders/CookManifest.h>
+#include <OgRendering/Managers/Loaders/TextureCache.h>
+#include <OgRendering/Managers/ResourceHandle.h>
+#include <OgRendering/Managers/ResourceRegistry.h>
+#include <OgRendering/Managers/ResourceReload.h>
+#include <OgRendering/Managers/TextureResidency.h>
+#include <OgRendering/Utils/JobSystem.h>
 #include <OgRendering/Resource/Texture.h>
 
 namespace OgEngine::Services
@@ -15,21 +25,191 @@ namespace OgEngine::Services
 		TextureService();
 		~TextureService();
 		
-		inline void Add(std::string_view p_filePath);
+		/**
+		 * @brief Load a texture on the job system, a texture already queued is moved to p_priority if it is higher.
+		 */
+		ResourceHandle<Texture> Add(std::string_view p_filePath, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load only the levels of the tail of a texture, its larger levels are read by UpdateStreaming as it is drawn larger.
+		 * A texture already loaded whole keeps its levels until the budget or its usage drops them.
+		 */
+		ResourceHandle<Texture> Stream(std::string_view p_filePath, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load a texture that is no longer needed once the references given are all released.
+		 * If nobody else added the texture, releasing the last reference before its job starts cancels the loading and forgets the texture.
+		 */
+		[[nodiscard]] ResourceReference<Texture> Request(std::string_view p_filePath, const LOAD_PRIORITY p_priority = LOAD_PRIORITY::VISIBLE);
+
+		/**
+		 * @brief Load a queued texture sooner.
+		 * @return False if the texture is unknown or its loading has already started
+		 */
+		bool Prioritize(std::string_view p_textureName, const LOAD_PRIORITY p_priority);
+
+		[[nodiscard]] std::shared_ptr<Texture> Get(std::string_view p_textureName) const;
+		[[nodiscard]] ResourceHandle<Texture> GetHandle(std::string_view p_textureName) const;
+		void WaitForAll();
+		void WaitForResource(std::string_view p_textureName);
+		[[nodiscard]] bool IsLoading(std::string_view p_textureName) const;
+
+		/**
+		 * @brief Return a reference keeping the texture from being evicted, empty if the name is unknown.
+		 */
+		[[nodiscard]] ResourceReference<Texture> Acquire(std::string_view p_textureName) const;
+
+		void SetBudget(const ResourceBudget& p_budget);
+		[[nodiscard]] const ResourceBudget& Budget() const;
+
+		/**
+		 * @brief Return the CPU memory used by the textures loaded.
+		 */
+		[[nodiscard]] uint64_t ResidentBytes() const;
+
+		/**
+		 * @brief Evict the least recently used textures nobody references until the budget is met.
+		 * @return The textures evicted, they are freed when the handles are released
+		 */
+		std::vector<ResourceHandle<Texture>> Trim();
+
+		/**
+		 * @brief Load again a texture in use, its file is cooked and loaded on the job system while the current version stays in use.
+		 * @return False if no texture of this file is loaded
+		 */
+		bool Reload(std::string_view p_filePath);
+
+		/**
+		 * @brief Replace the textures reloaded since the last call by their new version, the handles given before keep the previous one.
+		 * @note Call it from the main thread, a texture that failed to reload keeps its current version.
+		 * @return The textures replaced
+		 */
+		std::vector<ReloadedResource<Texture>> SwapReloaded();
+
+		/**
+		 * @brief Tell how large a streamed texture is drawn, call it every frame the texture is drawn.
+		 * @param p_screenSize Pixels covered on screen along the largest side of the texture
+		 */
+		void ReportUsage(std::string_view p_textureName, const float p_screenSize);
+
+		/**
+		 * @brief Read the levels the streamed textures need and drop the ones they don't, then replace the textures whose levels were read.
+		 * @note Call it from the main thread once per frame, after the usages are reported.
+		 * @return The textures replaced, the previous version is the one to replace in the renderer
+		 */
+		std::vector<ReloadedResource<Texture>> UpdateStreaming();
+
+		void SetStreamingBudget(const TextureStreamingBudget& p_budget);
+		[[nodiscard]] const TextureStreamingBudget& StreamingBudget() const;
+
+		/**
+		 * @brief Find the cooked files of the textures loaded from now on through a cook manifest, a source it lists unchanged isn't hashed.
+		 */
+		void SetManifest(std::shared_ptr<const CookManifest> p_manifest);
+
+		/**
+		 * @brief Cook the textures loaded from now on in BC1/BC3 rather than RGBA8, off by default.
+		 * @note Lossy, the cooked files of the other setting are cooked again.
+		 */
+		void SetBlockCompression(const bool p_compress);
+		[[nodiscard]] bool BlockCompression() const;
+
+		/**
+		 * @brief Filter the mip chains of the textures loaded from now on, box without gamma correction by default.
+		 * @param p_srgb Filter the colors in linear space, for the textures stored in sRGB
+		 */
+		void SetMipFilter(const Utils::MIP_FILTER p_filter, const bool p_srgb);
+		[[nodiscard]] TextureCache::CookSettings CookSettings() const;
+
+		/**
+		 * @brief Free the pixels of a texture uploaded to the GPU, if the budget asks for it.
+		 */
+		void ReleaseCpuData(std::string_view p_textureName);
 
-		[[nodiscard]] inline std::shared_ptr<Texture> Get(std::string_view p_textureName) const;
-		inline void WaitForAll() { m_pool.WaitForWorkers(); }
-		inline void WaitForResource(std::string_view p_textureName);
 		std::vector<Texture*>& GetAllTextures();
 
 	private:
-		inline void MultithreadedLoading(std::string_view p_filePath);
+		/**
+		 * @brief Register a texture and queue its loading, or return the texture already registered.
+		 * @param p_cancellable True if the loading may be cancelled once the references are released, an Add makes it false for good
+		 * @param p_reference Set to a reference to the texture if not nullptr
+		 */
+		ResourceHandle<Texture> Load(std::string_view p_filePath, const LOAD_PRIORITY p_priority, const bool p_cancellable, ResourceReference<Texture>* p_reference);
+
+		/**
+		 * @brief Forget a texture whose references were all released before its loading started.
+		 */
+		void CancelUnreferenced(const std::string& p_textureName, const ResourceHandle<Texture>& p_handle);
+
+		/**
+		 * @param p_maxSize Largest width or height of the levels loaded, 0 for all of them, a texture cooked now is loaded whole
+		 */
+		void MultithreadedLoading(const std::string& p_filePath, const uint32_t p_maxSize, const std::shared_ptr<Texture>& p_texture,
+			const ResourceHandle<Texture>& p_handle);
+
+		/**
+		 * @brief Read the levels of a streamed texture from its cooked file.
+		 */
+		void StreamLevels(const uint64_t p_sourceHash, const uint32_t p_maxSize, const std::shared_ptr<Texture>& p_texture,
+			const ResourceHandle<Texture>& p_handle);
+
+		/**
+		 * @brief Give the residency the levels of a streamed texture once it is loaded.
+		 */
+		void AddToResidency(const std::string& p_textureName, const Texture& p_texture);
+
+		/**
+		 * @brief Return the largest width or height of the levels to load for a texture, 0 if it isn't streamed.
+		 */
+		[[nodiscard]] uint32_t StreamedMaxSize(const std::string& p_textureName) const;
 
-		Concurrency::concurrent_unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
-		Utils::ThreadPool m_pool;
+		/**
+		 * @brief Return the hash the manifest gives to a source if it lists it unchanged, or the one its pack archive stores.
+		 */
+		[[nodiscard]] std::optional<uint64_t> TrustedHash(const std::string& p_filePath) const;
 
-		const std::hash<std::string> m_hashValueFromName;
-		std::list<std::pair<uint64_t, std::string>> m_workerToTexture;
+		const std::hash<std::string> m_hashValueFromName{};
 		std::vector<Texture*> m_texturesRefs;
+
+		// Shared engine pool, obtained by the constructor so it is destroyed after the service
+		Utils::JobSystem& m_jobs;
+
+		ResourceRegistry<ResourceHandle<Texture>> m_textures;
+		// New versions of the textures being loaded, swapped in by SwapReloaded
+		std::vector<PendingReload<Texture>> m_reloads;
+		std::mutex m_reloadsMutex;
+
+		std::shared_ptr<const CookManifest> m_manifest;
+		mutable std::mutex m_manifestMutex;
+
+		/**
+		 * @brief Levels of a streamed texture being read, swapped in by UpdateStreaming.
+		 */
+		struct PendingStream
+		{
+			std::string name;
+			uint32_t firstLevel;
+			// The version the levels replace, the ones read are dropped if it was reloaded or evicted meanwhile
+			std::shared_ptr<Texture> previous;
+			ResourceHandle<Texture> handle;
+		};
+
+		// Only used by the main thread
+		TextureResidency m_residency;
+		std::vector<PendingStream> m_streams;
+
+		// The names streamed, and the ones to give the residency once loaded, Reload runs on the thread of the watcher
+		std::unordered_set<std::string> m_streamedNames;
+		std::unordered_set<std::string> m_streamedLoading;
+		uint32_t m_streamingTailSize{ TextureStreamingBudget{}.tailSize };
+		mutable std::mutex m_streamedMutex;
+
+		ResourceBudget m_budget;
+		std::atomic<uint64_t> m_residentBytes{ 0u };
+		// Incremented on every Get, orders the textures from the least recently used
+		mutable std::atomic<uint64_t> m_useClock{ 0u };
+		// Copied by each loading job
+		TextureCache::CookSettings m_cookSettings;
+		mutable std::mutex m_cookSettingsMutex;
 	};
 }
@@ -0,0 +1,146 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Limits applied by the texture residency on each update.
+	 */
+	struct TextureStreamingBudget
+	{
+		/**
+		 * @brief Size of the levels resident or being read above which the largest levels are given up first.
+		 * The tails are always kept, even above it.
+		 */
+		uint64_t maxResidentBytes{ 256u * 1024u * 1024u };
+
+		/**
+		 * @brief The levels whose width and height are at most this are loaded with the texture, so a material shows at once.
+		 */
+		uint32_t tailSize{ 64u };
+
+		/**
+		 * @brief Number of textures whose larger levels are read at the same time.
+		 */
+		uint32_t maxLoadsInFlight{ 4u };
+
+		/**
+		 * @brief Number of updates a texture keeps its levels without any usage reported, it then goes back to its tail.
+		 */
+		uint32_t unusedUpdatesBeforeDrop{ 120u };
+	};
+
+	/**
+	 * @brief A texture to read again from one of its levels: the larger levels are dropped, the missing ones loaded.
+	 */
+	struct TextureStreamingRequest
+	{
+		std::string name;
+		uint32_t firstLevel;
+	};
+
+	/**
+	 * @brief Choose which mip levels of the streamed textures are resident, from how large they are drawn and a memory budget.
+	 * The residency only plans: it knows nothing of the files nor of the GPU, whoever reads the levels answers each request with OnLoaded.
+	 * Not thread safe, drive it from a single thread.
+	 */
+	class RENDERING_API TextureResidency final
+	{
+	public:
+		/**
+		 * @brief Start streaming a texture, a texture already streamed is replaced.
+		 * @param p_levelSizes Size of each level of the whole mip chain, from the largest one
+		 * @param p_width Width of the largest level
+		 * @param p_height Height of the largest level
+		 * @param p_residentLevel First level loaded
+		 */
+		void Add(const std::string& p_name, std::vector<uint64_t> p_levelSizes, const uint32_t p_width, const uint32_t p_height,
+			const uint32_t p_residentLevel);
+		void Remove(const std::string& p_name);
+		[[nodiscard]] bool Contains(const std::string& p_name) const;
+
+		/**
+		 * @brief Tell how large a texture is drawn, the largest size reported between two updates is kept.
+		 * @param p_screenSize Pixels covered on screen along the largest side of the texture
+		 */
+		void ReportUsage(const std::string& p_name, const float p_screenSize);
+
+		/**
+		 * @brief Choose the first level of each texture within the budget and return the textures to read again.
+		 * The textures dropping levels come first, then the ones missing their tail, then the ones missing the most levels until maxLoadsInFlight are being read.
+		 * @note Answer each request with OnLoaded, the texture gets no other request until then.
+		 */
+		std::vector<TextureStreamingRequest> Update();
+
+		/**
+		 * @brief Tell a request is done.
+		 * @param p_success False if the levels couldn't be read, the texture then keeps its levels and isn't streamed anymore
+		 */
+		void OnLoaded(const std::string& p_name, const bool p_success);
+
+		/**
+		 * @brief Return the first level loaded of a texture, 0 if it isn't streamed.
+		 */
+		[[nodiscard]] uint32_t ResidentLevel(const std::string& p_name) const;
+
+		/**
+		 * @brief Return the first level a texture needs for its last usage reported, before the budget is applied.
+		 */
+		[[nodiscard]] uint32_t DesiredLevel(const std::string& p_name) const;
+
+		/**
+		 * @brief Return the size of the levels resident or being read.
+		 */
+		[[nodiscard]] uint64_t ResidentBytes() const;
+		[[nodiscard]] uint32_t LoadsInFlight() const;
+
+		/**
+		 * @brief Return the first level whose width and height are at most p_tailSize, the last level if there is none.
+		 */
+		[[nodiscard]] static uint32_t TailLevel(const uint32_t p_width, const uint32_t p_height, const uint32_t p_levelCount,
+			const uint32_t p_tailSize);
+
+		/**
+		 * @brief Return the smallest level still as large as the texture is drawn, so a texel never covers more than a pixel.
+		 * @param p_screenSize Pixels covered on screen along the largest side of the texture
+		 */
+		[[nodiscard]] static uint32_t LevelForScreenSize(const uint32_t p_width, const uint32_t p_height, const uint32_t p_levelCount,
+			const float p_screenSize);
+
+		TextureStreamingBudget budget;
+
+	private:
+		struct StreamedTexture
+		{
+			// Size of the levels from each level to the last one
+			std::vector<uint64_t> bytesFrom;
+			uint32_t width{ 0u };
+			uint32_t height{ 0u };
+			uint32_t residentLevel{ 0u };
+			uint32_t requestedLevel{ 0u };
+			uint32_t targetLevel{ 0u };
+			bool isLoading{ false };
+			bool isFailed{ false };
+			// Largest size reported since the last update, and the one of the last update that got any
+			float screenSize{ 0.0f };
+			float lastScreenSize{ 0.0f };
+			uint32_t unusedUpdates{ 0u };
+		};
+
+		[[nodiscard]] uint32_t TailLevel(const StreamedTexture& p_texture) const;
+		[[nodiscard]] uint32_t DesiredLevel(const StreamedTexture& p_texture) const;
+		/**
+		 * @brief Return the size counted for a texture, its largest levels while a request is in flight.
+		 */
+		[[nodiscard]] static uint64_t CountedBytes(const StreamedTexture& p_texture);
+
+		std::unordered_map<std::string, StreamedTexture> m_textures;
+		uint64_t m_residentBytes{ 0u };
+		uint32_t m_loadsInFlight{ 0u };
+	};
+}
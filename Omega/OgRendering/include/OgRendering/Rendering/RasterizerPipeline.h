@@ -8,6 +8,7 @@
 #include <OgRendering/Resource/Mesh.h>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <OgRendering/UI/imgui/imgui.h>
 #include <OgRendering/Resource/ObjectInstance.h>
 #include <OgRendering/Resource/Texture.h>
@@ -18,6 +19,8 @@
 
 #define MAX_TEXTURES_RS 64
 #define MAX_OBJECTS_RS 500
+// Error on screen, in pixels, up to which a simplified level of a mesh is drawn instead of it
+#define LOD_PIXEL_ERROR_RS 1.0f
 
 namespace OgEngine
 {
@@ -117,6 +120,30 @@ namespace OgEngine
 		 */
 		void CleanAllObjectInstance();
 
+		/**
+		 * @brief Destroy the vertex and index buffers of a mesh, once no object uses it (after a reload for instance).
+		 * @param p_mesh The mesh, it may already be freed as only its address is used
+		 */
+		void DestroyMeshBuffers(Mesh* p_mesh);
+
+		/**
+		 * @brief Give the objects drawn with a texture its new version, with other mip levels, and destroy the image of the previous one.
+		 * @param p_previous The previous version, it may already be freed as only its address is used
+		 * @param p_texture The new version, its image is created if it has none yet
+		 */
+		void ReplaceTexture(Texture* p_previous, Texture* p_texture);
+
+		/**
+		 * @brief Destroy the image of a texture, once no object uses it (after its eviction for instance).
+		 * @param p_texture The texture, it may already be freed as only its address is used
+		 */
+		void DestroyTexture(Texture* p_texture);
+
+		/**
+		 * @brief Create the graphics pipelines again from the SPIR-V files, after they were compiled again.
+		 */
+		void ReloadShaders();
+
 		/**
 		* @brief Loads an image from path in an understandable format for ImGui
 		* @param p_texturePath is the path of the texture to load
@@ -167,13 +194,18 @@ namespace OgEngine
 		[[nodiscard]] VkFormat FindDepthFormat() const;
 		[[nodiscard]] VkFormat FindSupportedFormat(const std::vector<VkFormat>& p_candidates, VkImageTiling p_tiling, VkFormatFeatureFlags p_features) const;
 		[[nodiscard]] VkExtent2D ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& p_capabilities) const;
-		[[nodiscard]] VkImageView CreateImageView(VkImage p_image, VkFormat p_format, VkImageAspectFlags p_aspectFlags, uint32_t p_mipLevels) const;
+		[[nodiscard]] VkImageView CreateImageView(VkImage p_image, VkFormat p_format, VkImageAspectFlags p_aspectFlags, uint32_t p_mipLevels,
+			const VkComponentMapping& p_components = {}) const;
 		[[nodiscard]] uint32_t FindMemoryType(uint32_t p_typeFilter, VkMemoryPropertyFlags p_properties) const;
 		[[nodiscard]] VkCommandBuffer BeginSingleTimeCommands() const;
 		void EndSingleTimeCommands(VkCommandBuffer p_commandBuffer) const;
 		void CreateImage(uint32_t p_width, uint32_t p_height, uint32_t p_mipLevels, VkSampleCountFlagBits p_numSamples, VkFormat p_format, VkImageTiling p_tiling, VkImageUsageFlags p_usage, VkMemoryPropertyFlags p_properties, VkImage& p_image, VkDeviceMemory& p_imageMemory) const;
 		void CopyBuffer(VkBuffer p_srcBuffer, VkBuffer p_dstBuffer, VkDeviceSize p_size) const;
 		void CopyBufferToImage(const VkBuffer p_buffer, const VkImage p_image, const uint32_t p_width, const uint32_t p_height) const;
+		/**
+		 * @brief Copy each level stored in a buffer to the mip level of the same index.
+		 */
+		void CopyBufferToImage(const VkBuffer p_buffer, const VkImage p_image, const std::vector<MipLevel>& p_levels) const;
 		void GenerateMipmaps(VkImage p_image, VkFormat p_imageFormat, int32_t p_texWidth, int32_t p_texHeight, uint32_t p_mipLevels) const;
 		void CreateBuffer(const VkDeviceSize p_size, const VkBufferUsageFlags p_usage, VkMemoryPropertyFlags p_properties, VkBuffer& p_buffer, VkDeviceMemory& p_bufferMemory, const size_t p_dynamicOffset = 0) const;
 		VkResult CreateBuffer(VkBufferUsageFlags p_usageFlags, VkMemoryPropertyFlags p_memoryPropertyFlags, Buffer* p_buffer, VkDeviceSize p_size, void* p_data = nullptr) const;
@@ -203,7 +235,11 @@ namespace OgEngine
 		[[nodiscard]] VkDescriptorImageInfo Create2DDescriptor(const VkImage& p_image, const VkSamplerCreateInfo& p_samplerCreateInfo, const VkFormat& p_format, const VkImageLayout& p_layout) const;
 		void CreatePipelineCache();
 
-		void CreateVertexBuffer(Mesh* p_mesh, Buffer* p_objectInstance) const;
+		/**
+		 * @brief Return true if the mesh is drawn from its packed vertices, false if the packed pipeline couldn't be created.
+		 */
+		[[nodiscard]] bool UsesPackedVertices(const Mesh* p_mesh) const;
+		void CreateVertexBuffer(Mesh* p_mesh, Buffer* p_objectInstance, const bool p_packed) const;
 		void CreateIndexBuffer(Mesh* p_mesh, Buffer* p_objectInstance) const;
 		void AllocateBufferArray(ObjectInstance& p_objectInstance) const;
 		void AllocateDescriptorSet(ObjectInstance& p_objectInstance) const;
@@ -250,6 +286,8 @@ namespace OgEngine
 		VkDescriptorSetLayout m_descriptorSetLayout{};
 		VkPipelineLayout m_pipelineLayout{};
 		VkPipeline m_graphicsPipeline{};
+		// Same layout and states, reads PackedVertex. Null if its shader isn't compiled, every mesh is then drawn with its full vertices
+		VkPipeline m_packedGraphicsPipeline{};
 
 		// ImGUI
 #pragma region IMGUIMembers
@@ -297,6 +335,8 @@ namespace OgEngine
 
 		std::unordered_map<std::uint64_t, ObjectInstance> m_buffers;
 		std::unordered_map<Mesh*, std::pair<Buffer, Buffer>> m_meshesBuffers;
+		// The meshes whose vertex buffer holds PackedVertex
+		std::unordered_set<Mesh*> m_packedMeshes;
 		//Window size
 		uint32_t m_width{ 0u };
 		uint32_t m_height{ 0u };
@@ -346,6 +346,12 @@ namespace OgEngine
         */
         void AddTexture(const std::string& p_texture, const TEXTURE_TYPE p_type = TEXTURE_TYPE::TEXTURE);
 
+        /**
+        *   @brief Upload again a texture given to AddTexture, after the resource manager replaced it by a version with other mip levels
+        *   @param p_texture Name of the texture, the entities using it keep its index
+        */
+        void ReplaceTexture(const std::string& p_texture);
+
         /**
         *   @brief Create texture mipmaps
         *   @param p_image texture image previously loaded and allocated
@@ -367,6 +373,14 @@ namespace OgEngine
         */
         VkDescriptorImageInfo CreateTextureDescriptor(const VkDevice& p_device, TextureData& p_image, const VkSamplerCreateInfo& p_samplerCreateInfo, const VkFormat& p_format, const VkImageLayout& p_layout);
 
+        /**
+        *   @brief Create the image, the view and the sampler of a texture with the levels it holds
+        *   @param p_texture The texture to upload
+        *   @param p_type The normal maps are stored linearly, the other textures in sRGB
+        *   @return The image data, not yet referenced by the descriptor sets
+        */
+        TextureData UploadTexture(const Texture* p_texture, const TEXTURE_TYPE p_type);
+
         /**
         *   @brief Updates or creates the given entity with the new data sent
         *   @param p_id is the entity id
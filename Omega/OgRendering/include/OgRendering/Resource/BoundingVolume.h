@@ -0,0 +1,61 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <limits>
+#include <vector>
+
+#include <GPM/GPM.h>
+#include <OgRendering/Resource/Vertex.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Axis-aligned box, empty until a point is added (its minimum is above its maximum).
+	 */
+	struct RENDERING_API BoundingBox
+	{
+		GPM::Vector3F minimum{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		GPM::Vector3F maximum{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+		[[nodiscard]] bool Empty() const;
+		[[nodiscard]] GPM::Vector3F Center() const;
+		/**
+		 * @brief Half the size of the box on each axis.
+		 */
+		[[nodiscard]] GPM::Vector3F Extents() const;
+
+		/**
+		 * @brief Box around the transformed box, from its transformed center and extents.
+		 * @param p_transform Transform of the points, with the translation in the last column
+		 */
+		[[nodiscard]] BoundingBox Transformed(const GPM::Matrix4F& p_transform) const;
+
+		/**
+		 * @brief Box around the positions of vertices, reduced four vertices at a time with SSE when the processor has it.
+		 */
+		[[nodiscard]] static BoundingBox FromVertices(const std::vector<Vertex>& p_vertices);
+	};
+
+	/**
+	 * @brief Sphere, empty while its radius is negative.
+	 */
+	struct RENDERING_API BoundingSphere
+	{
+		GPM::Vector3F center{ 0.0f, 0.0f, 0.0f };
+		float radius{ -1.0f };
+
+		[[nodiscard]] bool Empty() const;
+
+		/**
+		 * @brief Sphere around the transformed sphere, its radius scaled by the largest scale of the transform.
+		 * @param p_transform Transform of the points, with the translation in the last column
+		 */
+		[[nodiscard]] BoundingSphere Transformed(const GPM::Matrix4F& p_transform) const;
+
+		/**
+		 * @brief Sphere centered on the box of vertices, reaching their farthest position.
+		 * @param p_box Box around the vertices, given by BoundingBox::FromVertices
+		 */
+		[[nodiscard]] static BoundingSphere FromVertices(const std::vector<Vertex>& p_vertices, const BoundingBox& p_box);
+	};
+}
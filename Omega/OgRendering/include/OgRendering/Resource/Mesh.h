@@ -1,8 +1,12 @@
 #pragma once
 #include <OgRendering/Export.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
-#include <OgRendering/Resource/Vertex.h>
+#include <OgRendering/Resource/BoundingVolume.h>
+#include <OgRendering/Resource/MeshLod.h>
+#include <OgRendering/Resource/Meshlet.h>
+#include <OgRendering/Resource/PackedVertex.h>
 
 namespace OgEngine
 {
@@ -12,9 +16,16 @@ namespace OgEngine
 		Mesh();
 		Mesh(const Mesh& p_other);
 		Mesh(Mesh&& p_other) noexcept;
+		/**
+		 * @brief Take the buffers of the mesh, given with std::move they are adopted without a copy.
+		 */
 		Mesh(std::vector<Vertex> p_vertices, std::vector<uint32_t> p_indices);
 		~Mesh();
 
+		/**
+		 * @brief Adopt the data of a mesh loaded for this one, its buffers are moved and not copied, the other mesh is left empty.
+		 * The name, path and hash of this mesh are kept.
+		 */
 		void FillData(const std::shared_ptr<Mesh>& p_other);
 		void SetMeshName(const std::string& p_meshName);
 		void SetParentMeshName(const std::string& p_parentMeshName);
@@ -23,9 +34,62 @@ namespace OgEngine
 		void AddSubMesh(const std::shared_ptr<Mesh>& p_newSubMesh);
 		void SetAsSubmesh(const bool p_isSubMesh);
 		void SetIndexSubmesh(const int p_subMeshIndex);
+		/**
+		 * @brief Choose how the rasterizer reads the vertices of the mesh and of its submeshes, FULL by default.
+		 * PACKED encodes the vertices once, the full ones are kept for the raytracer and the loaders.
+		 */
+		void SetVertexLayout(const VERTEX_LAYOUT p_layout);
+		/**
+		 * @brief Give the meshlets built from the indices of the mesh, see Utils::MeshletBuilder.
+		 */
+		void SetMeshlets(MeshletData p_meshlets);
+		/**
+		 * @brief Give the simplified levels of the mesh, from the finest to the coarsest, see Utils::MeshSimplifier.
+		 */
+		void SetLods(std::vector<MeshLod> p_lods);
+		/**
+		 * @brief Compute the bounding box and sphere of the vertices of the mesh and of its submeshes.
+		 */
+		void ComputeBounds();
+		/**
+		 * @brief Give bounds computed beforehand, those of a cooked mesh.
+		 */
+		void SetBounds(const BoundingBox& p_box, const BoundingSphere& p_sphere);
 
 		[[nodiscard]] const std::vector<OgEngine::Vertex>& Vertices() const;
 		[[nodiscard]] const std::vector<uint32_t>& Indices() const;
+		[[nodiscard]] VERTEX_LAYOUT VertexLayout() const;
+		/**
+		 * @brief Return the vertices encoded by SetVertexLayout, empty with the FULL layout.
+		 */
+		[[nodiscard]] const std::vector<PackedVertex>& PackedVertices() const;
+		/**
+		 * @brief Return the meshlets of the mesh, empty if it isn't a triangle list or wasn't imported.
+		 */
+		[[nodiscard]] const MeshletData& Meshlets() const;
+		/**
+		 * @brief Return the simplified levels of the mesh, level 0 being the mesh itself they start at level 1.
+		 */
+		[[nodiscard]] const std::vector<MeshLod>& Lods() const;
+		/**
+		 * @brief Return the indices of a level, those of the mesh for level 0 or a level past the last one.
+		 */
+		[[nodiscard]] const std::vector<uint32_t>& LodIndices(const size_t p_level) const;
+		/**
+		 * @brief Choose the coarsest level whose error is within a bound.
+		 * @param p_maxError Error allowed, in the units of the mesh
+		 * @return The level, 0 for the mesh itself
+		 */
+		[[nodiscard]] size_t SelectLod(const float p_maxError) const;
+		/**
+		 * @brief Return the box around the vertices of the mesh, in its own space, without its submeshes.
+		 * Empty until the bounds are computed or given, see BoundingBox::Transformed for the world space.
+		 */
+		[[nodiscard]] const BoundingBox& LocalBox() const;
+		/**
+		 * @brief Return the sphere around the vertices of the mesh, in its own space, without its submeshes.
+		 */
+		[[nodiscard]] const BoundingSphere& LocalSphere() const;
 		[[nodiscard]] std::string MeshName() const;
 		[[nodiscard]] std::string ParentMeshName() const;
 		[[nodiscard]] std::string MeshFilepath() const;
@@ -33,6 +97,10 @@ namespace OgEngine
 		[[nodiscard]] std::vector<std::shared_ptr<Mesh>>& SubMeshes();
 		[[nodiscard]] bool IsSubMesh() const;
 		[[nodiscard]] int SubMeshIndex() const;
+		/**
+		 * @brief Return the memory used by the vertices and indices of the mesh and of its submeshes.
+		 */
+		[[nodiscard]] uint64_t CpuBytes() const;
 
 		Mesh& operator=(const Mesh& p_other);
 		Mesh& operator=(Mesh&& p_other) noexcept;
@@ -40,6 +108,11 @@ namespace OgEngine
 	private:
 		std::vector<Vertex> m_vertices;
 		std::vector<uint32_t> m_indices;
+		std::vector<PackedVertex> m_packedVertices;
+		MeshletData m_meshlets;
+		std::vector<MeshLod> m_lods;
+		BoundingBox m_localBox;
+		BoundingSphere m_localSphere;
 		std::vector<std::shared_ptr<Mesh>> m_subMeshes;
 		std::string m_meshName;
 		std::string m_parentMeshName;
@@ -47,5 +120,6 @@ namespace OgEngine
 		uint64_t m_hashID{};
 		int m_subMeshIndex;
 		bool m_isSubmesh;
+		VERTEX_LAYOUT m_vertexLayout{ VERTEX_LAYOUT::FULL };
 	};
 }
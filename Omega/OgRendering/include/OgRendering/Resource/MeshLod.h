@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Simplified level of a mesh, drawn instead of it from far away.
+	 * The level only has its own indices, they index the vertices of the mesh.
+	 */
+	struct MeshLod
+	{
+		std::vector<uint32_t> indices;
+		/**
+		 * @brief How far the level strays from the mesh, the quadric error of its worst collapse in the units of the mesh.
+		 */
+		float error{ 0.0f };
+	};
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace OgEngine
+{
+	/**
+	 * @brief Cluster of a triangle list, small enough to be culled or given to a mesh shader group as a whole.
+	 * The triangles of a meshlet are contiguous in the index buffer of its mesh, from triangleOffset.
+	 * Laid out in vec4s, so an array of meshlets can be read as it is by a std430 storage buffer.
+	 */
+	struct Meshlet
+	{
+		/**
+		 * @brief Sphere bounding the vertices of the meshlet.
+		 */
+		float center[3]{};
+		float radius{ 0.0f };
+		/**
+		 * @brief The meshlet faces away from the eyes e with dot(normalize(coneApex - e), coneAxis) >= coneCutoff.
+		 * The cutoff is above 1 when the triangles face too many directions to be culled that way.
+		 */
+		float coneApex[3]{};
+		float coneCutoff{ 2.0f };
+		float coneAxis[3]{};
+		/**
+		 * @brief First triangle of the meshlet, in the index buffer of the mesh and in MeshletData::triangles.
+		 */
+		uint32_t triangleOffset{ 0u };
+		/**
+		 * @brief First vertex of the meshlet in MeshletData::vertices.
+		 */
+		uint32_t vertexOffset{ 0u };
+		uint32_t vertexCount{ 0u };
+		uint32_t triangleCount{ 0u };
+		uint32_t padding{ 0u };
+	};
+
+	static_assert(sizeof(Meshlet) == 64u, "A meshlet is read as four vec4s.");
+
+	/**
+	 * @brief The meshlets of a mesh, built by Utils::MeshletBuilder.
+	 */
+	struct MeshletData
+	{
+		std::vector<Meshlet> meshlets;
+		/**
+		 * @brief Indices in the vertices of the mesh, the vertices of each meshlet in the order its triangles use them.
+		 */
+		std::vector<uint32_t> vertices;
+		/**
+		 * @brief Three indices per triangle, local to the vertices of its meshlet.
+		 */
+		std::vector<uint8_t> triangles;
+
+		[[nodiscard]] bool Empty() const
+		{
+			return meshlets.empty();
+		}
+
+		[[nodiscard]] uint64_t Bytes() const
+		{
+			return meshlets.size() * sizeof(Meshlet) + vertices.size() * sizeof(uint32_t) + triangles.size() * sizeof(uint8_t);
+		}
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <OgRendering/Export.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <OgRendering/Resource/Vertex.h>
+
+namespace OgEngine
+{
+	/**
+	 * @brief How the vertices of a mesh are given to the rasterizer.
+	 */
+	enum class VERTEX_LAYOUT : uint8_t
+	{
+		/**
+		 * @brief The 56 bytes of Vertex, read as they are.
+		 */
+		FULL,
+		/**
+		 * @brief The 24 bytes of PackedVertex, decoded by the vertex shader.
+		 */
+		PACKED
+	};
+
+	/**
+	 * @brief Compact vertex for the rasterizer: float position, octahedral normal and tangent, half-float texture coordinates.
+	 * The normal and tangent are kept within 0.05 degree, the texture coordinates within 1/2048 of their value.
+	 */
+	struct RENDERING_API PackedVertex
+	{
+		float position[3]{};
+		/**
+		 * @brief Unit vectors folded on an octahedron, in 16 bits signed normalized components.
+		 */
+		int16_t normal[2]{};
+		int16_t tangent[2]{};
+		/**
+		 * @brief Half-floats, the coordinates beyond 65504 are clamped.
+		 */
+		uint16_t texCoord[2]{};
+
+		static VkVertexInputBindingDescription getBindingDescription();
+
+		/**
+		 * @brief Return the attributes read by rast_vert_packed.vert, the tangent is stored but not given to the shader.
+		 */
+		static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions();
+
+		/**
+		 * @brief Encode vertices, four at a time with SSE2 when the processor has it.
+		 */
+		[[nodiscard]] static std::vector<PackedVertex> Pack(const std::vector<Vertex>& p_vertices);
+
+		/**
+		 * @brief Decode vertices back to the full layout, the normals and tangents are renormalized.
+		 */
+		[[nodiscard]] static std::vector<Vertex> Unpack(const std::vector<PackedVertex>& p_vertices);
+	};
+
+	static_assert(sizeof(PackedVertex) == 24u, "The attribute descriptions expect a 24 bytes vertex.");
+}
@@ -3,12 +3,74 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <vulkan/vulkan.h>
 
 #include <OgRendering/Rendering/stb_image.h>
 
 namespace OgEngine
 {
+	/**
+	 * @brief Layout of the pixels of a texture, a decoded image keeps the channels and the bit depth of its file.
+	 * The 8 and 16 bits channels are unsigned normalized, the 32 bits ones are floats.
+	 */
+	enum class TEXTURE_FORMAT : uint32_t
+	{
+		RGBA8,
+		BC1,
+		BC3,
+		R8,
+		RG8,
+		RGB8,
+		R16,
+		RG16,
+		RGB16,
+		RGBA16,
+		R32F,
+		RG32F,
+		RGB32F,
+		RGBA32F
+	};
+
+	struct TextureFormatInfo
+	{
+		uint32_t channels;
+		/**
+		 * @brief 1, 2 or 4, 0 for the block compressed formats.
+		 */
+		uint32_t channelBytes;
+		bool isFloat;
+
+		[[nodiscard]] bool IsCompressed() const { return channelBytes == 0u; }
+		[[nodiscard]] uint32_t PixelBytes() const { return channels * channelBytes; }
+	};
+
+	/**
+	 * @brief A level of the mip chain stored by a texture, the offset is in bytes from Pixels().
+	 */
+	struct MipLevel
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	/**
+	 * @brief The cooked file a texture was read from, a streamed texture only holds the levels from firstLevel.
+	 */
+	struct TextureSource
+	{
+		/**
+		 * @brief Hash of the source file naming the cooked file, 0 if the texture wasn't cooked.
+		 */
+		uint64_t hash{ 0u };
+		uint32_t width{ 0u };
+		uint32_t height{ 0u };
+		uint32_t levelCount{ 0u };
+		uint32_t firstLevel{ 0u };
+	};
+
 	class RENDERING_API Texture final
 	{
 	public:
@@ -18,10 +80,23 @@ namespace OgEngine
 		~Texture();
 
 		void FillData(stbi_uc* p_pixels, const uint32_t p_width, const uint32_t p_height,
-			const uint32_t p_mipmapLevels);
+			const uint32_t p_mipmapLevels, const TEXTURE_FORMAT p_format = TEXTURE_FORMAT::RGBA8);
+		/**
+		 * @brief Fill the texture with precomputed mip levels, all stored in the same buffer.
+		 * @param p_data The levels, allocated with malloc as the texture frees it like the pixels of stbi
+		 * @param p_levels Where each level is in p_data, from the largest one
+		 */
+		void FillData(stbi_uc* p_data, const uint32_t p_width, const uint32_t p_height, const TEXTURE_FORMAT p_format,
+			std::vector<MipLevel> p_levels);
 		void FillData(const std::shared_ptr<Texture>& p_other);
 
 		void SetHashID(const uint64_t p_hashID);
+		void SetSource(const TextureSource& p_source);
+
+		/**
+		 * @brief Free the pixels, the size of the texture is kept.
+		 */
+		void ReleaseCpuData();
 
 		[[nodiscard]] stbi_uc* Pixels() const;
 		[[nodiscard]] VkDeviceSize ImageSize() const;
@@ -29,6 +104,52 @@ namespace OgEngine
 		[[nodiscard]] uint32_t Height() const;
 		[[nodiscard]] uint64_t HashID() const;
 		[[nodiscard]] uint32_t MipmapLevels() const;
+		[[nodiscard]] TEXTURE_FORMAT Format() const;
+		/**
+		 * @brief Return the format of the image created for the texture.
+		 * @param p_srgb If the colors are stored in sRGB, false for the data such as the normal maps, only the 8 bits formats have a sRGB version
+		 */
+		[[nodiscard]] VkFormat VulkanFormat(const bool p_srgb) const;
+		/**
+		 * @brief Return the swizzle of the image views of the texture, a grayscale image is read as gray in the RGB channels.
+		 */
+		[[nodiscard]] VkComponentMapping VulkanSwizzle() const;
+
+		/**
+		 * @brief Return the pixels expanded to 4 channels of the same depth, in the format given by RgbaFormat.
+		 * For the GPUs that can't sample the format of the texture, the gray is copied in the RGB channels and a missing alpha is opaque.
+		 * @param p_levels Filled with where each level is in the returned buffer
+		 */
+		[[nodiscard]] std::vector<uint8_t> RgbaPixels(std::vector<MipLevel>& p_levels) const;
+		/**
+		 * @brief Return the first level in RGBA8, for the images drawn by the UI which only reads this format.
+		 * @return The pixels, empty for a block compressed texture
+		 */
+		[[nodiscard]] std::vector<uint8_t> Rgba8Pixels() const;
+
+		[[nodiscard]] static const TextureFormatInfo& FormatInfo(const TEXTURE_FORMAT p_format);
+		/**
+		 * @brief Return the uncompressed format of an image.
+		 * @param p_channelBytes 1 or 2 for unsigned normalized channels, 4 for floats
+		 */
+		[[nodiscard]] static TEXTURE_FORMAT FormatOf(const uint32_t p_channels, const uint32_t p_channelBytes);
+		[[nodiscard]] static VkFormat VulkanFormat(const TEXTURE_FORMAT p_format, const bool p_srgb);
+		/**
+		 * @brief Return the 4 channels format of the same depth, a block compressed format is returned as it is.
+		 */
+		[[nodiscard]] static TEXTURE_FORMAT RgbaFormat(const TEXTURE_FORMAT p_format);
+		/**
+		 * @brief Return the levels stored by Pixels(), the levels after them are generated by the GPU.
+		 */
+		[[nodiscard]] const std::vector<MipLevel>& Levels() const;
+		/**
+		 * @brief Return the memory used by the pixels, 0 once released.
+		 */
+		[[nodiscard]] uint64_t CpuBytes() const;
+		/**
+		 * @brief Return the cooked file the texture was read from, Width(), Height() and Levels() start at its first level.
+		 */
+		[[nodiscard]] const TextureSource& Source() const;
 
 		Texture& operator=(const Texture& p_other);
 		Texture& operator=(Texture&& p_other) noexcept;
@@ -40,5 +161,8 @@ namespace OgEngine
 		uint32_t m_width{};
 		uint32_t m_height{};
 		uint32_t m_mipmapLevels{};
+		TEXTURE_FORMAT m_format{ TEXTURE_FORMAT::RGBA8 };
+		std::vector<MipLevel> m_levels;
+		TextureSource m_source;
 	};
 }
@@ -10,4 +10,6 @@ struct TextureData
 	VkSampler sampler;
 	VkImageView view;
 	std::uint32_t mipLevels;
+	VkFormat format;
+	VkComponentMapping components;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Watch the files of a directory and of its subdirectories from a thread of its own.
+	 * The changes are debounced: the files are reported once nothing touched them for a while, so a file written in several steps, or files saved together, are reported once.
+	 * @note Uses inotify on Linux, the other systems compare the modification times of the files a few times per second.
+	 */
+	class RENDERING_API FileWatcher final
+	{
+	public:
+		/**
+		 * @brief Called from the thread of the watcher with the files changed, created or moved in, their paths starting with the watched directory.
+		 */
+		using Callback = std::function<void(const std::vector<std::string>& p_files)>;
+
+		static constexpr std::chrono::milliseconds DEFAULT_DEBOUNCE{ 150 };
+
+		FileWatcher() = default;
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher& p_other) = delete;
+		FileWatcher(FileWatcher&& p_other) = delete;
+		FileWatcher& operator=(const FileWatcher& p_other) = delete;
+		FileWatcher& operator=(FileWatcher&& p_other) = delete;
+
+		/**
+		 * @brief Start watching a directory, the previous one is no longer watched.
+		 * @param p_directory The directory, its subdirectories created later are watched too
+		 * @param p_callback Called with the changed files, every batch once its files have all been left alone for p_debounce
+		 * @param p_debounce Time without events on the changed files before they are reported
+		 * @return False if the directory can't be watched
+		 * @note Returns once the directory and its subdirectories are watched, the changes made after it are all reported.
+		 */
+		bool Start(std::string_view p_directory, Callback p_callback, const std::chrono::milliseconds p_debounce = DEFAULT_DEBOUNCE);
+
+		/**
+		 * @brief Stop watching, the changes not reported yet are dropped.
+		 * @note Waits for the callback being called, if any, so don't call it from the callback.
+		 */
+		void Stop();
+
+		[[nodiscard]] bool IsWatching() const;
+
+	private:
+		/**
+		 * @param p_ready Set once the directories are watched
+		 */
+		void Run(std::promise<void> p_ready);
+
+		std::string m_directory;
+		Callback m_callback;
+		std::chrono::milliseconds m_debounce{ DEFAULT_DEBOUNCE };
+		std::atomic<bool> m_running{ false };
+		std::thread m_thread;
+		// inotify instance on Linux
+		int m_notifier{ -1 };
+	};
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OgEngine::Utils
+{
+	class JobSystem;
+
+	/**
+	 * @brief Order in which the queued jobs are taken, HIGH first.
+	 */
+	enum class JOB_PRIORITY : uint8_t
+	{
+		HIGH,
+		NORMAL,
+		LOW
+	};
+
+	/**
+	 * @brief Shared state of a job, owned by its handles and by the queue it waits in.
+	 */
+	struct Task;
+
+	/**
+	 * @brief Handle to a job submitted to a JobSystem, cheap to copy.
+	 */
+	class RENDERING_API TaskHandle
+	{
+	public:
+		TaskHandle() = default;
+
+		/**
+		 * @brief Tell if the handle refers to a job.
+		 */
+		[[nodiscard]] bool IsValid() const;
+
+		/**
+		 * @brief Tell if the job has run (an invalid handle is always done).
+		 */
+		[[nodiscard]] bool IsDone() const;
+
+		/**
+		 * @brief Block until the job has run.
+		 * @note The waiting thread runs other jobs in the meantime, so waiting from inside a job doesn't starve the workers.
+		 */
+		void Wait() const;
+
+		/**
+		 * @brief Schedule a job to run once this one is done.
+		 * @param p_continuation The job to run
+		 * @return The handle of the continuation
+		 */
+		TaskHandle Then(std::function<void()> p_continuation) const;
+
+		/**
+		 * @brief Move a job still queued to a higher priority, a lower or equal one is ignored.
+		 * @return False if the job has already started
+		 */
+		bool Prioritize(const JOB_PRIORITY p_priority) const;
+
+		/**
+		 * @brief Drop a job that hasn't started, it is marked done without running and its continuations are queued as usual.
+		 * @return False if the job has already started
+		 */
+		bool Cancel() const;
+
+	private:
+		friend class JobSystem;
+
+		TaskHandle(JobSystem* p_system, std::shared_ptr<Task> p_task);
+
+		JobSystem* m_system{ nullptr };
+		std::shared_ptr<Task> m_task;
+	};
+
+	/**
+	 * @brief Fixed set of worker threads, each one owning a queue of jobs and stealing from the others once its own is empty.
+	 * Jobs submitted from a worker go to its own queue (last in, first out for locality), the other ones go to a shared queue.
+	 * The jobs given a priority other than NORMAL always go to the shared queue of their priority: the HIGH ones are taken before anything
+	 * but the own queue of a worker, the LOW ones only once no other job is left.
+	 */
+	class RENDERING_API JobSystem final
+	{
+	public:
+		/**
+		 * @param p_workerCount Number of worker threads, 0 to use one per hardware thread except the calling one
+		 */
+		explicit JobSystem(const uint32_t p_workerCount = 0u);
+
+		/**
+		 * @brief Run the jobs still queued then stop the workers.
+		 */
+		~JobSystem();
+
+		JobSystem(const JobSystem& p_other) = delete;
+		JobSystem(JobSystem&& p_other) = delete;
+		JobSystem& operator=(const JobSystem& p_other) = delete;
+		JobSystem& operator=(JobSystem&& p_other) = delete;
+
+		/**
+		 * @brief Return the pool shared by the engine services.
+		 * @note Call it in the constructor of an object that uses it from its destructor, so the pool outlives the object.
+		 */
+		static JobSystem& Instance();
+
+		/**
+		 * @brief Queue a job.
+		 * @param p_job The function to run, an exception it throws is reported and doesn't stop the worker
+		 * @return The handle of the job
+		 */
+		TaskHandle Submit(std::function<void()> p_job);
+
+		/**
+		 * @brief Queue a job with a priority.
+		 * @param p_priority Order of the job relative to the other queued ones
+		 * @param p_job The function to run
+		 * @return The handle of the job
+		 */
+		TaskHandle Submit(const JOB_PRIORITY p_priority, std::function<void()> p_job);
+
+		/**
+		 * @brief Queue a function call.
+		 * @param p_function The function to call
+		 * @param p_args The arguments, copied (remember to give the object as first argument if you use a method)
+		 * @return The handle of the job
+		 */
+		template<typename Function, typename ... Args>
+		TaskHandle Submit(Function&& p_function, Args&& ... p_args)
+		{
+			return Submit(std::function<void()>(std::bind(std::forward<Function>(p_function), std::forward<Args>(p_args)...)));
+		}
+
+		/**
+		 * @brief Queue a function call with a priority.
+		 * @param p_priority Order of the job relative to the other queued ones
+		 * @param p_function The function to call
+		 * @param p_args The arguments, copied
+		 * @return The handle of the job
+		 */
+		template<typename Function, typename ... Args>
+		TaskHandle Submit(const JOB_PRIORITY p_priority, Function&& p_function, Args&& ... p_args)
+		{
+			return Submit(p_priority, std::function<void()>(std::bind(std::forward<Function>(p_function), std::forward<Args>(p_args)...)));
+		}
+
+		/**
+		 * @brief Call a function on sub-ranges of [p_begin, p_end) in parallel and wait for all of them, the calling thread takes part.
+		 * @param p_begin First index
+		 * @param p_end Index after the last one
+		 * @param p_body Function called with the bounds of each sub-range
+		 * @param p_grain Size of a sub-range, 0 to split the range in a few chunks per worker
+		 */
+		void ParallelForRange(const uint64_t p_begin, const uint64_t p_end, const std::function<void(uint64_t, uint64_t)>& p_body, const uint64_t p_grain = 0u);
+
+		/**
+		 * @brief Call a function for each index of [p_begin, p_end) in parallel and wait for all of them.
+		 * @param p_begin First index
+		 * @param p_end Index after the last one
+		 * @param p_body Function called with each index
+		 * @param p_grain Number of indices given to a job at once, 0 to split the range in a few chunks per worker
+		 */
+		template<typename Function>
+		void ParallelFor(const uint64_t p_begin, const uint64_t p_end, Function&& p_body, const uint64_t p_grain = 0u)
+		{
+			ParallelForRange(p_begin, p_end, [&p_body](const uint64_t p_first, const uint64_t p_last)
+			{
+				for (uint64_t i = p_first; i < p_last; ++i)
+					p_body(i);
+			}, p_grain);
+		}
+
+		/**
+		 * @brief Block until all the given jobs have run, running other jobs in the meantime.
+		 */
+		void WaitForAll(const std::vector<TaskHandle>& p_tasks);
+
+		[[nodiscard]] uint32_t WorkerCount() const;
+
+	private:
+		friend class TaskHandle;
+
+		/**
+		 * @brief Queue of a worker, the owner works on its back and the thieves on its front.
+		 */
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque<std::shared_ptr<Task>> tasks;
+		};
+
+		void Work(const uint32_t p_index);
+		void Push(std::shared_ptr<Task> p_task);
+
+		/**
+		 * @brief Take a job from the queue of the calling worker, then the shared HIGH and NORMAL queues, then the other workers,
+		 * then the shared LOW queue.
+		 * @return The job, nullptr if every queue is empty
+		 */
+		[[nodiscard]] std::shared_ptr<Task> Take();
+
+		/**
+		 * @brief Run one queued job, if any.
+		 * @return True if a job was run
+		 */
+		bool RunOne();
+
+		void Execute(const std::shared_ptr<Task>& p_task);
+		/**
+		 * @brief Mark a job done and queue its continuations.
+		 */
+		void Finish(const std::shared_ptr<Task>& p_task);
+		void Wait(const std::shared_ptr<Task>& p_task);
+		TaskHandle Then(const std::shared_ptr<Task>& p_task, std::function<void()> p_continuation);
+		bool Prioritize(const std::shared_ptr<Task>& p_task, const JOB_PRIORITY p_priority);
+		bool Cancel(const std::shared_ptr<Task>& p_task);
+
+		std::vector<std::unique_ptr<WorkQueue>> m_queues;
+		// One per priority
+		std::array<WorkQueue, 3u> m_sharedQueues;
+
+		std::atomic<uint64_t> m_queuedCount{ 0u };
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeUp;
+		std::condition_variable m_taskDone;
+		bool m_quit{ false };
+
+		// Last member, the threads start once everything they use is constructed
+		std::vector<std::thread> m_workers;
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Compression in the LZ4 block format: no entropy coding, so the decompression runs at the speed of a copy.
+	 * Used for the entries of the pack archives, which are decompressed each time they are read.
+	 */
+	class RENDERING_API Lz4 final
+	{
+	public:
+		/**
+		 * @brief Largest size a block of p_size bytes can take once compressed, when nothing repeats.
+		 */
+		[[nodiscard]] static size_t Bound(const size_t p_size);
+
+		/**
+		 * @brief Compress a block, greedily matching the last occurrence of each 4 bytes sequence.
+		 * @return The compressed block, Decompress needs the size of the original block to read it back
+		 */
+		[[nodiscard]] static std::vector<uint8_t> Compress(const uint8_t* p_data, const size_t p_size);
+
+		/**
+		 * @brief Decompress a block, every length and offset read is checked so a corrupted block can't write out of the buffer.
+		 * @param p_destination Buffer of the size of the original block
+		 * @return False if the block is corrupted or doesn't decompress to exactly p_destinationSize bytes
+		 */
+		[[nodiscard]] static bool Decompress(const uint8_t* p_source, const size_t p_sourceSize, uint8_t* p_destination,
+			const size_t p_destinationSize);
+
+	private:
+		Lz4() = default;
+	};
+}
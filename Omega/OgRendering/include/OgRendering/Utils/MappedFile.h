@@ -0,0 +1,57 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Read-only view of a whole file mapped in memory, the pages are read by the system when first touched.
+	 */
+	class RENDERING_API MappedFile final
+	{
+	public:
+		MappedFile() = default;
+
+		/**
+		 * @brief Map a file, check IsOpen for the result.
+		 * @param p_file Path of the file
+		 */
+		explicit MappedFile(std::string_view p_file);
+		~MappedFile();
+
+		MappedFile(const MappedFile& p_other) = delete;
+		MappedFile(MappedFile&& p_other) noexcept;
+		MappedFile& operator=(const MappedFile& p_other) = delete;
+		MappedFile& operator=(MappedFile&& p_other) noexcept;
+
+		/**
+		 * @brief Tell if the file is mapped, an empty file is never mapped.
+		 */
+		[[nodiscard]] bool IsOpen() const;
+		[[nodiscard]] const uint8_t* Data() const;
+		[[nodiscard]] size_t Size() const;
+
+		/**
+		 * @brief Hash the content of the file, used to name the cooked resources after their source.
+		 * @return The hash, 0 if the file isn't mapped
+		 */
+		[[nodiscard]] uint64_t ContentHash() const;
+		/**
+		 * @brief Hash bytes like ContentHash, for a file read another way than mapped.
+		 */
+		[[nodiscard]] static uint64_t HashBytes(const uint8_t* p_data, const size_t p_size);
+
+		void Close();
+
+	private:
+		const uint8_t* m_data{ nullptr };
+		size_t m_size{ 0u };
+#ifdef _WIN32
+		void* m_file{ nullptr };
+		void* m_mapping{ nullptr };
+#endif
+	};
+}
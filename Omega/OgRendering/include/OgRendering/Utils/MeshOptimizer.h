@@ -0,0 +1,70 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <OgRendering/Resource/Vertex.h>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief How well a triangle list uses the post-transform vertex cache, simulated as a FIFO.
+	 */
+	struct CacheStatistics
+	{
+		/**
+		 * @brief Average cache miss ratio, vertices transformed per triangle. 0.5 at best on a regular grid, 3 at worst.
+		 */
+		float acmr{ 0.0f };
+		/**
+		 * @brief Average transform to vertex ratio, vertices transformed per vertex referenced. 1 at best.
+		 */
+		float atvr{ 0.0f };
+	};
+
+	/**
+	 * @brief Reorder the triangle lists of imported meshes for the GPU, without changing what is drawn.
+	 * Run at import time, the cooked meshes keep the optimized order.
+	 */
+	class RENDERING_API MeshOptimizer final
+	{
+	public:
+		/**
+		 * @brief Size of the cache the orders are optimized for.
+		 */
+		static constexpr uint32_t CACHE_SIZE = 32u;
+
+		/**
+		 * @brief Simulate the vertex cache over a triangle list.
+		 * @param p_cacheSize Entries of the simulated FIFO, 16 is close to most GPUs
+		 */
+		[[nodiscard]] static CacheStatistics Analyze(const std::vector<uint32_t>& p_indices, const size_t p_vertexCount,
+			const uint32_t p_cacheSize = 16u);
+
+		/**
+		 * @brief Reorder the triangles for the vertex cache, with the linear-speed algorithm of Tom Forsyth.
+		 */
+		static void OptimizeVertexCache(std::vector<uint32_t>& p_indices, const size_t p_vertexCount);
+
+		/**
+		 * @brief Draw first the groups of triangles facing away from the center of the mesh, they are the most likely to hide the other ones.
+		 * The groups are cut where the cache is cold anyway, so the cache order given by OptimizeVertexCache is kept.
+		 */
+		static void OptimizeOverdraw(std::vector<uint32_t>& p_indices, const std::vector<Vertex>& p_vertices);
+
+		/**
+		 * @brief Store the vertices in the order the triangles first use them, the vertices no triangle uses are removed.
+		 * The vertices are swapped into place, the buffer is reused instead of copied to a new one.
+		 */
+		static void OptimizeVertexFetch(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices);
+
+		/**
+		 * @brief Run the three passes on a triangle list, in the order they have to be run.
+		 */
+		static void Optimize(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices);
+
+	private:
+		MeshOptimizer() = default;
+	};
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <OgRendering/Resource/MeshLod.h>
+#include <OgRendering/Resource/Vertex.h>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Build the detail levels of imported meshes by collapsing edges, ordered by quadric error.
+	 * The vertices are never moved nor added, a level is a new triangle list over the vertices of its mesh.
+	 */
+	class RENDERING_API MeshSimplifier final
+	{
+	public:
+		/**
+		 * @brief Triangles kept by each level, relative to the mesh.
+		 */
+		inline static const std::vector<float> DEFAULT_RATIOS = { 0.5f, 0.25f, 0.125f, 0.0625f };
+		/**
+		 * @brief Largest error of a level, relative to the largest side of the bounding box of the mesh.
+		 */
+		static constexpr float DEFAULT_MAX_ERROR = 0.02f;
+
+		/**
+		 * @brief Collapse the cheapest edges until the triangle list is small enough or the next collapse would be too visible.
+		 * The borders of the mesh and its seams, where the normals or texture coordinates are split, only collapse along themselves.
+		 * @param p_targetIndexCount Indices to stop at
+		 * @param p_maxError Largest error allowed, relative to the largest side of the bounding box of the mesh
+		 * @return The simplified triangle list and its error in the units of the mesh, the indices unchanged if they aren't a triangle list
+		 */
+		[[nodiscard]] static MeshLod Simplify(const std::vector<Vertex>& p_vertices, const std::vector<uint32_t>& p_indices,
+			const size_t p_targetIndexCount, const float p_maxError);
+
+		/**
+		 * @brief Simplify a mesh once per ratio, the levels are built in parallel on the job system.
+		 * A level that doesn't remove at least a tenth of the triangles of the previous one is left out.
+		 * @return The levels from the finest to the coarsest, their indices ordered for the vertex cache
+		 */
+		[[nodiscard]] static std::vector<MeshLod> BuildLods(const std::vector<Vertex>& p_vertices, const std::vector<uint32_t>& p_indices,
+			const std::vector<float>& p_ratios = DEFAULT_RATIOS, const float p_maxError = DEFAULT_MAX_ERROR);
+
+	private:
+		MeshSimplifier() = default;
+	};
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <OgRendering/Resource/Meshlet.h>
+#include <OgRendering/Resource/Vertex.h>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Split triangle lists into meshlets at import time, and cull them on the CPU.
+	 */
+	class RENDERING_API MeshletBuilder final
+	{
+	public:
+		/**
+		 * @brief Limits of a meshlet, those of the common mesh shader implementations.
+		 */
+		static constexpr uint32_t MAX_VERTICES = 64u;
+		static constexpr uint32_t MAX_TRIANGLES = 124u;
+
+		/**
+		 * @brief Grow meshlets from neighbour triangles, the ones adding the fewest vertices first.
+		 * The triangles are stored meshlet after meshlet, each one started from the first triangle left in the given order,
+		 * then the vertices in the order the triangles first use them.
+		 * @return The meshlets, empty if the indices aren't a triangle list
+		 */
+		[[nodiscard]] static MeshletData Build(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices);
+
+		/**
+		 * @brief Tell if meshlets describe a triangle list, their ranges are checked before drawing them.
+		 */
+		[[nodiscard]] static bool Validate(const MeshletData& p_meshlets, const size_t p_vertexCount, const std::vector<uint32_t>& p_indices);
+
+		/**
+		 * @brief Tell if every triangle of a meshlet faces away from an eye.
+		 * @param p_eye Position of the eye in the space of the mesh
+		 */
+		[[nodiscard]] static bool IsBackfacing(const Meshlet& p_meshlet, const GPM::Vector3F& p_eye);
+
+		/**
+		 * @brief List the ranges of the index buffer to draw, the meshlets facing away from the eye are left out.
+		 * @param p_ranges Filled with the first index and the index count of each range, contiguous meshlets are merged
+		 */
+		static void VisibleRanges(const MeshletData& p_meshlets, const GPM::Vector3F& p_eye, std::vector<std::pair<uint32_t, uint32_t>>& p_ranges);
+
+	private:
+		MeshletBuilder() = default;
+	};
+}
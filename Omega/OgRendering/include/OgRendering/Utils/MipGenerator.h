@@ -0,0 +1,68 @@
+#pragma once
+#include <OgRendering/Export.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <OgRendering/Resource/Texture.h>
+
+namespace OgEngine::Utils
+{
+	enum class MIP_FILTER : uint8_t
+	{
+		BOX,
+		KAISER
+	};
+
+	/**
+	 * @brief How the levels of a chain are built from each other.
+	 */
+	struct MipSettings
+	{
+		/**
+		 * @brief Number of channels of the pixels, 1 to 4.
+		 */
+		uint32_t channels{ 4u };
+		/**
+		 * @brief 1 for 8 bits channels, 2 for 16 bits ones, 4 for floats.
+		 * The 16 bits and float images are box filtered as they are stored, whatever the filter and the color space.
+		 */
+		uint32_t channelBytes{ 1u };
+		MIP_FILTER filter{ MIP_FILTER::BOX };
+		/**
+		 * @brief Filter the colors in linear space, for the images stored in sRGB. The alpha channel is always linear.
+		 */
+		bool srgb{ false };
+	};
+
+	/**
+	 * @brief Mip chains built on the CPU, so they are cooked once by the loading threads instead of blitted at every upload.
+	 * The linear box filter runs on AVX2 or SSE2 when the processor has them, the other filters work in floats.
+	 */
+	class RENDERING_API MipGenerator final
+	{
+	public:
+		/**
+		 * @brief Return the number of levels of a full chain, down to 1x1.
+		 */
+		[[nodiscard]] static uint32_t LevelCount(const uint32_t p_width, const uint32_t p_height);
+
+		/**
+		 * @brief Halve an image, a side of 1 pixel stays 1 pixel.
+		 * @param p_destination max(1, p_width / 2) * max(1, p_height / 2) pixels
+		 */
+		static void Downsample(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination,
+			const MipSettings& p_settings = {});
+
+		/**
+		 * @brief Build the full chain of an image.
+		 * @param p_levels Filled with where each level is in the returned buffer, from the image itself down to 1x1
+		 * @return The levels packed one after the other
+		 */
+		[[nodiscard]] static std::vector<uint8_t> BuildChain(const uint8_t* p_pixels, const uint32_t p_width, const uint32_t p_height,
+			std::vector<MipLevel>& p_levels, const MipSettings& p_settings = {});
+
+	private:
+		MipGenerator() = default;
+	};
+}
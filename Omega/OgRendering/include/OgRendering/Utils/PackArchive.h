@@ -0,0 +1,144 @@
+#pragma once
+#include <OgRendering/Export.h>
+#include <OgRendering/Utils/MappedFile.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OgEngine::Utils
+{
+	enum class PACK_COMPRESSION : uint32_t
+	{
+		NONE,
+		LZ4
+	};
+
+	/**
+	 * @brief Start of a pack archive, the table of contents and the names are at the end, after the payloads.
+	 */
+	struct PackHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t alignment;
+		uint64_t entryCount;
+		uint64_t tableOffset;
+		uint64_t namesOffset;
+		uint64_t namesSize;
+	};
+
+	/**
+	 * @brief Entry of the table of contents, the entries are sorted by the hash of their name to be found by a binary search.
+	 */
+	struct PackEntry
+	{
+		uint64_t nameHash;
+		/**
+		 * @brief Hash of the original file given by MappedFile::ContentHash, the file doesn't have to be read to find its cooked version.
+		 */
+		uint64_t contentHash;
+		/**
+		 * @brief Offset of the payload from the start of the archive, a multiple of the alignment of the archive.
+		 */
+		uint64_t offset;
+		uint64_t storedSize;
+		/**
+		 * @brief Size of the original file, storedSize is smaller when the payload is compressed.
+		 */
+		uint64_t size;
+		uint32_t nameOffset;
+		uint32_t nameSize;
+		PACK_COMPRESSION compression;
+		uint32_t reserved;
+	};
+
+	/**
+	 * @brief File to put in an archive.
+	 */
+	struct PackInput
+	{
+		/**
+		 * @brief Path the file is opened with once packed, relative to the working directory of the engine (Resources/...).
+		 */
+		std::string name;
+		/**
+		 * @brief File read, the name when empty.
+		 */
+		std::string file;
+	};
+
+	/**
+	 * @brief Single file holding many resources (.ogpack), opening it once replaces the open and stat calls of every file it holds.
+	 * The archive is mapped in memory: a payload stored as is is used in place, a compressed one is decompressed when read.
+	 *
+	 * Layout: PackHeader, the payloads each aligned on ALIGNMENT, the PackEntry table then the names, not null-terminated.
+	 */
+	class RENDERING_API PackArchive final
+	{
+	public:
+		inline static const std::string DEFAULT_FILE = "Resources.ogpack";
+		inline static const std::string EXTENSION = ".ogpack";
+		/**
+		 * @brief Increased when the layout changes, an archive of another version isn't opened.
+		 */
+		static constexpr uint32_t VERSION = 1u;
+		/**
+		 * @brief Alignment of the payloads, a cache line: the cooked meshes and textures can be read in place with aligned loads.
+		 */
+		static constexpr uint64_t ALIGNMENT = 64u;
+
+		/**
+		 * @brief Return the name a file is stored under, the same file always gets the same name whichever way its path is written.
+		 */
+		[[nodiscard]] static std::string EntryName(std::string_view p_file);
+		[[nodiscard]] static uint64_t HashName(std::string_view p_name);
+
+		/**
+		 * @brief Write an archive, through a temporary file so an interrupted write never leaves half an archive.
+		 * @param p_compress Compress the files in LZ4, a file is stored as is when it doesn't get at least 1/8 smaller
+		 * @return False if a file couldn't be read or the archive couldn't be written
+		 */
+		static bool Write(const std::string& p_file, const std::vector<PackInput>& p_inputs, const bool p_compress);
+
+		PackArchive() = default;
+
+		/**
+		 * @brief Map an archive and check its table of contents, check IsOpen for the result.
+		 */
+		explicit PackArchive(std::string_view p_file);
+
+		// The entries point in the mapping, an archive stays where it was opened
+		PackArchive(const PackArchive& p_other) = delete;
+		PackArchive(PackArchive&& p_other) = delete;
+		PackArchive& operator=(const PackArchive& p_other) = delete;
+		PackArchive& operator=(PackArchive&& p_other) = delete;
+
+		[[nodiscard]] bool IsOpen() const;
+		[[nodiscard]] const std::string& File() const;
+
+		/**
+		 * @brief Find the entry of a file, its path is normalized like the names.
+		 * @return The entry, nullptr if the archive doesn't hold the file
+		 */
+		[[nodiscard]] const PackEntry* Find(std::string_view p_file) const;
+		[[nodiscard]] std::string_view Name(const PackEntry& p_entry) const;
+		/**
+		 * @brief Return the payload of an entry as stored, compressed if the entry is.
+		 */
+		[[nodiscard]] const uint8_t* Payload(const PackEntry& p_entry) const;
+
+		[[nodiscard]] const PackEntry* Entries() const;
+		[[nodiscard]] uint64_t EntryCount() const;
+
+	private:
+		bool Validate();
+
+		MappedFile m_file;
+		std::string m_path;
+		const PackEntry* m_entries{ nullptr };
+		uint64_t m_entryCount{ 0u };
+		const char* m_names{ nullptr };
+	};
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <OgRendering/Export.h>
+#include <OgRendering/Utils/MappedFile.h>
+#include <OgRendering/Utils/PackArchive.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OgEngine::Utils
+{
+	/**
+	 * @brief Read-only content of a file opened through the VirtualFileSystem, from a pack archive or from the disk.
+	 */
+	class RENDERING_API FileView final
+	{
+	public:
+		FileView() = default;
+
+		FileView(const FileView& p_other) = delete;
+		FileView(FileView&& p_other) noexcept;
+		FileView& operator=(const FileView& p_other) = delete;
+		FileView& operator=(FileView&& p_other) noexcept;
+
+		/**
+		 * @brief Tell if the file was found, an empty file is never open like with MappedFile.
+		 */
+		[[nodiscard]] bool IsOpen() const;
+		[[nodiscard]] const uint8_t* Data() const;
+		[[nodiscard]] size_t Size() const;
+
+		/**
+		 * @brief Hash the content of the file like MappedFile::ContentHash, a packed file gives the hash stored by the archive.
+		 */
+		[[nodiscard]] uint64_t ContentHash() const;
+		[[nodiscard]] bool IsPacked() const;
+
+	private:
+		friend class VirtualFileSystem;
+
+		const uint8_t* m_data{ nullptr };
+		size_t m_size{ 0u };
+		uint64_t m_contentHash{ 0u };
+		// What keeps the data alive: the mapping of a loose file, the archive or the decompressed payload of a packed one
+		MappedFile m_file;
+		std::shared_ptr<const PackArchive> m_pack;
+		std::vector<uint8_t> m_buffer;
+	};
+
+	/**
+	 * @brief Where the resources are read from: the pack archives mounted, then the files on the disk.
+	 * The engine ships its resources packed, the loose files are the ones of development and of the tools.
+	 */
+	class RENDERING_API VirtualFileSystem final
+	{
+	public:
+		/**
+		 * @brief Return the file system shared by the loaders.
+		 */
+		static VirtualFileSystem& Instance();
+
+		/**
+		 * @brief Open a pack archive, its files are found before the ones of the archives mounted earlier and of the disk.
+		 * @return False if the archive is missing or invalid
+		 */
+		bool Mount(std::string_view p_pack);
+		/**
+		 * @brief Forget an archive, it stays mapped until the last FileView opened from it is destroyed.
+		 */
+		bool Unmount(std::string_view p_pack);
+		void UnmountAll();
+
+		/**
+		 * @brief Open a file, from the last archive mounted holding it or else from the disk.
+		 * @return The view, check IsOpen for the result
+		 */
+		[[nodiscard]] FileView Open(std::string_view p_file) const;
+		[[nodiscard]] bool Exists(std::string_view p_file) const;
+
+		/**
+		 * @brief Return the hash of a packed file without reading it.
+		 * @return The hash, std::nullopt if no archive mounted holds the file
+		 */
+		[[nodiscard]] std::optional<uint64_t> PackedHash(std::string_view p_file) const;
+
+	private:
+		VirtualFileSystem() = default;
+
+		using PackList = std::vector<std::shared_ptr<const PackArchive>>;
+
+		/**
+		 * @brief Return the archives mounted, the readers use their own copy of the list while it is changed.
+		 */
+		[[nodiscard]] std::shared_ptr<const PackList> Packs() const;
+		static const PackEntry* Find(const PackList& p_packs, std::string_view p_file, std::shared_ptr<const PackArchive>& p_pack);
+
+		mutable std::mutex m_packsMutex;
+		std::shared_ptr<const PackList> m_packs{ std::make_shared<const PackList>() };
+	};
+}
@@ -21,6 +21,22 @@ enum TEXTURE_TYPE : std::uint8_t
 	NORMAL = 1u
 };
 
+/**
+ * @brief Tell if a GPU can sample the optimally tiled images of a format, the 3 channels formats and some sRGB ones are optional.
+ * @param p_blit True if the mips of the images are generated by blits as well
+ */
+inline bool CanSampleFormat(const VkPhysicalDevice p_gpu, const VkFormat p_format, const bool p_blit)
+{
+	VkFormatProperties properties;
+	vkGetPhysicalDeviceFormatProperties(p_gpu, p_format, &properties);
+
+	VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	if (p_blit)
+		required |= VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+
+	return (properties.optimalTilingFeatures & required) == required;
+}
+
 /**
  * @brief Convert a GPM::Vector3<float> to a glm::vec3<float>
  * @param p_vector The vector to convert : GPM::Vector3<float>
@@ -0,0 +1,111 @@
+#include <OgRendering/Managers/Loaders/AssimpIOSystem.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+
+#include <assimp/IOStream.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	/**
+	 * @brief Stream over the content of a FileView, which it owns.
+	 */
+	class FileViewStream final : public Assimp::IOStream
+	{
+	public:
+		explicit FileViewStream(OgEngine::Utils::FileView&& p_view) : m_view(std::move(p_view))
+		{
+		}
+
+		size_t Read(void* p_buffer, const size_t p_size, const size_t p_count) override
+		{
+			if (p_size == 0u)
+				return 0u;
+
+			const size_t count = std::min(p_count, (m_view.Size() - m_position) / p_size);
+			std::memcpy(p_buffer, m_view.Data() + m_position, count * p_size);
+			m_position += count * p_size;
+			return count;
+		}
+
+		size_t Write(const void*, size_t, size_t) override
+		{
+			return 0u;
+		}
+
+		aiReturn Seek(const size_t p_offset, const aiOrigin p_origin) override
+		{
+			size_t position;
+			switch (p_origin)
+			{
+			case aiOrigin_SET:
+				position = p_offset;
+				break;
+			case aiOrigin_CUR:
+				position = m_position + p_offset;
+				break;
+			case aiOrigin_END:
+				if (p_offset > m_view.Size())
+					return AI_FAILURE;
+
+				position = m_view.Size() - p_offset;
+				break;
+			default:
+				return AI_FAILURE;
+			}
+
+			if (position > m_view.Size())
+				return AI_FAILURE;
+
+			m_position = position;
+			return AI_SUCCESS;
+		}
+
+		size_t Tell() const override
+		{
+			return m_position;
+		}
+
+		size_t FileSize() const override
+		{
+			return m_view.Size();
+		}
+
+		void Flush() override
+		{
+		}
+
+	private:
+		OgEngine::Utils::FileView m_view;
+		size_t m_position{ 0u };
+	};
+}
+
+bool OgEngine::AssimpIOSystem::Exists(const char* p_file) const
+{
+	return Utils::VirtualFileSystem::Instance().Exists(p_file);
+}
+
+char OgEngine::AssimpIOSystem::getOsSeparator() const
+{
+	// Understood on every system, and the separator of the names in the archives
+	return '/';
+}
+
+Assimp::IOStream* OgEngine::AssimpIOSystem::Open(const char* p_file, const char* p_mode)
+{
+	if (std::strchr(p_mode, 'w') || std::strchr(p_mode, 'a'))
+		return nullptr;
+
+	Utils::FileView view = Utils::VirtualFileSystem::Instance().Open(p_file);
+	if (!view.IsOpen())
+		return nullptr;
+
+	return new FileViewStream(std::move(view));
+}
+
+void OgEngine::AssimpIOSystem::Close(Assimp::IOStream* p_file)
+{
+	delete p_file;
+}
@@ -0,0 +1,228 @@
+#include <OgRendering/Managers/Loaders/CookManifest.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+	constexpr const char* HEADER = "OGCOOK";
+
+	/**
+	 * @brief The same file is always given the same key, whichever way its path is written.
+	 */
+	std::string Normalize(std::string_view p_file)
+	{
+		return std::filesystem::path(p_file).lexically_normal().generic_string();
+	}
+
+	std::vector<std::string_view> Split(std::string_view p_line)
+	{
+		std::vector<std::string_view> fields;
+		size_t start = 0u;
+		for (size_t end = p_line.find('\t'); end != std::string_view::npos; end = p_line.find('\t', start))
+		{
+			fields.emplace_back(p_line.substr(start, end - start));
+			start = end + 1u;
+		}
+
+		fields.emplace_back(p_line.substr(start));
+		return fields;
+	}
+
+	template<typename Integer>
+	bool ToInteger(const std::string_view p_value, Integer& p_result, const int p_base = 10)
+	{
+		const auto [end, error] = std::from_chars(p_value.data(), p_value.data() + p_value.size(), p_result, p_base);
+		return error == std::errc() && end == p_value.data() + p_value.size();
+	}
+}
+
+OgEngine::ASSET_KIND OgEngine::CookManifest::KindOf(std::string_view p_file)
+{
+	std::string extension = std::filesystem::path(p_file).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char p_character)
+	{
+		return static_cast<char>(std::tolower(p_character));
+	});
+
+	if (extension == ".omega")
+		return ASSET_KIND::SCENE;
+
+	// The formats decoded by stb_image
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp"
+		|| extension == ".psd" || extension == ".gif" || extension == ".hdr" || extension == ".pic" || extension == ".pnm")
+		return ASSET_KIND::TEXTURE;
+
+	// The formats the engine imports through Assimp
+	if (extension == ".obj" || extension == ".fbx" || extension == ".gltf" || extension == ".glb" || extension == ".dae"
+		|| extension == ".3ds" || extension == ".blend" || extension == ".ply" || extension == ".stl")
+		return ASSET_KIND::MESH;
+
+	return ASSET_KIND::NONE;
+}
+
+bool OgEngine::CookManifest::Load(const std::string& p_file)
+{
+	m_assets.clear();
+
+	// Shipped in the pack archive with the files it lists
+	const Utils::FileView view = Utils::VirtualFileSystem::Instance().Open(p_file);
+	if (!view.IsOpen())
+		return false;
+
+	std::istringstream file(std::string(reinterpret_cast<const char*>(view.Data()), view.Size()));
+
+	std::string line;
+	if (!std::getline(file, line) || line != std::string(HEADER) + '\t' + std::to_string(VERSION))
+		return false;
+
+	CookedAsset* current = nullptr;
+	while (std::getline(file, line))
+	{
+		if (line.empty())
+			continue;
+
+		const std::vector<std::string_view> fields = Split(line);
+		if (fields[0] == "D" && fields.size() == 2u && current)
+		{
+			current->dependencies.emplace_back(fields[1]);
+			continue;
+		}
+
+		uint32_t kind = 0u;
+		CookedAsset asset;
+		if (fields[0] != "A" || fields.size() != 8u || !ToInteger(fields[1], kind) || kind > static_cast<uint32_t>(ASSET_KIND::SCENE)
+			|| !ToInteger(fields[2], asset.sourceHash, 16) || !ToInteger(fields[3], asset.sourceSize) || !ToInteger(fields[4], asset.sourceWriteTime)
+			|| !ToInteger(fields[5], asset.cookVersion, 16))
+		{
+			std::cerr << "CookManifest error: " << p_file << " is badly structured, it is ignored.\n";
+			m_assets.clear();
+			return false;
+		}
+
+		asset.kind = static_cast<ASSET_KIND>(kind);
+		asset.source = Normalize(fields[6]);
+		asset.cooked = fields[7];
+
+		const std::string source = asset.source;
+		current = &(m_assets[source] = std::move(asset));
+	}
+
+	return true;
+}
+
+bool OgEngine::CookManifest::Save(const std::string& p_file) const
+{
+	// Sorted, so cooking the same sources writes the same manifest
+	std::vector<const CookedAsset*> assets;
+	assets.reserve(m_assets.size());
+	for (const auto& [source, asset] : m_assets)
+		assets.emplace_back(&asset);
+
+	std::sort(assets.begin(), assets.end(), [](const CookedAsset* p_left, const CookedAsset* p_right)
+	{
+		return p_left->source < p_right->source;
+	});
+
+	std::ostringstream content;
+	content << HEADER << '\t' << VERSION << '\n';
+	for (const CookedAsset* asset : assets)
+	{
+		content << "A\t" << static_cast<uint32_t>(asset->kind) << '\t' << std::hex << asset->sourceHash << std::dec << '\t'
+			<< asset->sourceSize << '\t' << asset->sourceWriteTime << '\t' << std::hex << asset->cookVersion << std::dec << '\t'
+			<< asset->source << '\t' << asset->cooked << '\n';
+
+		for (const std::string& dependency : asset->dependencies)
+			content << "D\t" << dependency << '\n';
+	}
+
+	std::error_code error;
+	const std::filesystem::path path(p_file);
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path(), error);
+
+	const std::string temporaryFile = p_file + ".tmp";
+	{
+		std::ofstream file(temporaryFile, std::ios::binary | std::ios::trunc);
+		const std::string text = content.str();
+		if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size())))
+		{
+			std::cerr << "CookManifest error: couldn't write " << temporaryFile << ".\n";
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryFile, p_file, error);
+	if (error)
+	{
+		std::cerr << "CookManifest error: couldn't replace " << p_file << ", " << error.message() << ".\n";
+		std::filesystem::remove(temporaryFile, error);
+		return false;
+	}
+
+	return true;
+}
+
+const OgEngine::CookedAsset* OgEngine::CookManifest::Find(std::string_view p_source) const
+{
+	const auto asset = m_assets.find(Normalize(p_source));
+	return asset != m_assets.end() ? &asset->second : nullptr;
+}
+
+void OgEngine::CookManifest::Set(CookedAsset p_asset)
+{
+	p_asset.source = Normalize(p_asset.source);
+	const std::string source = p_asset.source;
+	m_assets[source] = std::move(p_asset);
+}
+
+void OgEngine::CookManifest::Remove(std::string_view p_source)
+{
+	m_assets.erase(Normalize(p_source));
+}
+
+std::optional<uint64_t> OgEngine::CookManifest::TrustedHash(std::string_view p_source) const
+{
+	const CookedAsset* asset = Find(p_source);
+	if (!asset)
+		return std::nullopt;
+
+	uint64_t size = 0u;
+	int64_t writeTime = 0;
+	if (!Stamp(std::string(p_source), size, writeTime) || size != asset->sourceSize || writeTime != asset->sourceWriteTime)
+		return std::nullopt;
+
+	return asset->sourceHash;
+}
+
+const std::unordered_map<std::string, OgEngine::CookedAsset>& OgEngine::CookManifest::Assets() const
+{
+	return m_assets;
+}
+
+bool OgEngine::CookManifest::Empty() const
+{
+	return m_assets.empty();
+}
+
+bool OgEngine::CookManifest::Stamp(const std::string& p_file, uint64_t& p_size, int64_t& p_writeTime)
+{
+	std::error_code error;
+	const uintmax_t size = std::filesystem::file_size(p_file, error);
+	if (error)
+		return false;
+
+	const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(p_file, error);
+	if (error)
+		return false;
+
+	p_size = static_cast<uint64_t>(size);
+	p_writeTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+	return true;
+}
@@ -3,6 +3,7 @@
 inline bool OgEngine::LoaderManager::CheckValidMesh(const std::string_view p_file)
 {
 	Assimp::Importer importer;
+	importer.SetIOHandler(new AssimpIOSystem());
 	const aiScene* scene = importer.ReadFile(p_file.data(), aiProcessPreset_TargetRealtime_Quality);
 
 	if (!scene)
@@ -0,0 +1,308 @@
+#include <OgRendering/Managers/Loaders/MeshCache.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+#include <OgRendering/Utils/MeshletBuilder.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr char MAGIC[4] = { 'O', 'G', 'M', 'S' };
+	constexpr uint64_t DATA_ALIGNMENT = 16u;
+
+	uint64_t AlignUp(const uint64_t p_offset)
+	{
+		return (p_offset + DATA_ALIGNMENT - 1u) & ~(DATA_ALIGNMENT - 1u);
+	}
+
+	/**
+	 * @brief The main mesh followed by its submeshes, in the order of the entries of the file.
+	 */
+	std::vector<OgEngine::Mesh*> Flatten(const std::shared_ptr<OgEngine::Mesh>& p_mesh)
+	{
+		std::vector<OgEngine::Mesh*> meshes{ p_mesh.get() };
+		for (const auto& subMesh : p_mesh->SubMeshes())
+			meshes.emplace_back(subMesh.get());
+
+		return meshes;
+	}
+}
+
+uint64_t OgEngine::MeshCache::HashFile(std::string_view p_file)
+{
+	// A packed source isn't read, the archive stores its hash
+	const Utils::VirtualFileSystem& fileSystem = Utils::VirtualFileSystem::Instance();
+	if (const std::optional<uint64_t> packedHash = fileSystem.PackedHash(p_file))
+		return *packedHash;
+
+	return fileSystem.Open(p_file).ContentHash();
+}
+
+std::string OgEngine::MeshCache::CookedPath(const uint64_t p_sourceHash)
+{
+	std::ostringstream path;
+	path << DIRECTORY << std::hex;
+	path.width(16);
+	path.fill('0');
+	path << p_sourceHash << EXTENSION;
+
+	return path.str();
+}
+
+std::shared_ptr<OgEngine::Mesh> OgEngine::MeshCache::Read(const uint64_t p_sourceHash)
+{
+	if (p_sourceHash == 0u)
+		return nullptr;
+
+	const Utils::FileView file = Utils::VirtualFileSystem::Instance().Open(CookedPath(p_sourceHash));
+	if (!file.IsOpen() || file.Size() < sizeof(MeshFileHeader))
+		return nullptr;
+
+	MeshFileHeader header;
+	std::memcpy(&header, file.Data(), sizeof(header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+		|| header.sourceHash != p_sourceHash || header.vertexSize != sizeof(Vertex) || header.meshCount == 0u)
+		return nullptr;
+
+	const uint64_t size = file.Size();
+	if (header.meshCount > (size - sizeof(MeshFileHeader)) / sizeof(MeshFileEntry))
+		return nullptr;
+
+	// Every range is checked before anything is built, a truncated file is cooked again rather than read out of bounds
+	std::vector<MeshFileEntry> entries(header.meshCount);
+	std::memcpy(entries.data(), file.Data() + sizeof(MeshFileHeader), entries.size() * sizeof(MeshFileEntry));
+	const auto fits = [size](const uint64_t p_offset, const uint64_t p_count, const uint64_t p_elementSize)
+	{
+		return p_offset <= size && p_count <= (size - p_offset) / p_elementSize;
+	};
+
+	for (const MeshFileEntry& entry : entries)
+	{
+		if (!fits(entry.vertexOffset, entry.vertexCount, sizeof(Vertex)) || !fits(entry.indexOffset, entry.indexCount, sizeof(uint32_t))
+			|| !fits(entry.nameOffset, entry.nameLength, 1u) || !fits(entry.meshletOffset, entry.meshletCount, sizeof(Meshlet))
+			|| !fits(entry.meshletVertexOffset, entry.meshletVertexCount, sizeof(uint32_t))
+			|| !fits(entry.meshletTriangleOffset, entry.meshletTriangleCount, sizeof(uint8_t))
+			|| !fits(entry.lodOffset, entry.lodCount, sizeof(MeshFileLod)))
+			return nullptr;
+	}
+
+	std::shared_ptr<Mesh> mainMesh;
+	for (const MeshFileEntry& entry : entries)
+	{
+		std::vector<Vertex> vertices(entry.vertexCount);
+		std::memcpy(vertices.data(), file.Data() + entry.vertexOffset, entry.vertexCount * sizeof(Vertex));
+		std::vector<uint32_t> indices(entry.indexCount);
+		std::memcpy(indices.data(), file.Data() + entry.indexOffset, entry.indexCount * sizeof(uint32_t));
+
+		MeshletData meshlets;
+		meshlets.meshlets.resize(entry.meshletCount);
+		std::memcpy(meshlets.meshlets.data(), file.Data() + entry.meshletOffset, entry.meshletCount * sizeof(Meshlet));
+		meshlets.vertices.resize(entry.meshletVertexCount);
+		std::memcpy(meshlets.vertices.data(), file.Data() + entry.meshletVertexOffset, entry.meshletVertexCount * sizeof(uint32_t));
+		meshlets.triangles.resize(entry.meshletTriangleCount);
+		std::memcpy(meshlets.triangles.data(), file.Data() + entry.meshletTriangleOffset, entry.meshletTriangleCount * sizeof(uint8_t));
+
+		// The meshlets give the ranges drawn from the index buffer, a mesh whose meshlets don't match is cooked again
+		if (!meshlets.Empty() && !Utils::MeshletBuilder::Validate(meshlets, vertices.size(), indices))
+			return nullptr;
+
+		std::vector<MeshLod> lods(entry.lodCount);
+		for (size_t level = 0u; level < lods.size(); ++level)
+		{
+			MeshFileLod lod;
+			std::memcpy(&lod, file.Data() + entry.lodOffset + level * sizeof(MeshFileLod), sizeof(lod));
+			if (!fits(lod.indexOffset, lod.indexCount, sizeof(uint32_t)) || lod.indexCount % 3u != 0u)
+				return nullptr;
+
+			lods[level].indices.resize(lod.indexCount);
+			std::memcpy(lods[level].indices.data(), file.Data() + lod.indexOffset, lod.indexCount * sizeof(uint32_t));
+			lods[level].error = lod.error;
+
+			// The levels are drawn with the vertex buffer of the mesh
+			if (std::any_of(lods[level].indices.begin(), lods[level].indices.end(), [&vertices](const uint32_t p_index) { return p_index >= vertices.size(); }))
+				return nullptr;
+		}
+
+		auto mesh = std::make_shared<Mesh>(std::move(vertices), std::move(indices));
+		mesh->SetMeshName(std::string(reinterpret_cast<const char*>(file.Data() + entry.nameOffset), entry.nameLength));
+		mesh->SetMeshlets(std::move(meshlets));
+		mesh->SetLods(std::move(lods));
+
+		BoundingBox box;
+		box.minimum = GPM::Vector3F(entry.boundsMin[0], entry.boundsMin[1], entry.boundsMin[2]);
+		box.maximum = GPM::Vector3F(entry.boundsMax[0], entry.boundsMax[1], entry.boundsMax[2]);
+		BoundingSphere sphere;
+		sphere.center = GPM::Vector3F(entry.sphereCenter[0], entry.sphereCenter[1], entry.sphereCenter[2]);
+		sphere.radius = entry.sphereRadius;
+		mesh->SetBounds(box, sphere);
+
+		if (!mainMesh)
+			mainMesh = std::move(mesh);
+		else
+			mainMesh->AddSubMesh(mesh);
+	}
+
+	return mainMesh;
+}
+
+bool OgEngine::MeshCache::Write(const uint64_t p_sourceHash, const std::shared_ptr<Mesh>& p_mesh)
+{
+	if (p_sourceHash == 0u || !p_mesh)
+		return false;
+
+	const std::vector<Mesh*> meshes = Flatten(p_mesh);
+
+	MeshFileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.sourceHash = p_sourceHash;
+	header.vertexSize = static_cast<uint32_t>(sizeof(Vertex));
+	header.meshCount = static_cast<uint32_t>(meshes.size());
+
+	std::vector<MeshFileEntry> entries(meshes.size());
+	std::vector<std::vector<MeshFileLod>> lodTables(meshes.size());
+	std::string names;
+	uint64_t offset = sizeof(MeshFileHeader) + entries.size() * sizeof(MeshFileEntry);
+	for (size_t i = 0u; i < meshes.size(); ++i)
+	{
+		const std::string name = meshes[i]->MeshName();
+		entries[i].nameOffset = offset + names.size();
+		entries[i].nameLength = name.size();
+		names += name;
+	}
+	offset += names.size();
+
+	for (size_t i = 0u; i < meshes.size(); ++i)
+	{
+		const Mesh& mesh = *meshes[i];
+		MeshFileEntry& entry = entries[i];
+
+		entry.vertexOffset = AlignUp(offset);
+		entry.vertexCount = mesh.Vertices().size();
+		offset = entry.vertexOffset + entry.vertexCount * sizeof(Vertex);
+
+		entry.indexOffset = AlignUp(offset);
+		entry.indexCount = mesh.Indices().size();
+		offset = entry.indexOffset + entry.indexCount * sizeof(uint32_t);
+
+		const MeshletData& meshlets = mesh.Meshlets();
+		entry.meshletOffset = AlignUp(offset);
+		entry.meshletCount = meshlets.meshlets.size();
+		offset = entry.meshletOffset + entry.meshletCount * sizeof(Meshlet);
+
+		entry.meshletVertexOffset = AlignUp(offset);
+		entry.meshletVertexCount = meshlets.vertices.size();
+		offset = entry.meshletVertexOffset + entry.meshletVertexCount * sizeof(uint32_t);
+
+		entry.meshletTriangleOffset = AlignUp(offset);
+		entry.meshletTriangleCount = meshlets.triangles.size();
+		offset = entry.meshletTriangleOffset + entry.meshletTriangleCount * sizeof(uint8_t);
+
+		entry.lodOffset = AlignUp(offset);
+		entry.lodCount = mesh.Lods().size();
+		offset = entry.lodOffset + entry.lodCount * sizeof(MeshFileLod);
+		for (const MeshLod& lod : mesh.Lods())
+		{
+			MeshFileLod& fileLod = lodTables[i].emplace_back();
+			fileLod.indexOffset = AlignUp(offset);
+			fileLod.indexCount = lod.indices.size();
+			fileLod.error = lod.error;
+			fileLod.padding = 0u;
+			offset = fileLod.indexOffset + fileLod.indexCount * sizeof(uint32_t);
+		}
+
+		// A mesh built without its bounds gets them here, a cooked mesh never has to scan its vertices
+		BoundingBox box = mesh.LocalBox();
+		BoundingSphere sphere = mesh.LocalSphere();
+		if (box.Empty() || sphere.Empty())
+		{
+			box = BoundingBox::FromVertices(mesh.Vertices());
+			sphere = BoundingSphere::FromVertices(mesh.Vertices(), box);
+		}
+
+		entry.boundsMin[0] = box.minimum.x;
+		entry.boundsMin[1] = box.minimum.y;
+		entry.boundsMin[2] = box.minimum.z;
+		entry.boundsMax[0] = box.maximum.x;
+		entry.boundsMax[1] = box.maximum.y;
+		entry.boundsMax[2] = box.maximum.z;
+		entry.sphereCenter[0] = sphere.center.x;
+		entry.sphereCenter[1] = sphere.center.y;
+		entry.sphereCenter[2] = sphere.center.z;
+		entry.sphereRadius = sphere.radius;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(DIRECTORY, error);
+
+	// Written aside then renamed, a reader never maps a file being written
+	const std::string path = CookedPath(p_sourceHash);
+	std::ostringstream temporaryPath;
+	temporaryPath << path << '.' << std::this_thread::get_id() << ".tmp";
+	{
+		std::ofstream output(temporaryPath.str(), std::ios::binary | std::ios::trunc);
+		if (!output)
+		{
+			std::cerr << "Warning: Couldn't write the cooked mesh " << path << ".\n";
+			return false;
+		}
+
+		const auto pad = [&output]()
+		{
+			const auto position = static_cast<uint64_t>(output.tellp());
+			const char zeros[DATA_ALIGNMENT] = {};
+			output.write(zeros, static_cast<std::streamsize>(AlignUp(position) - position));
+		};
+
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(MeshFileEntry)));
+		output.write(names.data(), static_cast<std::streamsize>(names.size()));
+		for (size_t i = 0u; i < meshes.size(); ++i)
+		{
+			const Mesh* mesh = meshes[i];
+			pad();
+			output.write(reinterpret_cast<const char*>(mesh->Vertices().data()), static_cast<std::streamsize>(mesh->Vertices().size() * sizeof(Vertex)));
+			pad();
+			output.write(reinterpret_cast<const char*>(mesh->Indices().data()), static_cast<std::streamsize>(mesh->Indices().size() * sizeof(uint32_t)));
+
+			const MeshletData& meshlets = mesh->Meshlets();
+			pad();
+			output.write(reinterpret_cast<const char*>(meshlets.meshlets.data()), static_cast<std::streamsize>(meshlets.meshlets.size() * sizeof(Meshlet)));
+			pad();
+			output.write(reinterpret_cast<const char*>(meshlets.vertices.data()), static_cast<std::streamsize>(meshlets.vertices.size() * sizeof(uint32_t)));
+			pad();
+			output.write(reinterpret_cast<const char*>(meshlets.triangles.data()), static_cast<std::streamsize>(meshlets.triangles.size() * sizeof(uint8_t)));
+
+			pad();
+			output.write(reinterpret_cast<const char*>(lodTables[i].data()), static_cast<std::streamsize>(lodTables[i].size() * sizeof(MeshFileLod)));
+			for (const MeshLod& lod : mesh->Lods())
+			{
+				pad();
+				output.write(reinterpret_cast<const char*>(lod.indices.data()), static_cast<std::streamsize>(lod.indices.size() * sizeof(uint32_t)));
+			}
+		}
+
+		if (!output)
+		{
+			output.close();
+			std::filesystem::remove(temporaryPath.str(), error);
+			std::cerr << "Warning: Couldn't write the cooked mesh " << path << ".\n";
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath.str(), path, error);
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath.str(), error);
+		return false;
+	}
+
+	return true;
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <cstdlib>
 
 VkShaderModule ShaderLoader::LoadShader(const char* p_fileName, VkDevice p_device)
 {
@@ -37,3 +38,24 @@ VkShaderModule ShaderLoader::LoadShader(const char* p_fileName, VkDevice p_devic
 		return nullptr;
 	}
 }
+
+bool ShaderLoader::CompileShader(const std::string& p_source, const std::string& p_binary)
+{
+	const std::string command = "glslangValidator -t -V \"" + p_source + "\" -o \"" + p_binary + "\"";
+	if (std::system(command.c_str()) != 0)
+	{
+		std::cerr << "Error: Could not compile shader file \"" << p_source << "\"" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+std::string ShaderLoader::BinaryPath(const std::string& p_source)
+{
+	const size_t separator = p_source.find_last_of("/\\");
+	const std::string folder = separator == std::string::npos ? std::string() : p_source.substr(0, separator + 1);
+	const std::string fileName = p_source.substr(folder.size());
+
+	return folder + "bin/" + fileName.substr(0, fileName.find_last_of('.')) + ".spv";
+}
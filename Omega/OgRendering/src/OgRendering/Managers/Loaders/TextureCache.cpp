@@ -0,0 +1,327 @@
+#include <OgRendering/Managers/Loaders/TextureCache.h>
+#include <OgRendering/Rendering/stb_dxt.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+#include <OgRendering/Utils/MipGenerator.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr char MAGIC[4] = { 'O', 'G', 'T', 'X' };
+	constexpr uint64_t DATA_ALIGNMENT = 16u;
+
+	uint64_t AlignUp(const uint64_t p_offset)
+	{
+		return (p_offset + DATA_ALIGNMENT - 1u) & ~(DATA_ALIGNMENT - 1u);
+	}
+
+	bool IsOpaque(const stbi_uc* p_pixels, const uint32_t p_width, const uint32_t p_height, const uint32_t p_channels)
+	{
+		// The alpha is the last channel of the gray and alpha images and of the RGBA ones
+		if (p_channels != 2u && p_channels != 4u)
+			return true;
+
+		const size_t pixelCount = static_cast<size_t>(p_width) * p_height;
+		for (size_t pixel = 0u; pixel < pixelCount; ++pixel)
+		{
+			if (p_pixels[pixel * p_channels + p_channels - 1u] != 255u)
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Compress a 8 bits level block by block, the blocks crossing the border repeat the last row and column.
+	 * @param p_channels Channels of the level, expanded to RGBA like Texture::RgbaPixels does
+	 */
+	void CompressLevel(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, const uint32_t p_channels, const bool p_alpha,
+		uint8_t* p_destination)
+	{
+		const uint32_t blockSize = p_alpha ? 16u : 8u;
+		uint8_t block[16 * 4];
+
+		for (uint32_t blockY = 0u; blockY < p_height; blockY += 4u)
+		{
+			for (uint32_t blockX = 0u; blockX < p_width; blockX += 4u)
+			{
+				for (uint32_t y = 0u; y < 4u; ++y)
+				{
+					const uint32_t sourceY = std::min(blockY + y, p_height - 1u);
+					for (uint32_t x = 0u; x < 4u; ++x)
+					{
+						const uint32_t sourceX = std::min(blockX + x, p_width - 1u);
+						const uint8_t* pixel = p_source + (static_cast<size_t>(sourceY) * p_width + sourceX) * p_channels;
+						uint8_t* texel = block + (y * 4u + x) * 4u;
+						const bool isGray = p_channels < 3u;
+						texel[0] = pixel[0];
+						texel[1] = isGray ? pixel[0] : pixel[1];
+						texel[2] = isGray ? pixel[0] : pixel[2];
+						texel[3] = p_channels == 2u ? pixel[1] : p_channels == 4u ? pixel[3] : 255u;
+					}
+				}
+
+				stb_compress_dxt_block(p_destination, block, p_alpha ? 1 : 0, STB_DXT_NORMAL);
+				p_destination += blockSize;
+			}
+		}
+	}
+}
+
+bool OgEngine::TextureCache::IsCompressible(const TEXTURE_FORMAT p_format, const CookSettings& p_settings)
+{
+	return p_settings.compress && Texture::FormatInfo(p_format).channelBytes == 1u;
+}
+
+uint64_t OgEngine::TextureCache::LevelSize(const TEXTURE_FORMAT p_format, const uint32_t p_width, const uint32_t p_height)
+{
+	const uint64_t blocks = static_cast<uint64_t>((p_width + 3u) / 4u) * ((p_height + 3u) / 4u);
+	switch (p_format)
+	{
+	case TEXTURE_FORMAT::BC1:
+		return blocks * 8u;
+	case TEXTURE_FORMAT::BC3:
+		return blocks * 16u;
+	default:
+		return static_cast<uint64_t>(p_width) * p_height * Texture::FormatInfo(p_format).PixelBytes();
+	}
+}
+
+std::string OgEngine::TextureCache::CookedPath(const uint64_t p_sourceHash)
+{
+	std::ostringstream path;
+	path << DIRECTORY << std::hex;
+	path.width(16);
+	path.fill('0');
+	path << p_sourceHash << EXTENSION;
+
+	return path.str();
+}
+
+bool OgEngine::TextureCache::Cook(const uint8_t* p_pixels, const uint32_t p_width, const uint32_t p_height, const TEXTURE_FORMAT p_format,
+	const CookSettings& p_settings, Texture& p_texture)
+{
+	const TextureFormatInfo& info = Texture::FormatInfo(p_format);
+	if (info.IsCompressed())
+		return false;
+
+	Utils::MipSettings mips = p_settings.mips;
+	mips.channels = info.channels;
+	mips.channelBytes = info.channelBytes;
+
+	std::vector<MipLevel> levels;
+	const std::vector<uint8_t> chain = Utils::MipGenerator::BuildChain(p_pixels, p_width, p_height, levels, mips);
+
+	// Only the 8 bits images are compressed, BC1 and BC3 would lose the precision of the other ones
+	TEXTURE_FORMAT format = p_format;
+	if (IsCompressible(p_format, p_settings))
+		format = IsOpaque(p_pixels, p_width, p_height, info.channels) ? TEXTURE_FORMAT::BC1 : TEXTURE_FORMAT::BC3;
+
+	std::vector<MipLevel> cookedLevels;
+	uint64_t size = 0u;
+	for (const MipLevel& level : levels)
+	{
+		const uint64_t levelSize = LevelSize(format, level.width, level.height);
+		cookedLevels.push_back({ size, levelSize, level.width, level.height });
+		size += levelSize;
+	}
+
+	// Allocated like the pixels of stbi, the texture frees both the same way
+	auto* data = static_cast<stbi_uc*>(std::malloc(static_cast<size_t>(size)));
+	if (!data)
+		return false;
+
+	if (format == p_format)
+	{
+		std::memcpy(data, chain.data(), chain.size());
+	}
+	else
+	{
+		for (size_t level = 0u; level < levels.size(); ++level)
+			CompressLevel(chain.data() + levels[level].offset, levels[level].width, levels[level].height, info.channels,
+				format == TEXTURE_FORMAT::BC3, data + cookedLevels[level].offset);
+	}
+
+	p_texture.FillData(data, p_width, p_height, format, std::move(cookedLevels));
+	return true;
+}
+
+bool OgEngine::TextureCache::Import(const Utils::FileView& p_source, const uint64_t p_sourceHash, const CookSettings& p_settings, Texture& p_texture)
+{
+	if (!p_source.IsOpen())
+		return false;
+
+	const stbi_uc* source = p_source.Data();
+	const int sourceSize = static_cast<int>(p_source.Size());
+
+	// Decoded with the channels and the depth of the file: HDR images in floats, 16 bits PNG in 16 bits, the other ones in 8 bits
+	int width = 0, height = 0, channels = 0;
+	uint32_t channelBytes = 1u;
+	void* pixels = nullptr;
+	stbi_set_flip_vertically_on_load(true);
+	if (stbi_is_hdr_from_memory(source, sourceSize))
+	{
+		pixels = stbi_loadf_from_memory(source, sourceSize, &width, &height, &channels, 0);
+		channelBytes = 4u;
+	}
+	else if (stbi_is_16_bit_from_memory(source, sourceSize))
+	{
+		pixels = stbi_load_16_from_memory(source, sourceSize, &width, &height, &channels, 0);
+		channelBytes = 2u;
+	}
+	else
+	{
+		pixels = stbi_load_from_memory(source, sourceSize, &width, &height, &channels, 0);
+	}
+
+	if (!pixels)
+		return false;
+
+	const bool cooked = Cook(static_cast<const uint8_t*>(pixels), static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+		Texture::FormatOf(static_cast<uint32_t>(channels), channelBytes), p_settings, p_texture);
+	stbi_image_free(pixels);
+
+	// Without its cooked file, the levels dropped by the streaming couldn't be read again
+	if (cooked && Write(p_sourceHash, p_settings, p_texture))
+		p_texture.SetSource({ p_sourceHash, p_texture.Width(), p_texture.Height(), p_texture.MipmapLevels(), 0u });
+
+	return cooked;
+}
+
+bool OgEngine::TextureCache::Read(const uint64_t p_sourceHash, const CookSettings& p_settings, Texture& p_texture, const uint32_t p_maxSize)
+{
+	if (p_sourceHash == 0u)
+		return false;
+
+	const Utils::FileView file = Utils::VirtualFileSystem::Instance().Open(CookedPath(p_sourceHash));
+	if (!file.IsOpen() || file.Size() < sizeof(TextureFileHeader))
+		return false;
+
+	TextureFileHeader header;
+	std::memcpy(&header, file.Data(), sizeof(header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.sourceHash != p_sourceHash
+		|| header.format > static_cast<uint32_t>(TEXTURE_FORMAT::RGBA32F) || header.width == 0u || header.height == 0u || header.levelCount == 0u
+		|| IsCompressible(static_cast<TEXTURE_FORMAT>(header.format), p_settings)
+		|| (Texture::FormatInfo(static_cast<TEXTURE_FORMAT>(header.format)).IsCompressed() && !p_settings.compress)
+		|| header.mipFilter != static_cast<uint32_t>(p_settings.mips.filter) || (header.srgb != 0u) != p_settings.mips.srgb)
+		return false;
+
+	const uint64_t size = file.Size();
+	if (header.levelCount > (size - sizeof(TextureFileHeader)) / sizeof(MipLevel)
+		|| header.dataOffset < sizeof(TextureFileHeader) + header.levelCount * sizeof(MipLevel) || header.dataOffset > size)
+		return false;
+
+	std::vector<MipLevel> levels(header.levelCount);
+	std::memcpy(levels.data(), file.Data() + sizeof(TextureFileHeader), levels.size() * sizeof(MipLevel));
+
+	// The sizes are checked against the format as well, the GPU copies each level from them
+	const auto format = static_cast<TEXTURE_FORMAT>(header.format);
+	const uint64_t dataSize = size - header.dataOffset;
+	uint32_t width = header.width;
+	uint32_t height = header.height;
+	uint64_t expectedOffset = 0u;
+	for (const MipLevel& level : levels)
+	{
+		if (level.width != width || level.height != height || level.offset != expectedOffset
+			|| level.size != LevelSize(format, width, height) || level.size > dataSize - level.offset)
+			return false;
+
+		expectedOffset += level.size;
+		width = std::max(1u, width / 2u);
+		height = std::max(1u, height / 2u);
+	}
+
+	// The levels larger than asked stay in the file, only the pages of the ones read are touched
+	uint32_t firstLevel = 0u;
+	if (p_maxSize != 0u)
+	{
+		while (firstLevel + 1u < header.levelCount && std::max(levels[firstLevel].width, levels[firstLevel].height) > p_maxSize)
+			++firstLevel;
+	}
+
+	const uint64_t firstOffset = levels[firstLevel].offset;
+	levels.erase(levels.begin(), levels.begin() + firstLevel);
+	for (MipLevel& level : levels)
+		level.offset -= firstOffset;
+
+	const uint64_t readSize = expectedOffset - firstOffset;
+	auto* data = static_cast<stbi_uc*>(std::malloc(static_cast<size_t>(readSize)));
+	if (!data)
+		return false;
+
+	std::memcpy(data, file.Data() + header.dataOffset + firstOffset, static_cast<size_t>(readSize));
+	width = levels.front().width;
+	height = levels.front().height;
+	p_texture.FillData(data, width, height, format, std::move(levels));
+	p_texture.SetSource({ p_sourceHash, header.width, header.height, header.levelCount, firstLevel });
+
+	return true;
+}
+
+bool OgEngine::TextureCache::Write(const uint64_t p_sourceHash, const CookSettings& p_settings, const Texture& p_texture)
+{
+	if (p_sourceHash == 0u || !p_texture.Pixels() || p_texture.Levels().empty())
+		return false;
+
+	const std::vector<MipLevel>& levels = p_texture.Levels();
+
+	TextureFileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.sourceHash = p_sourceHash;
+	header.format = static_cast<uint32_t>(p_texture.Format());
+	header.width = p_texture.Width();
+	header.height = p_texture.Height();
+	header.levelCount = static_cast<uint32_t>(levels.size());
+	header.mipFilter = static_cast<uint32_t>(p_settings.mips.filter);
+	header.srgb = p_settings.mips.srgb ? 1u : 0u;
+	header.dataOffset = AlignUp(sizeof(TextureFileHeader) + levels.size() * sizeof(MipLevel));
+
+	std::error_code error;
+	std::filesystem::create_directories(DIRECTORY, error);
+
+	// Written aside then renamed, a reader never maps a file being written
+	const std::string path = CookedPath(p_sourceHash);
+	std::ostringstream temporaryPath;
+	temporaryPath << path << '.' << std::this_thread::get_id() << ".tmp";
+	{
+		std::ofstream output(temporaryPath.str(), std::ios::binary | std::ios::trunc);
+		if (!output)
+		{
+			std::cerr << "Warning: Couldn't write the cooked texture " << path << ".\n";
+			return false;
+		}
+
+		const char zeros[DATA_ALIGNMENT] = {};
+		const uint64_t tableEnd = sizeof(TextureFileHeader) + levels.size() * sizeof(MipLevel);
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		output.write(reinterpret_cast<const char*>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(MipLevel)));
+		output.write(zeros, static_cast<std::streamsize>(header.dataOffset - tableEnd));
+		output.write(reinterpret_cast<const char*>(p_texture.Pixels()), static_cast<std::streamsize>(p_texture.ImageSize()));
+
+		if (!output)
+		{
+			output.close();
+			std::filesystem::remove(temporaryPath.str(), error);
+			std::cerr << "Warning: Couldn't write the cooked texture " << path << ".\n";
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath.str(), path, error);
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath.str(), error);
+		return false;
+	}
+
+	return true;
+}
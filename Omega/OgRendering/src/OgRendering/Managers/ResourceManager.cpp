@@ -1,8 +1,48 @@
 #include <OgRendering/Managers/ResourceManager.h>
+#include <OgRendering/Managers/Loaders/CookManifest.h>
+#include <OgRendering/Managers/Loaders/ShaderLoader.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
 
 OgEngine::Services::MeshService    OgEngine::ResourceManager::m_meshService{};
 OgEngine::Services::TextureService OgEngine::ResourceManager::m_textureService{};
 bool                               OgEngine::ResourceManager::m_raytracingEnable = false;
+OgEngine::Utils::FileWatcher       OgEngine::ResourceManager::m_watcher{};
+std::vector<std::string>           OgEngine::ResourceManager::m_changedShaders{};
+std::mutex                         OgEngine::ResourceManager::m_changedShadersMutex{};
+
+namespace
+{
+	std::string Extension(const std::string& p_file)
+	{
+		std::string extension = std::filesystem::path(p_file).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char p_character)
+		{
+			return static_cast<char>(std::tolower(p_character));
+		});
+
+		return extension;
+	}
+
+	bool IsShaderStage(const std::string& p_extension)
+	{
+		return p_extension == ".vert" || p_extension == ".frag" || p_extension == ".comp" || p_extension == ".geom" || p_extension == ".tesc"
+			|| p_extension == ".tese" || p_extension == ".rgen" || p_extension == ".rchit" || p_extension == ".rahit" || p_extension == ".rmiss"
+			|| p_extension == ".rint";
+	}
+
+	void CompileShader(const std::string& p_source)
+	{
+		// The SPIR-V file written is seen by the watcher, which reports the shader as changed
+		OgEngine::Utils::JobSystem::Instance().Submit([p_source]()
+		{
+			ShaderLoader::CompileShader(p_source, ShaderLoader::BinaryPath(p_source));
+		});
+	}
+}
 
 OgEngine::ResourceManager& OgEngine::ResourceManager::Instance()
 {
@@ -10,3 +50,88 @@ OgEngine::ResourceManager& OgEngine::ResourceManager::Instance()
 
 	return m_instance;
 }
+
+bool OgEngine::ResourceManager::WatchResources(std::string_view p_directory, const std::chrono::milliseconds p_debounce)
+{
+	return m_watcher.Start(p_directory, &ResourceManager::ReloadFiles, p_debounce);
+}
+
+void OgEngine::ResourceManager::StopWatching()
+{
+	m_watcher.Stop();
+}
+
+void OgEngine::ResourceManager::ReloadFiles(const std::vector<std::string>& p_files)
+{
+	for (const std::string& file : p_files)
+	{
+		const std::string extension = Extension(file);
+		if (extension == ".spv")
+		{
+			std::lock_guard<std::mutex> lock(m_changedShadersMutex);
+			if (std::find(m_changedShaders.begin(), m_changedShaders.end(), file) == m_changedShaders.end())
+				m_changedShaders.emplace_back(file);
+		}
+		else if (extension == ".glsl")
+		{
+			// Included by the stages, every stage of its folder is compiled again
+			std::error_code error;
+			for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(file).parent_path(), error))
+			{
+				if (IsShaderStage(Extension(entry.path().string())))
+					CompileShader(entry.path().generic_string());
+			}
+		}
+		else if (IsShaderStage(extension))
+		{
+			CompileShader(file);
+		}
+		else if (CookManifest::KindOf(file) == ASSET_KIND::TEXTURE)
+		{
+			m_textureService.Reload(file);
+		}
+		else
+		{
+			// Any other file may be a mesh, it is only reloaded if a mesh of this file is loaded
+			m_meshService.Reload(file);
+		}
+	}
+}
+
+bool OgEngine::ResourceManager::LoadManifest(const std::string& p_file)
+{
+	auto manifest = std::make_shared<CookManifest>();
+	if (!manifest->Load(p_file))
+	{
+		std::cout << "Warning: No cook manifest in " << p_file << ", the sources are hashed to find their cooked files.\n";
+		return false;
+	}
+
+	std::shared_ptr<const CookManifest> shared = std::move(manifest);
+	m_meshService.SetManifest(shared);
+	m_textureService.SetManifest(shared);
+	return true;
+}
+
+bool OgEngine::ResourceManager::MountPack(const std::string& p_file)
+{
+	if (!Utils::VirtualFileSystem::Instance().Mount(p_file))
+	{
+		std::cout << "Warning: No pack archive in " << p_file << ", the resources are read from their files.\n";
+		return false;
+	}
+
+	return true;
+}
+
+OgEngine::ReloadedResources OgEngine::ResourceManager::ApplyReloads()
+{
+	ReloadedResources reloaded;
+	reloaded.meshes = m_meshService.SwapReloaded();
+	reloaded.textures = m_textureService.SwapReloaded();
+
+	std::lock_guard<std::mutex> lock(m_changedShadersMutex);
+	reloaded.shaders.swap(m_changedShaders);
+
+	return reloaded;
+}
@@ -1,86 +1,273 @@
 #include <OgRendering/Managers/Services/MeshService.h>
 #include <OgRendering/Managers/Loaders/LoaderManager.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
 #include <sstream>
 
-OgEngine::Services::MeshService::MeshService() = default;
+OgEngine::Services::MeshService::MeshService() : m_jobs(Utils::JobSystem::Instance())
+{
+}
 
 OgEngine::Services::MeshService::~MeshService()
 {
 	WaitForAll();
-	m_workerToMesh.clear();
-	m_meshes.clear();
+	m_meshes.Clear();
+}
+
+OgEngine::ResourceHandle<OgEngine::Mesh> OgEngine::Services::MeshService::Add(std::string_view p_filePath, const LOAD_PRIORITY p_priority)
+{
+	return Load(p_filePath, p_priority, false, nullptr);
+}
+
+OgEngine::ResourceReference<OgEngine::Mesh> OgEngine::Services::MeshService::Request(std::string_view p_filePath, const LOAD_PRIORITY p_priority)
+{
+	ResourceReference<Mesh> reference;
+	Load(p_filePath, p_priority, true, &reference);
+	return reference;
+}
+
+bool OgEngine::Services::MeshService::Prioritize(std::string_view p_meshName, const LOAD_PRIORITY p_priority)
+{
+	return GetHandle(p_meshName).Prioritize(p_priority);
 }
 
-void OgEngine::Services::MeshService::Add(std::string_view p_filePath)
+OgEngine::ResourceHandle<OgEngine::Mesh> OgEngine::Services::MeshService::Load(std::string_view p_filePath, const LOAD_PRIORITY p_priority, const bool p_cancellable, ResourceReference<Mesh>* p_reference)
 {
-	const std::string_view fileName{ p_filePath.data() + (p_filePath.find_last_of('/') + 1) };
+	// A view isn't NUL terminated, the name ends where p_filePath ends
+	const std::string_view fileName = p_filePath.substr(p_filePath.find_last_of('/') + 1);
+
+	auto mesh = std::make_shared<Mesh>();
+	mesh->SetHashID(m_hashValueFromName(std::string(p_filePath)));
+
+	bool isNew = false;
+	ResourceHandle<Mesh> handle = m_meshes.Update(fileName, [&mesh, &isNew, p_cancellable, p_reference](ResourceHandle<Mesh>& p_handle, bool)
+	{
+		// Referenced with the entry locked, so a cancellation can't drop the mesh before the reference is taken
+		const auto reference = [p_reference, &p_handle]()
+		{
+			if (p_reference)
+				*p_reference = ResourceReference<Mesh>(p_handle);
+
+			return p_handle;
+		};
+
+		// A file that failed to load is loaded again, it may have been fixed since
+		if (p_handle.IsValid() && !p_handle.IsFailed())
+		{
+			// Added for good, the loading is no longer cancelled when the references are released
+			if (!p_cancellable)
+				p_handle.OnUnreferenced(nullptr);
+
+			return reference();
+		}
+
+		p_handle = ResourceHandle<Mesh>(mesh);
+		isNew = true;
+		return reference();
+	});
 
-	if (m_meshes.find(fileName.data()) != m_meshes.end())
+	if (!isNew)
 	{
-		std::cout << "Warning: The file '" << fileName << "' already exist in memory, loading is discarded.\n";
+		// Needed sooner than when it was queued
+		if (handle.IsPending())
+			handle.Prioritize(p_priority);
+		else
+			std::cout << "Warning: The file '" << fileName << "' already exist in memory, loading is discarded.\n";
+
+		return handle;
 	}
 
-	// Check if the file is valid before adding anything
-	if (LoaderManager::CheckValidMesh(p_filePath))
+	if (p_cancellable)
 	{
-		m_meshes.insert({ fileName.data(), std::make_shared<Mesh>() });
+		handle.OnUnreferenced([this, name = std::string(fileName)](const ResourceHandle<Mesh>& p_handle)
+		{
+			CancelUnreferenced(name, p_handle);
+		});
+	}
 
-		m_meshes.at(fileName.data())->SetHashID(m_hashValueFromName(p_filePath.data()));
+	// The job owns a copy of the path, the caller may not keep its string alive until the end of the loading
+	handle.SetTask(m_jobs.Submit(ToJobPriority(p_priority), &MeshService::MultithreadedLoading, this, std::string(p_filePath), mesh, handle));
+	return handle;
+}
 
-		m_workerToMesh.emplace_back(std::make_pair<uint64_t, std::string>(m_pool.WorkersInUse(), fileName.data()));
+void OgEngine::Services::MeshService::CancelUnreferenced(const std::string& p_meshName, const ResourceHandle<Mesh>& p_handle)
+{
+	// Checked with the entry locked, a Request of the same file meanwhile either keeps the loading or queues it again
+	const bool cancelled = m_meshes.EraseIf(p_meshName, [&p_handle](const ResourceHandle<Mesh>& p_registered)
+	{
+		return p_registered == p_handle && p_handle.References() == 0u && p_handle.CancelTask();
+	});
 
-		m_pool.AddTask(&MeshService::MultithreadedLoading, this, p_filePath);
-	}
+	// Completed once the entry is unlocked, its callbacks may use the service
+	if (cancelled)
+		p_handle.Complete(false);
 }
 
-void OgEngine::Services::MeshService::MultithreadedLoading(std::string_view p_filePath)
+void OgEngine::Services::MeshService::MultithreadedLoading(const std::string& p_filePath, const std::shared_ptr<Mesh>& p_mesh, const ResourceHandle<Mesh>& p_handle)
 {
-	const std::string_view fileName{ p_filePath.data() + (p_filePath.find_last_of('/') + 1) };
-	const std::shared_ptr<Mesh> meshToAdd = LoaderManager::Load<Mesh>(p_filePath);
+	const std::string fileName = p_filePath.substr(p_filePath.find_last_of('/') + 1);
+	// A source listed unchanged by the cook manifest or packed isn't read to be hashed
+	const std::optional<uint64_t> trustedHash = TrustedHash(p_filePath);
+	const std::shared_ptr<Mesh> meshToAdd = trustedHash ? LoaderManager::LoadMesh(p_filePath, *trustedHash) : LoaderManager::Load<Mesh>(p_filePath);
 	if (meshToAdd)
 	{
-		auto& actualMesh = m_meshes.at(fileName.data());
+		auto& actualMesh = p_mesh;
+		// The placeholder handed out by Add takes the buffers of the loaded mesh, the vertices are never copied
 		actualMesh->FillData(meshToAdd);
 		if (actualMesh->MeshName().empty())
 		{
-			actualMesh->SetMeshName(fileName.data());
+			actualMesh->SetMeshName(fileName);
 		}
-		actualMesh->SetParentMeshName(fileName.data());
-		actualMesh->SetMeshFilepath(p_filePath.data());
+		actualMesh->SetParentMeshName(fileName);
+		actualMesh->SetMeshFilepath(p_filePath);
 		actualMesh->SetAsSubmesh(false);
 		actualMesh->SetIndexSubmesh(0);
 
 		int i = 0; 
-		for (auto& subMesh: m_meshes.at(fileName.data())->SubMeshes())
+		for (auto& subMesh: actualMesh->SubMeshes())
 		{
-			subMesh->SetParentMeshName(fileName.data());
-			subMesh->SetMeshFilepath(p_filePath.data());
+			subMesh->SetParentMeshName(fileName);
+			subMesh->SetMeshFilepath(p_filePath);
 			subMesh->SetAsSubmesh(true);
 			subMesh->SetIndexSubmesh(i);
 			++i;
 		}
+
+		actualMesh->SetVertexLayout(m_vertexLayout.load());
+
+		const uint64_t bytes = p_mesh->CpuBytes();
+		p_handle.SetResidentBytes(bytes);
+		m_residentBytes.fetch_add(bytes);
 	}
+
+	// Published last, the mesh is only given once completely filled
+	p_handle.Complete(meshToAdd != nullptr);
 }
 
-inline std::shared_ptr<OgEngine::Mesh> OgEngine::Services::MeshService::Get(std::string_view p_meshName) const
+std::shared_ptr<OgEngine::Mesh> OgEngine::Services::MeshService::Get(std::string_view p_meshName) const
 {
-	if (m_meshes.find(p_meshName.data()) != m_meshes.end())
-		return m_meshes.at(p_meshName.data());
+	// A file still loading or that couldn't be imported is considered as missing
+	const ResourceHandle<Mesh> handle = GetHandle(p_meshName);
+	handle.Touch(m_useClock.fetch_add(1u) + 1u);
+	return handle.Get();
+}
 
-	return nullptr;
+OgEngine::ResourceHandle<OgEngine::Mesh> OgEngine::Services::MeshService::GetHandle(std::string_view p_meshName) const
+{
+	return m_meshes.Find(p_meshName);
 }
 
-inline void OgEngine::Services::MeshService::WaitForResource(std::string_view p_meshName)
+bool OgEngine::Services::MeshService::IsLoading(std::string_view p_meshName) const
 {
-	const auto& pairFound = std::find_if(m_workerToMesh.begin(), m_workerToMesh.end(),
-		[p_meshName](const std::pair<uint64_t, std::string>& element)
-		{ return element.second == p_meshName.data(); });
+	return GetHandle(p_meshName).IsPending();
+}
+
+void OgEngine::Services::MeshService::WaitForAll()
+{
+	std::vector<ResourceHandle<Mesh>> handles;
+	m_meshes.ForEach([&handles](const std::string&, const ResourceHandle<Mesh>& p_handle)
+	{
+		if (p_handle.IsPending())
+			handles.emplace_back(p_handle);
+	});
 
-	if (pairFound != m_workerToMesh.end())
+	// The new versions of reloaded meshes aren't registered until they are swapped in
 	{
-		m_pool.WaitForWorker(pairFound->first);
-		m_workerToMesh.erase(pairFound);
+		std::lock_guard<std::mutex> lock(m_reloadsMutex);
+		for (const PendingReload<Mesh>& reload : m_reloads)
+			handles.emplace_back(reload.handle);
 	}
+
+	for (const auto& handle : handles)
+		handle.Wait();
+}
+
+void OgEngine::Services::MeshService::WaitForResource(std::string_view p_meshName)
+{
+	const ResourceHandle<Mesh> handle = GetHandle(p_meshName);
+	if (handle.IsValid())
+		handle.Wait();
 	else
-		std::cerr << "Couldn't find " << p_meshName.data() << ", waiting for the Resource skipped.\nThe resource might be already into memory or the file name is misspelled.\n";
-}
\ No newline at end of file
+		std::cerr << "Couldn't find " << p_meshName << ", waiting for the Resource skipped.\nThe resource might not be added yet or the file name is misspelled.\n";
+}
+
+OgEngine::ResourceReference<OgEngine::Mesh> OgEngine::Services::MeshService::Acquire(std::string_view p_meshName) const
+{
+	const ResourceHandle<Mesh> handle = GetHandle(p_meshName);
+	return handle.IsValid() ? ResourceReference<Mesh>(handle) : ResourceReference<Mesh>();
+}
+
+void OgEngine::Services::MeshService::SetBudget(const ResourceBudget& p_budget)
+{
+	m_budget = p_budget;
+}
+
+const OgEngine::ResourceBudget& OgEngine::Services::MeshService::Budget() const
+{
+	return m_budget;
+}
+
+uint64_t OgEngine::Services::MeshService::ResidentBytes() const
+{
+	return m_residentBytes.load();
+}
+
+std::vector<OgEngine::ResourceHandle<OgEngine::Mesh>> OgEngine::Services::MeshService::Trim()
+{
+	return TrimToBudget(m_meshes, m_residentBytes, m_budget.maxResidentBytes);
+}
+
+bool OgEngine::Services::MeshService::Reload(std::string_view p_filePath)
+{
+	const std::string fileName(p_filePath.substr(p_filePath.find_last_of('/') + 1));
+	// A mesh still loading reads the new file anyway, an unknown or evicted one is loaded by Add
+	if (!GetHandle(fileName).IsReady())
+		return false;
+
+	auto mesh = std::make_shared<Mesh>();
+	mesh->SetHashID(m_hashValueFromName(std::string(p_filePath)));
+	ResourceHandle<Mesh> handle(mesh);
+
+	{
+		std::lock_guard<std::mutex> lock(m_reloadsMutex);
+		m_reloads.push_back({ fileName, handle });
+	}
+
+	handle.SetTask(m_jobs.Submit(&MeshService::MultithreadedLoading, this, std::string(p_filePath), mesh, handle));
+	return true;
+}
+
+std::vector<OgEngine::ReloadedResource<OgEngine::Mesh>> OgEngine::Services::MeshService::SwapReloaded()
+{
+	return OgEngine::SwapReloaded(m_meshes, m_residentBytes, m_reloads, m_reloadsMutex);
+}
+
+void OgEngine::Services::MeshService::SetManifest(std::shared_ptr<const CookManifest> p_manifest)
+{
+	std::lock_guard<std::mutex> lock(m_manifestMutex);
+	m_manifest = std::move(p_manifest);
+}
+
+std::optional<uint64_t> OgEngine::Services::MeshService::TrustedHash(const std::string& p_filePath) const
+{
+	std::shared_ptr<const CookManifest> manifest;
+	{
+		std::lock_guard<std::mutex> lock(m_manifestMutex);
+		manifest = m_manifest;
+	}
+
+	if (const std::optional<uint64_t> hash = manifest ? manifest->TrustedHash(p_filePath) : std::nullopt)
+		return hash;
+
+	// A packed source is as good, the archive stores its hash
+	return Utils::VirtualFileSystem::Instance().PackedHash(p_filePath);
+}
+
+void OgEngine::Services::MeshService::SetVertexLayout(const VERTEX_LAYOUT p_layout)
+{
+	m_vertexLayout.store(p_layout);
+}
+
+OgEngine::VERTEX_LAYOUT OgEngine::Services::MeshService::VertexLayout() const
+{
+	return m_vertexLayout.load();
+}
@@ -1,114 +1,504 @@
 #include <OgRendering/Managers/Services/TextureService.h>
+#include <OgRendering/Managers/Loaders/TextureCache.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
 
 #include <algorithm>
-#include <cmath>
 #include <iostream>
-#include <fstream>
-OgEngine::Services::TextureService::TextureService()
+OgEngine::Services::TextureService::TextureService() : m_jobs(Utils::JobSystem::Instance())
 {
 }
 
 OgEngine::Services::TextureService::~TextureService()
 {
 	WaitForAll();
-	m_workerToTexture.clear();
-	m_textures.clear();
+	m_textures.Clear();
 }
 
-void OgEngine::Services::TextureService::Add(std::string_view p_filePath)
+OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::Services::TextureService::Add(std::string_view p_filePath, const LOAD_PRIORITY p_priority)
 {
-	const std::string_view fileName{p_filePath.data() + (p_filePath.find_last_of('/') + 1)};
+	return Load(p_filePath, p_priority, false, nullptr);
+}
 
-	if (m_textures.find(fileName.data()) != m_textures.end())
+OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::Services::TextureService::Stream(std::string_view p_filePath, const LOAD_PRIORITY p_priority)
+{
+	const std::string fileName(p_filePath.substr(p_filePath.find_last_of('/') + 1));
 	{
-		std::cout << "Warning: The file '" << fileName << "' already exist in memory, loading is discarded.\n";
-		return;
+		std::lock_guard<std::mutex> lock(m_streamedMutex);
+		m_streamedNames.insert(fileName);
+		m_streamedLoading.insert(fileName);
 	}
-	m_textures.insert({fileName.data(), std::make_shared<Texture>()});
 
-	m_textures.at(fileName.data())->SetHashID(m_hashValueFromName(p_filePath.data()));
+	return Load(p_filePath, p_priority, false, nullptr);
+}
 
-	m_workerToTexture.emplace_back(std::make_pair<uint64_t, std::string>(m_pool.WorkersInUse(), fileName.data()));
+OgEngine::ResourceReference<OgEngine::Texture> OgEngine::Services::TextureService::Request(std::string_view p_filePath, const LOAD_PRIORITY p_priority)
+{
+	ResourceReference<Texture> reference;
+	Load(p_filePath, p_priority, true, &reference);
+	return reference;
+}
 
-	m_pool.AddTask(&TextureService::MultithreadedLoading, this, p_filePath);
+bool OgEngine::Services::TextureService::Prioritize(std::string_view p_textureName, const LOAD_PRIORITY p_priority)
+{
+	return GetHandle(p_textureName).Prioritize(p_priority);
+}
+
+OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::Services::TextureService::Load(std::string_view p_filePath, const LOAD_PRIORITY p_priority, const bool p_cancellable, ResourceReference<Texture>* p_reference)
+{
+	// A view isn't NUL terminated, the name ends where p_filePath ends
+	const std::string_view fileName = p_filePath.substr(p_filePath.find_last_of('/') + 1);
+
+	auto texture = std::make_shared<Texture>();
+	texture->SetHashID(m_hashValueFromName(std::string(p_filePath)));
+
+	bool isNew = false;
+	ResourceHandle<Texture> handle = m_textures.Update(fileName, [&texture, &isNew, p_cancellable, p_reference](ResourceHandle<Texture>& p_handle, bool)
+	{
+		// Referenced with the entry locked, so a cancellation can't drop the texture before the reference is taken
+		const auto reference = [p_reference, &p_handle]()
+		{
+			if (p_reference)
+				*p_reference = ResourceReference<Texture>(p_handle);
+
+			return p_handle;
+		};
+
+		// A file that failed to load is loaded again, it may have been fixed since
+		if (p_handle.IsValid() && !p_handle.IsFailed())
+		{
+			// Added for good, the loading is no longer cancelled when the references are released
+			if (!p_cancellable)
+				p_handle.OnUnreferenced(nullptr);
+
+			return reference();
+		}
+
+		p_handle = ResourceHandle<Texture>(texture);
+		isNew = true;
+		return reference();
+	});
+
+	if (!isNew)
+	{
+		// Needed sooner than when it was queued
+		if (handle.IsPending())
+			handle.Prioritize(p_priority);
+		else
+			std::cout << "Warning: The file '" << fileName << "' already exist in memory, loading is discarded.\n";
+
+		return handle;
+	}
+
+	if (p_cancellable)
+	{
+		handle.OnUnreferenced([this, name = std::string(fileName)](const ResourceHandle<Texture>& p_handle)
+		{
+			CancelUnreferenced(name, p_handle);
+		});
+	}
+
+	// The job owns a copy of the path, the caller may not keep its string alive until the end of the loading
+	handle.SetTask(m_jobs.Submit(ToJobPriority(p_priority), &TextureService::MultithreadedLoading, this, std::string(p_filePath),
+		StreamedMaxSize(std::string(fileName)), texture, handle));
+	return handle;
+}
+
+void OgEngine::Services::TextureService::CancelUnreferenced(const std::string& p_textureName, const ResourceHandle<Texture>& p_handle)
+{
+	// Checked with the entry locked, a Request of the same file meanwhile either keeps the loading or queues it again
+	const bool cancelled = m_textures.EraseIf(p_textureName, [&p_handle](const ResourceHandle<Texture>& p_registered)
+	{
+		return p_registered == p_handle && p_handle.References() == 0u && p_handle.CancelTask();
+	});
+
+	// Completed once the entry is unlocked, its callbacks may use the service
+	if (cancelled)
+		p_handle.Complete(false);
 }
 
 std::shared_ptr<OgEngine::Texture> OgEngine::Services::TextureService::Get(std::string_view p_textureName) const
 {
-	if (m_textures.find(p_textureName.data()) != m_textures.end())
-		return m_textures.at(p_textureName.data());
+	// A file still loading or that couldn't be decoded is considered as missing
+	const ResourceHandle<Texture> handle = GetHandle(p_textureName);
+	handle.Touch(m_useClock.fetch_add(1u) + 1u);
+	return handle.Get();
+}
 
-	return nullptr;
+OgEngine::ResourceHandle<OgEngine::Texture> OgEngine::Services::TextureService::GetHandle(std::string_view p_textureName) const
+{
+	return m_textures.Find(p_textureName);
 }
 
-inline void OgEngine::Services::TextureService::WaitForResource(std::string_view p_textureName)
+void OgEngine::Services::TextureService::WaitForAll()
 {
-	const auto& pairFound = std::
-			find_if(m_workerToTexture.begin(), m_workerToTexture.end(),
-			        [p_textureName](const std::pair<uint64_t, std::string>& element)
-			        {
-				        return element.second == p_textureName.data();
-			        });
+	std::vector<ResourceHandle<Texture>> handles;
+	m_textures.ForEach([&handles](const std::string&, const ResourceHandle<Texture>& p_handle)
+	{
+		if (p_handle.IsPending())
+			handles.emplace_back(p_handle);
+	});
 
-	if (pairFound != m_workerToTexture.end())
+	// The new versions of reloaded textures aren't registered until they are swapped in
 	{
-		m_pool.WaitForWorker(pairFound->first);
-		m_workerToTexture.erase(pairFound);
+		std::lock_guard<std::mutex> lock(m_reloadsMutex);
+		for (const PendingReload<Texture>& reload : m_reloads)
+			handles.emplace_back(reload.handle);
 	}
+
+	for (const PendingStream& stream : m_streams)
+		handles.emplace_back(stream.handle);
+
+	for (const auto& handle : handles)
+		handle.Wait();
+}
+
+void OgEngine::Services::TextureService::WaitForResource(std::string_view p_textureName)
+{
+	const ResourceHandle<Texture> handle = GetHandle(p_textureName);
+	if (handle.IsValid())
+		handle.Wait();
 	else
-		std::cerr << "Couldn't find " << p_textureName.data() <<
-				", waiting for the Resource skipped.\nThe resource might be already into memory or the file name is misspelled.\n";
+		std::cerr << "Couldn't find " << p_textureName <<
+				", waiting for the Resource skipped.\nThe resource might not be added yet or the file name is misspelled.\n";
+}
+
+bool OgEngine::Services::TextureService::IsLoading(std::string_view p_textureName) const
+{
+	return GetHandle(p_textureName).IsPending();
 }
 
 std::vector<OgEngine::Texture*>& OgEngine::Services::TextureService::GetAllTextures()
 {
-	m_texturesRefs.resize(m_textures.size());
+	m_texturesRefs.clear();
+	m_texturesRefs.reserve(m_textures.Size());
 
-	auto i = 0;
-	for (const auto& element : m_textures)
+	// Only the textures completely loaded, the other ones are given by a later call
+	m_textures.ForEach([this](const std::string&, const ResourceHandle<Texture>& p_handle)
 	{
-		m_texturesRefs[i] = element.second.get();
-		++i;
-	}
+		if (const std::shared_ptr<Texture> texture = p_handle.Get())
+			m_texturesRefs.emplace_back(texture.get());
+	});
 
 	return m_texturesRefs;
 }
 
-void OgEngine::Services::TextureService::MultithreadedLoading(std::string_view p_filePath)
+void OgEngine::Services::TextureService::MultithreadedLoading(const std::string& p_filePath, const uint32_t p_maxSize,
+	const std::shared_ptr<Texture>& p_texture, const ResourceHandle<Texture>& p_handle)
 {
-	const std::string_view fileName{ p_filePath.data() + (p_filePath.find_last_of('/') + 1) };
-	int texWidth = 0, texHeight = 0, texChannels = 0;
-	stbi_set_flip_vertically_on_load(true);
+	const TextureCache::CookSettings settings = CookSettings();
+
+	// A source listed unchanged by the cook manifest or packed isn't read at all, otherwise it is mapped once,
+	// hashed to find its cooked file and only decoded when there is none
+	const std::optional<uint64_t> trustedHash = TrustedHash(p_filePath);
+	bool loaded = trustedHash && TextureCache::Read(*trustedHash, settings, *p_texture, p_maxSize);
+	if (!loaded)
+	{
+		const Utils::FileView source = Utils::VirtualFileSystem::Instance().Open(p_filePath);
+		const uint64_t sourceHash = source.ContentHash();
+		loaded = TextureCache::Read(sourceHash, settings, *p_texture, p_maxSize) || TextureCache::Import(source, sourceHash, settings, *p_texture);
+	}
 
-	// Check if we eitheir have a relative or full path
-	stbi_uc* pixels = nullptr;
-	const size_t index = p_filePath.find_first_of('/');
-	const std::string_view lectorName = p_filePath.data() + index;
-	const size_t lectorID = lectorName.find(":");
-	if (index != std::string::npos && index == 2 && lectorID != std::string::npos)
+	if (!loaded)
 	{
-		// Loading using full path
-		FILE* fp;
-		errno_t err;
-		if ((err = fopen_s(&fp, p_filePath.data(), "r")) == 0)
+		std::cout << "failed to load texture image named " << std::string(p_filePath.data()) << "\n";
+	}
+
+	if (loaded)
+	{
+		const uint64_t bytes = p_texture->CpuBytes();
+		p_handle.SetResidentBytes(bytes);
+		m_residentBytes.fetch_add(bytes);
+	}
+
+	// Published last, the texture is only given once completely filled
+	p_handle.Complete(loaded);
+}
+
+OgEngine::ResourceReference<OgEngine::Texture> OgEngine::Services::TextureService::Acquire(std::string_view p_textureName) const
+{
+	const ResourceHandle<Texture> handle = GetHandle(p_textureName);
+	return handle.IsValid() ? ResourceReference<Texture>(handle) : ResourceReference<Texture>();
+}
+
+void OgEngine::Services::TextureService::SetBudget(const ResourceBudget& p_budget)
+{
+	m_budget = p_budget;
+}
+
+const OgEngine::ResourceBudget& OgEngine::Services::TextureService::Budget() const
+{
+	return m_budget;
+}
+
+uint64_t OgEngine::Services::TextureService::ResidentBytes() const
+{
+	return m_residentBytes.load();
+}
+
+std::vector<OgEngine::ResourceHandle<OgEngine::Texture>> OgEngine::Services::TextureService::Trim()
+{
+	return TrimToBudget(m_textures, m_residentBytes, m_budget.maxResidentBytes);
+}
+
+bool OgEngine::Services::TextureService::Reload(std::string_view p_filePath)
+{
+	const std::string fileName(p_filePath.substr(p_filePath.find_last_of('/') + 1));
+	// A texture still loading reads the new file anyway, an unknown or evicted one is loaded by Add
+	if (!GetHandle(fileName).IsReady())
+		return false;
+
+	auto texture = std::make_shared<Texture>();
+	texture->SetHashID(m_hashValueFromName(std::string(p_filePath)));
+	ResourceHandle<Texture> handle(texture);
+
+	{
+		std::lock_guard<std::mutex> lock(m_reloadsMutex);
+		m_reloads.push_back({ fileName, handle });
+	}
+
+	handle.SetTask(m_jobs.Submit(&TextureService::MultithreadedLoading, this, std::string(p_filePath), StreamedMaxSize(fileName), texture, handle));
+	return true;
+}
+
+std::vector<OgEngine::ReloadedResource<OgEngine::Texture>> OgEngine::Services::TextureService::SwapReloaded()
+{
+	std::vector<ReloadedResource<Texture>> swapped = OgEngine::SwapReloaded(m_textures, m_residentBytes, m_reloads, m_reloadsMutex);
+
+	// A streamed texture reloaded starts again from its tail, the levels still being read for its previous version are dropped
+	std::lock_guard<std::mutex> lock(m_streamedMutex);
+	for (const ReloadedResource<Texture>& reloaded : swapped)
+	{
+		if (m_streamedNames.count(reloaded.name) == 0u)
+			continue;
+
+		m_residency.Remove(reloaded.name);
+		m_streamedLoading.insert(reloaded.name);
+	}
+
+	return swapped;
+}
+
+void OgEngine::Services::TextureService::ReportUsage(std::string_view p_textureName, const float p_screenSize)
+{
+	m_residency.ReportUsage(std::string(p_textureName), p_screenSize);
+}
+
+std::vector<OgEngine::ReloadedResource<OgEngine::Texture>> OgEngine::Services::TextureService::UpdateStreaming()
+{
+	// The streamed textures loaded since the last update start from the levels they were loaded with
+	std::vector<std::string> loaded;
+	{
+		std::lock_guard<std::mutex> lock(m_streamedMutex);
+		for (auto name = m_streamedLoading.begin(); name != m_streamedLoading.end();)
 		{
-			pixels = stbi_load_from_file(fp, &texWidth, &texHeight, &texChannels,
-				STBI_rgb_alpha);
+			if (GetHandle(*name).IsPending())
+			{
+				++name;
+				continue;
+			}
+
+			loaded.emplace_back(*name);
+			name = m_streamedLoading.erase(name);
 		}
-		fclose(fp);
 	}
-	else
+
+	for (const std::string& name : loaded)
 	{
-		// loading using relative path
-		pixels = stbi_load(p_filePath.data(), &texWidth, &texHeight, &texChannels,
-			STBI_rgb_alpha);
+		// A texture that failed to load isn't streamed
+		if (const std::shared_ptr<Texture> texture = GetHandle(name).Get())
+			AddToResidency(name, *texture);
 	}
-	const uint32_t mipmaps = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
 
-	m_textures.at(fileName.data())->FillData(pixels, texWidth, texHeight, mipmaps);
-	
-	if (!pixels)
+	for (const TextureStreamingRequest& request : m_residency.Update())
 	{
-		std::cout << "failed to load texture image named " << std::string(p_filePath.data()) << "\n";
+		const std::shared_ptr<Texture> previous = GetHandle(request.name).Get();
+		if (!previous)
+		{
+			m_residency.Remove(request.name);
+			continue;
+		}
+
+		// The largest side of the level asked, the levels larger than it aren't read
+		const TextureSource& source = previous->Source();
+		const uint32_t maxSize = request.firstLevel >= 32u ? 1u : std::max(1u, std::max(source.width, source.height) >> request.firstLevel);
+
+		auto texture = std::make_shared<Texture>();
+		texture->SetHashID(previous->HashID());
+		ResourceHandle<Texture> handle(texture);
+		m_streams.push_back({ request.name, request.firstLevel, previous, handle });
+
+		// Behind the textures not loaded at all, a texture already shows with its current levels
+		handle.SetTask(m_jobs.Submit(ToJobPriority(LOAD_PRIORITY::PREFETCH), &TextureService::StreamLevels, this, source.hash, maxSize,
+			texture, handle));
 	}
+
+	std::vector<ReloadedResource<Texture>> swapped;
+	for (auto stream = m_streams.begin(); stream != m_streams.end();)
+	{
+		if (stream->handle.IsPending())
+		{
+			++stream;
+			continue;
+		}
+
+		const std::shared_ptr<Texture> texture = stream->handle.Get();
+		ResourceHandle<Texture> previous;
+		bool isCurrent = false;
+		bool wasEvicted = false;
+		m_textures.Update(stream->name, [&stream, &texture, &previous, &isCurrent, &wasEvicted](ResourceHandle<Texture>& p_handle, const bool p_inserted)
+		{
+			wasEvicted = p_inserted;
+			isCurrent = !p_inserted && p_handle.Get() == stream->previous;
+			if (isCurrent && texture)
+			{
+				previous = p_handle;
+				p_handle = stream->handle;
+			}
+
+			return true;
+		});
+
+		if (wasEvicted)
+			m_textures.EraseIf(stream->name, [](const ResourceHandle<Texture>& p_handle) { return !p_handle.IsValid(); });
+
+		if (previous.IsValid())
+		{
+			m_residentBytes.fetch_sub(previous.ResidentBytes());
+			m_residency.OnLoaded(stream->name, true);
+			swapped.push_back({ stream->name, stream->previous, texture });
+		}
+		else
+		{
+			// The levels read aren't used, the job counted them
+			m_residentBytes.fetch_sub(stream->handle.ResidentBytes());
+			if (wasEvicted)
+			{
+				m_residency.Remove(stream->name);
+			}
+			else if (isCurrent)
+			{
+				std::cerr << "Warning: Couldn't stream the levels of " << stream->name << ", its current levels are kept.\n";
+				m_residency.OnLoaded(stream->name, false);
+			}
+			// Otherwise it was reloaded meanwhile, the residency starts again from the new version
+		}
+
+		stream = m_streams.erase(stream);
+	}
+
+	return swapped;
+}
+
+void OgEngine::Services::TextureService::SetStreamingBudget(const TextureStreamingBudget& p_budget)
+{
+	m_residency.budget = p_budget;
+
+	std::lock_guard<std::mutex> lock(m_streamedMutex);
+	m_streamingTailSize = p_budget.tailSize;
+}
+
+const OgEngine::TextureStreamingBudget& OgEngine::Services::TextureService::StreamingBudget() const
+{
+	return m_residency.budget;
+}
+
+void OgEngine::Services::TextureService::StreamLevels(const uint64_t p_sourceHash, const uint32_t p_maxSize,
+	const std::shared_ptr<Texture>& p_texture, const ResourceHandle<Texture>& p_handle)
+{
+	const bool loaded = TextureCache::Read(p_sourceHash, CookSettings(), *p_texture, p_maxSize);
+	if (loaded)
+	{
+		const uint64_t bytes = p_texture->CpuBytes();
+		p_handle.SetResidentBytes(bytes);
+		m_residentBytes.fetch_add(bytes);
+	}
+
+	p_handle.Complete(loaded);
+}
+
+void OgEngine::Services::TextureService::AddToResidency(const std::string& p_textureName, const Texture& p_texture)
+{
+	// Without a cooked file, the levels dropped couldn't be read again
+	const TextureSource& source = p_texture.Source();
+	if (source.hash == 0u || source.levelCount == 0u)
+		return;
+
+	std::vector<uint64_t> levelSizes;
+	levelSizes.reserve(source.levelCount);
+	uint32_t width = source.width;
+	uint32_t height = source.height;
+	for (uint32_t level = 0u; level < source.levelCount; ++level)
+	{
+		levelSizes.push_back(TextureCache::LevelSize(p_texture.Format(), width, height));
+		width = std::max(1u, width / 2u);
+		height = std::max(1u, height / 2u);
+	}
+
+	m_residency.Add(p_textureName, std::move(levelSizes), source.width, source.height, source.firstLevel);
+}
+
+uint32_t OgEngine::Services::TextureService::StreamedMaxSize(const std::string& p_textureName) const
+{
+	std::lock_guard<std::mutex> lock(m_streamedMutex);
+	return m_streamedNames.count(p_textureName) != 0u ? m_streamingTailSize : 0u;
+}
+
+void OgEngine::Services::TextureService::SetManifest(std::shared_ptr<const CookManifest> p_manifest)
+{
+	std::lock_guard<std::mutex> lock(m_manifestMutex);
+	m_manifest = std::move(p_manifest);
+}
+
+std::optional<uint64_t> OgEngine::Services::TextureService::TrustedHash(const std::string& p_filePath) const
+{
+	std::shared_ptr<const CookManifest> manifest;
+	{
+		std::lock_guard<std::mutex> lock(m_manifestMutex);
+		manifest = m_manifest;
+	}
+
+	if (const std::optional<uint64_t> hash = manifest ? manifest->TrustedHash(p_filePath) : std::nullopt)
+		return hash;
+
+	// A packed source is as good, the archive stores its hash
+	return Utils::VirtualFileSystem::Instance().PackedHash(p_filePath);
+}
+
+void OgEngine::Services::TextureService::SetBlockCompression(const bool p_compress)
+{
+	std::lock_guard<std::mutex> lock(m_cookSettingsMutex);
+	m_cookSettings.compress = p_compress;
+}
+
+bool OgEngine::Services::TextureService::BlockCompression() const
+{
+	return CookSettings().compress;
+}
+
+void OgEngine::Services::TextureService::SetMipFilter(const Utils::MIP_FILTER p_filter, const bool p_srgb)
+{
+	std::lock_guard<std::mutex> lock(m_cookSettingsMutex);
+	m_cookSettings.mips.filter = p_filter;
+	m_cookSettings.mips.srgb = p_srgb;
+}
+
+OgEngine::TextureCache::CookSettings OgEngine::Services::TextureService::CookSettings() const
+{
+	std::lock_guard<std::mutex> lock(m_cookSettingsMutex);
+	return m_cookSettings;
+}
+
+void OgEngine::Services::TextureService::ReleaseCpuData(std::string_view p_textureName)
+{
+	if (!m_budget.releaseCpuDataAfterUpload)
+		return;
+
+	const ResourceHandle<Texture> handle = GetHandle(p_textureName);
+	const std::shared_ptr<Texture> texture = handle.Get();
+	if (!texture || !texture->Pixels())
+		return;
+
+	texture->ReleaseCpuData();
+	m_residentBytes.fetch_sub(handle.ResidentBytes());
+	handle.SetResidentBytes(0u);
 }
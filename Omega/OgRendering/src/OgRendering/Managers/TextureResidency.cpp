@@ -0,0 +1,268 @@
+#include <OgRendering/Managers/TextureResidency.h>
+
+#include <algorithm>
+#include <queue>
+
+namespace
+{
+	/**
+	 * @brief Return the larger side of a level, each level halves the one before down to a single texel.
+	 */
+	uint32_t LevelSide(const uint32_t p_width, const uint32_t p_height, const uint32_t p_level)
+	{
+		return p_level >= 32u ? 1u : std::max(1u, std::max(p_width, p_height) >> p_level);
+	}
+}
+
+void OgEngine::TextureResidency::Add(const std::string& p_name, std::vector<uint64_t> p_levelSizes, const uint32_t p_width,
+	const uint32_t p_height, const uint32_t p_residentLevel)
+{
+	Remove(p_name);
+	if (p_levelSizes.empty())
+		return;
+
+	StreamedTexture texture;
+	texture.width = p_width;
+	texture.height = p_height;
+	texture.residentLevel = std::min(p_residentLevel, static_cast<uint32_t>(p_levelSizes.size() - 1u));
+
+	// One more for the end of the chain, so the size of the levels from any level is a single read
+	texture.bytesFrom.resize(p_levelSizes.size() + 1u, 0u);
+	for (size_t level = p_levelSizes.size(); level > 0u; --level)
+		texture.bytesFrom[level - 1u] = texture.bytesFrom[level] + p_levelSizes[level - 1u];
+
+	m_residentBytes += CountedBytes(texture);
+	m_textures.emplace(p_name, std::move(texture));
+}
+
+void OgEngine::TextureResidency::Remove(const std::string& p_name)
+{
+	const auto texture = m_textures.find(p_name);
+	if (texture == m_textures.end())
+		return;
+
+	// A request still in flight is answered for nothing, OnLoaded ignores the textures it doesn't know
+	if (texture->second.isLoading && texture->second.requestedLevel < texture->second.residentLevel)
+		--m_loadsInFlight;
+
+	m_residentBytes -= CountedBytes(texture->second);
+	m_textures.erase(texture);
+}
+
+bool OgEngine::TextureResidency::Contains(const std::string& p_name) const
+{
+	return m_textures.find(p_name) != m_textures.end();
+}
+
+void OgEngine::TextureResidency::ReportUsage(const std::string& p_name, const float p_screenSize)
+{
+	const auto texture = m_textures.find(p_name);
+	if (texture != m_textures.end())
+		texture->second.screenSize = std::max(texture->second.screenSize, p_screenSize);
+}
+
+std::vector<OgEngine::TextureStreamingRequest> OgEngine::TextureResidency::Update()
+{
+	using Entry = std::pair<const std::string, StreamedTexture>;
+
+	uint64_t targetBytes = 0u;
+	for (Entry& entry : m_textures)
+	{
+		StreamedTexture& texture = entry.second;
+
+		// A texture drawn now and then keeps its levels until it goes unused for a while
+		if (texture.screenSize > 0.0f)
+		{
+			texture.lastScreenSize = texture.screenSize;
+			texture.unusedUpdates = 0u;
+		}
+		else if (texture.unusedUpdates <= budget.unusedUpdatesBeforeDrop)
+		{
+			++texture.unusedUpdates;
+		}
+
+		texture.screenSize = 0.0f;
+		texture.targetLevel = texture.isFailed ? texture.residentLevel : DesiredLevel(texture);
+		targetBytes += texture.bytesFrom[texture.targetLevel];
+	}
+
+	// Over the budget, the largest level of all the textures is given up first, down to their tails
+	if (budget.maxResidentBytes != 0u && targetBytes > budget.maxResidentBytes)
+	{
+		const auto levelBytes = [](const Entry* p_entry)
+		{
+			const StreamedTexture& texture = p_entry->second;
+			return texture.bytesFrom[texture.targetLevel] - texture.bytesFrom[texture.targetLevel + 1u];
+		};
+
+		// Ordered by name as well, so the same usage always gives the same levels
+		const auto isSmaller = [&levelBytes](const Entry* p_left, const Entry* p_right)
+		{
+			const uint64_t left = levelBytes(p_left);
+			const uint64_t right = levelBytes(p_right);
+			return left != right ? left < right : p_left->first > p_right->first;
+		};
+
+		std::priority_queue<Entry*, std::vector<Entry*>, decltype(isSmaller)> largest(isSmaller);
+		for (Entry& entry : m_textures)
+		{
+			if (!entry.second.isFailed && entry.second.targetLevel < TailLevel(entry.second))
+				largest.push(&entry);
+		}
+
+		while (targetBytes > budget.maxResidentBytes && !largest.empty())
+		{
+			Entry* entry = largest.top();
+			largest.pop();
+
+			targetBytes -= levelBytes(entry);
+			if (++entry->second.targetLevel < TailLevel(entry->second))
+				largest.push(entry);
+		}
+	}
+
+	std::vector<TextureStreamingRequest> requests;
+	std::vector<Entry*> loads;
+	for (Entry& entry : m_textures)
+	{
+		StreamedTexture& texture = entry.second;
+		if (texture.isLoading || texture.targetLevel == texture.residentLevel)
+			continue;
+
+		if (texture.targetLevel < texture.residentLevel)
+		{
+			loads.push_back(&entry);
+			continue;
+		}
+
+		// Dropping levels frees memory, it is never delayed
+		texture.isLoading = true;
+		texture.requestedLevel = texture.targetLevel;
+		requests.push_back({ entry.first, texture.targetLevel });
+	}
+
+	// The textures missing their tail first, then the ones missing the most levels, then the largest on screen
+	std::sort(loads.begin(), loads.end(), [this](const Entry* p_left, const Entry* p_right)
+	{
+		const StreamedTexture& left = p_left->second;
+		const StreamedTexture& right = p_right->second;
+		const bool isLeftUnderTail = left.residentLevel > TailLevel(left);
+		const bool isRightUnderTail = right.residentLevel > TailLevel(right);
+		if (isLeftUnderTail != isRightUnderTail)
+			return isLeftUnderTail;
+
+		const uint32_t leftMissing = left.residentLevel - left.targetLevel;
+		const uint32_t rightMissing = right.residentLevel - right.targetLevel;
+		if (leftMissing != rightMissing)
+			return leftMissing > rightMissing;
+
+		if (left.lastScreenSize != right.lastScreenSize)
+			return left.lastScreenSize > right.lastScreenSize;
+
+		return p_left->first < p_right->first;
+	});
+
+	for (Entry* entry : loads)
+	{
+		if (m_loadsInFlight >= budget.maxLoadsInFlight)
+			break;
+
+		// The levels being dropped are still counted, a load may wait for them to be gone
+		// The tails are read whatever the budget, the way the budget keeps them
+		StreamedTexture& texture = entry->second;
+		const uint64_t addedBytes = texture.bytesFrom[texture.targetLevel] - texture.bytesFrom[texture.residentLevel];
+		if (budget.maxResidentBytes != 0u && texture.targetLevel < TailLevel(texture) && m_residentBytes + addedBytes > budget.maxResidentBytes)
+			continue;
+
+		texture.isLoading = true;
+		texture.requestedLevel = texture.targetLevel;
+		m_residentBytes += addedBytes;
+		++m_loadsInFlight;
+		requests.push_back({ entry->first, texture.targetLevel });
+	}
+
+	return requests;
+}
+
+void OgEngine::TextureResidency::OnLoaded(const std::string& p_name, const bool p_success)
+{
+	const auto found = m_textures.find(p_name);
+	if (found == m_textures.end() || !found->second.isLoading)
+		return;
+
+	StreamedTexture& texture = found->second;
+	if (texture.requestedLevel < texture.residentLevel)
+		--m_loadsInFlight;
+
+	m_residentBytes -= CountedBytes(texture);
+	texture.isLoading = false;
+	if (p_success)
+		texture.residentLevel = texture.requestedLevel;
+	else
+		texture.isFailed = true;
+
+	m_residentBytes += CountedBytes(texture);
+}
+
+uint32_t OgEngine::TextureResidency::ResidentLevel(const std::string& p_name) const
+{
+	const auto texture = m_textures.find(p_name);
+	return texture != m_textures.end() ? texture->second.residentLevel : 0u;
+}
+
+uint32_t OgEngine::TextureResidency::DesiredLevel(const std::string& p_name) const
+{
+	const auto texture = m_textures.find(p_name);
+	return texture != m_textures.end() ? DesiredLevel(texture->second) : 0u;
+}
+
+uint64_t OgEngine::TextureResidency::ResidentBytes() const
+{
+	return m_residentBytes;
+}
+
+uint32_t OgEngine::TextureResidency::LoadsInFlight() const
+{
+	return m_loadsInFlight;
+}
+
+uint32_t OgEngine::TextureResidency::TailLevel(const uint32_t p_width, const uint32_t p_height, const uint32_t p_levelCount,
+	const uint32_t p_tailSize)
+{
+	uint32_t level = 0u;
+	while (level + 1u < p_levelCount && LevelSide(p_width, p_height, level) > p_tailSize)
+		++level;
+
+	return level;
+}
+
+uint32_t OgEngine::TextureResidency::LevelForScreenSize(const uint32_t p_width, const uint32_t p_height, const uint32_t p_levelCount,
+	const float p_screenSize)
+{
+	uint32_t level = 0u;
+	while (level + 1u < p_levelCount && static_cast<float>(LevelSide(p_width, p_height, level + 1u)) >= p_screenSize)
+		++level;
+
+	return level;
+}
+
+uint32_t OgEngine::TextureResidency::TailLevel(const StreamedTexture& p_texture) const
+{
+	return TailLevel(p_texture.width, p_texture.height, static_cast<uint32_t>(p_texture.bytesFrom.size() - 1u), budget.tailSize);
+}
+
+uint32_t OgEngine::TextureResidency::DesiredLevel(const StreamedTexture& p_texture) const
+{
+	const uint32_t tail = TailLevel(p_texture);
+	if (p_texture.lastScreenSize <= 0.0f || p_texture.unusedUpdates > budget.unusedUpdatesBeforeDrop)
+		return tail;
+
+	const auto levelCount = static_cast<uint32_t>(p_texture.bytesFrom.size() - 1u);
+	return std::min(tail, LevelForScreenSize(p_texture.width, p_texture.height, levelCount, p_texture.lastScreenSize));
+}
+
+uint64_t OgEngine::TextureResidency::CountedBytes(const StreamedTexture& p_texture)
+{
+	const uint32_t level = p_texture.isLoading ? std::min(p_texture.residentLevel, p_texture.requestedLevel) : p_texture.residentLevel;
+	return p_texture.bytesFrom[level];
+}
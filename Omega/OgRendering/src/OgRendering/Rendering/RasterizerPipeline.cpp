@@ -4,6 +4,7 @@
 #include <OgRendering/Managers/ResourceManager.h>
 #include <OgRendering/Rendering/VulkanContext.h>
 #include <OgRendering/Utils/Debugger.h>
+#include <OgRendering/Utils/MeshletBuilder.h>
 #include <OgRendering/UI/imgui/imgui_impl_glfw.h>
 #include <OgRendering/UI/imgui/imgui_impl_vulkan.h>
 
@@ -101,8 +102,12 @@ void OgEngine::RasterizerPipeline::Update(
 		{
 			if (m_meshesBuffers.find(p_mesh) == m_meshesBuffers.end())
 			{
+				const bool packed = UsesPackedVertices(p_mesh);
+				if (packed)
+					m_packedMeshes.insert(p_mesh);
+
 				m_meshesBuffers.try_emplace(p_mesh);
-				CreateVertexBuffer(p_mesh, &m_meshesBuffers[p_mesh].first);
+				CreateVertexBuffer(p_mesh, &m_meshesBuffers[p_mesh].first, packed);
 				CreateIndexBuffer(p_mesh, &m_meshesBuffers[p_mesh].second);
 			}
 		}
@@ -155,8 +160,12 @@ void OgEngine::RasterizerPipeline::Update(
 		{
 			if (m_meshesBuffers.find(p_mesh) == m_meshesBuffers.end())
 			{
+				const bool packed = UsesPackedVertices(p_mesh);
+				if (packed)
+					m_packedMeshes.insert(p_mesh);
+
 				m_meshesBuffers.try_emplace(p_mesh);
-				CreateVertexBuffer(p_mesh, &m_meshesBuffers[p_mesh].first);
+				CreateVertexBuffer(p_mesh, &m_meshesBuffers[p_mesh].first, packed);
 				CreateIndexBuffer(p_mesh, &m_meshesBuffers[p_mesh].second);
 			}
 		}
@@ -205,6 +214,8 @@ void OgEngine::RasterizerPipeline::RenderFrame()
 			vkCmdSetScissor(m_commandBuffers[i], 0, 1, &scissor);
 
 			size_t objectIndex = 0u;
+			VkPipeline boundPipeline = m_graphicsPipeline;
+			std::vector<std::pair<uint32_t, uint32_t>> visibleRanges;
 
 			for (const auto& m_buffer : m_buffers)
 			{
@@ -213,6 +224,19 @@ void OgEngine::RasterizerPipeline::RenderFrame()
 					continue; // Skip to the next model because this model has a nullptr mesh, might crash.
 				}
 
+				// Both pipelines share their layout, the descriptor sets stay bound when switching
+				const VkPipeline pipeline = m_packedMeshes.count(m_buffer.second.model.Mesh()) != 0u ? m_packedGraphicsPipeline : m_graphicsPipeline;
+				if (pipeline == VK_NULL_HANDLE)
+				{
+					continue; // The packed pipeline couldn't be created again with the swap chain
+				}
+
+				if (pipeline != boundPipeline)
+				{
+					vkCmdBindPipeline(m_commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+					boundPipeline = pipeline;
+				}
+
 				vkCmdBindDescriptorSets(
 					m_commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS,
 					m_pipelineLayout, 0,
@@ -234,13 +258,50 @@ void OgEngine::RasterizerPipeline::RenderFrame()
 					0,
 					VK_INDEX_TYPE_UINT32);
 
-				vkCmdDrawIndexed(
-					m_commandBuffers[i],
-					static_cast<uint32_t>(m_buffer.second.model.Mesh()->Indices().size()),
-					1,
-					0,
-					0,
-					0);
+				Mesh* mesh = m_buffer.second.model.Mesh();
+				visibleRanges.clear();
+
+				// The shader reads the model matrix transposed
+				const glm::mat4 modelView = m_camera.matrices.view * glm::transpose(m_buffer.second.model.ModelMatrix());
+				const glm::vec4 eye = glm::inverse(modelView)[3];
+
+				// The coarsest level whose error stays under a pixel, measured from the closest point of the mesh
+				size_t level = 0u;
+				const BoundingSphere& sphere = mesh->LocalSphere();
+				if (!mesh->Lods().empty() && !sphere.Empty())
+				{
+					const float distance = glm::length(glm::vec3(eye) - glm::vec3(sphere.center.x, sphere.center.y, sphere.center.z)) - sphere.radius;
+					if (distance > 0.0f)
+					{
+						const float pixelsPerUnit = m_camera.matrices.perspective[1][1] * static_cast<float>(m_height) * 0.5f / distance;
+						level = mesh->SelectLod(LOD_PIXEL_ERROR_RS / pixelsPerUnit);
+					}
+				}
+
+				// The cones are built around the counter-clockwise normals, the rasterizer only keeps those triangles
+				// when the camera mirrors them, any other transform is drawn whole
+				if (level == 0u && !mesh->Meshlets().Empty() && glm::determinant(glm::mat3(modelView)) < 0.0f)
+					Utils::MeshletBuilder::VisibleRanges(mesh->Meshlets(), GPM::Vector3F(eye.x, eye.y, eye.z), visibleRanges);
+				else
+				{
+					// The levels follow the mesh in its index buffer
+					auto firstIndex = static_cast<uint32_t>(mesh->Indices().size());
+					for (size_t previous = 1u; previous < level; ++previous)
+						firstIndex += static_cast<uint32_t>(mesh->LodIndices(previous).size());
+
+					visibleRanges.emplace_back(level == 0u ? 0u : firstIndex, static_cast<uint32_t>(mesh->LodIndices(level).size()));
+				}
+
+				for (const auto& [firstIndex, indexCount] : visibleRanges)
+				{
+					vkCmdDrawIndexed(
+						m_commandBuffers[i],
+						indexCount,
+						1,
+						firstIndex,
+						0,
+						0);
+				}
 
 				++objectIndex;
 			}
@@ -390,13 +451,14 @@ VkExtent2D OgEngine::RasterizerPipeline::ChooseSwapExtent(const VkSurfaceCapabil
 }
 
 VkImageView OgEngine::RasterizerPipeline::CreateImageView(VkImage            p_image, VkFormat       p_format,
-	VkImageAspectFlags p_aspectFlags, uint32_t p_mipLevels) const
+	VkImageAspectFlags p_aspectFlags, uint32_t p_mipLevels, const VkComponentMapping& p_components) const
 {
 	VkImageViewCreateInfo viewInfo = {};
 	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 	viewInfo.image = p_image;
 	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
 	viewInfo.format = p_format;
+	viewInfo.components = p_components;
 	viewInfo.subresourceRange.aspectMask = p_aspectFlags;
 	viewInfo.subresourceRange.baseMipLevel = 0;
 	viewInfo.subresourceRange.levelCount = p_mipLevels;
@@ -609,6 +671,36 @@ void OgEngine::RasterizerPipeline::CopyBufferToImage(const VkBuffer p_buffer, co
 	EndSingleTimeCommands(commandBuffer);
 }
 
+void OgEngine::RasterizerPipeline::CopyBufferToImage(const VkBuffer p_buffer, const VkImage p_image,
+	const std::vector<MipLevel>& p_levels) const
+{
+	VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+
+	std::vector<VkBufferImageCopy> regions(p_levels.size());
+	for (size_t level = 0; level < p_levels.size(); ++level)
+	{
+		VkBufferImageCopy& region = regions[level];
+		region.bufferOffset = p_levels[level].offset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = static_cast<uint32_t>(level);
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = {
+			p_levels[level].width,
+			p_levels[level].height,
+			1
+		};
+	}
+
+	vkCmdCopyBufferToImage(commandBuffer, p_buffer, p_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		static_cast<uint32_t>(regions.size()), regions.data());
+
+	EndSingleTimeCommands(commandBuffer);
+}
+
 void OgEngine::RasterizerPipeline::CreateBuffer(const VkDeviceSize    p_size, const VkBufferUsageFlags p_usage,
 	VkMemoryPropertyFlags p_properties, VkBuffer& p_buffer,
 	VkDeviceMemory& p_bufferMemory, const size_t p_dynamicOffset) const
@@ -882,6 +974,79 @@ void OgEngine::RasterizerPipeline::DestroyObject(const std::uint64_t p_objectID)
 
 }
 
+void OgEngine::RasterizerPipeline::DestroyMeshBuffers(Mesh* p_mesh)
+{
+	const auto buffers = m_meshesBuffers.find(p_mesh);
+	if (buffers == m_meshesBuffers.end())
+		return;
+
+	// The frames in flight may still read the buffers
+	vkDeviceWaitIdle(m_vulkanDevice.logicalDevice);
+	buffers->second.first.Destroy();
+	buffers->second.second.Destroy();
+	m_meshesBuffers.erase(buffers);
+	m_packedMeshes.erase(p_mesh);
+}
+
+void OgEngine::RasterizerPipeline::ReplaceTexture(Texture* p_previous, Texture* p_texture)
+{
+	if (!p_texture)
+		return;
+
+	if (m_textures.find(p_texture) == m_textures.end())
+		CreateTexture(p_texture, TEXTURE_TYPE::TEXTURE);
+
+	const auto previous = m_textures.find(p_previous);
+	if (previous == m_textures.end() || p_previous == p_texture)
+		return;
+
+	// The frames in flight may still sample the previous image
+	vkDeviceWaitIdle(m_vulkanDevice.logicalDevice);
+	for (auto& [objectID, object] : m_buffers)
+	{
+		if (object.model.Texture() != p_previous)
+			continue;
+
+		object.model.SetTexture(p_texture);
+		BindDescriptorSet(object);
+	}
+
+	vkDestroySampler(m_vulkanDevice.logicalDevice, previous->second.sampler, nullptr);
+	vkDestroyImageView(m_vulkanDevice.logicalDevice, previous->second.view, nullptr);
+	vkDestroyImage(m_vulkanDevice.logicalDevice, previous->second.img, nullptr);
+	vkFreeMemory(m_vulkanDevice.logicalDevice, previous->second.memory, nullptr);
+	m_textures.erase(previous);
+}
+
+void OgEngine::RasterizerPipeline::DestroyTexture(Texture* p_texture)
+{
+	const auto texture = m_textures.find(p_texture);
+	if (texture == m_textures.end())
+		return;
+
+	// The frames in flight may still sample the image
+	vkDeviceWaitIdle(m_vulkanDevice.logicalDevice);
+	vkDestroySampler(m_vulkanDevice.logicalDevice, texture->second.sampler, nullptr);
+	vkDestroyImageView(m_vulkanDevice.logicalDevice, texture->second.view, nullptr);
+	vkDestroyImage(m_vulkanDevice.logicalDevice, texture->second.img, nullptr);
+	vkFreeMemory(m_vulkanDevice.logicalDevice, texture->second.memory, nullptr);
+	m_textures.erase(texture);
+}
+
+void OgEngine::RasterizerPipeline::ReloadShaders()
+{
+	vkDeviceWaitIdle(m_vulkanDevice.logicalDevice);
+
+	vkDestroyPipeline(m_vulkanDevice.logicalDevice, m_graphicsPipeline, nullptr);
+	if (m_packedGraphicsPipeline != VK_NULL_HANDLE)
+		vkDestroyPipeline(m_vulkanDevice.logicalDevice, m_packedGraphicsPipeline, nullptr);
+	vkDestroyPipelineLayout(m_vulkanDevice.logicalDevice, m_pipelineLayout, nullptr);
+	vkDestroyPipelineCache(m_vulkanDevice.logicalDevice, m_pipelineCache, nullptr);
+
+	// The command buffers are recorded every frame, the next one binds the new pipelines
+	CreateGraphicsPipeline();
+}
+
 void OgEngine::RasterizerPipeline::GenerateMipmaps(VkImage p_image, VkFormat     p_imageFormat, int32_t p_texWidth,
 	int32_t p_texHeight, uint32_t p_mipLevels) const
 {
@@ -1535,6 +1700,32 @@ void OgEngine::RasterizerPipeline::CreateGraphicsPipeline()
 		throw std::runtime_error("failed to create graphics pipeline!");
 	}
 
+	// The packed pipeline only differs by its vertex input and the shader decoding it
+	m_packedGraphicsPipeline = VK_NULL_HANDLE;
+	VkShaderModule packedVertShaderModule = ShaderLoader::LoadShader("Resources/shaders/bin/rast_vert_packed.spv",
+		m_vulkanDevice.logicalDevice);
+	if (packedVertShaderModule != VK_NULL_HANDLE)
+	{
+		shaderStages[0].module = packedVertShaderModule;
+
+		auto packedBindingDescription = PackedVertex::getBindingDescription();
+		auto packedAttributeDescriptions = PackedVertex::getAttributeDescriptions();
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(packedAttributeDescriptions.size());
+		vertexInputInfo.pVertexBindingDescriptions = &packedBindingDescription;
+		vertexInputInfo.pVertexAttributeDescriptions = packedAttributeDescriptions.data();
+
+		if (vkCreateGraphicsPipelines(m_vulkanDevice.logicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+			&m_packedGraphicsPipeline) != VK_SUCCESS)
+		{
+			m_packedGraphicsPipeline = VK_NULL_HANDLE;
+		}
+
+		vkDestroyShaderModule(m_vulkanDevice.logicalDevice, packedVertShaderModule, nullptr);
+	}
+
+	if (m_packedGraphicsPipeline == VK_NULL_HANDLE)
+		std::cerr << "Warning: Couldn't create the packed vertices pipeline, the meshes are drawn with their full vertices.\n";
+
 	vkDestroyShaderModule(m_vulkanDevice.logicalDevice, fragShaderModule, nullptr);
 	vkDestroyShaderModule(m_vulkanDevice.logicalDevice, vertShaderModule, nullptr);
 
@@ -1667,8 +1858,10 @@ ImTextureID OgEngine::RasterizerPipeline::AddUITexture(const char* p_texturePath
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 		&stagingBuffer, bufferSize);
 
+	// The UI reads RGBA8 whatever the format of the texture
+	const std::vector<uint8_t> pixels = uiTexture->Rgba8Pixels();
 	stagingBuffer.Map();
-	memcpy_s(stagingBuffer.mapped, bufferSize, uiTexture->Pixels(), bufferSize);
+	memcpy_s(stagingBuffer.mapped, bufferSize, pixels.data(), std::min<size_t>(static_cast<size_t>(bufferSize), pixels.size()));
 	stagingBuffer.Unmap();
 
 	VkImageCreateInfo info = Initializers::imageCreateInfo();
@@ -1765,34 +1958,59 @@ void OgEngine::RasterizerPipeline::CreateTextureImage(TextureData& p_textureData
 	const auto* texture = p_loadedTexture;
 	if (texture != nullptr)
 	{
+		VkFormat format = texture->VulkanFormat(false);
+		const uint8_t* pixels = texture->Pixels();
+		VkDeviceSize imageSize = texture->ImageSize();
+		std::vector<MipLevel> levels = texture->Levels();
+		p_textureData.components = texture->VulkanSwizzle();
+
+		// A format the GPU can't sample, the 3 channels ones on most GPUs, is expanded to 4 channels of the same depth
+		std::vector<uint8_t> rgbaPixels;
+		if (!Texture::FormatInfo(texture->Format()).IsCompressed() && !CanSampleFormat(m_vulkanDevice.gpu, format, levels.size() < texture->MipmapLevels()))
+		{
+			rgbaPixels = texture->RgbaPixels(levels);
+			pixels = rgbaPixels.data();
+			imageSize = rgbaPixels.size();
+			format = Texture::VulkanFormat(Texture::RgbaFormat(texture->Format()), false);
+			p_textureData.components = {};
+		}
+
 		p_textureData.mipLevels = texture->MipmapLevels();
+		p_textureData.format = format;
 		VkBuffer       stagingBuffer;
 		VkDeviceMemory stagingBufferMemory;
-		CreateBuffer(texture->ImageSize(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		CreateBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
 			stagingBufferMemory);
 
 		void* data;
-		vkMapMemory(m_vulkanDevice.logicalDevice, stagingBufferMemory, 0, texture->ImageSize(), 0, &data);
-		memcpy_s(data, static_cast<size_t>(texture->ImageSize()), texture->Pixels(),
-			static_cast<size_t>(texture->ImageSize()));
+		vkMapMemory(m_vulkanDevice.logicalDevice, stagingBufferMemory, 0, imageSize, 0, &data);
+		memcpy_s(data, static_cast<size_t>(imageSize), pixels, static_cast<size_t>(imageSize));
 		vkUnmapMemory(m_vulkanDevice.logicalDevice, stagingBufferMemory);
 
-		CreateImage(texture->Width(), texture->Height(), texture->MipmapLevels(), VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM,
+		CreateImage(texture->Width(), texture->Height(), texture->MipmapLevels(), VK_SAMPLE_COUNT_1_BIT, format,
 			VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, p_textureData.img, p_textureData.memory);
 
-		TransitionImageLayout(p_textureData.img, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
+		TransitionImageLayout(p_textureData.img, format, VK_IMAGE_LAYOUT_UNDEFINED,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture->MipmapLevels());
-		CopyBufferToImage(stagingBuffer, p_textureData.img, static_cast<uint32_t>(texture->Width()),
-			static_cast<uint32_t>(texture->Height()));
-		//transitioned to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL while generating mipmaps
+		CopyBufferToImage(stagingBuffer, p_textureData.img, levels);
 
 		vkDestroyBuffer(m_vulkanDevice.logicalDevice, stagingBuffer, nullptr);
 		vkFreeMemory(m_vulkanDevice.logicalDevice, stagingBufferMemory, nullptr);
 
-		GenerateMipmaps(m_textureImage, VK_FORMAT_R8G8B8A8_UNORM, texture->Width(), texture->Height(), texture->MipmapLevels());
+		// A cooked texture brings its whole mip chain, the other ones only their first level
+		if (levels.size() < texture->MipmapLevels())
+		{
+			//transitioned to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL while generating mipmaps
+			GenerateMipmaps(p_textureData.img, format, texture->Width(), texture->Height(), texture->MipmapLevels());
+		}
+		else
+		{
+			TransitionImageLayout(p_textureData.img, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture->MipmapLevels());
+		}
 	}
 }
 
@@ -1821,8 +2039,8 @@ VkDescriptorImageInfo OgEngine::RasterizerPipeline::Create2DDescriptor(const VkI
 
 void OgEngine::RasterizerPipeline::CreateTextureImageView(TextureData& p_textureData) const
 {
-	p_textureData.view = CreateImageView(p_textureData.img, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT,
-		p_textureData.mipLevels);
+	p_textureData.view = CreateImageView(p_textureData.img, p_textureData.format, VK_IMAGE_ASPECT_COLOR_BIT,
+		p_textureData.mipLevels, p_textureData.components);
 }
 
 void OgEngine::RasterizerPipeline::CreateTextureSampler(TextureData& p_textureData)
@@ -1851,14 +2069,28 @@ void OgEngine::RasterizerPipeline::CreateTextureSampler(TextureData& p_textureDa
 	}
 }
 
-void OgEngine::RasterizerPipeline::CreateVertexBuffer(Mesh* p_mesh, Buffer* p_bufferArray) const
+bool OgEngine::RasterizerPipeline::UsesPackedVertices(const Mesh* p_mesh) const
+{
+	return m_packedGraphicsPipeline != VK_NULL_HANDLE && p_mesh != nullptr && p_mesh->VertexLayout() == VERTEX_LAYOUT::PACKED
+		&& !p_mesh->PackedVertices().empty();
+}
+
+void OgEngine::RasterizerPipeline::CreateVertexBuffer(Mesh* p_mesh, Buffer* p_bufferArray, const bool p_packed) const
 {
 	if (p_bufferArray == nullptr)
 	{
 		return;
 	}
 
-	if (p_mesh != nullptr && !p_mesh->Vertices().empty())
+	if (p_packed)
+	{
+		const VkDeviceSize verticesBufferSize = sizeof(PackedVertex) * p_mesh->PackedVertices().size();
+
+		CreateBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			p_bufferArray, verticesBufferSize, (void*)(p_mesh->PackedVertices().data()));
+	}
+	else if (p_mesh != nullptr && !p_mesh->Vertices().empty())
 	{
 		const VkDeviceSize verticesBufferSize = sizeof(p_mesh->Vertices()[0]) * p_mesh->Vertices().size();
 
@@ -1875,7 +2107,18 @@ void OgEngine::RasterizerPipeline::CreateIndexBuffer(Mesh* p_mesh, Buffer* p_buf
 		return;
 	}
 
-	if (p_mesh != nullptr && !p_mesh->Indices().empty())
+	if (p_mesh != nullptr && !p_mesh->Indices().empty() && !p_mesh->Lods().empty())
+	{
+		// The indices of the simplified levels follow those of the mesh, every level is drawn from the same buffer
+		std::vector<uint32_t> indices(p_mesh->Indices());
+		for (const MeshLod& lod : p_mesh->Lods())
+			indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+
+		CreateBuffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			p_bufferArray, sizeof(uint32_t) * indices.size(), (void*)(indices.data()));
+	}
+	else if (p_mesh != nullptr && !p_mesh->Indices().empty())
 	{
 		const VkDeviceSize indicesBufferSize = sizeof(p_mesh->Indices()[0]) * p_mesh->Indices().size();
 
@@ -2128,6 +2371,8 @@ void OgEngine::RasterizerPipeline::CleanupSwapChain()
 		m_commandBuffers.data());
 
 	vkDestroyPipeline(m_vulkanDevice.logicalDevice, m_graphicsPipeline, nullptr);
+	if (m_packedGraphicsPipeline != VK_NULL_HANDLE)
+		vkDestroyPipeline(m_vulkanDevice.logicalDevice, m_packedGraphicsPipeline, nullptr);
 	vkDestroyPipelineLayout(m_vulkanDevice.logicalDevice, m_pipelineLayout, nullptr);
 	vkDestroyRenderPass(m_vulkanDevice.logicalDevice, m_renderPass, nullptr);
 
@@ -691,6 +691,7 @@ VkDescriptorImageInfo OgEngine::RaytracingPipeline::CreateTextureDescriptor(cons
     VkImageViewCreateInfo viewInfo = Initializers::imageViewCreateInfo();
     viewInfo.image = p_image.img;
     viewInfo.format = p_format;
+    viewInfo.components = p_image.components;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, ~0u, 0, 1 };
 
@@ -1691,7 +1692,8 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
     int width = 0;
     int height = 0;
     int channels = 0;
-    stbi_uc* pixels = nullptr;
+    // The UI reads RGBA8 whatever the format of the texture
+    std::vector<uint8_t> pixels;
 
     std::string_view p_filePath = p_texture;
     const std::string_view fileName{ p_filePath.data() + (p_filePath.find_last_of('/') + 1) };
@@ -1700,13 +1702,13 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
     {
         width = ResourceManager::Get<Texture>("error.png")->Width();
         height = ResourceManager::Get<Texture>("error.png")->Height();
-        pixels = ResourceManager::Get<Texture>("error.png")->Pixels();
+        pixels = ResourceManager::Get<Texture>("error.png")->Rgba8Pixels();
     }
     else
     {
         width = ResourceManager::Get<Texture>(fileName)->Width();
         height = ResourceManager::Get<Texture>(fileName)->Height();
-        pixels = ResourceManager::Get<Texture>(fileName)->Pixels();
+        pixels = ResourceManager::Get<Texture>(fileName)->Rgba8Pixels();
     }
 
     
@@ -1724,7 +1726,7 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
         &stagingBuffer, bufferSize);
 
     stagingBuffer.Map();
-    memcpy(stagingBuffer.mapped, pixels, bufferSize);
+    memcpy(stagingBuffer.mapped, pixels.data(), std::min<size_t>(static_cast<size_t>(bufferSize), pixels.size()));
     stagingBuffer.Unmap();
 
     //stbi_image_free(ResourceManager::Get<Texture>(p_texture)->Pixels());
@@ -1738,7 +1740,7 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
     info.extent = { extent.width, extent.height, 1 };
     info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     info.samples = VK_SAMPLE_COUNT_1_BIT;
-    TextureData data;
+    TextureData data{};
     vkCreateImage(m_vulkanDevice.logicalDevice, &info, nullptr, &data.img);
 
     VkCommandBuffer cmdBuffer = CreateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -1772,18 +1774,38 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
-    VkBufferImageCopy copyRegion{};
-    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copyRegion.imageSubresource.layerCount = 1;
+    // The UI images are a single RGBA8 level, the GPU generates the other ones
+    const std::vector<MipLevel> levels{ MipLevel{ 0u, bufferSize, extent.width, extent.height } };
+    std::vector<VkBufferImageCopy> copyRegions(levels.size());
+    for (size_t level = 0; level < levels.size(); ++level)
+    {
+        VkBufferImageCopy& copyRegion = copyRegions[level];
+        copyRegion.bufferOffset = levels[level].offset;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = static_cast<uint32_t>(level);
+        copyRegion.imageSubresource.layerCount = 1;
 
-    VkExtent3D extend3D;
-    extend3D.width = width;
-    extend3D.height = height;
-    extend3D.depth = 1;
-    copyRegion.imageExtent = extend3D;
+        VkExtent3D extend3D;
+        extend3D.width = levels[level].width;
+        extend3D.height = levels[level].height;
+        extend3D.depth = 1;
+        copyRegion.imageExtent = extend3D;
+    }
 
     vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer.buffer, data.img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1, &copyRegion);
+        static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+    // A cooked texture brings its whole mip chain, the other ones only their first level
+    const bool generateMipmaps = levels.size() < mipLevels;
+    if (!generateMipmaps)
+    {
+        SetImageLayout(cmdBuffer, data.img,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            range,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
 
     range.levelCount = 1;
 
@@ -1803,42 +1825,90 @@ ImTextureID OgEngine::RaytracingPipeline::AddUITexture(const char* p_texture)
 
 void OgEngine::RaytracingPipeline::AddTexture(const std::string& p_texture, const TEXTURE_TYPE p_type)
 {
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    stbi_uc* pixels = nullptr;
-
     const std::string_view p_filePath = p_texture;
     const std::string_view fileName{ p_filePath.data() + (p_filePath.find_last_of('/') + 1) };
 
-    if (ResourceManager::Get<Texture>(fileName) == nullptr)
+    const Texture* texture = ResourceManager::Get<Texture>(fileName);
+    if (texture == nullptr)
     {
-            pixels = ResourceManager::Get<Texture>("error.png")->Pixels();
-            width = ResourceManager::Get<Texture>("error.png")->Width();
-            height = ResourceManager::Get<Texture>("error.png")->Height();
+        texture = ResourceManager::Get<Texture>("error.png");
     }
-    else
+
+    const TextureData data = UploadTexture(texture, p_type);
+    if (p_type == 0)
     {
-        width = ResourceManager::Get<Texture>(fileName)->Width();
-        height = ResourceManager::Get<Texture>(fileName)->Height();
-        pixels = ResourceManager::Get<Texture>(fileName)->Pixels();
+        m_textures.push_back(data);
+        m_textureCtr.emplace_back(p_texture);
     }
+    else if (p_type == 1)
+    {
+        m_normalMaps.push_back(data);
+        m_normalMapsCtr.emplace_back(p_texture);
+    }
+    UpdateDescriptorSets();
+}
 
+void OgEngine::RaytracingPipeline::ReplaceTexture(const std::string& p_texture)
+{
+    const Texture* texture = ResourceManager::Get<Texture>(p_texture);
+    const bool isTexture = std::find(m_textureCtr.begin(), m_textureCtr.end(), p_texture) != m_textureCtr.end();
+    const bool isNormalMap = std::find(m_normalMapsCtr.begin(), m_normalMapsCtr.end(), p_texture) != m_normalMapsCtr.end();
+    if (texture == nullptr || (!isTexture && !isNormalMap))
+        return;
 
-    VkDeviceSize bufferSize = width * height * sizeof(glm::u8vec4);
+    // The frames in flight may still sample the previous images, the entities keep the index of the texture
+    vkDeviceWaitIdle(m_vulkanDevice.logicalDevice);
+    const auto replace = [this, texture, &p_texture](std::vector<TextureData>& p_textures, const std::vector<std::string>& p_names, const TEXTURE_TYPE p_type)
+    {
+        for (size_t i = 0; i < p_names.size(); ++i)
+        {
+            if (p_names[i] != p_texture)
+                continue;
+
+            vkDestroySampler(m_vulkanDevice.logicalDevice, p_textures[i].sampler, nullptr);
+            vkDestroyImageView(m_vulkanDevice.logicalDevice, p_textures[i].view, nullptr);
+            vkDestroyImage(m_vulkanDevice.logicalDevice, p_textures[i].img, nullptr);
+            vkFreeMemory(m_vulkanDevice.logicalDevice, p_textures[i].memory, nullptr);
+            p_textures[i] = UploadTexture(texture, p_type);
+        }
+    };
+
+    replace(m_textures, m_textureCtr, TEXTURE_TYPE::TEXTURE);
+    replace(m_normalMaps, m_normalMapsCtr, TEXTURE_TYPE::NORMAL);
+    UpdateDescriptorSets();
+}
+
+TextureData OgEngine::RaytracingPipeline::UploadTexture(const Texture* p_texture, const TEXTURE_TYPE p_type)
+{
+    const int width = p_texture->Width();
+    const int height = p_texture->Height();
+    const uint8_t* pixels = p_texture->Pixels();
+
+    // Every level the texture brings, block compressed or not
+    VkDeviceSize bufferSize = p_texture->ImageSize();
     VkExtent2D extent;
     extent.width = width;
     extent.height = height;
     auto imgSize = extent;
 
-    VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
-    if (p_type == 1)
+    // The normal maps are stored linearly
+    VkFormat format = p_texture->VulkanFormat(p_type != 1);
+    VkComponentMapping components = p_texture->VulkanSwizzle();
+
+    const uint32_t mipLevels = p_texture->MipmapLevels();
+    std::vector<MipLevel> levels = p_texture->Levels();
+
+    // A format the GPU can't sample, the 3 channels ones on most GPUs, is expanded to 4 channels of the same depth
+    std::vector<uint8_t> rgbaPixels;
+    if (!Texture::FormatInfo(p_texture->Format()).IsCompressed() && !CanSampleFormat(m_vulkanDevice.gpu, format, levels.size() < mipLevels))
     {
-        format = VK_FORMAT_R8G8B8A8_UNORM;
+        rgbaPixels = p_texture->RgbaPixels(levels);
+        pixels = rgbaPixels.data();
+        bufferSize = rgbaPixels.size();
+        format = Texture::VulkanFormat(Texture::RgbaFormat(p_texture->Format()), p_type != 1);
+        components = {};
     }
 
-    auto mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
-
     Buffer stagingBuffer;
     CreateBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -1861,7 +1931,7 @@ void OgEngine::RaytracingPipeline::AddTexture(const std::string& p_texture, cons
     info.samples = VK_SAMPLE_COUNT_1_BIT;
     info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    TextureData data;
+    TextureData data{};
     vkCreateImage(m_vulkanDevice.logicalDevice, &info, nullptr, &data.img);
 
     VkCommandBuffer cmdBuffer = CreateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -1895,18 +1965,36 @@ void OgEngine::RaytracingPipeline::AddTexture(const std::string& p_texture, cons
         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
-    VkBufferImageCopy copyRegion{};
-    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copyRegion.imageSubresource.layerCount = 1;
+    std::vector<VkBufferImageCopy> copyRegions(levels.size());
+    for (size_t level = 0; level < levels.size(); ++level)
+    {
+        VkBufferImageCopy& copyRegion = copyRegions[level];
+        copyRegion.bufferOffset = levels[level].offset;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = static_cast<uint32_t>(level);
+        copyRegion.imageSubresource.layerCount = 1;
 
-    VkExtent3D extend3D;
-    extend3D.width = width;
-    extend3D.height = height;
-    extend3D.depth = 1;
-    copyRegion.imageExtent = extend3D;
+        VkExtent3D extend3D;
+        extend3D.width = levels[level].width;
+        extend3D.height = levels[level].height;
+        extend3D.depth = 1;
+        copyRegion.imageExtent = extend3D;
+    }
 
     vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer.buffer, data.img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1, &copyRegion);
+        static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+    // A cooked texture brings its whole mip chain, the other ones only their first level
+    const bool generateMipmaps = levels.size() < mipLevels;
+    if (!generateMipmaps)
+    {
+        SetImageLayout(cmdBuffer, data.img,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            range,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
 
     range.levelCount = 1;
 
@@ -1916,23 +2004,17 @@ void OgEngine::RaytracingPipeline::AddTexture(const std::string& p_texture, cons
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.maxLod = FLT_MAX;
 
+    data.components = components;
     data.info = CreateTextureDescriptor(m_vulkanDevice.logicalDevice, data, samplerInfo, format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
     QueueCmdBufferAndFlush(cmdBuffer, m_graphicsQueue);
     stagingBuffer.Destroy();
-    CreateTextureMipmaps(data.img, format, width, height, mipLevels);
-    if (p_type == 0)
+    if (generateMipmaps)
     {
-        m_textures.push_back(data);
-        m_textureCtr.emplace_back(p_texture);
-    }
-    else if (p_type == 1)
-    {
-        m_normalMaps.push_back(data);
-        m_normalMapsCtr.emplace_back(p_texture);
+        CreateTextureMipmaps(data.img, format, width, height, mipLevels);
     }
-    UpdateDescriptorSets();
 
+    return data;
 }
 
 void OgEngine::RaytracingPipeline::CreateTopLevelAccelerationStructure()
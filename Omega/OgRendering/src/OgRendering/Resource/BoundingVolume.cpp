@@ -0,0 +1,200 @@
+#include <OgRendering/Resource/BoundingVolume.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define BOUNDING_VOLUME_SSE2
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+	/**
+	 * @brief Element of a transform, stored row after row.
+	 */
+	float Element(const GPM::Matrix4F& p_transform, const int p_row, const int p_column)
+	{
+		return p_transform.m_data[p_row * 4 + p_column];
+	}
+
+#ifdef BOUNDING_VOLUME_SSE2
+	// The position is loaded with the first component of the normal, the fourth lane is ignored
+	static_assert(offsetof(OgEngine::Vertex, position) == 0u && sizeof(OgEngine::Vertex) >= 4u * sizeof(float),
+		"A position is read as four floats.");
+
+	__m128 LoadPosition(const OgEngine::Vertex& p_vertex)
+	{
+		return _mm_loadu_ps(&p_vertex.position.x);
+	}
+
+	/**
+	 * @brief Column of the rotation and scale of a transform, or its translation for the last one.
+	 */
+	__m128 Column(const GPM::Matrix4F& p_transform, const int p_column)
+	{
+		return _mm_setr_ps(Element(p_transform, 0, p_column), Element(p_transform, 1, p_column), Element(p_transform, 2, p_column), 0.0f);
+	}
+
+	GPM::Vector3F Store(const __m128 p_vector)
+	{
+		float values[4];
+		_mm_storeu_ps(values, p_vector);
+		return GPM::Vector3F(values[0], values[1], values[2]);
+	}
+#endif
+}
+
+bool OgEngine::BoundingBox::Empty() const
+{
+	return minimum.x > maximum.x || minimum.y > maximum.y || minimum.z > maximum.z;
+}
+
+GPM::Vector3F OgEngine::BoundingBox::Center() const
+{
+	return GPM::Vector3F((minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f);
+}
+
+GPM::Vector3F OgEngine::BoundingBox::Extents() const
+{
+	return GPM::Vector3F((maximum.x - minimum.x) * 0.5f, (maximum.y - minimum.y) * 0.5f, (maximum.z - minimum.z) * 0.5f);
+}
+
+OgEngine::BoundingBox OgEngine::BoundingBox::Transformed(const GPM::Matrix4F& p_transform) const
+{
+	if (Empty())
+		return *this;
+
+	const GPM::Vector3F center = Center(), extents = Extents();
+	BoundingBox box;
+
+#ifdef BOUNDING_VOLUME_SSE2
+	// The center is transformed as a point, the extents by the absolute value of the rotation and scale
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 x = Column(p_transform, 0), y = Column(p_transform, 1), z = Column(p_transform, 2);
+	const __m128 newCenter = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(center.x)), _mm_mul_ps(y, _mm_set1_ps(center.y))),
+		_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(center.z)), Column(p_transform, 3)));
+	const __m128 newExtents = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, x), _mm_set1_ps(extents.x)),
+		_mm_mul_ps(_mm_andnot_ps(signMask, y), _mm_set1_ps(extents.y))), _mm_mul_ps(_mm_andnot_ps(signMask, z), _mm_set1_ps(extents.z)));
+
+	box.minimum = Store(_mm_sub_ps(newCenter, newExtents));
+	box.maximum = Store(_mm_add_ps(newCenter, newExtents));
+#else
+	float newCenter[3], newExtents[3];
+	for (int row = 0; row < 3; ++row)
+	{
+		newCenter[row] = Element(p_transform, row, 0) * center.x + Element(p_transform, row, 1) * center.y
+			+ Element(p_transform, row, 2) * center.z + Element(p_transform, row, 3);
+		newExtents[row] = std::abs(Element(p_transform, row, 0)) * extents.x + std::abs(Element(p_transform, row, 1)) * extents.y
+			+ std::abs(Element(p_transform, row, 2)) * extents.z;
+	}
+
+	box.minimum = GPM::Vector3F(newCenter[0] - newExtents[0], newCenter[1] - newExtents[1], newCenter[2] - newExtents[2]);
+	box.maximum = GPM::Vector3F(newCenter[0] + newExtents[0], newCenter[1] + newExtents[1], newCenter[2] + newExtents[2]);
+#endif
+
+	return box;
+}
+
+OgEngine::BoundingBox OgEngine::BoundingBox::FromVertices(const std::vector<Vertex>& p_vertices)
+{
+	BoundingBox box;
+	if (p_vertices.empty())
+		return box;
+
+	size_t i = 0u;
+#ifdef BOUNDING_VOLUME_SSE2
+	// Two pairs of accumulators, so the reductions of consecutive vertices don't wait on each other
+	__m128 minimum0 = LoadPosition(p_vertices[0]), maximum0 = minimum0;
+	__m128 minimum1 = minimum0, maximum1 = minimum0;
+	for (; i + 4u <= p_vertices.size(); i += 4u)
+	{
+		const __m128 a = LoadPosition(p_vertices[i]), b = LoadPosition(p_vertices[i + 1u]);
+		const __m128 c = LoadPosition(p_vertices[i + 2u]), d = LoadPosition(p_vertices[i + 3u]);
+		minimum0 = _mm_min_ps(minimum0, _mm_min_ps(a, b));
+		maximum0 = _mm_max_ps(maximum0, _mm_max_ps(a, b));
+		minimum1 = _mm_min_ps(minimum1, _mm_min_ps(c, d));
+		maximum1 = _mm_max_ps(maximum1, _mm_max_ps(c, d));
+	}
+
+	box.minimum = Store(_mm_min_ps(minimum0, minimum1));
+	box.maximum = Store(_mm_max_ps(maximum0, maximum1));
+#endif
+
+	for (; i < p_vertices.size(); ++i)
+	{
+		const GPM::Vector3F& position = p_vertices[i].position;
+		box.minimum = GPM::Vector3F(std::min(box.minimum.x, position.x), std::min(box.minimum.y, position.y), std::min(box.minimum.z, position.z));
+		box.maximum = GPM::Vector3F(std::max(box.maximum.x, position.x), std::max(box.maximum.y, position.y), std::max(box.maximum.z, position.z));
+	}
+
+	return box;
+}
+
+bool OgEngine::BoundingSphere::Empty() const
+{
+	return radius < 0.0f;
+}
+
+OgEngine::BoundingSphere OgEngine::BoundingSphere::Transformed(const GPM::Matrix4F& p_transform) const
+{
+	if (Empty())
+		return *this;
+
+	BoundingSphere sphere;
+	float largestScale = 0.0f;
+	for (int column = 0; column < 3; ++column)
+	{
+		const float x = Element(p_transform, 0, column), y = Element(p_transform, 1, column), z = Element(p_transform, 2, column);
+		largestScale = std::max(largestScale, x * x + y * y + z * z);
+	}
+
+	sphere.center = GPM::Vector3F(
+		Element(p_transform, 0, 0) * center.x + Element(p_transform, 0, 1) * center.y + Element(p_transform, 0, 2) * center.z + Element(p_transform, 0, 3),
+		Element(p_transform, 1, 0) * center.x + Element(p_transform, 1, 1) * center.y + Element(p_transform, 1, 2) * center.z + Element(p_transform, 1, 3),
+		Element(p_transform, 2, 0) * center.x + Element(p_transform, 2, 1) * center.y + Element(p_transform, 2, 2) * center.z + Element(p_transform, 2, 3));
+	sphere.radius = radius * std::sqrt(largestScale);
+
+	return sphere;
+}
+
+OgEngine::BoundingSphere OgEngine::BoundingSphere::FromVertices(const std::vector<Vertex>& p_vertices, const BoundingBox& p_box)
+{
+	BoundingSphere sphere;
+	if (p_vertices.empty() || p_box.Empty())
+		return sphere;
+
+	sphere.center = p_box.Center();
+	float radiusSquared = 0.0f;
+	size_t i = 0u;
+
+#ifdef BOUNDING_VOLUME_SSE2
+	// Four vertices at a time, turned into their x, y and z components
+	const __m128 centerX = _mm_set1_ps(sphere.center.x), centerY = _mm_set1_ps(sphere.center.y), centerZ = _mm_set1_ps(sphere.center.z);
+	__m128 farthest = _mm_setzero_ps();
+	for (; i + 4u <= p_vertices.size(); i += 4u)
+	{
+		__m128 x = LoadPosition(p_vertices[i]), y = LoadPosition(p_vertices[i + 1u]);
+		__m128 z = LoadPosition(p_vertices[i + 2u]), w = LoadPosition(p_vertices[i + 3u]);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+
+		const __m128 dx = _mm_sub_ps(x, centerX), dy = _mm_sub_ps(y, centerY), dz = _mm_sub_ps(z, centerZ);
+		farthest = _mm_max_ps(farthest, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+	}
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, farthest);
+	radiusSquared = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+
+	for (; i < p_vertices.size(); ++i)
+	{
+		const GPM::Vector3F& position = p_vertices[i].position;
+		const float dx = position.x - sphere.center.x, dy = position.y - sphere.center.y, dz = position.z - sphere.center.z;
+		radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+	}
+
+	sphere.radius = std::sqrt(radiusSquared);
+	return sphere;
+}
@@ -14,6 +14,12 @@ OgEngine::Mesh::Mesh(const Mesh & p_other)
 
 	m_vertices = p_other.m_vertices;
 	m_indices = p_other.m_indices;
+	m_packedVertices = p_other.m_packedVertices;
+	m_meshlets = p_other.m_meshlets;
+	m_lods = p_other.m_lods;
+	m_localBox = p_other.m_localBox;
+	m_localSphere = p_other.m_localSphere;
+	m_vertexLayout = p_other.m_vertexLayout;
 	m_hashID = p_other.m_hashID;
 	m_meshName = p_other.m_meshName;
 	m_parentMeshName = p_other.m_parentMeshName;
@@ -27,6 +33,12 @@ OgEngine::Mesh::Mesh(Mesh && p_other) noexcept
 {
 	m_vertices = std::move(p_other.m_vertices);
 	m_indices = std::move(p_other.m_indices);
+	m_packedVertices = std::move(p_other.m_packedVertices);
+	m_meshlets = std::move(p_other.m_meshlets);
+	m_lods = std::move(p_other.m_lods);
+	m_localBox = p_other.m_localBox;
+	m_localSphere = p_other.m_localSphere;
+	m_vertexLayout = p_other.m_vertexLayout;
 	m_hashID = p_other.m_hashID;
 	m_meshName = std::move(p_other.m_meshName);
 	m_parentMeshName = std::move(p_other.m_parentMeshName);
@@ -53,6 +65,12 @@ void OgEngine::Mesh::FillData(const std::shared_ptr<Mesh> & p_other)
 	{
 		m_vertices = std::move(p_other->m_vertices);
 		m_indices = std::move(p_other->m_indices);
+		m_packedVertices = std::move(p_other->m_packedVertices);
+		m_meshlets = std::move(p_other->m_meshlets);
+		m_lods = std::move(p_other->m_lods);
+		m_localBox = p_other->m_localBox;
+		m_localSphere = p_other->m_localSphere;
+		m_vertexLayout = p_other->m_vertexLayout;
 		m_subMeshes = std::move(p_other->m_subMeshes);
 	}
 }
@@ -82,6 +100,54 @@ const std::vector<uint32_t>& OgEngine::Mesh::Indices() const
 	return m_indices;
 }
 
+OgEngine::VERTEX_LAYOUT OgEngine::Mesh::VertexLayout() const
+{
+	return m_vertexLayout;
+}
+
+const std::vector<OgEngine::PackedVertex>& OgEngine::Mesh::PackedVertices() const
+{
+	return m_packedVertices;
+}
+
+const OgEngine::MeshletData& OgEngine::Mesh::Meshlets() const
+{
+	return m_meshlets;
+}
+
+const std::vector<OgEngine::MeshLod>& OgEngine::Mesh::Lods() const
+{
+	return m_lods;
+}
+
+const std::vector<uint32_t>& OgEngine::Mesh::LodIndices(const size_t p_level) const
+{
+	if (p_level == 0u || p_level > m_lods.size())
+		return m_indices;
+
+	return m_lods[p_level - 1u].indices;
+}
+
+const OgEngine::BoundingBox& OgEngine::Mesh::LocalBox() const
+{
+	return m_localBox;
+}
+
+const OgEngine::BoundingSphere& OgEngine::Mesh::LocalSphere() const
+{
+	return m_localSphere;
+}
+
+size_t OgEngine::Mesh::SelectLod(const float p_maxError) const
+{
+	// The errors grow with the levels
+	size_t level = 0u;
+	while (level < m_lods.size() && m_lods[level].error <= p_maxError)
+		++level;
+
+	return level;
+}
+
 std::string OgEngine::Mesh::MeshName() const
 {
 	return m_meshName;
@@ -117,6 +183,21 @@ int OgEngine::Mesh::SubMeshIndex() const
 	return m_subMeshIndex;
 }
 
+uint64_t OgEngine::Mesh::CpuBytes() const
+{
+	uint64_t bytes = m_vertices.size() * sizeof(Vertex) + m_indices.size() * sizeof(uint32_t)
+		+ m_packedVertices.size() * sizeof(PackedVertex) + m_meshlets.Bytes();
+	for (const MeshLod& lod : m_lods)
+		bytes += lod.indices.size() * sizeof(uint32_t);
+	for (const auto& subMesh : m_subMeshes)
+	{
+		if (subMesh)
+			bytes += subMesh->CpuBytes();
+	}
+
+	return bytes;
+}
+
 OgEngine::Mesh& OgEngine::Mesh::operator=(const Mesh & p_other)
 {
 	if (&p_other == this)
@@ -124,6 +205,12 @@ OgEngine::Mesh& OgEngine::Mesh::operator=(const Mesh & p_other)
 
 	m_vertices = p_other.m_vertices;
 	m_indices = p_other.m_indices;
+	m_packedVertices = p_other.m_packedVertices;
+	m_meshlets = p_other.m_meshlets;
+	m_lods = p_other.m_lods;
+	m_localBox = p_other.m_localBox;
+	m_localSphere = p_other.m_localSphere;
+	m_vertexLayout = p_other.m_vertexLayout;
 	m_hashID = p_other.m_hashID;
 	m_meshName = p_other.m_meshName;
 	m_parentMeshName = p_other.m_parentMeshName;
@@ -139,6 +226,12 @@ OgEngine::Mesh& OgEngine::Mesh::operator=(Mesh && p_other) noexcept
 {
 	m_vertices = std::move(p_other.m_vertices);
 	m_indices = std::move(p_other.m_indices);
+	m_packedVertices = std::move(p_other.m_packedVertices);
+	m_meshlets = std::move(p_other.m_meshlets);
+	m_lods = std::move(p_other.m_lods);
+	m_localBox = p_other.m_localBox;
+	m_localSphere = p_other.m_localSphere;
+	m_vertexLayout = p_other.m_vertexLayout;
 	m_hashID = p_other.m_hashID;
 	m_meshName = std::move(p_other.m_meshName);
 	m_parentMeshName = std::move(p_other.m_parentMeshName);
@@ -169,3 +262,51 @@ void OgEngine::Mesh::SetIndexSubmesh(const int p_subMeshIndex)
 {
 	m_subMeshIndex = p_subMeshIndex;
 }
+
+void OgEngine::Mesh::SetVertexLayout(const VERTEX_LAYOUT p_layout)
+{
+	if (p_layout == VERTEX_LAYOUT::PACKED)
+	{
+		if (m_vertexLayout != VERTEX_LAYOUT::PACKED || m_packedVertices.size() != m_vertices.size())
+			m_packedVertices = PackedVertex::Pack(m_vertices);
+	}
+	else
+	{
+		m_packedVertices.clear();
+		m_packedVertices.shrink_to_fit();
+	}
+
+	m_vertexLayout = p_layout;
+	for (const auto& subMesh : m_subMeshes)
+	{
+		if (subMesh)
+			subMesh->SetVertexLayout(p_layout);
+	}
+}
+
+void OgEngine::Mesh::SetMeshlets(MeshletData p_meshlets)
+{
+	m_meshlets = std::move(p_meshlets);
+}
+
+void OgEngine::Mesh::SetLods(std::vector<MeshLod> p_lods)
+{
+	m_lods = std::move(p_lods);
+}
+
+void OgEngine::Mesh::ComputeBounds()
+{
+	m_localBox = BoundingBox::FromVertices(m_vertices);
+	m_localSphere = BoundingSphere::FromVertices(m_vertices, m_localBox);
+	for (const auto& subMesh : m_subMeshes)
+	{
+		if (subMesh)
+			subMesh->ComputeBounds();
+	}
+}
+
+void OgEngine::Mesh::SetBounds(const BoundingBox& p_box, const BoundingSphere& p_sphere)
+{
+	m_localBox = p_box;
+	m_localSphere = p_sphere;
+}
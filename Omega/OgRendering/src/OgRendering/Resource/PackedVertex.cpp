@@ -0,0 +1,362 @@
+#include <OgRendering/Resource/PackedVertex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define PACKED_VERTEX_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr float SNORM16_MAX = 32767.0f;
+
+	int16_t ToSnorm16(const float p_value)
+	{
+		// Rounded half away from zero in floats, exactly as the SSE2 path does
+		const float scaled = std::clamp(p_value, -1.0f, 1.0f) * SNORM16_MAX;
+		return static_cast<int16_t>(scaled + std::copysign(0.5f, scaled));
+	}
+
+	float FromSnorm16(const int16_t p_value)
+	{
+		return std::max(static_cast<float>(p_value) / SNORM16_MAX, -1.0f);
+	}
+
+	void EncodeOctahedral(const GPM::Vector3F& p_vector, int16_t (&p_encoded)[2])
+	{
+		const float length = std::abs(p_vector.x) + std::abs(p_vector.y) + std::abs(p_vector.z);
+		if (length <= 0.0f)
+		{
+			p_encoded[0] = 0;
+			p_encoded[1] = 0;
+			return;
+		}
+
+		float x = p_vector.x / length;
+		float y = p_vector.y / length;
+		if (p_vector.z < 0.0f)
+		{
+			// The lower half of the octahedron is folded over the diagonals of the upper one
+			const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldedX;
+			y = foldedY;
+		}
+
+		p_encoded[0] = ToSnorm16(x);
+		p_encoded[1] = ToSnorm16(y);
+	}
+
+	GPM::Vector3F DecodeOctahedral(const int16_t (&p_encoded)[2])
+	{
+		float x = FromSnorm16(p_encoded[0]);
+		float y = FromSnorm16(p_encoded[1]);
+		const float z = 1.0f - std::abs(x) - std::abs(y);
+		const float fold = std::max(-z, 0.0f);
+		x += x >= 0.0f ? -fold : fold;
+		y += y >= 0.0f ? -fold : fold;
+
+		const float length = std::sqrt(x * x + y * y + z * z);
+		return { x / length, y / length, z / length };
+	}
+
+	/**
+	 * @brief Round to the nearest half, ties to even. NaN gives 0, the values beyond the largest half are clamped to it.
+	 */
+	uint16_t FloatToHalf(const float p_value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &p_value, sizeof(bits));
+		const auto sign = static_cast<uint16_t>((bits >> 16u) & 0x8000u);
+		uint32_t magnitude = bits & 0x7fffffffu;
+
+		if (magnitude > 0x7f800000u)
+			return 0u;
+		// 65520 and above round to infinity
+		if (magnitude >= 0x477ff000u)
+			return sign | 0x7bffu;
+		if (magnitude < 0x38800000u)
+		{
+			// Subnormal half, counted in steps of 2^-24
+			float absolute;
+			std::memcpy(&absolute, &magnitude, sizeof(absolute));
+			return sign | static_cast<uint16_t>(std::lrint(absolute * 16777216.0f));
+		}
+
+		magnitude += 0xfffu + ((magnitude >> 13u) & 1u);
+		return sign | static_cast<uint16_t>((magnitude >> 13u) - (112u << 10u));
+	}
+
+	float HalfToFloat(const uint16_t p_value)
+	{
+		const uint32_t sign = static_cast<uint32_t>(p_value & 0x8000u) << 16u;
+		const uint32_t exponent = (p_value >> 10u) & 0x1fu;
+		const uint32_t mantissa = p_value & 0x3ffu;
+
+		if (exponent == 0u)
+		{
+			const float value = static_cast<float>(mantissa) / 16777216.0f;
+			return sign != 0u ? -value : value;
+		}
+
+		const uint32_t bits = sign | (exponent == 0x1fu ? 0x7f800000u | (mantissa << 13u) : ((exponent + 112u) << 23u) | (mantissa << 13u));
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	void PackScalar(const OgEngine::Vertex& p_vertex, OgEngine::PackedVertex& p_packed)
+	{
+		p_packed.position[0] = p_vertex.position.x;
+		p_packed.position[1] = p_vertex.position.y;
+		p_packed.position[2] = p_vertex.position.z;
+		EncodeOctahedral(p_vertex.normal, p_packed.normal);
+		EncodeOctahedral(p_vertex.tangent, p_packed.tangent);
+		p_packed.texCoord[0] = FloatToHalf(p_vertex.texCoord.x);
+		p_packed.texCoord[1] = FloatToHalf(p_vertex.texCoord.y);
+	}
+
+	void UnpackScalar(const OgEngine::PackedVertex& p_packed, OgEngine::Vertex& p_vertex)
+	{
+		p_vertex.position = { p_packed.position[0], p_packed.position[1], p_packed.position[2] };
+		p_vertex.normal = DecodeOctahedral(p_packed.normal);
+		p_vertex.tangent = DecodeOctahedral(p_packed.tangent);
+		p_vertex.texCoord = { HalfToFloat(p_packed.texCoord[0]), HalfToFloat(p_packed.texCoord[1]) };
+	}
+
+#ifdef PACKED_VERTEX_SSE2
+	/**
+	 * @brief Octahedral encoding of four vectors given by components, the same rounding as EncodeOctahedral.
+	 */
+	void EncodeOctahedral4(const __m128 p_x, const __m128 p_y, const __m128 p_z, int32_t (&p_encodedX)[4], int32_t (&p_encodedY)[4])
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		const __m128 length = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, p_x), _mm_andnot_ps(signMask, p_y)), _mm_andnot_ps(signMask, p_z));
+		const __m128 isNull = _mm_cmple_ps(length, _mm_setzero_ps());
+		const __m128 divisor = _mm_or_ps(_mm_and_ps(isNull, one), _mm_andnot_ps(isNull, length));
+		__m128 x = _mm_andnot_ps(isNull, _mm_div_ps(p_x, divisor));
+		__m128 y = _mm_andnot_ps(isNull, _mm_div_ps(p_y, divisor));
+
+		// sign(0) is positive, as in the scalar fold
+		const __m128 signX = _mm_andnot_ps(_mm_cmpge_ps(x, _mm_setzero_ps()), signMask);
+		const __m128 signY = _mm_andnot_ps(_mm_cmpge_ps(y, _mm_setzero_ps()), signMask);
+		const __m128 foldedX = _mm_xor_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, y)), signX);
+		const __m128 foldedY = _mm_xor_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), signY);
+		const __m128 isLower = _mm_cmplt_ps(p_z, _mm_setzero_ps());
+		x = _mm_or_ps(_mm_and_ps(isLower, foldedX), _mm_andnot_ps(isLower, x));
+		y = _mm_or_ps(_mm_and_ps(isLower, foldedY), _mm_andnot_ps(isLower, y));
+
+		const __m128 scale = _mm_set1_ps(SNORM16_MAX);
+		const __m128 minimum = _mm_set1_ps(-1.0f);
+		x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(x, minimum), one), scale);
+		y = _mm_mul_ps(_mm_min_ps(_mm_max_ps(y, minimum), one), scale);
+
+		// Round half away from zero, the conversion truncates
+		const __m128 half = _mm_set1_ps(0.5f);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p_encodedX), _mm_cvttps_epi32(_mm_add_ps(x, _mm_or_ps(half, _mm_and_ps(x, signMask)))));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p_encodedY), _mm_cvttps_epi32(_mm_add_ps(y, _mm_or_ps(half, _mm_and_ps(y, signMask)))));
+	}
+
+	/**
+	 * @brief FloatToHalf of four values, false without writing anything if one of them isn't a normal half or zero.
+	 */
+	bool FloatToHalf4(const __m128 p_values, uint16_t (&p_halves)[4])
+	{
+		const __m128i bits = _mm_castps_si128(p_values);
+		const __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7fffffff));
+		const __m128i isZero = _mm_cmpeq_epi32(magnitude, _mm_setzero_si128());
+		const __m128i isNormal = _mm_and_si128(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x387fffff)),
+			_mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x477ff000)));
+		if (_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(isZero, isNormal))) != 0xf)
+			return false;
+
+		const __m128i odd = _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(1));
+		const __m128i rounded = _mm_add_epi32(magnitude, _mm_add_epi32(odd, _mm_set1_epi32(0xfff)));
+		__m128i halves = _mm_sub_epi32(_mm_srli_epi32(rounded, 13), _mm_set1_epi32(112 << 10));
+		halves = _mm_andnot_si128(isZero, halves);
+		halves = _mm_or_si128(halves, _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000)));
+
+		alignas(16) int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), halves);
+		for (int i = 0; i < 4; ++i)
+			p_halves[i] = static_cast<uint16_t>(lanes[i]);
+
+		return true;
+	}
+
+	void Pack4(const OgEngine::Vertex* p_vertices, OgEngine::PackedVertex* p_packed)
+	{
+		const OgEngine::Vertex& v0 = p_vertices[0];
+		const OgEngine::Vertex& v1 = p_vertices[1];
+		const OgEngine::Vertex& v2 = p_vertices[2];
+		const OgEngine::Vertex& v3 = p_vertices[3];
+
+		int32_t normalX[4], normalY[4], tangentX[4], tangentY[4];
+		EncodeOctahedral4(_mm_setr_ps(v0.normal.x, v1.normal.x, v2.normal.x, v3.normal.x),
+			_mm_setr_ps(v0.normal.y, v1.normal.y, v2.normal.y, v3.normal.y),
+			_mm_setr_ps(v0.normal.z, v1.normal.z, v2.normal.z, v3.normal.z), normalX, normalY);
+		EncodeOctahedral4(_mm_setr_ps(v0.tangent.x, v1.tangent.x, v2.tangent.x, v3.tangent.x),
+			_mm_setr_ps(v0.tangent.y, v1.tangent.y, v2.tangent.y, v3.tangent.y),
+			_mm_setr_ps(v0.tangent.z, v1.tangent.z, v2.tangent.z, v3.tangent.z), tangentX, tangentY);
+
+		uint16_t u[4], v[4];
+		const bool uFits = FloatToHalf4(_mm_setr_ps(v0.texCoord.x, v1.texCoord.x, v2.texCoord.x, v3.texCoord.x), u);
+		const bool vFits = FloatToHalf4(_mm_setr_ps(v0.texCoord.y, v1.texCoord.y, v2.texCoord.y, v3.texCoord.y), v);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const OgEngine::Vertex& vertex = p_vertices[i];
+			OgEngine::PackedVertex& packed = p_packed[i];
+			packed.position[0] = vertex.position.x;
+			packed.position[1] = vertex.position.y;
+			packed.position[2] = vertex.position.z;
+			packed.normal[0] = static_cast<int16_t>(normalX[i]);
+			packed.normal[1] = static_cast<int16_t>(normalY[i]);
+			packed.tangent[0] = static_cast<int16_t>(tangentX[i]);
+			packed.tangent[1] = static_cast<int16_t>(tangentY[i]);
+			// Subnormals, huge and non-finite coordinates are rare enough to go through the scalar path
+			packed.texCoord[0] = uFits ? u[i] : FloatToHalf(vertex.texCoord.x);
+			packed.texCoord[1] = vFits ? v[i] : FloatToHalf(vertex.texCoord.y);
+		}
+	}
+
+	void DecodeOctahedral4(const int16_t p_x0, const int16_t p_y0, const int16_t p_x1, const int16_t p_y1,
+		const int16_t p_x2, const int16_t p_y2, const int16_t p_x3, const int16_t p_y3, GPM::Vector3F* p_decoded[4])
+	{
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 inverseScale = _mm_set1_ps(1.0f / SNORM16_MAX);
+		const __m128 minimum = _mm_set1_ps(-1.0f);
+
+		__m128 x = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(p_x0, p_x1, p_x2, p_x3)), inverseScale), minimum);
+		__m128 y = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(p_y0, p_y1, p_y2, p_y3)), inverseScale), minimum);
+		const __m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+		const __m128 fold = _mm_max_ps(_mm_xor_ps(z, signMask), _mm_setzero_ps());
+
+		// -fold where the component is positive or zero, +fold elsewhere
+		const __m128 foldX = _mm_xor_ps(fold, _mm_andnot_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), signMask));
+		const __m128 foldY = _mm_xor_ps(fold, _mm_andnot_ps(_mm_cmplt_ps(y, _mm_setzero_ps()), signMask));
+		x = _mm_add_ps(x, foldX);
+		y = _mm_add_ps(y, foldY);
+
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+		alignas(16) float decodedX[4], decodedY[4], decodedZ[4];
+		_mm_store_ps(decodedX, _mm_div_ps(x, length));
+		_mm_store_ps(decodedY, _mm_div_ps(y, length));
+		_mm_store_ps(decodedZ, _mm_div_ps(z, length));
+		for (int i = 0; i < 4; ++i)
+			*p_decoded[i] = { decodedX[i], decodedY[i], decodedZ[i] };
+	}
+
+	/**
+	 * @brief Exact conversion of four halves, subnormals and non-finite values included.
+	 */
+	__m128 HalfToFloat4(const uint16_t p_h0, const uint16_t p_h1, const uint16_t p_h2, const uint16_t p_h3)
+	{
+		const __m128i halves = _mm_setr_epi32(p_h0, p_h1, p_h2, p_h3);
+		const __m128i magnitude = _mm_and_si128(halves, _mm_set1_epi32(0x7fff));
+		const __m128i sign = _mm_slli_epi32(_mm_xor_si128(halves, magnitude), 16);
+
+		// Rebiasing with a product by 2^112 turns the subnormal halves into normal floats
+		const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+		const __m128i isInfinityOrNaN = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7bff));
+		const __m128i exponent = _mm_and_si128(isInfinityOrNaN, _mm_set1_epi32(255 << 23));
+
+		return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, exponent)));
+	}
+
+	void Unpack4(const OgEngine::PackedVertex* p_packed, OgEngine::Vertex* p_vertices)
+	{
+		const OgEngine::PackedVertex& p0 = p_packed[0];
+		const OgEngine::PackedVertex& p1 = p_packed[1];
+		const OgEngine::PackedVertex& p2 = p_packed[2];
+		const OgEngine::PackedVertex& p3 = p_packed[3];
+
+		GPM::Vector3F* normals[4] = { &p_vertices[0].normal, &p_vertices[1].normal, &p_vertices[2].normal, &p_vertices[3].normal };
+		GPM::Vector3F* tangents[4] = { &p_vertices[0].tangent, &p_vertices[1].tangent, &p_vertices[2].tangent, &p_vertices[3].tangent };
+		DecodeOctahedral4(p0.normal[0], p0.normal[1], p1.normal[0], p1.normal[1], p2.normal[0], p2.normal[1], p3.normal[0], p3.normal[1], normals);
+		DecodeOctahedral4(p0.tangent[0], p0.tangent[1], p1.tangent[0], p1.tangent[1], p2.tangent[0], p2.tangent[1], p3.tangent[0], p3.tangent[1], tangents);
+
+		alignas(16) float u[4], v[4];
+		_mm_store_ps(u, HalfToFloat4(p0.texCoord[0], p1.texCoord[0], p2.texCoord[0], p3.texCoord[0]));
+		_mm_store_ps(v, HalfToFloat4(p0.texCoord[1], p1.texCoord[1], p2.texCoord[1], p3.texCoord[1]));
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const OgEngine::PackedVertex& packed = p_packed[i];
+			OgEngine::Vertex& vertex = p_vertices[i];
+			vertex.position = { packed.position[0], packed.position[1], packed.position[2] };
+			vertex.texCoord = { u[i], v[i] };
+		}
+	}
+#endif
+}
+
+VkVertexInputBindingDescription OgEngine::PackedVertex::getBindingDescription()
+{
+	VkVertexInputBindingDescription bindingDescription = {};
+	bindingDescription.binding = 0;
+	bindingDescription.stride = sizeof(PackedVertex);
+	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 3> OgEngine::PackedVertex::getAttributeDescriptions()
+{
+	std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = {};
+
+	attributeDescriptions[0].binding = 0;
+	attributeDescriptions[0].location = 0;
+	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[0].offset = offsetof(PackedVertex, position);
+
+	attributeDescriptions[1].binding = 0;
+	attributeDescriptions[1].location = 1;
+	attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
+	attributeDescriptions[1].offset = offsetof(PackedVertex, normal);
+
+	// The tangent isn't read by rast_vert_packed.vert, the texture coordinates keep the location of the full layout
+	attributeDescriptions[2].binding = 0;
+	attributeDescriptions[2].location = 3;
+	attributeDescriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+	attributeDescriptions[2].offset = offsetof(PackedVertex, texCoord);
+
+	return attributeDescriptions;
+}
+
+std::vector<OgEngine::PackedVertex> OgEngine::PackedVertex::Pack(const std::vector<Vertex>& p_vertices)
+{
+	std::vector<PackedVertex> packed(p_vertices.size());
+
+	size_t i = 0u;
+#ifdef PACKED_VERTEX_SSE2
+	for (; i + 4u <= p_vertices.size(); i += 4u)
+		Pack4(p_vertices.data() + i, packed.data() + i);
+#endif
+	for (; i < p_vertices.size(); ++i)
+		PackScalar(p_vertices[i], packed[i]);
+
+	return packed;
+}
+
+std::vector<OgEngine::Vertex> OgEngine::PackedVertex::Unpack(const std::vector<PackedVertex>& p_vertices)
+{
+	std::vector<Vertex> vertices(p_vertices.size());
+
+	size_t i = 0u;
+#ifdef PACKED_VERTEX_SSE2
+	for (; i + 4u <= p_vertices.size(); i += 4u)
+		Unpack4(p_vertices.data() + i, vertices.data() + i);
+#endif
+	for (; i < p_vertices.size(); ++i)
+		UnpackScalar(p_vertices[i], vertices[i]);
+
+	return vertices;
+}
@@ -1,5 +1,40 @@
 #include <OgRendering/Resource/Texture.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	// In the order of TEXTURE_FORMAT
+	constexpr std::array<OgEngine::TextureFormatInfo, 14u> FORMATS
+	{ {
+		{ 4u, 1u, false }, { 4u, 0u, false }, { 4u, 0u, false },
+		{ 1u, 1u, false }, { 2u, 1u, false }, { 3u, 1u, false },
+		{ 1u, 2u, false }, { 2u, 2u, false }, { 3u, 2u, false }, { 4u, 2u, false },
+		{ 1u, 4u, true }, { 2u, 4u, true }, { 3u, 4u, true }, { 4u, 4u, true }
+	} };
+
+	/**
+	 * @brief Copy pixels of 1 to 3 channels to RGBA ones, the gray goes in the RGB channels and a missing alpha is set to p_opaque.
+	 */
+	template<typename Channel>
+	void ExpandToRgba(const uint8_t* p_source, const uint64_t p_pixelCount, const uint32_t p_channels, const Channel p_opaque, uint8_t* p_destination)
+	{
+		const auto* source = reinterpret_cast<const Channel*>(p_source);
+		auto* destination = reinterpret_cast<Channel*>(p_destination);
+		for (uint64_t pixel = 0u; pixel < p_pixelCount; ++pixel, source += p_channels, destination += 4u)
+		{
+			const bool isGray = p_channels < 3u;
+			destination[0] = source[0];
+			destination[1] = isGray ? source[0] : source[1];
+			destination[2] = isGray ? source[0] : source[2];
+			destination[3] = p_channels == 2u ? source[1] : p_channels == 4u ? source[3] : p_opaque;
+		}
+	}
+}
+
 OgEngine::Texture::Texture()
 = default;
 
@@ -16,6 +51,9 @@ OgEngine::Texture::Texture(const Texture & p_other)
 	m_width = p_other.m_width;
 	m_height = p_other.m_height;
 	m_mipmapLevels = p_other.m_mipmapLevels;
+	m_format = p_other.m_format;
+	m_levels = p_other.m_levels;
+	m_source = p_other.m_source;
 }
 
 OgEngine::Texture::Texture(Texture && p_other) noexcept
@@ -26,6 +64,9 @@ OgEngine::Texture::Texture(Texture && p_other) noexcept
 	m_width = p_other.m_width;
 	m_height = p_other.m_height;
 	m_mipmapLevels = p_other.m_mipmapLevels;
+	m_format = p_other.m_format;
+	m_levels = p_other.m_levels;
+	m_source = p_other.m_source;
 }
 
 void OgEngine::Texture::SetHashID(const uint64_t p_hashID)
@@ -33,6 +74,17 @@ void OgEngine::Texture::SetHashID(const uint64_t p_hashID)
 	m_hashID = p_hashID;
 }
 
+void OgEngine::Texture::SetSource(const TextureSource& p_source)
+{
+	m_source = p_source;
+}
+
+void OgEngine::Texture::ReleaseCpuData()
+{
+	stbi_image_free(m_pixels);
+	m_pixels = nullptr;
+}
+
 stbi_uc* OgEngine::Texture::Pixels() const
 {
 	return m_pixels;
@@ -63,6 +115,181 @@ uint32_t OgEngine::Texture::MipmapLevels() const
 	return m_mipmapLevels;
 }
 
+OgEngine::TEXTURE_FORMAT OgEngine::Texture::Format() const
+{
+	return m_format;
+}
+
+VkFormat OgEngine::Texture::VulkanFormat(const bool p_srgb) const
+{
+	return VulkanFormat(m_format, p_srgb);
+}
+
+VkComponentMapping OgEngine::Texture::VulkanSwizzle() const
+{
+	switch (FormatInfo(m_format).channels)
+	{
+	case 1u:
+		return { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE };
+	case 2u:
+		return { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G };
+	default:
+		return { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+	}
+}
+
+std::vector<uint8_t> OgEngine::Texture::RgbaPixels(std::vector<MipLevel>& p_levels) const
+{
+	const TextureFormatInfo& info = FormatInfo(m_format);
+	if (!m_pixels || info.IsCompressed())
+		return {};
+
+	uint64_t size = 0u;
+	p_levels.clear();
+	for (const MipLevel& level : m_levels)
+	{
+		const uint64_t levelSize = static_cast<uint64_t>(level.width) * level.height * 4u * info.channelBytes;
+		p_levels.push_back({ size, levelSize, level.width, level.height });
+		size += levelSize;
+	}
+
+	std::vector<uint8_t> pixels(static_cast<size_t>(size));
+	for (size_t level = 0u; level < m_levels.size(); ++level)
+	{
+		const uint8_t* source = m_pixels + m_levels[level].offset;
+		uint8_t* destination = pixels.data() + p_levels[level].offset;
+		const uint64_t pixelCount = static_cast<uint64_t>(m_levels[level].width) * m_levels[level].height;
+
+		if (info.channels == 4u)
+			std::memcpy(destination, source, static_cast<size_t>(m_levels[level].size));
+		else if (info.channelBytes == 1u)
+			ExpandToRgba<uint8_t>(source, pixelCount, info.channels, 0xFFu, destination);
+		else if (info.channelBytes == 2u)
+			ExpandToRgba<uint16_t>(source, pixelCount, info.channels, 0xFFFFu, destination);
+		else
+			ExpandToRgba<float>(source, pixelCount, info.channels, 1.0f, destination);
+	}
+
+	return pixels;
+}
+
+std::vector<uint8_t> OgEngine::Texture::Rgba8Pixels() const
+{
+	const TextureFormatInfo& info = FormatInfo(m_format);
+	if (!m_pixels || info.IsCompressed() || m_levels.empty())
+		return {};
+
+	const uint64_t pixelCount = static_cast<uint64_t>(m_width) * m_height;
+	std::vector<uint8_t> rgba(static_cast<size_t>(pixelCount * 4u));
+	if (info.channelBytes == 1u)
+	{
+		if (info.channels == 4u)
+			std::memcpy(rgba.data(), m_pixels, rgba.size());
+		else
+			ExpandToRgba<uint8_t>(m_pixels, pixelCount, info.channels, 0xFFu, rgba.data());
+
+		return rgba;
+	}
+
+	// The wider channels are expanded first then narrowed, the floats are clamped to [0, 1]
+	std::vector<MipLevel> levels;
+	const std::vector<uint8_t> wide = RgbaPixels(levels);
+	for (size_t value = 0u; value < rgba.size(); ++value)
+	{
+		if (info.channelBytes == 2u)
+		{
+			uint16_t channel;
+			std::memcpy(&channel, wide.data() + value * 2u, sizeof(channel));
+			rgba[value] = static_cast<uint8_t>(channel >> 8u);
+		}
+		else
+		{
+			float channel;
+			std::memcpy(&channel, wide.data() + value * 4u, sizeof(channel));
+			rgba[value] = static_cast<uint8_t>(std::clamp(channel, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+	}
+
+	return rgba;
+}
+
+const OgEngine::TextureFormatInfo& OgEngine::Texture::FormatInfo(const TEXTURE_FORMAT p_format)
+{
+	const auto index = static_cast<size_t>(p_format);
+	return FORMATS[index < FORMATS.size() ? index : 0u];
+}
+
+OgEngine::TEXTURE_FORMAT OgEngine::Texture::FormatOf(const uint32_t p_channels, const uint32_t p_channelBytes)
+{
+	// The first format of each depth has 1 channel, the next ones follow
+	const uint32_t channels = p_channels < 1u ? 1u : p_channels > 4u ? 4u : p_channels;
+	switch (p_channelBytes)
+	{
+	case 2u:
+		return static_cast<TEXTURE_FORMAT>(static_cast<uint32_t>(TEXTURE_FORMAT::R16) + channels - 1u);
+	case 4u:
+		return static_cast<TEXTURE_FORMAT>(static_cast<uint32_t>(TEXTURE_FORMAT::R32F) + channels - 1u);
+	default:
+		return channels == 4u ? TEXTURE_FORMAT::RGBA8 : static_cast<TEXTURE_FORMAT>(static_cast<uint32_t>(TEXTURE_FORMAT::R8) + channels - 1u);
+	}
+}
+
+VkFormat OgEngine::Texture::VulkanFormat(const TEXTURE_FORMAT p_format, const bool p_srgb)
+{
+	switch (p_format)
+	{
+	case TEXTURE_FORMAT::BC1:
+		return p_srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+	case TEXTURE_FORMAT::BC3:
+		return p_srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+	case TEXTURE_FORMAT::R8:
+		return p_srgb ? VK_FORMAT_R8_SRGB : VK_FORMAT_R8_UNORM;
+	case TEXTURE_FORMAT::RG8:
+		return p_srgb ? VK_FORMAT_R8G8_SRGB : VK_FORMAT_R8G8_UNORM;
+	case TEXTURE_FORMAT::RGB8:
+		return p_srgb ? VK_FORMAT_R8G8B8_SRGB : VK_FORMAT_R8G8B8_UNORM;
+	case TEXTURE_FORMAT::R16:
+		return VK_FORMAT_R16_UNORM;
+	case TEXTURE_FORMAT::RG16:
+		return VK_FORMAT_R16G16_UNORM;
+	case TEXTURE_FORMAT::RGB16:
+		return VK_FORMAT_R16G16B16_UNORM;
+	case TEXTURE_FORMAT::RGBA16:
+		return VK_FORMAT_R16G16B16A16_UNORM;
+	case TEXTURE_FORMAT::R32F:
+		return VK_FORMAT_R32_SFLOAT;
+	case TEXTURE_FORMAT::RG32F:
+		return VK_FORMAT_R32G32_SFLOAT;
+	case TEXTURE_FORMAT::RGB32F:
+		return VK_FORMAT_R32G32B32_SFLOAT;
+	case TEXTURE_FORMAT::RGBA32F:
+		return VK_FORMAT_R32G32B32A32_SFLOAT;
+	default:
+		return p_srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+OgEngine::TEXTURE_FORMAT OgEngine::Texture::RgbaFormat(const TEXTURE_FORMAT p_format)
+{
+	const TextureFormatInfo& info = FormatInfo(p_format);
+	return info.IsCompressed() ? p_format : FormatOf(4u, info.channelBytes);
+}
+
+const std::vector<OgEngine::MipLevel>& OgEngine::Texture::Levels() const
+{
+	return m_levels;
+}
+
+uint64_t OgEngine::Texture::CpuBytes() const
+{
+	return m_pixels ? m_imageSize : 0u;
+}
+
+const OgEngine::TextureSource& OgEngine::Texture::Source() const
+{
+	return m_source;
+}
+
 OgEngine::Texture& OgEngine::Texture::operator=(const Texture & p_other)
 {
 	if (&p_other == this)
@@ -74,6 +301,9 @@ OgEngine::Texture& OgEngine::Texture::operator=(const Texture & p_other)
 	m_width = p_other.m_width;
 	m_height = p_other.m_height;
 	m_mipmapLevels = p_other.m_mipmapLevels;
+	m_format = p_other.m_format;
+	m_levels = p_other.m_levels;
+	m_source = p_other.m_source;
 
 	return *this;
 }
@@ -86,6 +316,9 @@ OgEngine::Texture& OgEngine::Texture::operator=(Texture && p_other) noexcept
 	m_width = p_other.m_width;
 	m_height = p_other.m_height;
 	m_mipmapLevels = p_other.m_mipmapLevels;
+	m_format = p_other.m_format;
+	m_levels = p_other.m_levels;
+	m_source = p_other.m_source;
 
 	return *this;
 }
@@ -96,14 +329,29 @@ OgEngine::Texture::~Texture()
 }
 
 void OgEngine::Texture::FillData(stbi_uc * p_pixels, const uint32_t p_width, const uint32_t p_height,
-	const uint32_t p_mipmapLevels)
+	const uint32_t p_mipmapLevels, const TEXTURE_FORMAT p_format)
 {
 	m_pixels = p_pixels;
 	m_width = p_width;
 	m_height = p_height;
 	m_mipmapLevels = p_mipmapLevels;
 
-	m_imageSize = m_width * m_height * 4u;
+	m_imageSize = static_cast<VkDeviceSize>(m_width) * m_height * FormatInfo(p_format).PixelBytes();
+	m_format = p_format;
+	m_levels = { MipLevel{ 0u, m_imageSize, m_width, m_height } };
+}
+
+void OgEngine::Texture::FillData(stbi_uc* p_data, const uint32_t p_width, const uint32_t p_height, const TEXTURE_FORMAT p_format,
+	std::vector<MipLevel> p_levels)
+{
+	m_pixels = p_data;
+	m_width = p_width;
+	m_height = p_height;
+	m_format = p_format;
+	m_levels = std::move(p_levels);
+	m_mipmapLevels = static_cast<uint32_t>(m_levels.size());
+
+	m_imageSize = m_levels.empty() ? 0u : m_levels.back().offset + m_levels.back().size;
 }
 
 void OgEngine::Texture::FillData(const std::shared_ptr<Texture> & p_other)
@@ -115,5 +363,8 @@ void OgEngine::Texture::FillData(const std::shared_ptr<Texture> & p_other)
 		m_width = p_other->m_width;
 		m_height = p_other->m_height;
 		m_mipmapLevels = p_other->m_mipmapLevels;
+		m_format = p_other->m_format;
+		m_levels = p_other->m_levels;
+		m_source = p_other->m_source;
 	}
 }
@@ -0,0 +1,301 @@
+#include <OgRendering/Utils/FileWatcher.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Longest time the thread sleeps without checking if it must stop
+	constexpr std::chrono::milliseconds WAKE_UP_PERIOD{ 50 };
+
+	/**
+	 * @brief Files that changed, with the time of their last change.
+	 */
+	using PendingFiles = std::unordered_map<std::string, Clock::time_point>;
+
+	std::string Join(const std::string& p_directory, const std::string& p_name)
+	{
+		return p_directory + '/' + p_name;
+	}
+
+	Clock::time_point LastChange(const PendingFiles& p_pending)
+	{
+		Clock::time_point lastChange;
+		for (const auto& [file, time] : p_pending)
+			lastChange = std::max(lastChange, time);
+
+		return lastChange;
+	}
+
+	/**
+	 * @brief Take all the pending files once none of them changed for the debounce time, so a burst of changes is one batch.
+	 * @return The files, sorted
+	 */
+	std::vector<std::string> TakeSettled(PendingFiles& p_pending, const std::chrono::milliseconds p_debounce)
+	{
+		std::vector<std::string> settled;
+		if (p_pending.empty() || Clock::now() - LastChange(p_pending) < p_debounce)
+			return settled;
+
+		settled.reserve(p_pending.size());
+		for (const auto& [file, time] : p_pending)
+			settled.emplace_back(file);
+		p_pending.clear();
+
+		std::sort(settled.begin(), settled.end());
+		return settled;
+	}
+
+	/**
+	 * @brief Time until the pending files settle, at most WAKE_UP_PERIOD.
+	 */
+	std::chrono::milliseconds NextWakeUp(const PendingFiles& p_pending, const std::chrono::milliseconds p_debounce)
+	{
+		if (p_pending.empty())
+			return WAKE_UP_PERIOD;
+
+		const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(LastChange(p_pending) + p_debounce - Clock::now());
+		return std::min(WAKE_UP_PERIOD, std::max(remaining, std::chrono::milliseconds(0)));
+	}
+
+#ifdef __linux__
+	constexpr uint32_t WATCHED_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+	/**
+	 * @brief Watch a directory and its subdirectories.
+	 * @param p_pending If given, the files already in the directories are added to it, for a directory created after the watch started
+	 */
+	void AddWatches(const int p_notifier, const std::string& p_directory, std::unordered_map<int, std::string>& p_watches, PendingFiles* p_pending)
+	{
+		const int root = inotify_add_watch(p_notifier, p_directory.c_str(), WATCHED_EVENTS);
+		if (root < 0)
+			return;
+
+		p_watches[root] = p_directory;
+
+		std::error_code error;
+		for (auto entry = std::filesystem::recursive_directory_iterator(p_directory, std::filesystem::directory_options::skip_permission_denied, error);
+			!error && entry != std::filesystem::recursive_directory_iterator(); entry.increment(error))
+		{
+			const std::string path = entry->path().generic_string();
+			if (entry->is_directory(error))
+			{
+				const int watch = inotify_add_watch(p_notifier, path.c_str(), WATCHED_EVENTS);
+				if (watch >= 0)
+					p_watches[watch] = path;
+			}
+			else if (p_pending && entry->is_regular_file(error))
+			{
+				(*p_pending)[path] = Clock::now();
+			}
+		}
+	}
+#else
+	// Time between two scans of the directory
+	constexpr std::chrono::milliseconds SCAN_PERIOD{ 250 };
+
+	struct FileStamp
+	{
+		std::filesystem::file_time_type writeTime;
+		uintmax_t size;
+
+		bool operator==(const FileStamp& p_other) const { return writeTime == p_other.writeTime && size == p_other.size; }
+	};
+
+	using Snapshot = std::unordered_map<std::string, FileStamp>;
+
+	Snapshot Scan(const std::string& p_directory)
+	{
+		Snapshot snapshot;
+		std::error_code error;
+		for (auto entry = std::filesystem::recursive_directory_iterator(p_directory, std::filesystem::directory_options::skip_permission_denied, error);
+			!error && entry != std::filesystem::recursive_directory_iterator(); entry.increment(error))
+		{
+			std::error_code fileError;
+			if (!entry->is_regular_file(fileError))
+				continue;
+
+			const FileStamp stamp{ entry->last_write_time(fileError), entry->file_size(fileError) };
+			if (!fileError)
+				snapshot.emplace(entry->path().generic_string(), stamp);
+		}
+
+		return snapshot;
+	}
+#endif
+}
+
+OgEngine::Utils::FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+bool OgEngine::Utils::FileWatcher::Start(std::string_view p_directory, Callback p_callback, const std::chrono::milliseconds p_debounce)
+{
+	Stop();
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(p_directory, error))
+	{
+		std::cerr << "FileWatcher error: " << p_directory << " is not a directory.\n";
+		return false;
+	}
+
+	m_directory = std::filesystem::path(p_directory).generic_string();
+	while (m_directory.size() > 1u && m_directory.back() == '/')
+		m_directory.pop_back();
+
+	m_callback = std::move(p_callback);
+	m_debounce = p_debounce;
+
+#ifdef __linux__
+	m_notifier = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_notifier < 0)
+	{
+		std::cerr << "FileWatcher error: inotify is unavailable, " << m_directory << " is not watched.\n";
+		return false;
+	}
+
+	// The subdirectories are watched by the thread, a single watch is enough to know the directory can be watched
+	if (inotify_add_watch(m_notifier, m_directory.c_str(), WATCHED_EVENTS) < 0)
+	{
+		std::cerr << "FileWatcher error: couldn't watch " << m_directory << ".\n";
+		close(m_notifier);
+		m_notifier = -1;
+		return false;
+	}
+#endif
+
+	m_running.store(true);
+	std::promise<void> ready;
+	std::future<void> isReady = ready.get_future();
+	m_thread = std::thread(&FileWatcher::Run, this, std::move(ready));
+	isReady.wait();
+	return true;
+}
+
+void OgEngine::Utils::FileWatcher::Stop()
+{
+	m_running.store(false);
+	if (m_thread.joinable())
+		m_thread.join();
+
+#ifdef __linux__
+	if (m_notifier >= 0)
+	{
+		close(m_notifier);
+		m_notifier = -1;
+	}
+#endif
+}
+
+bool OgEngine::Utils::FileWatcher::IsWatching() const
+{
+	return m_running.load();
+}
+
+void OgEngine::Utils::FileWatcher::Run(std::promise<void> p_ready)
+{
+	PendingFiles pending;
+
+#ifdef __linux__
+	std::unordered_map<int, std::string> watches;
+	AddWatches(m_notifier, m_directory, watches, nullptr);
+
+	alignas(inotify_event) char buffer[16u * 1024u];
+#else
+	Snapshot snapshot = Scan(m_directory);
+	Clock::time_point lastScan = Clock::now();
+#endif
+
+	p_ready.set_value();
+
+	while (m_running.load())
+	{
+		const std::chrono::milliseconds wait = NextWakeUp(pending, m_debounce);
+
+#ifdef __linux__
+		pollfd notifier{ m_notifier, POLLIN, 0 };
+		if (poll(&notifier, 1, static_cast<int>(wait.count())) > 0 && (notifier.revents & POLLIN))
+		{
+			ssize_t length;
+			while ((length = read(m_notifier, buffer, sizeof(buffer))) > 0)
+			{
+				for (ssize_t offset = 0; offset < length;)
+				{
+					const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+					offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						std::cerr << "FileWatcher warning: too many changes at once in " << m_directory << ", some of them are missed.\n";
+						continue;
+					}
+
+					if (event->mask & IN_IGNORED)
+					{
+						watches.erase(event->wd);
+						continue;
+					}
+
+					const auto directory = watches.find(event->wd);
+					if (directory == watches.end() || event->len == 0u)
+						continue;
+
+					const std::string path = Join(directory->second, event->name);
+					if (event->mask & IN_ISDIR)
+					{
+						// The files written before the directory is watched are reported with it
+						if (event->mask & (IN_CREATE | IN_MOVED_TO))
+							AddWatches(m_notifier, path, watches, &pending);
+					}
+					else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+					{
+						pending[path] = Clock::now();
+					}
+				}
+			}
+		}
+#else
+		std::this_thread::sleep_for(wait);
+		if (Clock::now() - lastScan >= SCAN_PERIOD)
+		{
+			Snapshot current = Scan(m_directory);
+			for (const auto& [file, stamp] : current)
+			{
+				const auto previous = snapshot.find(file);
+				if (previous == snapshot.end() || !(previous->second == stamp))
+					pending[file] = Clock::now();
+			}
+
+			snapshot = std::move(current);
+			lastScan = Clock::now();
+		}
+#endif
+
+		const std::vector<std::string> settled = TakeSettled(pending, m_debounce);
+		if (settled.empty() || !m_callback)
+			continue;
+
+		try
+		{
+			m_callback(settled);
+		}
+		catch (const std::exception& p_exception)
+		{
+			std::cerr << "FileWatcher error: " << p_exception.what() << '\n';
+		}
+	}
+}
@@ -0,0 +1,360 @@
+#include <OgRendering/Utils/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+struct OgEngine::Utils::Task
+{
+	std::function<void()> job;
+	std::atomic<bool> done{ false };
+
+	std::atomic<OgEngine::Utils::JOB_PRIORITY> priority{ OgEngine::Utils::JOB_PRIORITY::NORMAL };
+	// Set by the thread that runs or cancels the job, a job prioritized is queued twice and the entry taken last is skipped
+	std::atomic<bool> claimed{ false };
+	// False for a continuation until the job it follows is done
+	std::atomic<bool> queued{ false };
+
+	// Guards the continuations, so none is added once the job is done
+	std::mutex mutex;
+	bool finished{ false };
+	std::vector<std::shared_ptr<Task>> continuations;
+};
+
+namespace
+{
+	// Pool and queue of the worker running on this thread, nullptr outside the workers
+	thread_local OgEngine::Utils::JobSystem* t_system = nullptr;
+	thread_local uint32_t t_workerIndex = 0u;
+}
+
+OgEngine::Utils::TaskHandle::TaskHandle(JobSystem* p_system, std::shared_ptr<Task> p_task)
+	: m_system(p_system), m_task(std::move(p_task))
+{
+}
+
+bool OgEngine::Utils::TaskHandle::IsValid() const
+{
+	return m_task != nullptr;
+}
+
+bool OgEngine::Utils::TaskHandle::IsDone() const
+{
+	return !m_task || m_task->done.load(std::memory_order_acquire);
+}
+
+void OgEngine::Utils::TaskHandle::Wait() const
+{
+	if (m_task)
+		m_system->Wait(m_task);
+}
+
+OgEngine::Utils::TaskHandle OgEngine::Utils::TaskHandle::Then(std::function<void()> p_continuation) const
+{
+	if (!m_task)
+		return JobSystem::Instance().Submit(std::move(p_continuation));
+
+	return m_system->Then(m_task, std::move(p_continuation));
+}
+
+bool OgEngine::Utils::TaskHandle::Prioritize(const JOB_PRIORITY p_priority) const
+{
+	return m_task && m_system->Prioritize(m_task, p_priority);
+}
+
+bool OgEngine::Utils::TaskHandle::Cancel() const
+{
+	return m_task && m_system->Cancel(m_task);
+}
+
+OgEngine::Utils::JobSystem::JobSystem(const uint32_t p_workerCount)
+{
+	// The thread submitting the jobs usually waits for them and runs some meanwhile, it counts as a worker
+	const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+	const uint32_t workerCount = p_workerCount != 0u ? p_workerCount : std::max(hardwareThreads, 2u) - 1u;
+
+	m_queues.reserve(workerCount);
+	for (uint32_t i = 0u; i < workerCount; ++i)
+		m_queues.emplace_back(std::make_unique<WorkQueue>());
+
+	m_workers.reserve(workerCount);
+	for (uint32_t i = 0u; i < workerCount; ++i)
+		m_workers.emplace_back(&JobSystem::Work, this, i);
+}
+
+OgEngine::Utils::JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_quit = true;
+	}
+	m_wakeUp.notify_all();
+
+	for (auto& worker : m_workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+}
+
+OgEngine::Utils::JobSystem& OgEngine::Utils::JobSystem::Instance()
+{
+	static JobSystem instance;
+	return instance;
+}
+
+OgEngine::Utils::TaskHandle OgEngine::Utils::JobSystem::Submit(std::function<void()> p_job)
+{
+	return Submit(JOB_PRIORITY::NORMAL, std::move(p_job));
+}
+
+OgEngine::Utils::TaskHandle OgEngine::Utils::JobSystem::Submit(const JOB_PRIORITY p_priority, std::function<void()> p_job)
+{
+	auto task = std::make_shared<Task>();
+	task->job = std::move(p_job);
+	task->priority.store(p_priority);
+	Push(task);
+
+	return TaskHandle(this, std::move(task));
+}
+
+void OgEngine::Utils::JobSystem::ParallelForRange(const uint64_t p_begin, const uint64_t p_end, const std::function<void(uint64_t, uint64_t)>& p_body, const uint64_t p_grain)
+{
+	if (p_end <= p_begin)
+		return;
+
+	const uint64_t count = p_end - p_begin;
+	// A few chunks per thread, so a thread finishing early steals the remaining ones
+	const uint64_t chunkTarget = (static_cast<uint64_t>(WorkerCount()) + 1u) * 4u;
+	const uint64_t grain = p_grain != 0u ? p_grain : std::max<uint64_t>((count + chunkTarget - 1u) / chunkTarget, 1u);
+
+	std::vector<TaskHandle> tasks;
+	tasks.reserve(count / grain + 1u);
+	for (uint64_t first = p_begin + grain; first < p_end; first += grain)
+	{
+		const uint64_t last = std::min(first + grain, p_end);
+		tasks.emplace_back(Submit([&p_body, first, last]() { p_body(first, last); }));
+	}
+
+	p_body(p_begin, std::min(p_begin + grain, p_end));
+	WaitForAll(tasks);
+}
+
+void OgEngine::Utils::JobSystem::WaitForAll(const std::vector<TaskHandle>& p_tasks)
+{
+	for (const auto& task : p_tasks)
+		task.Wait();
+}
+
+uint32_t OgEngine::Utils::JobSystem::WorkerCount() const
+{
+	return static_cast<uint32_t>(m_queues.size());
+}
+
+void OgEngine::Utils::JobSystem::Work(const uint32_t p_index)
+{
+	t_system = this;
+	t_workerIndex = p_index;
+
+	while (true)
+	{
+		if (RunOne())
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		// The queued jobs are run before quitting, their handles may be waited on
+		if (m_quit && m_queuedCount.load() == 0u)
+			break;
+
+		m_wakeUp.wait(lock, [this]() { return m_quit || m_queuedCount.load() != 0u; });
+	}
+}
+
+void OgEngine::Utils::JobSystem::Push(std::shared_ptr<Task> p_task)
+{
+	p_task->queued.store(true);
+	const JOB_PRIORITY priority = p_task->priority.load();
+	WorkQueue& queue = t_system == this && priority == JOB_PRIORITY::NORMAL
+		? *m_queues[t_workerIndex] : m_sharedQueues[static_cast<size_t>(priority)];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.emplace_back(std::move(p_task));
+	}
+	m_queuedCount.fetch_add(1u);
+
+	// Taking the lock orders the increment with a worker checking the count before sleeping
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_wakeUp.notify_one();
+}
+
+std::shared_ptr<OgEngine::Utils::Task> OgEngine::Utils::JobSystem::Take()
+{
+	if (m_queuedCount.load() == 0u)
+		return nullptr;
+
+	const auto takeFrom = [this](WorkQueue& p_queue, const bool p_back) -> std::shared_ptr<Task>
+	{
+		std::lock_guard<std::mutex> lock(p_queue.mutex);
+		while (!p_queue.tasks.empty())
+		{
+			std::shared_ptr<Task> task;
+			if (p_back)
+			{
+				task = std::move(p_queue.tasks.back());
+				p_queue.tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(p_queue.tasks.front());
+				p_queue.tasks.pop_front();
+			}
+			m_queuedCount.fetch_sub(1u);
+
+			// Skip the jobs cancelled or already taken from the queue of their new priority
+			if (!task->claimed.exchange(true))
+				return task;
+		}
+
+		return nullptr;
+	};
+
+	const bool isWorker = t_system == this;
+	if (isWorker)
+	{
+		if (auto task = takeFrom(*m_queues[t_workerIndex], true))
+			return task;
+	}
+
+	if (auto task = takeFrom(m_sharedQueues[static_cast<size_t>(JOB_PRIORITY::HIGH)], false))
+		return task;
+
+	if (auto task = takeFrom(m_sharedQueues[static_cast<size_t>(JOB_PRIORITY::NORMAL)], false))
+		return task;
+
+	// Steal the oldest job of another worker, starting with the next one so the thieves spread out
+	const auto queueCount = static_cast<uint32_t>(m_queues.size());
+	const uint32_t start = isWorker ? t_workerIndex + 1u : 0u;
+	for (uint32_t i = 0u; i < queueCount; ++i)
+	{
+		const uint32_t victim = (start + i) % queueCount;
+		if (isWorker && victim == t_workerIndex)
+			continue;
+
+		if (auto task = takeFrom(*m_queues[victim], false))
+			return task;
+	}
+
+	return takeFrom(m_sharedQueues[static_cast<size_t>(JOB_PRIORITY::LOW)], false);
+}
+
+bool OgEngine::Utils::JobSystem::RunOne()
+{
+	const std::shared_ptr<Task> task = Take();
+	if (!task)
+		return false;
+
+	Execute(task);
+	return true;
+}
+
+void OgEngine::Utils::JobSystem::Execute(const std::shared_ptr<Task>& p_task)
+{
+	try
+	{
+		p_task->job();
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "A job threw an exception: " << p_exception.what() << '\n';
+	}
+	catch (...)
+	{
+		std::cerr << "A job threw an unknown exception.\n";
+	}
+	// Release what the job captured as soon as it has run
+	p_task->job = nullptr;
+
+	Finish(p_task);
+}
+
+void OgEngine::Utils::JobSystem::Finish(const std::shared_ptr<Task>& p_task)
+{
+	std::vector<std::shared_ptr<Task>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(p_task->mutex);
+		p_task->finished = true;
+		p_task->done.store(true, std::memory_order_release);
+		continuations.swap(p_task->continuations);
+	}
+
+	for (auto& continuation : continuations)
+		Push(std::move(continuation));
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_taskDone.notify_all();
+}
+
+void OgEngine::Utils::JobSystem::Wait(const std::shared_ptr<Task>& p_task)
+{
+	while (!p_task->done.load(std::memory_order_acquire))
+	{
+		if (RunOne())
+			continue;
+
+		// Nothing to run, the job is running on another thread (the timeout catches jobs queued meanwhile)
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_taskDone.wait_for(lock, std::chrono::milliseconds(1), [&p_task]() { return p_task->done.load(std::memory_order_acquire); });
+	}
+}
+
+OgEngine::Utils::TaskHandle OgEngine::Utils::JobSystem::Then(const std::shared_ptr<Task>& p_task, std::function<void()> p_continuation)
+{
+	auto continuation = std::make_shared<Task>();
+	continuation->job = std::move(p_continuation);
+	continuation->priority.store(p_task->priority.load());
+
+	{
+		std::lock_guard<std::mutex> lock(p_task->mutex);
+		if (!p_task->finished)
+		{
+			p_task->continuations.emplace_back(continuation);
+			return TaskHandle(this, std::move(continuation));
+		}
+	}
+
+	Push(continuation);
+	return TaskHandle(this, std::move(continuation));
+}
+
+bool OgEngine::Utils::JobSystem::Prioritize(const std::shared_ptr<Task>& p_task, const JOB_PRIORITY p_priority)
+{
+	if (p_task->claimed.load())
+		return false;
+
+	JOB_PRIORITY current = p_task->priority.load();
+	do
+	{
+		if (p_priority >= current)
+			return true;
+	} while (!p_task->priority.compare_exchange_weak(current, p_priority));
+
+	// Queued again rather than searched for, the entry left in the queue of the previous priority is skipped once this one is taken.
+	// A continuation not queued yet is queued with its new priority when the job it follows is done.
+	if (p_task->queued.load())
+		Push(p_task);
+	return true;
+}
+
+bool OgEngine::Utils::JobSystem::Cancel(const std::shared_ptr<Task>& p_task)
+{
+	if (p_task->claimed.exchange(true))
+		return false;
+
+	// The entry stays queued until a worker skips it, what the job captured is released now
+	p_task->job = nullptr;
+	Finish(p_task);
+	return true;
+}
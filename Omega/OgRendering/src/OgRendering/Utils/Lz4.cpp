@@ -0,0 +1,186 @@
+#include <OgRendering/Utils/Lz4.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	// The rules of the LZ4 block format
+	constexpr size_t MIN_MATCH = 4u;
+	constexpr size_t LAST_LITERALS = 5u;
+	constexpr size_t MATCH_FIND_LIMIT = 12u;
+	constexpr size_t MAX_OFFSET = 65535u;
+	constexpr uint32_t HASH_BITS = 14u;
+
+	uint32_t Read32(const uint8_t* p_data)
+	{
+		uint32_t value;
+		std::memcpy(&value, p_data, sizeof(value));
+		return value;
+	}
+
+	uint32_t Hash(const uint32_t p_sequence)
+	{
+		return (p_sequence * 2654435761u) >> (32u - HASH_BITS);
+	}
+
+	/**
+	 * @brief Write the part of a length that doesn't fit in its 4 bits of the token.
+	 */
+	void WriteLength(std::vector<uint8_t>& p_output, size_t p_length)
+	{
+		for (; p_length >= 255u; p_length -= 255u)
+			p_output.push_back(255u);
+
+		p_output.push_back(static_cast<uint8_t>(p_length));
+	}
+
+	bool ReadLength(const uint8_t* p_source, const size_t p_sourceSize, size_t& p_position, size_t& p_length)
+	{
+		uint8_t value;
+		do
+		{
+			if (p_position >= p_sourceSize)
+				return false;
+
+			value = p_source[p_position++];
+			p_length += value;
+		} while (value == 255u);
+
+		return true;
+	}
+
+	/**
+	 * @brief Write a sequence: the literals since the last match, then the match, the last sequence of a block has no match.
+	 */
+	void WriteSequence(std::vector<uint8_t>& p_output, const uint8_t* p_literals, const size_t p_literalCount, const size_t p_offset,
+		const size_t p_matchLength)
+	{
+		const size_t token = p_output.size();
+		p_output.push_back(static_cast<uint8_t>(std::min<size_t>(p_literalCount, 15u) << 4u));
+		if (p_literalCount >= 15u)
+			WriteLength(p_output, p_literalCount - 15u);
+
+		p_output.insert(p_output.end(), p_literals, p_literals + p_literalCount);
+		if (p_matchLength == 0u)
+			return;
+
+		p_output.push_back(static_cast<uint8_t>(p_offset & 0xffu));
+		p_output.push_back(static_cast<uint8_t>(p_offset >> 8u));
+
+		const size_t matchLength = p_matchLength - MIN_MATCH;
+		p_output[token] |= static_cast<uint8_t>(std::min<size_t>(matchLength, 15u));
+		if (matchLength >= 15u)
+			WriteLength(p_output, matchLength - 15u);
+	}
+}
+
+size_t OgEngine::Utils::Lz4::Bound(const size_t p_size)
+{
+	return p_size + p_size / 255u + 16u;
+}
+
+std::vector<uint8_t> OgEngine::Utils::Lz4::Compress(const uint8_t* p_data, const size_t p_size)
+{
+	std::vector<uint8_t> output;
+	output.reserve(Bound(p_size));
+
+	size_t anchor = 0u;
+	if (p_size > MATCH_FIND_LIMIT)
+	{
+		// Position + 1 of the last occurrence of each hashed sequence, 0 when there is none
+		std::vector<size_t> table(size_t{ 1u } << HASH_BITS, 0u);
+		const size_t matchLimit = p_size - LAST_LITERALS;
+		const size_t findLimit = p_size - MATCH_FIND_LIMIT;
+
+		size_t position = 0u;
+		while (position <= findLimit)
+		{
+			const uint32_t sequence = Read32(p_data + position);
+			size_t& last = table[Hash(sequence)];
+			const size_t candidate = last;
+			last = position + 1u;
+
+			if (candidate == 0u || position - (candidate - 1u) > MAX_OFFSET || Read32(p_data + candidate - 1u) != sequence)
+			{
+				// The data that doesn't repeat is crossed faster and faster
+				position += 1u + ((position - anchor) >> 6u);
+				continue;
+			}
+
+			size_t match = candidate - 1u;
+			while (position > anchor && match > 0u && p_data[position - 1u] == p_data[match - 1u])
+			{
+				--position;
+				--match;
+			}
+
+			size_t length = MIN_MATCH;
+			while (position + length < matchLimit && p_data[position + length] == p_data[match + length])
+				++length;
+
+			WriteSequence(output, p_data + anchor, position - anchor, position - match, length);
+			position += length;
+			anchor = position;
+		}
+	}
+
+	WriteSequence(output, p_data + anchor, p_size - anchor, 0u, 0u);
+	return output;
+}
+
+bool OgEngine::Utils::Lz4::Decompress(const uint8_t* p_source, const size_t p_sourceSize, uint8_t* p_destination,
+	const size_t p_destinationSize)
+{
+	size_t source = 0u, destination = 0u;
+	while (source < p_sourceSize)
+	{
+		const uint8_t token = p_source[source++];
+
+		size_t literalCount = token >> 4u;
+		if (literalCount == 15u && !ReadLength(p_source, p_sourceSize, source, literalCount))
+			return false;
+
+		if (literalCount > p_sourceSize - source || literalCount > p_destinationSize - destination)
+			return false;
+
+		if (literalCount > 0u)
+			std::memcpy(p_destination + destination, p_source + source, literalCount);
+
+		source += literalCount;
+		destination += literalCount;
+
+		// Only the last sequence ends without a match
+		if (source == p_sourceSize)
+			return destination == p_destinationSize;
+
+		if (p_sourceSize - source < 2u)
+			return false;
+
+		const size_t offset = p_source[source] | static_cast<size_t>(p_source[source + 1u]) << 8u;
+		source += 2u;
+		if (offset == 0u || offset > destination)
+			return false;
+
+		size_t length = token & 0xfu;
+		if (length == 15u && !ReadLength(p_source, p_sourceSize, source, length))
+			return false;
+
+		length += MIN_MATCH;
+		if (length > p_destinationSize - destination)
+			return false;
+
+		// A match closer than its length repeats the bytes it is writing, it is copied byte after byte
+		uint8_t* output = p_destination + destination;
+		const uint8_t* input = output - offset;
+		if (offset >= length)
+			std::memcpy(output, input, length);
+		else
+			for (size_t i = 0u; i < length; ++i)
+				output[i] = input[i];
+
+		destination += length;
+	}
+
+	return false;
+}
@@ -0,0 +1,174 @@
+#include <OgRendering/Utils/MappedFile.h>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	uint64_t Mix(uint64_t p_value)
+	{
+		p_value ^= p_value >> 33u;
+		p_value *= 0xff51afd7ed558ccdull;
+		p_value ^= p_value >> 33u;
+		p_value *= 0xc4ceb9fe1a85ec53ull;
+		p_value ^= p_value >> 33u;
+		return p_value;
+	}
+}
+
+OgEngine::Utils::MappedFile::MappedFile(std::string_view p_file)
+{
+	const std::string file(p_file);
+
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(handle);
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		CloseHandle(handle);
+		return;
+	}
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(handle);
+		return;
+	}
+
+	m_file = handle;
+	m_mapping = mapping;
+	m_data = static_cast<const uint8_t*>(view);
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	const int descriptor = open(file.c_str(), O_RDONLY);
+	if (descriptor < 0)
+		return;
+
+	struct stat status {};
+	if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+	{
+		close(descriptor);
+		return;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+	// The mapping stays valid once the descriptor is closed
+	close(descriptor);
+	if (view == MAP_FAILED)
+		return;
+
+	m_data = static_cast<const uint8_t*>(view);
+	m_size = static_cast<size_t>(status.st_size);
+#endif
+}
+
+OgEngine::Utils::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+OgEngine::Utils::MappedFile::MappedFile(MappedFile&& p_other) noexcept
+{
+	*this = std::move(p_other);
+}
+
+OgEngine::Utils::MappedFile& OgEngine::Utils::MappedFile::operator=(MappedFile&& p_other) noexcept
+{
+	if (&p_other == this)
+		return *this;
+
+	Close();
+	std::swap(m_data, p_other.m_data);
+	std::swap(m_size, p_other.m_size);
+#ifdef _WIN32
+	std::swap(m_file, p_other.m_file);
+	std::swap(m_mapping, p_other.m_mapping);
+#endif
+
+	return *this;
+}
+
+bool OgEngine::Utils::MappedFile::IsOpen() const
+{
+	return m_data != nullptr;
+}
+
+const uint8_t* OgEngine::Utils::MappedFile::Data() const
+{
+	return m_data;
+}
+
+size_t OgEngine::Utils::MappedFile::Size() const
+{
+	return m_size;
+}
+
+uint64_t OgEngine::Utils::MappedFile::ContentHash() const
+{
+	if (!m_data)
+		return 0u;
+
+	return HashBytes(m_data, m_size);
+}
+
+uint64_t OgEngine::Utils::MappedFile::HashBytes(const uint8_t* p_data, const size_t p_size)
+{
+	// Eight bytes at a time, the source files can weigh hundreds of megabytes
+	uint64_t hash = Mix(p_size ^ 0x9e3779b97f4a7c15ull);
+
+	size_t offset = 0u;
+	for (; offset + sizeof(uint64_t) <= p_size; offset += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, p_data + offset, sizeof(word));
+		hash = (hash ^ Mix(word)) * 0x100000001b3ull;
+	}
+
+	uint64_t tail = 0u;
+	std::memcpy(&tail, p_data + offset, p_size - offset);
+	hash = Mix(hash ^ tail);
+
+	// 0 means that the file couldn't be read
+	return hash != 0u ? hash : 1u;
+}
+
+void OgEngine::Utils::MappedFile::Close()
+{
+	if (!m_data)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping);
+	CloseHandle(m_file);
+	m_file = nullptr;
+	m_mapping = nullptr;
+#else
+	munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0u;
+}
@@ -0,0 +1,424 @@
+#include <OgRendering/Utils/MeshOptimizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+	using OgEngine::Utils::MeshOptimizer;
+
+	constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	// The scoring of "Linear-Speed Vertex Cache Optimisation", Tom Forsyth
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+	constexpr uint32_t VALENCE_TABLE_SIZE = 32u;
+
+	struct ScoreTables
+	{
+		std::array<float, MeshOptimizer::CACHE_SIZE> cache{};
+		std::array<float, VALENCE_TABLE_SIZE> valence{};
+	};
+
+	const ScoreTables& Scores()
+	{
+		static const ScoreTables tables = []()
+		{
+			ScoreTables values;
+			for (uint32_t position = 0u; position < MeshOptimizer::CACHE_SIZE; ++position)
+			{
+				// The vertices of the last triangle get a fixed score, so it isn't simply repeated
+				if (position < 3u)
+					values.cache[position] = LAST_TRIANGLE_SCORE;
+				else
+					values.cache[position] = std::pow(1.0f - static_cast<float>(position - 3u) / static_cast<float>(MeshOptimizer::CACHE_SIZE - 3u),
+						CACHE_DECAY_POWER);
+			}
+
+			for (uint32_t triangles = 1u; triangles < VALENCE_TABLE_SIZE; ++triangles)
+				values.valence[triangles] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(triangles), -VALENCE_BOOST_POWER);
+
+			return values;
+		}();
+
+		return tables;
+	}
+
+	/**
+	 * @brief Score of a vertex, higher when it is in the cache or when few triangles still use it.
+	 */
+	float VertexScore(const uint32_t p_cachePosition, const uint32_t p_liveTriangles)
+	{
+		if (p_liveTriangles == 0u)
+			return -1.0f;
+
+		const ScoreTables& scores = Scores();
+		float score = p_cachePosition < MeshOptimizer::CACHE_SIZE ? scores.cache[p_cachePosition] : 0.0f;
+		score += p_liveTriangles < VALENCE_TABLE_SIZE ? scores.valence[p_liveTriangles]
+			: VALENCE_BOOST_SCALE * std::pow(static_cast<float>(p_liveTriangles), -VALENCE_BOOST_POWER);
+
+		return score;
+	}
+
+	struct Float3
+	{
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+	};
+
+	Float3 Position(const OgEngine::Vertex& p_vertex)
+	{
+		return { p_vertex.position.x, p_vertex.position.y, p_vertex.position.z };
+	}
+}
+
+OgEngine::Utils::CacheStatistics OgEngine::Utils::MeshOptimizer::Analyze(const std::vector<uint32_t>& p_indices, const size_t p_vertexCount,
+	const uint32_t p_cacheSize)
+{
+	CacheStatistics statistics;
+	if (p_indices.size() < 3u || p_vertexCount == 0u || p_cacheSize == 0u)
+		return statistics;
+
+	// Time at which each vertex entered the FIFO, it is still there while fewer than p_cacheSize misses followed
+	std::vector<uint64_t> insertedAt(p_vertexCount, std::numeric_limits<uint64_t>::max());
+	std::vector<bool> referenced(p_vertexCount, false);
+	uint64_t misses = 0u;
+	size_t uniqueVertices = 0u;
+
+	for (const uint32_t index : p_indices)
+	{
+		if (index >= p_vertexCount)
+			continue;
+
+		if (!referenced[index])
+		{
+			referenced[index] = true;
+			++uniqueVertices;
+		}
+
+		if (insertedAt[index] == std::numeric_limits<uint64_t>::max() || misses - insertedAt[index] >= p_cacheSize)
+		{
+			insertedAt[index] = misses;
+			++misses;
+		}
+	}
+
+	statistics.acmr = static_cast<float>(misses) / static_cast<float>(p_indices.size() / 3u);
+	statistics.atvr = uniqueVertices > 0u ? static_cast<float>(misses) / static_cast<float>(uniqueVertices) : 0.0f;
+
+	return statistics;
+}
+
+void OgEngine::Utils::MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& p_indices, const size_t p_vertexCount)
+{
+	const size_t triangleCount = p_indices.size() / 3u;
+	if (triangleCount < 2u || p_vertexCount == 0u)
+		return;
+
+	if (std::any_of(p_indices.begin(), p_indices.end(), [p_vertexCount](const uint32_t p_index) { return p_index >= p_vertexCount; }))
+		return;
+
+	// Triangles of each vertex, the ones already emitted are moved past liveTriangles
+	std::vector<uint32_t> liveTriangles(p_vertexCount, 0u);
+	for (size_t i = 0u; i < triangleCount * 3u; ++i)
+		++liveTriangles[p_indices[i]];
+
+	std::vector<uint32_t> adjacencyOffsets(p_vertexCount + 1u, 0u);
+	std::partial_sum(liveTriangles.begin(), liveTriangles.end(), adjacencyOffsets.begin() + 1);
+
+	std::vector<uint32_t> adjacency(triangleCount * 3u);
+	{
+		std::vector<uint32_t> filled(p_vertexCount, 0u);
+		for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+		{
+			for (size_t corner = 0u; corner < 3u; ++corner)
+			{
+				const uint32_t vertex = p_indices[triangle * 3u + corner];
+				adjacency[adjacencyOffsets[vertex] + filled[vertex]++] = static_cast<uint32_t>(triangle);
+			}
+		}
+	}
+
+	std::vector<uint32_t> cachePositions(p_vertexCount, INVALID_INDEX);
+	std::vector<float> vertexScores(p_vertexCount);
+	for (size_t vertex = 0u; vertex < p_vertexCount; ++vertex)
+		vertexScores[vertex] = VertexScore(INVALID_INDEX, liveTriangles[vertex]);
+
+	std::vector<float> triangleScores(triangleCount);
+	for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+		triangleScores[triangle] = vertexScores[p_indices[triangle * 3u]] + vertexScores[p_indices[triangle * 3u + 1u]]
+			+ vertexScores[p_indices[triangle * 3u + 2u]];
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3u);
+
+	// The 3 vertices of the triangle emitted are pushed before the cache is trimmed
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(CACHE_SIZE + 3u);
+	nextCache.reserve(CACHE_SIZE + 3u);
+
+	size_t cursor = 0u;
+	uint32_t best = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+	while (output.size() < triangleCount * 3u)
+	{
+		// No triangle touches the cache anymore, the next one in the input order starts a new strip
+		if (best == INVALID_INDEX)
+		{
+			while (emitted[cursor])
+				++cursor;
+			best = static_cast<uint32_t>(cursor);
+		}
+
+		emitted[best] = true;
+		const uint32_t* triangleIndices = &p_indices[static_cast<size_t>(best) * 3u];
+
+		nextCache.clear();
+		for (uint32_t corner = 0u; corner < 3u; ++corner)
+		{
+			const uint32_t vertex = triangleIndices[corner];
+			output.push_back(vertex);
+			// A degenerate triangle uses a vertex twice, it takes a single entry of the cache
+			if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+				nextCache.push_back(vertex);
+
+			// The triangle leaves the live ones of its vertices
+			const uint32_t begin = adjacencyOffsets[vertex];
+			const uint32_t end = begin + liveTriangles[vertex];
+			const auto position = std::find(adjacency.begin() + begin, adjacency.begin() + end, best);
+			std::iter_swap(position, adjacency.begin() + end - 1u);
+			--liveTriangles[vertex];
+		}
+
+		for (const uint32_t vertex : cache)
+		{
+			if (vertex != triangleIndices[0] && vertex != triangleIndices[1] && vertex != triangleIndices[2])
+				nextCache.push_back(vertex);
+		}
+
+		// The vertices pushed out of the cache lose their cache score
+		for (size_t position = CACHE_SIZE; position < nextCache.size(); ++position)
+		{
+			const uint32_t vertex = nextCache[position];
+			cachePositions[vertex] = INVALID_INDEX;
+			vertexScores[vertex] = VertexScore(INVALID_INDEX, liveTriangles[vertex]);
+			for (uint32_t adjacent = adjacencyOffsets[vertex]; adjacent < adjacencyOffsets[vertex] + liveTriangles[vertex]; ++adjacent)
+			{
+				const uint32_t triangle = adjacency[adjacent];
+				triangleScores[triangle] = vertexScores[p_indices[triangle * 3u]] + vertexScores[p_indices[triangle * 3u + 1u]]
+					+ vertexScores[p_indices[triangle * 3u + 2u]];
+			}
+		}
+		nextCache.resize(std::min<size_t>(nextCache.size(), CACHE_SIZE));
+
+		for (size_t position = 0u; position < nextCache.size(); ++position)
+		{
+			const uint32_t vertex = nextCache[position];
+			cachePositions[vertex] = static_cast<uint32_t>(position);
+			vertexScores[vertex] = VertexScore(static_cast<uint32_t>(position), liveTriangles[vertex]);
+		}
+
+		// Only the triangles around the cache changed, the best next one is among them
+		best = INVALID_INDEX;
+		float bestScore = -1.0f;
+		for (const uint32_t vertex : nextCache)
+		{
+			for (uint32_t adjacent = adjacencyOffsets[vertex]; adjacent < adjacencyOffsets[vertex] + liveTriangles[vertex]; ++adjacent)
+			{
+				const uint32_t triangle = adjacency[adjacent];
+				const float score = vertexScores[p_indices[triangle * 3u]] + vertexScores[p_indices[triangle * 3u + 1u]]
+					+ vertexScores[p_indices[triangle * 3u + 2u]];
+				triangleScores[triangle] = score;
+
+				if (score > bestScore)
+				{
+					bestScore = score;
+					best = triangle;
+				}
+			}
+		}
+
+		std::swap(cache, nextCache);
+	}
+
+	p_indices.resize(triangleCount * 3u);
+	std::copy(output.begin(), output.end(), p_indices.begin());
+}
+
+void OgEngine::Utils::MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& p_indices, const std::vector<Vertex>& p_vertices)
+{
+	const size_t triangleCount = p_indices.size() / 3u;
+	if (triangleCount < 2u)
+		return;
+
+	if (std::any_of(p_indices.begin(), p_indices.end(), [&p_vertices](const uint32_t p_index) { return p_index >= p_vertices.size(); }))
+		return;
+
+	// A group starts on each triangle whose 3 vertices miss the cache, the cache is cold there in any order
+	constexpr uint32_t cacheSize = 16u;
+	std::vector<uint64_t> insertedAt(p_vertices.size(), std::numeric_limits<uint64_t>::max());
+	uint64_t misses = 0u;
+	std::vector<size_t> groupStarts;
+
+	for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+	{
+		uint32_t triangleMisses = 0u;
+		for (size_t corner = 0u; corner < 3u; ++corner)
+		{
+			const uint32_t vertex = p_indices[triangle * 3u + corner];
+			if (insertedAt[vertex] == std::numeric_limits<uint64_t>::max() || misses - insertedAt[vertex] >= cacheSize)
+			{
+				insertedAt[vertex] = misses;
+				++misses;
+				++triangleMisses;
+			}
+		}
+
+		if (triangle == 0u || triangleMisses == 3u)
+			groupStarts.push_back(triangle);
+	}
+	groupStarts.push_back(triangleCount);
+
+	struct Group
+	{
+		size_t begin;
+		size_t end;
+		Float3 centroid;
+		Float3 normal;
+		float area;
+		float sortKey;
+	};
+
+	std::vector<Group> groups(groupStarts.size() - 1u);
+	Float3 meshCentroid;
+	float meshArea = 0.0f;
+
+	for (size_t groupIndex = 0u; groupIndex < groups.size(); ++groupIndex)
+	{
+		Group& group = groups[groupIndex];
+		group = { groupStarts[groupIndex], groupStarts[groupIndex + 1u], {}, {}, 0.0f, 0.0f };
+
+		for (size_t triangle = group.begin; triangle < group.end; ++triangle)
+		{
+			const Float3 a = Position(p_vertices[p_indices[triangle * 3u]]);
+			const Float3 b = Position(p_vertices[p_indices[triangle * 3u + 1u]]);
+			const Float3 c = Position(p_vertices[p_indices[triangle * 3u + 2u]]);
+
+			const Float3 ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+			const Float3 ac{ c.x - a.x, c.y - a.y, c.z - a.z };
+			const Float3 normal{ ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x };
+			const float area = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+			// Weighted by their area, a thin triangle barely covers anything
+			group.centroid.x += (a.x + b.x + c.x) / 3.0f * area;
+			group.centroid.y += (a.y + b.y + c.y) / 3.0f * area;
+			group.centroid.z += (a.z + b.z + c.z) / 3.0f * area;
+			group.normal.x += normal.x;
+			group.normal.y += normal.y;
+			group.normal.z += normal.z;
+			group.area += area;
+		}
+
+		meshCentroid.x += group.centroid.x;
+		meshCentroid.y += group.centroid.y;
+		meshCentroid.z += group.centroid.z;
+		meshArea += group.area;
+
+		if (group.area > 0.0f)
+		{
+			group.centroid.x /= group.area;
+			group.centroid.y /= group.area;
+			group.centroid.z /= group.area;
+		}
+	}
+
+	if (meshArea <= 0.0f)
+		return;
+
+	meshCentroid.x /= meshArea;
+	meshCentroid.y /= meshArea;
+	meshCentroid.z /= meshArea;
+
+	for (Group& group : groups)
+	{
+		const float length = std::sqrt(group.normal.x * group.normal.x + group.normal.y * group.normal.y + group.normal.z * group.normal.z);
+		if (length <= 0.0f)
+			continue;
+
+		group.sortKey = ((group.centroid.x - meshCentroid.x) * group.normal.x + (group.centroid.y - meshCentroid.y) * group.normal.y
+			+ (group.centroid.z - meshCentroid.z) * group.normal.z) / length;
+	}
+
+	std::stable_sort(groups.begin(), groups.end(), [](const Group& p_left, const Group& p_right)
+	{
+		return p_left.sortKey > p_right.sortKey;
+	});
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3u);
+	for (const Group& group : groups)
+		output.insert(output.end(), p_indices.begin() + group.begin * 3u, p_indices.begin() + group.end * 3u);
+
+	std::copy(output.begin(), output.end(), p_indices.begin());
+}
+
+void OgEngine::Utils::MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices)
+{
+	if (std::any_of(p_indices.begin(), p_indices.end(), [&p_vertices](const uint32_t p_index) { return p_index >= p_vertices.size(); }))
+		return;
+
+	std::vector<uint32_t> remap(p_vertices.size(), INVALID_INDEX);
+	uint32_t usedVertices = 0u;
+
+	for (uint32_t& index : p_indices)
+	{
+		if (remap[index] == INVALID_INDEX)
+			remap[index] = usedVertices++;
+
+		index = remap[index];
+	}
+
+	// The vertices no triangle uses go after the used ones, each position then takes its vertex from a single source
+	std::vector<uint32_t> sources(remap.size());
+	uint32_t unusedVertex = usedVertices;
+	for (uint32_t i = 0u; i < remap.size(); ++i)
+		sources[remap[i] != INVALID_INDEX ? remap[i] : unusedVertex++] = i;
+
+	// The permutation is applied in place cycle after cycle, every vertex is moved once plus once per cycle
+	for (uint32_t i = 0u; i < sources.size(); ++i)
+	{
+		if (sources[i] == i)
+			continue;
+
+		Vertex first = std::move(p_vertices[i]);
+		uint32_t position = i;
+		while (sources[position] != i)
+		{
+			const uint32_t source = sources[position];
+			p_vertices[position] = std::move(p_vertices[source]);
+			sources[position] = position;
+			position = source;
+		}
+
+		p_vertices[position] = std::move(first);
+		sources[position] = position;
+	}
+
+	p_vertices.resize(usedVertices);
+}
+
+void OgEngine::Utils::MeshOptimizer::Optimize(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices)
+{
+	// The groups of the overdraw pass come from the cache order, the vertices follow the final order of the triangles
+	OptimizeVertexCache(p_indices, p_vertices.size());
+	OptimizeOverdraw(p_indices, p_vertices);
+	OptimizeVertexFetch(p_vertices, p_indices);
+}
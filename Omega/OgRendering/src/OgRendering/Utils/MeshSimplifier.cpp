@@ -0,0 +1,534 @@
+#include <OgRendering/Utils/MeshSimplifier.h>
+#include <OgRendering/Utils/JobSystem.h>
+#include <OgRendering/Utils/MeshOptimizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+	// Weight of the planes holding the borders and seams in place, against the planes of the triangles
+	constexpr double EDGE_WEIGHT = 10.0;
+
+	// A collapse turning a triangle by more than about 75 degrees is refused, it is about to flip
+	constexpr float FLIP_COSINE = 0.25f;
+
+	enum class VERTEX_KIND : uint8_t
+	{
+		// Inside a surface, with a single set of attributes: collapses toward any neighbour
+		MANIFOLD,
+		// On an open edge of the surface: collapses along the border only
+		BORDER,
+		// Split in two vertices with different normals or texture coordinates: collapses along the seam only, both sides at once
+		SEAM,
+		// Where borders or seams meet, or anything else: never moves
+		LOCKED
+	};
+
+	struct Float3
+	{
+		float x{ 0.0f }, y{ 0.0f }, z{ 0.0f };
+	};
+
+	Float3 Position(const OgEngine::Vertex& p_vertex)
+	{
+		return { p_vertex.position.x, p_vertex.position.y, p_vertex.position.z };
+	}
+
+	Float3 Subtract(const Float3& p_left, const Float3& p_right)
+	{
+		return { p_left.x - p_right.x, p_left.y - p_right.y, p_left.z - p_right.z };
+	}
+
+	float Dot(const Float3& p_left, const Float3& p_right)
+	{
+		return p_left.x * p_right.x + p_left.y * p_right.y + p_left.z * p_right.z;
+	}
+
+	Float3 Cross(const Float3& p_left, const Float3& p_right)
+	{
+		return { p_left.y * p_right.z - p_left.z * p_right.y, p_left.z * p_right.x - p_left.x * p_right.z, p_left.x * p_right.y - p_left.y * p_right.x };
+	}
+
+	/**
+	 * @brief Sum of squared distances to weighted planes, as the symmetric matrix A, the vector b and the constant c of x'Ax + 2b'x + c.
+	 */
+	struct Quadric
+	{
+		double a00{ 0.0 }, a01{ 0.0 }, a02{ 0.0 }, a11{ 0.0 }, a12{ 0.0 }, a22{ 0.0 };
+		double b0{ 0.0 }, b1{ 0.0 }, b2{ 0.0 };
+		double c{ 0.0 };
+		double weight{ 0.0 };
+
+		void AddPlane(const Float3& p_normal, const Float3& p_point, const double p_weight)
+		{
+			const double x = p_normal.x, y = p_normal.y, z = p_normal.z;
+			const double d = -(x * p_point.x + y * p_point.y + z * p_point.z);
+
+			a00 += p_weight * x * x;
+			a01 += p_weight * x * y;
+			a02 += p_weight * x * z;
+			a11 += p_weight * y * y;
+			a12 += p_weight * y * z;
+			a22 += p_weight * z * z;
+			b0 += p_weight * x * d;
+			b1 += p_weight * y * d;
+			b2 += p_weight * z * d;
+			c += p_weight * d * d;
+			weight += p_weight;
+		}
+
+		void Add(const Quadric& p_other)
+		{
+			a00 += p_other.a00;
+			a01 += p_other.a01;
+			a02 += p_other.a02;
+			a11 += p_other.a11;
+			a12 += p_other.a12;
+			a22 += p_other.a22;
+			b0 += p_other.b0;
+			b1 += p_other.b1;
+			b2 += p_other.b2;
+			c += p_other.c;
+			weight += p_other.weight;
+		}
+
+		[[nodiscard]] double Evaluate(const Float3& p_point) const
+		{
+			const double x = p_point.x, y = p_point.y, z = p_point.z;
+			return a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t from{ 0u };
+		uint32_t to{ 0u };
+		double error{ 0.0 };
+	};
+
+	// What is known of an edge of a triangle, from the triangles around its end
+	constexpr uint8_t OPPOSITE_POSITIONS = 1u << 0u;
+	constexpr uint8_t OPPOSITE_VERTICES = 1u << 1u;
+	constexpr uint8_t NON_MANIFOLD = 1u << 2u;
+
+	/**
+	 * @brief Give the vertices at the same position the same identifier, the smallest of their indices.
+	 */
+	std::vector<uint32_t> PositionIdentifiers(const std::vector<OgEngine::Vertex>& p_vertices)
+	{
+		std::vector<uint32_t> order(p_vertices.size());
+		std::iota(order.begin(), order.end(), 0u);
+		const auto less = [&p_vertices](const uint32_t p_left, const uint32_t p_right)
+		{
+			const Float3 left = Position(p_vertices[p_left]), right = Position(p_vertices[p_right]);
+			if (left.x != right.x)
+				return left.x < right.x;
+			if (left.y != right.y)
+				return left.y < right.y;
+			if (left.z != right.z)
+				return left.z < right.z;
+			return p_left < p_right;
+		};
+		std::sort(order.begin(), order.end(), less);
+
+		std::vector<uint32_t> identifiers(p_vertices.size());
+		for (size_t i = 0u; i < order.size(); ++i)
+		{
+			const bool samePosition = i > 0u && Position(p_vertices[order[i - 1u]]).x == Position(p_vertices[order[i]]).x
+				&& Position(p_vertices[order[i - 1u]]).y == Position(p_vertices[order[i]]).y
+				&& Position(p_vertices[order[i - 1u]]).z == Position(p_vertices[order[i]]).z;
+			identifiers[order[i]] = samePosition ? identifiers[order[i - 1u]] : order[i];
+		}
+
+		return identifiers;
+	}
+
+	/**
+	 * @brief Simplify a triangle list in place, pass after pass of independent collapses.
+	 * @return The largest squared error of the collapses done
+	 */
+	double CollapseEdges(const std::vector<OgEngine::Vertex>& p_vertices, std::vector<uint32_t>& p_indices,
+		const size_t p_targetIndexCount, const double p_maxSquaredError)
+	{
+		const size_t vertexCount = p_vertices.size();
+		const std::vector<uint32_t> positionIds = PositionIdentifiers(p_vertices);
+
+		std::vector<Float3> positions(vertexCount);
+		for (size_t vertex = 0u; vertex < vertexCount; ++vertex)
+			positions[vertex] = Position(p_vertices[vertex]);
+
+		std::vector<uint32_t> triangleOffsets(vertexCount + 1u), triangles, fill;
+		std::vector<uint8_t> edgeFlags;
+		// Find the triangles around each position, then the opposite of each edge among the triangles around its end
+		const auto buildAdjacency = [&]()
+		{
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+			for (const uint32_t index : p_indices)
+				++triangleOffsets[positionIds[index] + 1u];
+			for (size_t vertex = 0u; vertex < vertexCount; ++vertex)
+				triangleOffsets[vertex + 1u] += triangleOffsets[vertex];
+			triangles.resize(p_indices.size());
+			fill.assign(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (size_t i = 0u; i < p_indices.size(); ++i)
+				triangles[fill[positionIds[p_indices[i]]]++] = static_cast<uint32_t>(i / 3u);
+
+			edgeFlags.assign(p_indices.size(), 0u);
+			for (size_t i = 0u; i < p_indices.size(); ++i)
+			{
+				const uint32_t from = p_indices[i], to = p_indices[i - i % 3u + (i + 1u) % 3u];
+				const uint32_t fromPosition = positionIds[from], toPosition = positionIds[to];
+				uint32_t sameDirection = 0u;
+				for (uint32_t j = triangleOffsets[toPosition]; j < triangleOffsets[toPosition + 1u]; ++j)
+				{
+					const uint32_t* corners = &p_indices[triangles[j] * 3u];
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						const uint32_t start = corners[corner], end = corners[(corner + 1u) % 3u];
+						if (positionIds[start] == toPosition && positionIds[end] == fromPosition)
+						{
+							edgeFlags[i] |= OPPOSITE_POSITIONS;
+							if (start == to && end == from)
+								edgeFlags[i] |= OPPOSITE_VERTICES;
+						}
+						else if (positionIds[start] == fromPosition && positionIds[end] == toPosition)
+							++sameDirection;
+					}
+				}
+
+				// Two triangles with the same edge in the same direction, or a triangle folded on itself
+				if (sameDirection > 1u)
+					edgeFlags[i] |= NON_MANIFOLD;
+			}
+		};
+
+		// The quadrics, like everything below, are kept per position: the vertices of a seam move together
+		std::vector<Quadric> quadrics(vertexCount);
+		buildAdjacency();
+		for (size_t triangle = 0u; triangle < p_indices.size() / 3u; ++triangle)
+		{
+			const uint32_t* corners = &p_indices[triangle * 3u];
+			const Float3 a = positions[corners[0]], b = positions[corners[1]], c = positions[corners[2]];
+			const Float3 normal = Cross(Subtract(b, a), Subtract(c, a));
+			const float length = std::sqrt(Dot(normal, normal));
+			if (length <= 0.0f)
+				continue;
+
+			const Float3 unitNormal{ normal.x / length, normal.y / length, normal.z / length };
+			for (size_t corner = 0u; corner < 3u; ++corner)
+				quadrics[positionIds[corners[corner]]].AddPlane(unitNormal, a, length * 0.5);
+
+			// A border or seam edge is also held by a plane standing on it, so it doesn't slide inward
+			for (size_t corner = 0u; corner < 3u; ++corner)
+			{
+				if (edgeFlags[triangle * 3u + corner] & OPPOSITE_VERTICES)
+					continue;
+
+				const uint32_t from = corners[corner], to = corners[(corner + 1u) % 3u];
+				const Float3 edge = Subtract(positions[to], positions[from]);
+				const Float3 side = Cross(edge, unitNormal);
+				const float sideLength = std::sqrt(Dot(side, side));
+				if (sideLength <= 0.0f)
+					continue;
+
+				const Float3 unitSide{ side.x / sideLength, side.y / sideLength, side.z / sideLength };
+				const double weight = EDGE_WEIGHT * Dot(edge, edge);
+				quadrics[positionIds[from]].AddPlane(unitSide, positions[from], weight);
+				quadrics[positionIds[to]].AddPlane(unitSide, positions[from], weight);
+			}
+		}
+
+		std::vector<VERTEX_KIND> kinds(vertexCount);
+		std::vector<uint8_t> isBorder(vertexCount), isSeam(vertexCount), isLocked(vertexCount), locked(vertexCount);
+		std::vector<uint32_t> members(vertexCount * 2u);
+		std::vector<uint32_t> remap(vertexCount);
+		std::iota(remap.begin(), remap.end(), 0u);
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> ring, otherRing;
+		double maxError = 0.0;
+
+		while (p_indices.size() > p_targetIndexCount)
+		{
+			const size_t triangleCount = p_indices.size() / 3u;
+
+			// Classify the positions from the edges missing their opposite, on the surface and between the vertices
+			std::fill(isBorder.begin(), isBorder.end(), 0u);
+			std::fill(isSeam.begin(), isSeam.end(), 0u);
+			std::fill(isLocked.begin(), isLocked.end(), 0u);
+			for (size_t i = 0u; i < p_indices.size(); ++i)
+			{
+				const uint32_t fromPosition = positionIds[p_indices[i]], toPosition = positionIds[p_indices[i - i % 3u + (i + 1u) % 3u]];
+				if (edgeFlags[i] & NON_MANIFOLD)
+					isLocked[fromPosition] = isLocked[toPosition] = 1u;
+				if (!(edgeFlags[i] & OPPOSITE_POSITIONS))
+					isBorder[fromPosition] = isBorder[toPosition] = 1u;
+				else if (!(edgeFlags[i] & OPPOSITE_VERTICES))
+					isSeam[fromPosition] = isSeam[toPosition] = 1u;
+			}
+
+			for (uint32_t position = 0u; position < vertexCount; ++position)
+			{
+				if (triangleOffsets[position] == triangleOffsets[position + 1u])
+					continue;
+
+				// The vertices sharing the position, up to the two of a seam
+				uint32_t memberCount = 0u;
+				for (uint32_t i = triangleOffsets[position]; i < triangleOffsets[position + 1u]; ++i)
+				{
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						const uint32_t vertex = p_indices[triangles[i] * 3u + corner];
+						if (positionIds[vertex] != position || (memberCount > 0u && members[position * 2u] == vertex)
+							|| (memberCount > 1u && members[position * 2u + 1u] == vertex))
+							continue;
+
+						if (memberCount < 2u)
+							members[position * 2u + memberCount] = vertex;
+						++memberCount;
+					}
+				}
+
+				if (isLocked[position])
+					kinds[position] = VERTEX_KIND::LOCKED;
+				else if (isBorder[position])
+					kinds[position] = memberCount == 1u && !isSeam[position] ? VERTEX_KIND::BORDER : VERTEX_KIND::LOCKED;
+				else if (isSeam[position])
+					kinds[position] = memberCount == 2u ? VERTEX_KIND::SEAM : VERTEX_KIND::LOCKED;
+				else
+					kinds[position] = memberCount == 1u ? VERTEX_KIND::MANIFOLD : VERTEX_KIND::LOCKED;
+			}
+
+			// Every edge once, collapsed in its cheapest allowed direction
+			collapses.clear();
+			for (size_t i = 0u; i < p_indices.size(); ++i)
+			{
+				const uint32_t first = positionIds[p_indices[i]], second = positionIds[p_indices[i - i % 3u + (i + 1u) % 3u]];
+				const bool isBorderEdge = !(edgeFlags[i] & OPPOSITE_POSITIONS);
+				if (first > second && !isBorderEdge)
+					continue;
+
+				const auto allowed = [&kinds, isBorderEdge](const uint32_t p_from, const uint32_t p_to)
+				{
+					switch (kinds[p_from])
+					{
+					case VERTEX_KIND::MANIFOLD:
+						return true;
+					case VERTEX_KIND::BORDER:
+						return isBorderEdge && (kinds[p_to] == VERTEX_KIND::BORDER || kinds[p_to] == VERTEX_KIND::LOCKED);
+					case VERTEX_KIND::SEAM:
+						return kinds[p_to] == VERTEX_KIND::SEAM || kinds[p_to] == VERTEX_KIND::LOCKED;
+					default:
+						return false;
+					}
+				};
+
+				Quadric quadric = quadrics[first];
+				quadric.Add(quadrics[second]);
+				const double weight = std::max(quadric.weight, std::numeric_limits<double>::min());
+
+				Collapse collapse{ 0u, 0u, std::numeric_limits<double>::max() };
+				if (allowed(first, second))
+					collapse = { first, second, std::max(quadric.Evaluate(positions[second]), 0.0) / weight };
+				if (allowed(second, first))
+				{
+					const double error = std::max(quadric.Evaluate(positions[first]), 0.0) / weight;
+					if (error < collapse.error)
+						collapse = { second, first, error };
+				}
+
+				if (collapse.error <= p_maxSquaredError)
+					collapses.emplace_back(collapse);
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& p_left, const Collapse& p_right) { return p_left.error < p_right.error; });
+
+			// The cheapest collapses first, each one leaves its neighbourhood untouched for the rest of the pass
+			std::fill(locked.begin(), locked.end(), 0u);
+			size_t remainingTriangles = triangleCount;
+			size_t collapsed = 0u;
+			for (const Collapse& collapse : collapses)
+			{
+				if (remainingTriangles * 3u <= p_targetIndexCount)
+					break;
+				if (locked[collapse.from] || locked[collapse.to])
+					continue;
+
+				// Each vertex at the collapsed position goes to the vertex its triangles share at the kept one,
+				// the faces that would flip and the collapses pinching the surface are refused
+				uint32_t sources[2] = {}, targets[2] = {};
+				uint32_t sourceCount = 0u, mapped = 0u, sharedTriangles = 0u;
+				bool valid = true;
+				ring.clear();
+				for (uint32_t i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1u] && valid; ++i)
+				{
+					const uint32_t* corners = &p_indices[triangles[i] * 3u];
+					size_t fromCorner = 3u, toCorner = 3u;
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						if (positionIds[corners[corner]] == collapse.from)
+							fromCorner = corner;
+						else if (positionIds[corners[corner]] == collapse.to)
+							toCorner = corner;
+						else
+							ring.emplace_back(positionIds[corners[corner]]);
+					}
+
+					const uint32_t source = corners[fromCorner];
+					uint32_t slot = 0u;
+					while (slot < sourceCount && sources[slot] != source)
+						++slot;
+					if (slot == sourceCount)
+					{
+						if (sourceCount == 2u)
+						{
+							valid = false;
+							break;
+						}
+						sources[sourceCount] = source;
+						targets[sourceCount++] = std::numeric_limits<uint32_t>::max();
+					}
+
+					if (toCorner != 3u)
+					{
+						++sharedTriangles;
+						if (targets[slot] == std::numeric_limits<uint32_t>::max())
+						{
+							targets[slot] = corners[toCorner];
+							++mapped;
+						}
+						else if (targets[slot] != corners[toCorner])
+							valid = false;
+						continue;
+					}
+
+					const Float3 a = positions[corners[0]], b = positions[corners[1]], c = positions[corners[2]];
+					Float3 moved[3] = { a, b, c };
+					moved[fromCorner] = positions[collapse.to];
+					const Float3 before = Cross(Subtract(b, a), Subtract(c, a));
+					const Float3 after = Cross(Subtract(moved[1], moved[0]), Subtract(moved[2], moved[0]));
+					if (Dot(before, after) <= FLIP_COSINE * std::sqrt(Dot(before, before) * Dot(after, after)))
+						valid = false;
+				}
+
+				if (!valid || mapped != sourceCount || (sourceCount == 2u && targets[0] == targets[1]))
+					continue;
+
+				// The positions around both ends may only share the triangles of the edge
+				std::sort(ring.begin(), ring.end());
+				ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+				otherRing.clear();
+				for (uint32_t i = triangleOffsets[collapse.to]; i < triangleOffsets[collapse.to + 1u]; ++i)
+				{
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						const uint32_t position = positionIds[p_indices[triangles[i] * 3u + corner]];
+						if (position != collapse.to && position != collapse.from)
+							otherRing.emplace_back(position);
+					}
+				}
+				std::sort(otherRing.begin(), otherRing.end());
+				otherRing.erase(std::unique(otherRing.begin(), otherRing.end()), otherRing.end());
+
+				size_t sharedNeighbours = 0u;
+				for (const uint32_t position : ring)
+					sharedNeighbours += std::binary_search(otherRing.begin(), otherRing.end(), position) ? 1u : 0u;
+				if (sharedNeighbours != sharedTriangles)
+					continue;
+
+				for (uint32_t i = 0u; i < sourceCount; ++i)
+					remap[sources[i]] = targets[i];
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+
+				locked[collapse.from] = locked[collapse.to] = 1u;
+				for (const uint32_t position : ring)
+					locked[position] = 1u;
+
+				remainingTriangles -= std::min<size_t>(sharedTriangles, remainingTriangles);
+				maxError = std::max(maxError, collapse.error);
+				++collapsed;
+			}
+
+			if (collapsed == 0u)
+				break;
+
+			// Remove the triangles the collapses flattened
+			size_t kept = 0u;
+			for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+			{
+				const uint32_t a = remap[p_indices[triangle * 3u]], b = remap[p_indices[triangle * 3u + 1u]], c = remap[p_indices[triangle * 3u + 2u]];
+				if (positionIds[a] == positionIds[b] || positionIds[b] == positionIds[c] || positionIds[a] == positionIds[c])
+					continue;
+
+				p_indices[kept++] = a;
+				p_indices[kept++] = b;
+				p_indices[kept++] = c;
+			}
+			p_indices.resize(kept);
+			buildAdjacency();
+		}
+
+		return maxError;
+	}
+}
+
+OgEngine::MeshLod OgEngine::Utils::MeshSimplifier::Simplify(const std::vector<Vertex>& p_vertices, const std::vector<uint32_t>& p_indices,
+	const size_t p_targetIndexCount, const float p_maxError)
+{
+	MeshLod lod;
+	lod.indices = p_indices;
+	if (p_indices.empty() || p_indices.size() % 3u != 0u
+		|| std::any_of(p_indices.begin(), p_indices.end(), [&p_vertices](const uint32_t p_index) { return p_index >= p_vertices.size(); }))
+		return lod;
+
+	Float3 minimum = Position(p_vertices[p_indices[0]]), maximum = minimum;
+	for (const uint32_t index : p_indices)
+	{
+		const Float3 position = Position(p_vertices[index]);
+		minimum = { std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z) };
+		maximum = { std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z) };
+	}
+
+	const double extent = std::max({ maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z });
+	const double maxError = static_cast<double>(p_maxError) * extent;
+
+	lod.error = static_cast<float>(std::sqrt(CollapseEdges(p_vertices, lod.indices, p_targetIndexCount, maxError * maxError)));
+	return lod;
+}
+
+std::vector<OgEngine::MeshLod> OgEngine::Utils::MeshSimplifier::BuildLods(const std::vector<Vertex>& p_vertices,
+	const std::vector<uint32_t>& p_indices, const std::vector<float>& p_ratios, const float p_maxError)
+{
+	if (p_indices.empty() || p_indices.size() % 3u != 0u)
+		return {};
+
+	std::vector<MeshLod> levels(p_ratios.size());
+	const size_t triangleCount = p_indices.size() / 3u;
+
+	// Every level starts from the mesh, the errors don't add up from one level to the next
+	JobSystem::Instance().ParallelFor(0u, levels.size(), [&](const uint64_t p_level)
+	{
+		const auto targetTriangles = static_cast<size_t>(static_cast<double>(triangleCount) * std::clamp(p_ratios[p_level], 0.0f, 1.0f));
+		levels[p_level] = Simplify(p_vertices, p_indices, targetTriangles * 3u, p_maxError);
+		MeshOptimizer::OptimizeVertexCache(levels[p_level].indices, p_vertices.size());
+	}, 1u);
+
+	std::vector<MeshLod> lods;
+	size_t previousIndexCount = p_indices.size();
+	float previousError = 0.0f;
+	for (MeshLod& level : levels)
+	{
+		if (level.indices.empty() || level.indices.size() * 10u > previousIndexCount * 9u)
+			continue;
+
+		// A coarser level is never announced as closer to the mesh than a finer one
+		level.error = std::max(level.error, previousError);
+		previousIndexCount = level.indices.size();
+		previousError = level.error;
+		lods.emplace_back(std::move(level));
+	}
+
+	return lods;
+}
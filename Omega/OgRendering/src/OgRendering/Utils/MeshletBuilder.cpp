@@ -0,0 +1,380 @@
+#include <OgRendering/Utils/MeshletBuilder.h>
+#include <OgRendering/Utils/MeshOptimizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	using OgEngine::Utils::MeshletBuilder;
+
+	constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	// Below this, the normals of a meshlet spread over more than about 84 degrees from their mean and the cone never culls
+	constexpr float MIN_CONE_SPREAD = 0.1f;
+
+	struct Float3
+	{
+		float x{ 0.0f }, y{ 0.0f }, z{ 0.0f };
+	};
+
+	Float3 Position(const OgEngine::Vertex& p_vertex)
+	{
+		return { p_vertex.position.x, p_vertex.position.y, p_vertex.position.z };
+	}
+
+	Float3 Subtract(const Float3& p_left, const Float3& p_right)
+	{
+		return { p_left.x - p_right.x, p_left.y - p_right.y, p_left.z - p_right.z };
+	}
+
+	float Dot(const Float3& p_left, const Float3& p_right)
+	{
+		return p_left.x * p_right.x + p_left.y * p_right.y + p_left.z * p_right.z;
+	}
+
+	Float3 Cross(const Float3& p_left, const Float3& p_right)
+	{
+		return { p_left.y * p_right.z - p_left.z * p_right.y, p_left.z * p_right.x - p_left.x * p_right.z, p_left.x * p_right.y - p_left.y * p_right.x };
+	}
+
+	/**
+	 * @brief Split the triangles in meshlets, without changing the buffers.
+	 * @param p_order Filled with the triangles, meshlet after meshlet
+	 * @param p_triangleCounts Filled with the number of triangles of each meshlet
+	 */
+	void Partition(const std::vector<OgEngine::Vertex>& p_vertices, const std::vector<uint32_t>& p_indices,
+		std::vector<uint32_t>& p_order, std::vector<uint32_t>& p_triangleCounts)
+	{
+		const size_t triangleCount = p_indices.size() / 3u;
+
+		// Triangles using each vertex
+		std::vector<uint32_t> adjacencyOffsets(p_vertices.size() + 1u, 0u);
+		for (const uint32_t index : p_indices)
+			++adjacencyOffsets[index + 1u];
+		for (size_t vertex = 0u; vertex < p_vertices.size(); ++vertex)
+			adjacencyOffsets[vertex + 1u] += adjacencyOffsets[vertex];
+
+		// Triangles not emitted yet using each vertex
+		std::vector<uint32_t> liveTriangles(p_vertices.size());
+		for (size_t vertex = 0u; vertex < p_vertices.size(); ++vertex)
+			liveTriangles[vertex] = adjacencyOffsets[vertex + 1u] - adjacencyOffsets[vertex];
+
+		std::vector<uint32_t> adjacency(p_indices.size());
+		std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0u; i < p_indices.size(); ++i)
+			adjacency[fill[p_indices[i]]++] = static_cast<uint32_t>(i / 3u);
+
+		std::vector<Float3> centroids(triangleCount);
+		for (size_t triangle = 0u; triangle < triangleCount; ++triangle)
+		{
+			const Float3 a = Position(p_vertices[p_indices[triangle * 3u]]);
+			const Float3 b = Position(p_vertices[p_indices[triangle * 3u + 1u]]);
+			const Float3 c = Position(p_vertices[p_indices[triangle * 3u + 2u]]);
+			centroids[triangle] = { (a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f };
+		}
+
+		// Stamped with the meshlet being grown, nothing is cleared between two meshlets
+		std::vector<uint32_t> vertexMeshlet(p_vertices.size(), INVALID_INDEX);
+		std::vector<uint32_t> candidateMeshlet(triangleCount, INVALID_INDEX);
+		std::vector<uint8_t> emitted(triangleCount, 0u);
+		std::vector<uint32_t> candidates;
+
+		p_order.clear();
+		p_order.reserve(triangleCount);
+		p_triangleCounts.clear();
+
+		size_t seed = 0u;
+		for (uint32_t meshlet = 0u;; ++meshlet)
+		{
+			while (seed < triangleCount && emitted[seed])
+				++seed;
+			if (seed == triangleCount)
+				break;
+
+			uint32_t vertexCount = 0u, triangles = 0u;
+			Float3 centroidSum;
+			candidates.clear();
+
+			const auto add = [&](const uint32_t p_triangle)
+			{
+				emitted[p_triangle] = 1u;
+				p_order.emplace_back(p_triangle);
+				for (size_t corner = 0u; corner < 3u; ++corner)
+					--liveTriangles[p_indices[p_triangle * 3u + corner]];
+				++triangles;
+				centroidSum = { centroidSum.x + centroids[p_triangle].x, centroidSum.y + centroids[p_triangle].y, centroidSum.z + centroids[p_triangle].z };
+
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					const uint32_t vertex = p_indices[p_triangle * 3u + corner];
+					if (vertexMeshlet[vertex] == meshlet)
+						continue;
+
+					vertexMeshlet[vertex] = meshlet;
+					++vertexCount;
+					for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1u]; ++i)
+					{
+						const uint32_t neighbour = adjacency[i];
+						if (!emitted[neighbour] && candidateMeshlet[neighbour] != meshlet)
+						{
+							candidateMeshlet[neighbour] = meshlet;
+							candidates.emplace_back(neighbour);
+						}
+					}
+				}
+			};
+
+			add(static_cast<uint32_t>(seed));
+			while (triangles < MeshletBuilder::MAX_TRIANGLES)
+			{
+				const Float3 center = { centroidSum.x / static_cast<float>(triangles), centroidSum.y / static_cast<float>(triangles),
+					centroidSum.z / static_cast<float>(triangles) };
+
+				uint32_t best = INVALID_INDEX, bestPriority = 4u;
+				float bestDistance = std::numeric_limits<float>::max();
+				size_t kept = 0u;
+				for (size_t i = 0u; i < candidates.size(); ++i)
+				{
+					const uint32_t candidate = candidates[i];
+					if (emitted[candidate])
+						continue;
+
+					uint32_t newVertices = 0u;
+					bool isLast = false;
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						const uint32_t vertex = p_indices[candidate * 3u + corner];
+						newVertices += vertexMeshlet[vertex] != meshlet ? 1u : 0u;
+						isLast = isLast || liveTriangles[vertex] == 1u;
+					}
+
+					// The meshlet only grows, a triangle that doesn't fit now never will
+					if (vertexCount + newVertices > MeshletBuilder::MAX_VERTICES)
+						continue;
+					candidates[kept++] = candidate;
+
+					// The last triangle of a vertex goes first, left behind it would end up alone in a meshlet
+					const uint32_t priority = isLast ? 0u : newVertices;
+					if (priority > bestPriority)
+						continue;
+
+					// Among the triangles of the same priority, the closest keeps the bounding sphere tight
+					const Float3 offset = Subtract(centroids[candidate], center);
+					const float distance = Dot(offset, offset);
+					if (priority < bestPriority || distance < bestDistance)
+					{
+						best = candidate;
+						bestPriority = priority;
+						bestDistance = distance;
+					}
+
+					// A triangle between vertices of the meshlet can't make it any larger, no need to look further
+					if (newVertices == 0u)
+					{
+						candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(kept), candidates.begin() + static_cast<std::ptrdiff_t>(i + 1u));
+						kept = candidates.size();
+						break;
+					}
+				}
+				candidates.resize(kept);
+
+				// No neighbour left, or none fitting: the next meshlet starts elsewhere rather than being scattered
+				if (best == INVALID_INDEX)
+					break;
+
+				add(best);
+			}
+
+			p_triangleCounts.emplace_back(triangles);
+		}
+	}
+
+	void ComputeBounds(OgEngine::Meshlet& p_meshlet, const OgEngine::MeshletData& p_data, const std::vector<OgEngine::Vertex>& p_vertices)
+	{
+		Float3 minimum{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		Float3 maximum{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		for (uint32_t i = 0u; i < p_meshlet.vertexCount; ++i)
+		{
+			const Float3 position = Position(p_vertices[p_data.vertices[p_meshlet.vertexOffset + i]]);
+			minimum = { std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z) };
+			maximum = { std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z) };
+		}
+
+		const Float3 center{ (minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f };
+		float radiusSquared = 0.0f;
+		for (uint32_t i = 0u; i < p_meshlet.vertexCount; ++i)
+		{
+			const Float3 offset = Subtract(Position(p_vertices[p_data.vertices[p_meshlet.vertexOffset + i]]), center);
+			radiusSquared = std::max(radiusSquared, Dot(offset, offset));
+		}
+
+		p_meshlet.center[0] = center.x;
+		p_meshlet.center[1] = center.y;
+		p_meshlet.center[2] = center.z;
+		p_meshlet.radius = std::sqrt(radiusSquared);
+
+		// Unit normals of the triangles, the degenerate ones face nowhere and are left out
+		std::vector<Float3> normals;
+		std::vector<Float3> corners;
+		normals.reserve(p_meshlet.triangleCount);
+		corners.reserve(p_meshlet.triangleCount);
+		Float3 axis;
+		for (uint32_t triangle = 0u; triangle < p_meshlet.triangleCount; ++triangle)
+		{
+			const uint8_t* local = &p_data.triangles[(p_meshlet.triangleOffset + triangle) * 3u];
+			const Float3 a = Position(p_vertices[p_data.vertices[p_meshlet.vertexOffset + local[0]]]);
+			const Float3 b = Position(p_vertices[p_data.vertices[p_meshlet.vertexOffset + local[1]]]);
+			const Float3 c = Position(p_vertices[p_data.vertices[p_meshlet.vertexOffset + local[2]]]);
+
+			const Float3 normal = Cross(Subtract(b, a), Subtract(c, a));
+			const float length = std::sqrt(Dot(normal, normal));
+			if (length <= 0.0f)
+				continue;
+
+			normals.push_back({ normal.x / length, normal.y / length, normal.z / length });
+			corners.push_back(a);
+			axis = { axis.x + normals.back().x, axis.y + normals.back().y, axis.z + normals.back().z };
+		}
+
+		p_meshlet.coneApex[0] = center.x;
+		p_meshlet.coneApex[1] = center.y;
+		p_meshlet.coneApex[2] = center.z;
+		p_meshlet.coneCutoff = 2.0f;
+
+		const float axisLength = std::sqrt(Dot(axis, axis));
+		if (axisLength <= 0.0f)
+			return;
+
+		axis = { axis.x / axisLength, axis.y / axisLength, axis.z / axisLength };
+		p_meshlet.coneAxis[0] = axis.x;
+		p_meshlet.coneAxis[1] = axis.y;
+		p_meshlet.coneAxis[2] = axis.z;
+
+		float minimumDot = 1.0f;
+		for (const Float3& normal : normals)
+			minimumDot = std::min(minimumDot, Dot(normal, axis));
+
+		if (minimumDot <= MIN_CONE_SPREAD)
+			return;
+
+		// Slide the apex back along the axis until it is behind the plane of every triangle
+		float apexDistance = 0.0f;
+		for (size_t i = 0u; i < normals.size(); ++i)
+			apexDistance = std::max(apexDistance, Dot(Subtract(center, corners[i]), normals[i]) / Dot(axis, normals[i]));
+
+		p_meshlet.coneApex[0] = center.x - axis.x * apexDistance;
+		p_meshlet.coneApex[1] = center.y - axis.y * apexDistance;
+		p_meshlet.coneApex[2] = center.z - axis.z * apexDistance;
+		// The eye sees the back of every triangle when it is within 90 degrees minus their spread from the reversed axis
+		p_meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+	}
+}
+
+OgEngine::MeshletData OgEngine::Utils::MeshletBuilder::Build(std::vector<Vertex>& p_vertices, std::vector<uint32_t>& p_indices)
+{
+	MeshletData data;
+	if (p_indices.empty() || p_indices.size() % 3u != 0u
+		|| std::any_of(p_indices.begin(), p_indices.end(), [&p_vertices](const uint32_t p_index) { return p_index >= p_vertices.size(); }))
+		return data;
+
+	std::vector<uint32_t> order, triangleCounts;
+	Partition(p_vertices, p_indices, order, triangleCounts);
+
+	std::vector<uint32_t> indices(p_indices.size());
+	for (size_t i = 0u; i < order.size(); ++i)
+		std::copy_n(p_indices.begin() + order[i] * 3u, 3u, indices.begin() + i * 3u);
+
+	p_indices.swap(indices);
+	MeshOptimizer::OptimizeVertexFetch(p_vertices, p_indices);
+
+	data.meshlets.resize(triangleCounts.size());
+	data.triangles.resize(p_indices.size());
+	std::vector<uint32_t> localIndex(p_vertices.size(), INVALID_INDEX);
+	uint32_t triangleOffset = 0u;
+	for (size_t i = 0u; i < triangleCounts.size(); ++i)
+	{
+		Meshlet& meshlet = data.meshlets[i];
+		meshlet.triangleOffset = triangleOffset;
+		meshlet.triangleCount = triangleCounts[i];
+		meshlet.vertexOffset = static_cast<uint32_t>(data.vertices.size());
+
+		for (uint32_t index = triangleOffset * 3u; index < (triangleOffset + meshlet.triangleCount) * 3u; ++index)
+		{
+			const uint32_t vertex = p_indices[index];
+			if (localIndex[vertex] == INVALID_INDEX)
+			{
+				localIndex[vertex] = meshlet.vertexCount++;
+				data.vertices.emplace_back(vertex);
+			}
+
+			data.triangles[index] = static_cast<uint8_t>(localIndex[vertex]);
+		}
+
+		for (uint32_t vertex = meshlet.vertexOffset; vertex < data.vertices.size(); ++vertex)
+			localIndex[data.vertices[vertex]] = INVALID_INDEX;
+
+		ComputeBounds(meshlet, data, p_vertices);
+		triangleOffset += meshlet.triangleCount;
+	}
+
+	return data;
+}
+
+bool OgEngine::Utils::MeshletBuilder::Validate(const MeshletData& p_meshlets, const size_t p_vertexCount, const std::vector<uint32_t>& p_indices)
+{
+	if (p_meshlets.triangles.size() != p_indices.size())
+		return false;
+
+	// The meshlets cover the triangle list, one after the other
+	uint64_t triangleOffset = 0u;
+	for (const Meshlet& meshlet : p_meshlets.meshlets)
+	{
+		if (meshlet.triangleOffset != triangleOffset || meshlet.triangleCount == 0u || meshlet.triangleCount > MAX_TRIANGLES
+			|| meshlet.vertexCount == 0u || meshlet.vertexCount > MAX_VERTICES
+			|| static_cast<uint64_t>(meshlet.vertexOffset) + meshlet.vertexCount > p_meshlets.vertices.size()
+			|| (triangleOffset + meshlet.triangleCount) * 3u > p_indices.size())
+			return false;
+
+		for (uint32_t index = meshlet.triangleOffset * 3u; index < (meshlet.triangleOffset + meshlet.triangleCount) * 3u; ++index)
+		{
+			const uint8_t local = p_meshlets.triangles[index];
+			if (local >= meshlet.vertexCount || p_meshlets.vertices[meshlet.vertexOffset + local] != p_indices[index]
+				|| p_indices[index] >= p_vertexCount)
+				return false;
+		}
+
+		triangleOffset += meshlet.triangleCount;
+	}
+
+	return triangleOffset * 3u == p_indices.size();
+}
+
+bool OgEngine::Utils::MeshletBuilder::IsBackfacing(const Meshlet& p_meshlet, const GPM::Vector3F& p_eye)
+{
+	if (p_meshlet.coneCutoff > 1.0f)
+		return false;
+
+	const Float3 toApex{ p_meshlet.coneApex[0] - p_eye.x, p_meshlet.coneApex[1] - p_eye.y, p_meshlet.coneApex[2] - p_eye.z };
+	const Float3 axis{ p_meshlet.coneAxis[0], p_meshlet.coneAxis[1], p_meshlet.coneAxis[2] };
+
+	return Dot(toApex, axis) >= p_meshlet.coneCutoff * std::sqrt(Dot(toApex, toApex));
+}
+
+void OgEngine::Utils::MeshletBuilder::VisibleRanges(const MeshletData& p_meshlets, const GPM::Vector3F& p_eye,
+	std::vector<std::pair<uint32_t, uint32_t>>& p_ranges)
+{
+	p_ranges.clear();
+	for (const Meshlet& meshlet : p_meshlets.meshlets)
+	{
+		if (IsBackfacing(meshlet, p_eye))
+			continue;
+
+		const uint32_t firstIndex = meshlet.triangleOffset * 3u;
+		if (!p_ranges.empty() && p_ranges.back().first + p_ranges.back().second == firstIndex)
+			p_ranges.back().second += meshlet.triangleCount * 3u;
+		else
+			p_ranges.emplace_back(firstIndex, meshlet.triangleCount * 3u);
+	}
+}
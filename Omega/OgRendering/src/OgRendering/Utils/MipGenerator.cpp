@@ -0,0 +1,445 @@
+#include <OgRendering/Utils/MipGenerator.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MIP_GENERATOR_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC compiles the intrinsics of any instruction set, the processor is checked before calling them
+#define MIP_TARGET_AVX2
+#else
+#define MIP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+	using OgEngine::Utils::MipSettings;
+
+	// 4096 steps of linear intensity, fine enough for the darkest sRGB values
+	constexpr uint32_t LINEAR_STEPS = 4095u;
+
+	constexpr uint32_t KAISER_TAPS = 6u;
+
+	const std::array<float, 256>& SrgbToLinear()
+	{
+		static const std::array<float, 256> table = []()
+		{
+			std::array<float, 256> values{};
+			for (uint32_t i = 0u; i < values.size(); ++i)
+			{
+				const float srgb = static_cast<float>(i) / 255.0f;
+				values[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+			}
+			return values;
+		}();
+
+		return table;
+	}
+
+	const std::array<uint8_t, LINEAR_STEPS + 1u>& LinearToSrgb()
+	{
+		static const std::array<uint8_t, LINEAR_STEPS + 1u> table = []()
+		{
+			std::array<uint8_t, LINEAR_STEPS + 1u> values{};
+			for (uint32_t i = 0u; i < values.size(); ++i)
+			{
+				const float linear = static_cast<float>(i) / static_cast<float>(LINEAR_STEPS);
+				const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+				values[i] = static_cast<uint8_t>(std::clamp(srgb, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+			return values;
+		}();
+
+		return table;
+	}
+
+	/**
+	 * @brief Weights of a Kaiser windowed sinc halving an image, the taps are centered between two source pixels.
+	 */
+	const std::array<float, KAISER_TAPS>& KaiserWeights()
+	{
+		static const std::array<float, KAISER_TAPS> weights = []()
+		{
+			// Modified Bessel function of the first kind, order 0
+			const auto bessel = [](const float p_x)
+			{
+				float sum = 1.0f;
+				float term = 1.0f;
+				for (int k = 1; k < 16; ++k)
+				{
+					term *= (p_x / (2.0f * static_cast<float>(k))) * (p_x / (2.0f * static_cast<float>(k)));
+					sum += term;
+				}
+				return sum;
+			};
+
+			constexpr float alpha = 4.0f;
+			constexpr float halfWidth = 1.5f;
+			constexpr float pi = 3.14159265358979f;
+
+			std::array<float, KAISER_TAPS> values{};
+			float total = 0.0f;
+			for (uint32_t tap = 0u; tap < KAISER_TAPS; ++tap)
+			{
+				// Distance in pixels of the destination, the source ones are twice smaller
+				const float distance = (static_cast<float>(tap) - 2.5f) * 0.5f;
+				const float sinc = std::sin(pi * distance) / (pi * distance);
+				const float ratio = distance / halfWidth;
+				const float window = bessel(alpha * std::sqrt(std::max(0.0f, 1.0f - ratio * ratio))) / bessel(alpha);
+
+				values[tap] = sinc * window;
+				total += values[tap];
+			}
+
+			for (float& value : values)
+				value /= total;
+
+			return values;
+		}();
+
+		return weights;
+	}
+
+	bool IsColor(const uint32_t p_channel, const MipSettings& p_settings)
+	{
+		// The second channel of a gray image is its alpha
+		return p_settings.srgb && (p_settings.channels < 3u ? p_channel == 0u : p_channel < 3u);
+	}
+
+	float Decode(const uint8_t p_value, const bool p_srgb)
+	{
+		return p_srgb ? SrgbToLinear()[p_value] : static_cast<float>(p_value) / 255.0f;
+	}
+
+	uint8_t Encode(const float p_value, const bool p_srgb)
+	{
+		const float value = std::clamp(p_value, 0.0f, 1.0f);
+		if (p_srgb)
+			return LinearToSrgb()[static_cast<uint32_t>(value * static_cast<float>(LINEAR_STEPS) + 0.5f)];
+
+		return static_cast<uint8_t>(value * 255.0f + 0.5f);
+	}
+
+	/**
+	 * @brief Average the 2x2 blocks of the bytes [p_begin, p_end) of a destination row, the reference of the vectorized versions.
+	 */
+	void BoxRow(const uint8_t* p_row0, const uint8_t* p_row1, const uint32_t p_width, const uint32_t p_channels,
+		uint8_t* p_destination, const uint32_t p_begin, const uint32_t p_end)
+	{
+		for (uint32_t byte = p_begin; byte < p_end; ++byte)
+		{
+			const uint32_t x = byte / p_channels;
+			const uint32_t channel = byte % p_channels;
+			const uint32_t x0 = std::min(x * 2u, p_width - 1u) * p_channels + channel;
+			const uint32_t x1 = std::min(x * 2u + 1u, p_width - 1u) * p_channels + channel;
+
+			const uint32_t sum = p_row0[x0] + p_row0[x1] + p_row1[x0] + p_row1[x1];
+			p_destination[byte] = static_cast<uint8_t>((sum + 2u) / 4u);
+		}
+	}
+
+#ifdef MIP_GENERATOR_X64
+	bool HasAvx2()
+	{
+		static const bool hasAvx2 = []()
+		{
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+
+			// The system has to save the AVX registers as well
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+				return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}();
+
+		return hasAvx2;
+	}
+
+	/**
+	 * @brief 16 destination bytes from 32 bytes of each source row.
+	 * @return The first byte of the row left to the scalar version
+	 */
+	MIP_TARGET_AVX2 uint32_t BoxRowAvx2(const uint8_t* p_row0, const uint8_t* p_row1, const uint32_t p_channels,
+		uint8_t* p_destination, const uint32_t p_rowBytes)
+	{
+		// The channels of two neighbor pixels side by side, so they are summed by pairs of bytes
+		const __m256i interleave = p_channels == 4u
+			? _mm256_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15, 0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15)
+			: _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		const __m256i ones = _mm256_set1_epi8(1);
+		const __m256i two = _mm256_set1_epi16(2);
+
+		uint32_t byte = 0u;
+		for (; byte + 16u <= p_rowBytes; byte += 16u)
+		{
+			const __m256i top = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_row0 + byte * 2u)), interleave);
+			const __m256i bottom = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_row1 + byte * 2u)), interleave);
+
+			const __m256i sum = _mm256_add_epi16(_mm256_maddubs_epi16(top, ones), _mm256_maddubs_epi16(bottom, ones));
+			const __m256i average = _mm256_srli_epi16(_mm256_add_epi16(sum, two), 2);
+
+			// Packed within each half, the two halves are gathered in the low 128 bits
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(average, average), 0xD8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_destination + byte), _mm256_castsi256_si128(packed));
+		}
+
+		return byte;
+	}
+
+	/**
+	 * @brief 8 destination bytes from 16 bytes of each source row.
+	 * @return The first byte of the row left to the scalar version
+	 */
+	uint32_t BoxRowSse2(const uint8_t* p_row0, const uint8_t* p_row1, const uint32_t p_channels,
+		uint8_t* p_destination, const uint32_t p_rowBytes)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i two = _mm_set1_epi16(2);
+		const __m128i ones = _mm_set1_epi16(1);
+
+		uint32_t byte = 0u;
+		for (; byte + 8u <= p_rowBytes; byte += 8u)
+		{
+			const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_row0 + byte * 2u));
+			const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_row1 + byte * 2u));
+
+			const __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+			const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+			__m128i sum;
+			if (p_channels == 4u)
+			{
+				// Each half holds two pixels, the upper one is added to the lower one
+				const __m128i lowPixels = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+				const __m128i highPixels = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+				sum = _mm_unpacklo_epi64(lowPixels, highPixels);
+			}
+			else
+			{
+				sum = _mm_packs_epi32(_mm_madd_epi16(low, ones), _mm_madd_epi16(high, ones));
+			}
+
+			const __m128i average = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(p_destination + byte), _mm_packus_epi16(average, average));
+		}
+
+		return byte;
+	}
+#endif
+
+	void DownsampleBox(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination,
+		const MipSettings& p_settings)
+	{
+		const uint32_t channels = p_settings.channels;
+		const uint32_t width = std::max(1u, p_width / 2u);
+		const uint32_t height = std::max(1u, p_height / 2u);
+		const uint32_t rowBytes = width * channels;
+
+		for (uint32_t y = 0u; y < height; ++y)
+		{
+			// The second row is the first one again on a side of 1 pixel
+			const uint8_t* row0 = p_source + static_cast<size_t>(std::min(y * 2u, p_height - 1u)) * p_width * channels;
+			const uint8_t* row1 = p_source + static_cast<size_t>(std::min(y * 2u + 1u, p_height - 1u)) * p_width * channels;
+			uint8_t* destination = p_destination + static_cast<size_t>(y) * rowBytes;
+
+			uint32_t begin = 0u;
+#ifdef MIP_GENERATOR_X64
+			// A column of 1 pixel is averaged with itself, only the scalar version repeats it
+			if (p_width > 1u && (channels == 1u || channels == 4u))
+				begin = HasAvx2() ? BoxRowAvx2(row0, row1, channels, destination, rowBytes) : BoxRowSse2(row0, row1, channels, destination, rowBytes);
+#endif
+			BoxRow(row0, row1, p_width, channels, destination, begin, rowBytes);
+		}
+	}
+
+	void DownsampleBoxSrgb(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination,
+		const MipSettings& p_settings)
+	{
+		const uint32_t channels = p_settings.channels;
+		const uint32_t width = std::max(1u, p_width / 2u);
+		const uint32_t height = std::max(1u, p_height / 2u);
+
+		for (uint32_t y = 0u; y < height; ++y)
+		{
+			const uint8_t* row0 = p_source + static_cast<size_t>(std::min(y * 2u, p_height - 1u)) * p_width * channels;
+			const uint8_t* row1 = p_source + static_cast<size_t>(std::min(y * 2u + 1u, p_height - 1u)) * p_width * channels;
+
+			for (uint32_t x = 0u; x < width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2u, p_width - 1u) * channels;
+				const uint32_t x1 = std::min(x * 2u + 1u, p_width - 1u) * channels;
+				for (uint32_t channel = 0u; channel < channels; ++channel)
+				{
+					const bool srgb = IsColor(channel, p_settings);
+					const float sum = Decode(row0[x0 + channel], srgb) + Decode(row0[x1 + channel], srgb)
+						+ Decode(row1[x0 + channel], srgb) + Decode(row1[x1 + channel], srgb);
+
+					p_destination[(static_cast<size_t>(y) * width + x) * channels + channel] = Encode(sum * 0.25f, srgb);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Filter the rows then the columns, in linear floats.
+	 */
+	void DownsampleKaiser(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination,
+		const MipSettings& p_settings)
+	{
+		const uint32_t channels = p_settings.channels;
+		const uint32_t width = std::max(1u, p_width / 2u);
+		const uint32_t height = std::max(1u, p_height / 2u);
+		const std::array<float, KAISER_TAPS>& weights = KaiserWeights();
+
+		// The source pixels are decoded once, they are read by several taps
+		std::vector<float> decoded(static_cast<size_t>(p_width) * p_height * channels);
+		for (size_t value = 0u; value < decoded.size(); ++value)
+			decoded[value] = Decode(p_source[value], IsColor(static_cast<uint32_t>(value % channels), p_settings));
+
+		// Past the borders, the taps read the last pixel again
+		const auto sourceIndex = [](const uint32_t p_destinationIndex, const uint32_t p_tap, const uint32_t p_sourceSize)
+		{
+			const int64_t index = static_cast<int64_t>(p_destinationIndex) * 2 + static_cast<int64_t>(p_tap) - 2;
+			return static_cast<uint32_t>(std::clamp<int64_t>(index, 0, static_cast<int64_t>(p_sourceSize) - 1));
+		};
+
+		std::vector<float> rows(static_cast<size_t>(width) * p_height * channels, 0.0f);
+		for (uint32_t y = 0u; y < p_height; ++y)
+		{
+			const float* sourceRow = decoded.data() + static_cast<size_t>(y) * p_width * channels;
+			float* row = rows.data() + static_cast<size_t>(y) * width * channels;
+			for (uint32_t x = 0u; x < width; ++x)
+			{
+				for (uint32_t tap = 0u; tap < KAISER_TAPS; ++tap)
+				{
+					const float* pixel = sourceRow + static_cast<size_t>(sourceIndex(x, tap, p_width)) * channels;
+					for (uint32_t channel = 0u; channel < channels; ++channel)
+						row[x * channels + channel] += weights[tap] * pixel[channel];
+				}
+			}
+		}
+
+		std::vector<float> column(static_cast<size_t>(width) * channels);
+		for (uint32_t y = 0u; y < height; ++y)
+		{
+			std::fill(column.begin(), column.end(), 0.0f);
+			for (uint32_t tap = 0u; tap < KAISER_TAPS; ++tap)
+			{
+				const float* row = rows.data() + static_cast<size_t>(sourceIndex(y, tap, p_height)) * width * channels;
+				for (size_t value = 0u; value < column.size(); ++value)
+					column[value] += weights[tap] * row[value];
+			}
+
+			uint8_t* destination = p_destination + static_cast<size_t>(y) * width * channels;
+			for (size_t value = 0u; value < column.size(); ++value)
+				destination[value] = Encode(column[value], IsColor(static_cast<uint32_t>(value % channels), p_settings));
+		}
+	}
+}
+
+uint32_t OgEngine::Utils::MipGenerator::LevelCount(const uint32_t p_width, const uint32_t p_height)
+{
+	uint32_t levels = 1u;
+	for (uint32_t size = std::max(p_width, p_height); size > 1u; size /= 2u)
+		++levels;
+
+	return levels;
+}
+
+namespace
+{
+	/**
+	 * @brief Average the 2x2 blocks of an image of 16 bits or float channels, as they are stored.
+	 */
+	template<typename Channel>
+	void DownsampleWide(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination, const uint32_t p_channels)
+	{
+		const uint32_t width = std::max(1u, p_width / 2u);
+		const uint32_t height = std::max(1u, p_height / 2u);
+		const auto* source = reinterpret_cast<const Channel*>(p_source);
+		auto* destination = reinterpret_cast<Channel*>(p_destination);
+
+		for (uint32_t y = 0u; y < height; ++y)
+		{
+			const Channel* row0 = source + static_cast<size_t>(std::min(y * 2u, p_height - 1u)) * p_width * p_channels;
+			const Channel* row1 = source + static_cast<size_t>(std::min(y * 2u + 1u, p_height - 1u)) * p_width * p_channels;
+			for (uint32_t x = 0u; x < width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2u, p_width - 1u) * p_channels;
+				const uint32_t x1 = std::min(x * 2u + 1u, p_width - 1u) * p_channels;
+				for (uint32_t channel = 0u; channel < p_channels; ++channel)
+				{
+					const float average = (static_cast<float>(row0[x0 + channel]) + static_cast<float>(row0[x1 + channel])
+						+ static_cast<float>(row1[x0 + channel]) + static_cast<float>(row1[x1 + channel])) * 0.25f;
+
+					Channel& result = destination[(static_cast<size_t>(y) * width + x) * p_channels + channel];
+					if constexpr (std::is_floating_point_v<Channel>)
+						result = average;
+					else
+						result = static_cast<Channel>(average + 0.5f);
+				}
+			}
+		}
+	}
+}
+
+void OgEngine::Utils::MipGenerator::Downsample(const uint8_t* p_source, const uint32_t p_width, const uint32_t p_height, uint8_t* p_destination,
+	const MipSettings& p_settings)
+{
+	if (p_settings.channelBytes == 2u)
+		DownsampleWide<uint16_t>(p_source, p_width, p_height, p_destination, p_settings.channels);
+	else if (p_settings.channelBytes == 4u)
+		DownsampleWide<float>(p_source, p_width, p_height, p_destination, p_settings.channels);
+	else if (p_settings.filter == MIP_FILTER::KAISER)
+		DownsampleKaiser(p_source, p_width, p_height, p_destination, p_settings);
+	else if (p_settings.srgb)
+		DownsampleBoxSrgb(p_source, p_width, p_height, p_destination, p_settings);
+	else
+		DownsampleBox(p_source, p_width, p_height, p_destination, p_settings);
+}
+
+std::vector<uint8_t> OgEngine::Utils::MipGenerator::BuildChain(const uint8_t* p_pixels, const uint32_t p_width, const uint32_t p_height,
+	std::vector<MipLevel>& p_levels, const MipSettings& p_settings)
+{
+	p_levels.clear();
+	const uint32_t levelCount = LevelCount(p_width, p_height);
+
+	uint64_t size = 0u;
+	for (uint32_t level = 0u, width = p_width, height = p_height; level < levelCount; ++level)
+	{
+		const uint64_t levelSize = static_cast<uint64_t>(width) * height * p_settings.channels * p_settings.channelBytes;
+		p_levels.push_back({ size, levelSize, width, height });
+		size += levelSize;
+
+		width = std::max(1u, width / 2u);
+		height = std::max(1u, height / 2u);
+	}
+
+	std::vector<uint8_t> chain(size);
+	std::memcpy(chain.data(), p_pixels, p_levels.front().size);
+	for (size_t level = 1u; level < p_levels.size(); ++level)
+	{
+		const MipLevel& parent = p_levels[level - 1u];
+		Downsample(chain.data() + parent.offset, parent.width, parent.height, chain.data() + p_levels[level].offset, p_settings);
+	}
+
+	return chain;
+}
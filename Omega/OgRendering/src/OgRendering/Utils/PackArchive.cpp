@@ -0,0 +1,266 @@
+#include <OgRendering/Utils/PackArchive.h>
+#include <OgRendering/Utils/Lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+	using OgEngine::Utils::PackEntry;
+
+	constexpr char MAGIC[8] = { 'O', 'G', 'P', 'A', 'C', 'K', '\0', '\0' };
+
+	uint64_t AlignUp(const uint64_t p_offset)
+	{
+		constexpr uint64_t alignment = OgEngine::Utils::PackArchive::ALIGNMENT;
+		return (p_offset + alignment - 1u) & ~(alignment - 1u);
+	}
+
+	bool Pad(std::ofstream& p_output, const uint64_t p_offset)
+	{
+		const char zeros[OgEngine::Utils::PackArchive::ALIGNMENT] = {};
+		return static_cast<bool>(p_output.write(zeros, static_cast<std::streamsize>(AlignUp(p_offset) - p_offset)));
+	}
+
+	bool IsBefore(const PackEntry& p_left, const uint64_t p_hash)
+	{
+		return p_left.nameHash < p_hash;
+	}
+}
+
+std::string OgEngine::Utils::PackArchive::EntryName(std::string_view p_file)
+{
+	return std::filesystem::path(p_file).lexically_normal().generic_string();
+}
+
+uint64_t OgEngine::Utils::PackArchive::HashName(std::string_view p_name)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (const char character : p_name)
+		hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001b3ull;
+
+	return hash;
+}
+
+bool OgEngine::Utils::PackArchive::Write(const std::string& p_file, const std::vector<PackInput>& p_inputs, const bool p_compress)
+{
+	struct PendingEntry
+	{
+		std::string name;
+		std::string file;
+		uint64_t hash;
+	};
+
+	// Sorted by hash for the binary search of Find, then by name so the same files always give the same archive
+	std::vector<PendingEntry> pending;
+	pending.reserve(p_inputs.size());
+	for (const PackInput& input : p_inputs)
+	{
+		std::string name = EntryName(input.name);
+		const uint64_t hash = HashName(name);
+		pending.push_back({ std::move(name), input.file.empty() ? input.name : input.file, hash });
+	}
+
+	std::sort(pending.begin(), pending.end(), [](const PendingEntry& p_left, const PendingEntry& p_right)
+	{
+		return p_left.hash != p_right.hash ? p_left.hash < p_right.hash : p_left.name < p_right.name;
+	});
+
+	const auto duplicate = std::adjacent_find(pending.begin(), pending.end(), [](const PendingEntry& p_left, const PendingEntry& p_right)
+	{
+		return p_left.name == p_right.name;
+	});
+	if (duplicate != pending.end())
+	{
+		std::cerr << "PackArchive error: " << duplicate->name << " is packed twice in " << p_file << ".\n";
+		return false;
+	}
+
+	std::error_code error;
+	const std::filesystem::path path(p_file);
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path(), error);
+
+	// Written aside then renamed, the engine may have the previous archive mapped
+	const std::string temporaryFile = p_file + ".tmp";
+	const auto fail = [&temporaryFile](const std::string& p_message)
+	{
+		std::error_code removeError;
+		std::filesystem::remove(temporaryFile, removeError);
+		std::cerr << "PackArchive error: " << p_message << ".\n";
+		return false;
+	};
+
+	std::vector<PackEntry> entries(pending.size());
+	std::string names;
+	{
+		std::ofstream output(temporaryFile, std::ios::binary | std::ios::trunc);
+		if (!output)
+			return fail("couldn't write " + temporaryFile);
+
+		PackHeader header{};
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		uint64_t offset = sizeof(PackHeader);
+		for (size_t i = 0u; i < pending.size(); ++i)
+		{
+			const PendingEntry& source = pending[i];
+			const MappedFile file(source.file);
+			// An empty file is never mapped
+			if (!file.IsOpen() && (std::filesystem::file_size(source.file, error) != 0u || error))
+				return fail("couldn't read " + source.file);
+
+			PackEntry& entry = entries[i];
+			entry.nameHash = source.hash;
+			entry.contentHash = file.ContentHash();
+			entry.size = file.Size();
+			entry.nameOffset = static_cast<uint32_t>(names.size());
+			entry.nameSize = static_cast<uint32_t>(source.name.size());
+			names += source.name;
+
+			const uint8_t* payload = file.Data();
+			entry.storedSize = entry.size;
+			entry.compression = PACK_COMPRESSION::NONE;
+
+			std::vector<uint8_t> compressed;
+			if (p_compress && file.IsOpen())
+			{
+				compressed = Lz4::Compress(file.Data(), file.Size());
+				if (compressed.size() < file.Size() - file.Size() / 8u)
+				{
+					payload = compressed.data();
+					entry.storedSize = compressed.size();
+					entry.compression = PACK_COMPRESSION::LZ4;
+				}
+			}
+
+			if (!Pad(output, offset))
+				return fail("couldn't write " + temporaryFile);
+
+			entry.offset = AlignUp(offset);
+			output.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(entry.storedSize));
+			offset = entry.offset + entry.storedSize;
+		}
+
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.alignment = static_cast<uint32_t>(ALIGNMENT);
+		header.entryCount = entries.size();
+		header.tableOffset = AlignUp(offset);
+		header.namesOffset = header.tableOffset + entries.size() * sizeof(PackEntry);
+		header.namesSize = names.size();
+
+		Pad(output, offset);
+		output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+		output.write(names.data(), static_cast<std::streamsize>(names.size()));
+		// The header is written last, an archive cut short is rejected by its magic
+		output.seekp(0);
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		if (!output)
+			return fail("couldn't write " + temporaryFile);
+	}
+
+	std::filesystem::rename(temporaryFile, p_file, error);
+	if (error)
+		return fail("couldn't replace " + p_file + ", " + error.message());
+
+	return true;
+}
+
+OgEngine::Utils::PackArchive::PackArchive(std::string_view p_file) : m_file(p_file), m_path(p_file)
+{
+	if (m_file.IsOpen() && !Validate())
+	{
+		std::cerr << "PackArchive error: " << m_path << " is badly structured or of another version, it is ignored.\n";
+		m_file.Close();
+		m_entries = nullptr;
+		m_entryCount = 0u;
+		m_names = nullptr;
+	}
+}
+
+bool OgEngine::Utils::PackArchive::Validate()
+{
+	const uint64_t size = m_file.Size();
+	if (size < sizeof(PackHeader))
+		return false;
+
+	PackHeader header;
+	std::memcpy(&header, m_file.Data(), sizeof(header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.alignment != ALIGNMENT
+		|| header.tableOffset % ALIGNMENT != 0u || header.tableOffset > size
+		|| header.entryCount > (size - header.tableOffset) / sizeof(PackEntry)
+		|| header.namesOffset != header.tableOffset + header.entryCount * sizeof(PackEntry) || header.namesSize > size - header.namesOffset)
+		return false;
+
+	// The table is aligned in the mapping, which starts on a page
+	const auto* entries = reinterpret_cast<const PackEntry*>(m_file.Data() + header.tableOffset);
+	for (uint64_t i = 0u; i < header.entryCount; ++i)
+	{
+		const PackEntry& entry = entries[i];
+		if (entry.offset % ALIGNMENT != 0u || entry.offset > header.tableOffset || entry.storedSize > header.tableOffset - entry.offset
+			|| static_cast<uint64_t>(entry.nameOffset) + entry.nameSize > header.namesSize
+			|| entry.compression > PACK_COMPRESSION::LZ4 || (entry.compression == PACK_COMPRESSION::NONE && entry.storedSize != entry.size)
+			|| (i > 0u && entries[i - 1u].nameHash > entry.nameHash))
+			return false;
+	}
+
+	m_entries = entries;
+	m_entryCount = header.entryCount;
+	m_names = reinterpret_cast<const char*>(m_file.Data() + header.namesOffset);
+	return true;
+}
+
+bool OgEngine::Utils::PackArchive::IsOpen() const
+{
+	return m_file.IsOpen();
+}
+
+const std::string& OgEngine::Utils::PackArchive::File() const
+{
+	return m_path;
+}
+
+const OgEngine::Utils::PackEntry* OgEngine::Utils::PackArchive::Find(std::string_view p_file) const
+{
+	if (!m_entries)
+		return nullptr;
+
+	const std::string name = EntryName(p_file);
+	const uint64_t hash = HashName(name);
+
+	// The names of the entries sharing the hash are compared
+	const PackEntry* end = m_entries + m_entryCount;
+	for (const PackEntry* entry = std::lower_bound(m_entries, end, hash, IsBefore); entry != end && entry->nameHash == hash; ++entry)
+	{
+		if (Name(*entry) == name)
+			return entry;
+	}
+
+	return nullptr;
+}
+
+std::string_view OgEngine::Utils::PackArchive::Name(const PackEntry& p_entry) const
+{
+	return { m_names + p_entry.nameOffset, p_entry.nameSize };
+}
+
+const uint8_t* OgEngine::Utils::PackArchive::Payload(const PackEntry& p_entry) const
+{
+	return m_file.Data() + p_entry.offset;
+}
+
+const OgEngine::Utils::PackEntry* OgEngine::Utils::PackArchive::Entries() const
+{
+	return m_entries;
+}
+
+uint64_t OgEngine::Utils::PackArchive::EntryCount() const
+{
+	return m_entryCount;
+}
@@ -0,0 +1,183 @@
+#include <OgRendering/Utils/VirtualFileSystem.h>
+#include <OgRendering/Utils/Lz4.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+OgEngine::Utils::FileView::FileView(FileView&& p_other) noexcept
+{
+	*this = std::move(p_other);
+}
+
+OgEngine::Utils::FileView& OgEngine::Utils::FileView::operator=(FileView&& p_other) noexcept
+{
+	if (&p_other == this)
+		return *this;
+
+	// The data of a decompressed payload stays where it is, the buffer is moved without copy
+	m_data = std::exchange(p_other.m_data, nullptr);
+	m_size = std::exchange(p_other.m_size, 0u);
+	m_contentHash = std::exchange(p_other.m_contentHash, 0u);
+	m_file = std::move(p_other.m_file);
+	m_pack = std::move(p_other.m_pack);
+	m_buffer = std::move(p_other.m_buffer);
+
+	return *this;
+}
+
+bool OgEngine::Utils::FileView::IsOpen() const
+{
+	return m_data != nullptr;
+}
+
+const uint8_t* OgEngine::Utils::FileView::Data() const
+{
+	return m_data;
+}
+
+size_t OgEngine::Utils::FileView::Size() const
+{
+	return m_size;
+}
+
+uint64_t OgEngine::Utils::FileView::ContentHash() const
+{
+	if (!m_data)
+		return 0u;
+
+	return m_pack ? m_contentHash : m_file.ContentHash();
+}
+
+bool OgEngine::Utils::FileView::IsPacked() const
+{
+	return m_pack != nullptr;
+}
+
+OgEngine::Utils::VirtualFileSystem& OgEngine::Utils::VirtualFileSystem::Instance()
+{
+	static VirtualFileSystem fileSystem;
+	return fileSystem;
+}
+
+bool OgEngine::Utils::VirtualFileSystem::Mount(std::string_view p_pack)
+{
+	auto pack = std::make_shared<const PackArchive>(p_pack);
+	if (!pack->IsOpen())
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_packsMutex);
+	auto packs = std::make_shared<PackList>(*m_packs);
+	// Mounted again, the archive may have been written again since
+	packs->erase(std::remove_if(packs->begin(), packs->end(), [&pack](const std::shared_ptr<const PackArchive>& p_mounted)
+	{
+		return p_mounted->File() == pack->File();
+	}), packs->end());
+
+	packs->emplace_back(std::move(pack));
+	m_packs = std::move(packs);
+	return true;
+}
+
+bool OgEngine::Utils::VirtualFileSystem::Unmount(std::string_view p_pack)
+{
+	std::lock_guard<std::mutex> lock(m_packsMutex);
+	auto packs = std::make_shared<PackList>(*m_packs);
+	const auto mounted = std::remove_if(packs->begin(), packs->end(), [p_pack](const std::shared_ptr<const PackArchive>& p_mounted)
+	{
+		return p_mounted->File() == p_pack;
+	});
+
+	if (mounted == packs->end())
+		return false;
+
+	packs->erase(mounted, packs->end());
+	m_packs = std::move(packs);
+	return true;
+}
+
+void OgEngine::Utils::VirtualFileSystem::UnmountAll()
+{
+	std::lock_guard<std::mutex> lock(m_packsMutex);
+	m_packs = std::make_shared<const PackList>();
+}
+
+OgEngine::Utils::FileView OgEngine::Utils::VirtualFileSystem::Open(std::string_view p_file) const
+{
+	FileView view;
+
+	std::shared_ptr<const PackArchive> pack;
+	const PackEntry* entry = Find(*Packs(), p_file, pack);
+	if (!entry)
+	{
+		view.m_file = MappedFile(p_file);
+		view.m_data = view.m_file.Data();
+		view.m_size = view.m_file.Size();
+		return view;
+	}
+
+	// Empty, like an empty loose file which is never mapped
+	if (entry->size == 0u)
+		return view;
+
+	if (entry->compression == PACK_COMPRESSION::LZ4)
+	{
+		view.m_buffer.resize(static_cast<size_t>(entry->size));
+		if (!Lz4::Decompress(pack->Payload(*entry), static_cast<size_t>(entry->storedSize), view.m_buffer.data(), view.m_buffer.size()))
+		{
+			std::cerr << "VirtualFileSystem error: " << p_file << " is corrupted in " << pack->File() << ".\n";
+			return {};
+		}
+
+		view.m_data = view.m_buffer.data();
+	}
+	else
+	{
+		// Used in place from the mapping of the archive
+		view.m_data = pack->Payload(*entry);
+	}
+
+	view.m_size = static_cast<size_t>(entry->size);
+	view.m_contentHash = entry->contentHash;
+	view.m_pack = std::move(pack);
+	return view;
+}
+
+bool OgEngine::Utils::VirtualFileSystem::Exists(std::string_view p_file) const
+{
+	std::shared_ptr<const PackArchive> pack;
+	if (Find(*Packs(), p_file, pack))
+		return true;
+
+	std::error_code error;
+	return std::filesystem::is_regular_file(std::filesystem::path(p_file), error);
+}
+
+std::optional<uint64_t> OgEngine::Utils::VirtualFileSystem::PackedHash(std::string_view p_file) const
+{
+	std::shared_ptr<const PackArchive> pack;
+	const PackEntry* entry = Find(*Packs(), p_file, pack);
+	return entry ? std::optional<uint64_t>(entry->contentHash) : std::nullopt;
+}
+
+std::shared_ptr<const OgEngine::Utils::VirtualFileSystem::PackList> OgEngine::Utils::VirtualFileSystem::Packs() const
+{
+	std::lock_guard<std::mutex> lock(m_packsMutex);
+	return m_packs;
+}
+
+const OgEngine::Utils::PackEntry* OgEngine::Utils::VirtualFileSystem::Find(const PackList& p_packs, std::string_view p_file,
+	std::shared_ptr<const PackArchive>& p_pack)
+{
+	for (auto pack = p_packs.rbegin(); pack != p_packs.rend(); ++pack)
+	{
+		if (const PackEntry* entry = (*pack)->Find(p_file))
+		{
+			p_pack = *pack;
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,292 @@
+#include "LegacySceneParser.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stack>
+#include <stdexcept>
+#include <vector>
+
+// The functions SceneLoader had before it parsed in one pass, kept as they were
+namespace
+{
+	const std::vector<std::string> symbolsList = {
+		"<SceneNode>", "<Transform>", "<Model>", "<Material>", "<RigidBody>", "<LightSource>",
+			"</SceneNode>", "</Transform>", "</Model>", "</Material>", "</RigidBody>", "</LightSource>"
+	};
+
+	float StringToFloat(const std::string_view p_stringValue)
+	{
+		float value;
+		try
+		{
+			value = std::stof(p_stringValue.data());
+		}
+		catch (const std::invalid_argument& p_exception)
+		{
+			throw std::runtime_error(p_exception.what());
+		}
+		catch (const std::out_of_range& p_exception)
+		{
+			throw std::runtime_error(p_exception.what());
+		}
+
+		return value;
+	}
+
+	int StringToInt(const std::string_view p_stringValue)
+	{
+		int value;
+		try
+		{
+			value = std::stoi(p_stringValue.data());
+		}
+		catch (const std::invalid_argument& p_exception)
+		{
+			throw std::runtime_error(p_exception.what());
+		}
+		catch (const std::out_of_range& p_exception)
+		{
+			throw std::runtime_error(p_exception.what());
+		}
+
+		return value;
+	}
+
+	std::string ExtractDataFromAttribute(const std::string& p_attributeLine)
+	{
+		const size_t index = p_attributeLine.find_first_of('>') + 1u;
+		std::string data = p_attributeLine.substr(index);
+		std::istringstream valueStream(data);
+
+		std::getline(valueStream, data, '<');
+
+		return data;
+	}
+
+	std::string ExtractNameFromAttribute(const std::string& p_attributeLine)
+	{
+		return ExtractDataFromAttribute(p_attributeLine);
+	}
+
+	float ExtractFloatFromAttribute(const std::string& p_attributeLine)
+	{
+		return StringToFloat(ExtractDataFromAttribute(p_attributeLine));
+	}
+
+	int ExtractIntegerFromAttribute(const std::string& p_attributeLine)
+	{
+		return StringToInt(ExtractDataFromAttribute(p_attributeLine));
+	}
+
+	bool ExtractBooleanFromAttribute(const std::string& p_attributeLine)
+	{
+		return StringToInt(ExtractDataFromAttribute(p_attributeLine));
+	}
+
+	glm::vec3 ExtractVector3FromAttribute(const std::string& p_attributeLine)
+	{
+		const std::string data = ExtractDataFromAttribute(p_attributeLine);
+
+		glm::vec3 returnedVector;
+		std::istringstream valueStream(data);
+		std::string readValue;
+
+		std::getline(valueStream, readValue, ';');
+		returnedVector.x = StringToFloat(readValue);
+
+		std::getline(valueStream, readValue, ';');
+		returnedVector.y = StringToFloat(readValue);
+
+		std::getline(valueStream, readValue);
+		returnedVector.z = StringToFloat(readValue);
+
+		return returnedVector;
+	}
+
+	glm::vec4 ExtractVector4FromAttribute(const std::string& p_attributeLine)
+	{
+		const std::string data = ExtractDataFromAttribute(p_attributeLine);
+
+		glm::vec4 returnedVector;
+		std::istringstream valueStream(data);
+		std::string readValue;
+
+		std::getline(valueStream, readValue, ';');
+		returnedVector.x = StringToFloat(readValue);
+
+		std::getline(valueStream, readValue, ';');
+		returnedVector.y = StringToFloat(readValue);
+
+		std::getline(valueStream, readValue, ';');
+		returnedVector.z = StringToFloat(readValue);
+
+		std::getline(valueStream, readValue);
+		returnedVector.w = StringToFloat(readValue);
+
+		return returnedVector;
+	}
+
+	bool IsPair(const std::string& p_openingSymbol, const std::string& p_closingSymbol)
+	{
+		return (p_openingSymbol == "<SceneNode>" && p_closingSymbol == "</SceneNode>")
+			|| (p_openingSymbol == "<Transform>" && p_closingSymbol == "</Transform>")
+			|| (p_openingSymbol == "<Model>" && p_closingSymbol == "</Model>")
+			|| (p_openingSymbol == "<Material>" && p_closingSymbol == "</Material>")
+			|| (p_openingSymbol == "<RigidBody>" && p_closingSymbol == "</RigidBody>")
+			|| (p_openingSymbol == "<LightSource>" && p_closingSymbol == "</LightSource>");
+	}
+
+	bool SceneFileIntegrityCheck(const std::string& p_file)
+	{
+		std::ifstream file;
+		file.open(p_file, std::ios::in);
+		std::stack<std::string> s;
+
+		if (file.is_open())
+		{
+			std::string line;
+			while (!file.eof())
+			{
+				std::getline(file, line);
+
+				const size_t indexBegin = line.find_first_of('<');
+				const size_t indexEnd = line.find_first_of('>') + 1u;
+				std::string data;
+				if (indexBegin != std::string::npos && indexEnd != std::string::npos)
+					data = line.substr(indexBegin, indexEnd - indexBegin);
+				else
+					data = line;
+
+				if (std::find(symbolsList.begin(), symbolsList.end(), data) != symbolsList.end())
+				{
+					if (data == "<SceneNode>" || data == "<Transform>" || data == "<Model>" || data == "<Material>" || data == "<RigidBody>" || data == "<LightSource>")
+						s.push(data);
+					else if (data == "</SceneNode>" || data == "</Transform>" || data == "</Model>" || data == "</Material>" || data == "</RigidBody>" || data == "</LightSource>")
+					{
+						if (s.empty() || !IsPair(s.top(), data))
+							return false;
+						s.pop();
+					}
+				}
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		return s.empty();
+	}
+}
+
+OgEngine::SceneDescription LegacySceneParser::Parse(const std::string& p_file)
+{
+	using namespace OgEngine;
+
+	if (!SceneFileIntegrityCheck(p_file))
+		throw std::runtime_error(p_file + " is not a valid Omega scene file");
+
+	std::ifstream file;
+	file.open(p_file, std::ios::in);
+
+	SceneDescription scene;
+	// Indices of the open nodes, where Core::LoadScene kept their SceneNode
+	std::stack<uint64_t> latestNodes;
+	std::string line;
+	while (!file.eof())
+	{
+		std::getline(file, line);
+		if (line.find("<SceneNode>") != std::string::npos)
+		{
+			SceneNodeDescription& node = scene.nodes.emplace_back();
+			node.key = scene.nodes.size() - 1u;
+			if (!latestNodes.empty())
+				node.parent = latestNodes.top();
+			latestNodes.push(node.key);
+		}
+		else if (line.find("<Transform>") != std::string::npos)
+		{
+			TransformDescription& transform = scene.nodes[latestNodes.top()].transform;
+			std::getline(file, line);
+			transform.name = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			transform.position = ExtractVector3FromAttribute(line);
+			std::getline(file, line);
+			transform.rotation = ExtractVector4FromAttribute(line);
+			std::getline(file, line);
+			transform.scale = ExtractVector3FromAttribute(line);
+		}
+		else if (line.find("<Model>") != std::string::npos)
+		{
+			ModelDescription& model = scene.nodes[latestNodes.top()].model.emplace();
+			std::getline(file, line);
+			model.parentMeshName = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			model.meshName = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			model.meshFilepath = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			model.isSubMesh = ExtractIntegerFromAttribute(line);
+			std::getline(file, line);
+			model.subMeshIndex = ExtractIntegerFromAttribute(line);
+		}
+		else if (line.find("<Material>") != std::string::npos)
+		{
+			MaterialDescription& material = scene.nodes[latestNodes.top()].material.emplace();
+			std::getline(file, line);
+			material.color = glm::vec4(ExtractVector3FromAttribute(line), 1.0f);
+			std::getline(file, line);
+			material.specular = ExtractVector4FromAttribute(line);
+			std::getline(file, line);
+			material.emissive = ExtractVector4FromAttribute(line);
+			std::getline(file, line);
+			material.ior = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			material.roughness = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			material.type = ExtractIntegerFromAttribute(line);
+			std::getline(file, line);
+			material.textureName = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			material.texturePath = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			material.normalName = ExtractNameFromAttribute(line);
+			std::getline(file, line);
+			material.normalPath = ExtractNameFromAttribute(line);
+		}
+		else if (line.find("<RigidBody>") != std::string::npos)
+		{
+			RigidBodyDescription& rigidBody = scene.nodes[latestNodes.top()].rigidBody.emplace();
+			std::getline(file, line);
+			rigidBody.shapeSize.x = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.shapeSize.y = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.shapeSize.z = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.mass = ExtractFloatFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.type = ExtractIntegerFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.useGravity = ExtractBooleanFromAttribute(line);
+			std::getline(file, line);
+			rigidBody.isStatic = ExtractBooleanFromAttribute(line);
+		}
+		else if (line.find("<LightSource>") != std::string::npos)
+		{
+			LightSourceDescription& lightSource = scene.nodes[latestNodes.top()].lightSource.emplace();
+			std::getline(file, line);
+			lightSource.color = ExtractVector4FromAttribute(line);
+			std::getline(file, line);
+			lightSource.direction = ExtractVector4FromAttribute(line);
+			std::getline(file, line);
+			lightSource.lightType = ExtractIntegerFromAttribute(line);
+		}
+		else if (line.find("</SceneNode>") != std::string::npos)
+		{
+			latestNodes.pop();
+		}
+	}
+
+	return scene;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <OgCore/SceneLoader/SceneDescription.h>
+#include <string>
+
+namespace LegacySceneParser
+{
+	/**
+	 * @brief Read a scene file the way Core::LoadScene did before SceneLoader::Parse, the reference of the "load legacy" phase.
+	 * The file is read twice (integrity check, then parse), line by line, each value going through substr, istringstream and std::stof.
+	 * @note Only the parsing is kept: the description is filled where the ECS was, so both parsers build the same result.
+	 * @note Throw a std::runtime_error if the file is invalid.
+	 */
+	OgEngine::SceneDescription Parse(const std::string& p_file);
+}
@@ -0,0 +1,231 @@
+#include <OgCore/SceneLoader/SceneGenerator.h>
+#include <OgCore/SceneLoader/SceneLoader.h>
+#include <OgCore/SceneLoader/SceneSaver.h>
+#include "LegacySceneParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace OgEngine;
+
+namespace
+{
+	/**
+	 * @return The highest memory used by the process so far, in bytes
+	 */
+	uint64_t PeakMemory()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters{};
+		GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+		return counters.PeakWorkingSetSize;
+#else
+		rusage usage{};
+		getrusage(RUSAGE_SELF, &usage);
+		return static_cast<uint64_t>(usage.ru_maxrss) * 1024u;
+#endif
+	}
+
+	/**
+	 * @brief Run a phase several times and print its best time.
+	 * @param p_name The name of the phase
+	 * @param p_nodes Number of nodes processed by one run
+	 * @param p_iterations Number of runs
+	 * @param p_run The phase
+	 * @param p_reset Called before each run and not timed, frees what the previous run made so the run doesn't pay for it
+	 * @return The best time, in seconds
+	 */
+	double Measure(const char* p_name, const uint64_t p_nodes, const uint32_t p_iterations, const std::function<void()>& p_run,
+		const std::function<void()>& p_reset = {})
+	{
+		double best = 0.0;
+		for (uint32_t i = 0u; i < p_iterations; ++i)
+		{
+			if (p_reset)
+				p_reset();
+
+			const auto start = std::chrono::steady_clock::now();
+			p_run();
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			best = i == 0u ? elapsed : std::min(best, elapsed);
+		}
+
+		std::printf("%-16s %10llu %12.3f %14.0f\n", p_name, static_cast<unsigned long long>(p_nodes), best * 1000.0,
+			best > 0.0 ? static_cast<double>(p_nodes) / best : 0.0);
+		return best;
+	}
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OgSceneBenchmark [options]             time the scene files paths on a generated scene\n"
+			"       OgSceneBenchmark --generate <file> [options] write a generated scene file\n\n"
+			"Options:\n"
+			"  --nodes <n>         number of nodes, root included (default 100000)\n"
+			"  --depth <n>         maximum depth of the hierarchy (default 8)\n"
+			"  --models <r>        ratio of nodes with a model (default 0.7)\n"
+			"  --materials <r>     ratio of models with a material (default 0.8)\n"
+			"  --rigidbodies <r>   ratio of nodes with a rigidBody (default 0.2)\n"
+			"  --lights <r>        ratio of nodes with a light source (default 0.05)\n"
+			"  --reuse <r>         ratio of models and textures reusing an asset (default 0.9)\n"
+			"  --seed <n>          seed of the generation (default 0)\n"
+			"  --iterations <n>    runs of each phase, the best one is reported (default 5)\n"
+			"  --output <file>     scene file written by the benchmark (default benchmark.omega)\n";
+	}
+}
+
+int main(const int p_argc, char** p_argv)
+{
+	SceneGenerationSettings settings;
+	settings.nodeCount = 100000u;
+	uint32_t iterations = 5u;
+	std::string output = "benchmark.omega";
+	std::string generatedFile;
+
+	try
+	{
+		for (int i = 1; i < p_argc; ++i)
+		{
+			const std::string option = p_argv[i];
+			if (option == "--help" || option == "-h")
+			{
+				PrintUsage();
+				return 0;
+			}
+			if (i + 1 >= p_argc)
+				throw std::invalid_argument("missing value for " + option);
+
+			const std::string value = p_argv[++i];
+			if (option == "--generate")
+				generatedFile = value;
+			else if (option == "--nodes")
+				settings.nodeCount = std::stoull(value);
+			else if (option == "--depth")
+				settings.maxDepth = static_cast<uint32_t>(std::stoul(value));
+			else if (option == "--models")
+				settings.modelRatio = std::stof(value);
+			else if (option == "--materials")
+				settings.materialRatio = std::stof(value);
+			else if (option == "--rigidbodies")
+				settings.rigidBodyRatio = std::stof(value);
+			else if (option == "--lights")
+				settings.lightSourceRatio = std::stof(value);
+			else if (option == "--reuse")
+				settings.assetReuseRatio = std::stof(value);
+			else if (option == "--seed")
+				settings.seed = std::stoull(value);
+			else if (option == "--iterations")
+				iterations = std::max(1u, static_cast<uint32_t>(std::stoul(value)));
+			else if (option == "--output")
+				output = value;
+			else
+				throw std::invalid_argument("unknown option " + option);
+		}
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << p_exception.what() << "\n\n";
+		PrintUsage();
+		return 1;
+	}
+
+	if (!generatedFile.empty())
+	{
+		std::ofstream file(generatedFile, std::ios::out | std::ios::trunc | std::ios::binary);
+		if (!file.is_open())
+		{
+			std::cerr << "Couldn't write " << generatedFile << ".\n";
+			return 1;
+		}
+		file << SceneSaver::Serialize(SceneGenerator::Generate(settings));
+		return 0;
+	}
+
+	try
+	{
+		std::printf("%-16s %10s %12s %14s\n", "phase", "nodes", "best ms", "nodes/s");
+
+		SceneDescription scene;
+		const uint64_t nodes = settings.nodeCount;
+		Measure("generate", nodes, iterations, [&]() { scene = SceneGenerator::Generate(settings); });
+
+		std::string content;
+		Measure("serialize", nodes, iterations, [&]() { content = SceneSaver::Serialize(scene); });
+
+		SceneDescription parsed;
+		// The scenes read are freed out of the time of the loads, freeing 50k nodes takes about a tenth of a load
+		const auto resetParsed = [&]() { parsed = SceneDescription(); };
+		Measure("parse memory", nodes, iterations, [&]() { parsed = SceneLoader::ParseFromMemory(content); }, resetParsed);
+		content.clear();
+		content.shrink_to_fit();
+
+		// Same paths as Core::SaveScene and Core::LoadScene, without the ECS and the renderer
+		Measure("save full", nodes, iterations, [&]()
+		{
+			// A saver tracking the file would only append the changes: each run starts from nothing, like a first save
+			std::filesystem::remove(output);
+			std::filesystem::remove(output + SceneLoader::DELTA_EXTENSION);
+			SceneSaver saver;
+			saver.Save(output, scene);
+			saver.Wait();
+		});
+
+		const double load = Measure("load", nodes, iterations, [&]() { parsed = SceneLoader::Parse(output); }, resetParsed);
+
+		// The parser SceneLoader replaced, on the same file
+		SceneDescription legacy;
+		const double legacyLoad = Measure("load legacy", nodes, iterations, [&]() { legacy = LegacySceneParser::Parse(output); },
+			[&]() { legacy = SceneDescription(); });
+		if (legacy.nodes.size() != parsed.nodes.size())
+			throw std::runtime_error("the legacy parser read " + std::to_string(legacy.nodes.size()) + " nodes out of " + std::to_string(parsed.nodes.size()));
+		std::printf("%-16s %10s %11.1fx\n", "load speed-up", "", load > 0.0 ? legacyLoad / load : 0.0);
+
+		// One node out of a hundred moved, saved as delta records appended to the journal
+		std::vector<uint64_t> keys(parsed.nodes.size());
+		for (size_t i = 0u; i < keys.size(); ++i)
+			keys[i] = i;
+		const uint64_t modified = std::max<uint64_t>(nodes / 100u, 1u);
+		uint32_t run = 0u;
+		SceneSaver saver;
+		saver.Track(output, parsed, keys);
+		Measure("save delta", modified, iterations, [&]()
+		{
+			// The copy stands for the capture of the scene made by Core::SaveScene
+			SceneDescription snapshot = scene;
+			for (uint64_t i = 0u; i < modified && i < snapshot.nodes.size(); ++i)
+				snapshot.nodes[(i * 100u) % snapshot.nodes.size()].transform.position.y += static_cast<float>(++run);
+
+			saver.Save(output, std::move(snapshot));
+			saver.Wait();
+		});
+
+		Measure("load delta", nodes, iterations, [&]() { parsed = SceneLoader::Parse(output); }, resetParsed);
+
+		// Highest memory of the whole process, all the phases included
+		std::printf("%-16s %10s %12.1f MB\n", "process peak", "", static_cast<double>(PeakMemory()) / (1024.0 * 1024.0));
+
+		std::filesystem::remove(output);
+		std::filesystem::remove(output + SceneLoader::DELTA_EXTENSION);
+	}
+	catch (const std::exception& p_exception)
+	{
+		std::cerr << "Benchmark failed: " << p_exception.what() << '\n';
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+#include "Tests.h"
+#include <OgRendering/Resource/BoundingVolume.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace OgEngine;
+
+namespace
+{
+	std::vector<Vertex> RandomCloud(const size_t p_count, const uint32_t p_seed)
+	{
+		std::mt19937 random(p_seed);
+		std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+		std::vector<Vertex> vertices(p_count);
+		for (Vertex& vertex : vertices)
+		{
+			vertex.position = GPM::Vector3F(coordinate(random), coordinate(random), coordinate(random));
+			// The SSE loads read the first component of the normal with the position, it must not leak into the box
+			vertex.normal = GPM::Vector3F(1000.0f, -1000.0f, 1000.0f);
+		}
+
+		return vertices;
+	}
+
+	/**
+	 * @brief Vertex by vertex box, what the SSE reduction must give to the bit.
+	 */
+	BoundingBox ReferenceBox(const std::vector<Vertex>& p_vertices)
+	{
+		BoundingBox box;
+		for (const Vertex& vertex : p_vertices)
+		{
+			box.minimum = GPM::Vector3F(std::min(box.minimum.x, vertex.position.x), std::min(box.minimum.y, vertex.position.y), std::min(box.minimum.z, vertex.position.z));
+			box.maximum = GPM::Vector3F(std::max(box.maximum.x, vertex.position.x), std::max(box.maximum.y, vertex.position.y), std::max(box.maximum.z, vertex.position.z));
+		}
+
+		return box;
+	}
+
+	float ReferenceRadius(const std::vector<Vertex>& p_vertices, const GPM::Vector3F& p_center)
+	{
+		float radiusSquared = 0.0f;
+		for (const Vertex& vertex : p_vertices)
+		{
+			const float dx = vertex.position.x - p_center.x, dy = vertex.position.y - p_center.y, dz = vertex.position.z - p_center.z;
+			radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+		}
+
+		return std::sqrt(radiusSquared);
+	}
+
+	bool SameVector(const GPM::Vector3F& p_a, const GPM::Vector3F& p_b)
+	{
+		return p_a.x == p_b.x && p_a.y == p_b.y && p_a.z == p_b.z;
+	}
+
+	/**
+	 * @brief A point transformed by a matrix stored row after row, with the translation in the last column.
+	 */
+	GPM::Vector3F TransformPoint(const GPM::Matrix4F& p_transform, const GPM::Vector3F& p_point)
+	{
+		const float* m = p_transform.m_data;
+		return GPM::Vector3F(m[0] * p_point.x + m[1] * p_point.y + m[2] * p_point.z + m[3],
+			m[4] * p_point.x + m[5] * p_point.y + m[6] * p_point.z + m[7],
+			m[8] * p_point.x + m[9] * p_point.y + m[10] * p_point.z + m[11]);
+	}
+
+	void CheckFromVertices()
+	{
+		// Shorter than, as long as and longer than a block of four vertices, then clouds of every remainder
+		std::vector<size_t> counts{ 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u };
+		for (size_t count = 64u; count < 68u; ++count)
+			counts.push_back(count);
+		counts.push_back(1001u);
+
+		for (const size_t count : counts)
+		{
+			const std::vector<Vertex> vertices = RandomCloud(count, static_cast<uint32_t>(count) * 17u + 3u);
+			const BoundingBox box = BoundingBox::FromVertices(vertices);
+			const BoundingBox expected = ReferenceBox(vertices);
+			OG_CHECK(box.Empty() == (count == 0u));
+			OG_CHECK(SameVector(box.minimum, expected.minimum));
+			OG_CHECK(SameVector(box.maximum, expected.maximum));
+
+			const BoundingSphere sphere = BoundingSphere::FromVertices(vertices, box);
+			OG_CHECK(sphere.Empty() == (count == 0u));
+			if (count == 0u)
+				continue;
+
+			OG_CHECK(SameVector(sphere.center, box.Center()));
+			const float radius = ReferenceRadius(vertices, box.Center());
+			OG_CHECK(std::abs(sphere.radius - radius) <= radius * 1e-6f);
+		}
+
+		// The extreme vertex in each lane of the blocks and in the remainder
+		for (size_t extreme = 0u; extreme < 7u; ++extreme)
+		{
+			std::vector<Vertex> vertices = RandomCloud(7u, 5u);
+			vertices[extreme].position = GPM::Vector3F(-200.0f, 300.0f, -400.0f);
+			const BoundingBox box = BoundingBox::FromVertices(vertices);
+			OG_CHECK(box.minimum.x == -200.0f && box.maximum.y == 300.0f && box.minimum.z == -400.0f);
+			OG_CHECK(std::abs(BoundingSphere::FromVertices(vertices, box).radius - ReferenceRadius(vertices, box.Center())) <= 1e-3f);
+		}
+	}
+
+	void CheckTransformed()
+	{
+		const std::vector<Vertex> vertices = RandomCloud(200u, 9u);
+		const BoundingBox box = BoundingBox::FromVertices(vertices);
+		const BoundingSphere sphere = BoundingSphere::FromVertices(vertices, box);
+
+		std::mt19937 random(21u);
+		std::uniform_real_distribution<double> angle(-3.0, 3.0);
+		std::uniform_real_distribution<float> translation(-100.0f, 100.0f), scale(0.25f, 4.0f);
+		for (uint32_t i = 0u; i < 32u; ++i)
+		{
+			const GPM::Vector3D axis = GPM::Vector3D(angle(random), angle(random), angle(random) + 4.0).Normalized();
+			// Mirrored once in a while, a negative scale must not turn the box inside out
+			const float mirror = i % 4u == 3u ? -1.0f : 1.0f;
+			const GPM::Matrix4F transform = GPM::Matrix4F::CreateTransformation(GPM::Vector3F(translation(random), translation(random), translation(random)),
+				GPM::Quaternion(axis, angle(random)), GPM::Vector3F(scale(random) * mirror, scale(random), scale(random)));
+
+			const BoundingBox transformedBox = box.Transformed(transform);
+			const BoundingSphere transformedSphere = sphere.Transformed(transform);
+			OG_CHECK(!transformedBox.Empty());
+			OG_CHECK(!transformedSphere.Empty());
+
+			// Within the rounding of the transform, scaled with the size of the volumes
+			const float epsilon = 1e-4f * (transformedSphere.radius + 100.0f);
+			bool boxContains = true, sphereContains = true;
+			for (const Vertex& vertex : vertices)
+			{
+				const GPM::Vector3F point = TransformPoint(transform, vertex.position);
+				boxContains = boxContains && point.x >= transformedBox.minimum.x - epsilon && point.x <= transformedBox.maximum.x + epsilon
+					&& point.y >= transformedBox.minimum.y - epsilon && point.y <= transformedBox.maximum.y + epsilon
+					&& point.z >= transformedBox.minimum.z - epsilon && point.z <= transformedBox.maximum.z + epsilon;
+
+				const float dx = point.x - transformedSphere.center.x, dy = point.y - transformedSphere.center.y, dz = point.z - transformedSphere.center.z;
+				sphereContains = sphereContains && std::sqrt(dx * dx + dy * dy + dz * dz) <= transformedSphere.radius + epsilon;
+			}
+			OG_CHECK(boxContains);
+			OG_CHECK(sphereContains);
+		}
+
+		// An empty volume stays empty
+		OG_CHECK(BoundingBox().Transformed(GPM::Matrix4F::identity).Empty());
+		OG_CHECK(BoundingSphere().Transformed(GPM::Matrix4F::identity).Empty());
+	}
+}
+
+/**
+ * The vectorized box and sphere against a scalar reference, and the transformed volumes around the transformed vertices.
+ */
+OG_SUITE(BoundingVolume)
+{
+	CheckFromVertices();
+	CheckTransformed();
+}
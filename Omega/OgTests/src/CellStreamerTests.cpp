@@ -0,0 +1,138 @@
+#include "Tests.h"
+#include <OgCore/SceneLoader/CellStreamer.h>
+#include <OgCore/SceneLoader/WorldPartition.h>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <utility>
+
+using namespace OgEngine;
+
+namespace
+{
+	constexpr float CELL_SIZE = 64.0f;
+	constexpr int32_t GRID_HALF_EXTENT = 3;
+
+	using CellSet = std::set<std::pair<int32_t, int32_t>>;
+
+	/**
+	 * @brief A root and one model in the middle of each cell of a square grid centered on the origin.
+	 */
+	SceneDescription GridScene()
+	{
+		SceneDescription scene;
+		scene.nodes.emplace_back().transform.name = "Root";
+		for (int32_t x = -GRID_HALF_EXTENT; x <= GRID_HALF_EXTENT; ++x)
+		{
+			for (int32_t z = -GRID_HALF_EXTENT; z <= GRID_HALF_EXTENT; ++z)
+			{
+				SceneNodeDescription& node = scene.nodes.emplace_back();
+				node.key = scene.nodes.size() - 1u;
+				node.parent = 0u;
+				node.transform.name = "Model " + std::to_string(x) + ";" + std::to_string(z);
+				node.transform.position = { (static_cast<float>(x) + 0.5f) * CELL_SIZE, 0.0f, (static_cast<float>(z) + 0.5f) * CELL_SIZE };
+				ModelDescription& model = node.model.emplace();
+				model.parentMeshName = "cube.obj";
+				model.meshName = "cube.obj";
+				model.meshFilepath = "Resources/models/cube.obj";
+			}
+		}
+
+		return scene;
+	}
+
+	CellSet ToSet(const std::vector<CellCoordinates>& p_cells)
+	{
+		CellSet cells;
+		for (const CellCoordinates& cell : p_cells)
+			cells.emplace(cell.x, cell.z);
+
+		return cells;
+	}
+}
+
+/**
+ * A camera follows a scripted path over a baked partition, without any scene nor renderer.
+ * After each move the streamer is updated until the cells settle, and the resident cells must be the ones the radii ask for:
+ * in range of loadRadius, out of range of unloadRadius, and unchanged in between.
+ */
+OG_SUITE(CellStreamer)
+{
+	const std::string directory = WorldPartition::DirectoryOf(OgTests::TemporaryDirectory("CellStreamer") + "/grid.omega");
+	const SceneDescription persistent = WorldPartition::Bake(GridScene(), CELL_SIZE, directory);
+	OG_CHECK(persistent.nodes.size() == 1u);
+
+	const WorldPartition partition = WorldPartition::Open(directory);
+	const size_t cellCount = static_cast<size_t>(2 * GRID_HALF_EXTENT + 1) * static_cast<size_t>(2 * GRID_HALF_EXTENT + 1);
+	OG_CHECK(partition.cells.size() == cellCount);
+
+	CellSet active;
+	uint32_t activations = 0u;
+	uint32_t deactivations = 0u;
+	CellStreamer streamer(directory, partition,
+		[&](const CellCoordinates& p_cell, const SceneDescription& p_content)
+		{
+			OG_CHECK(active.emplace(p_cell.x, p_cell.z).second);
+			// The cell root and the model baked into it
+			OG_CHECK(p_content.nodes.size() == 2u);
+			++activations;
+		},
+		[&](const CellCoordinates& p_cell)
+		{
+			OG_CHECK(active.erase({ p_cell.x, p_cell.z }) == 1u);
+			++deactivations;
+		});
+
+	streamer.budget.loadRadius = 40.0f;
+	streamer.budget.unloadRadius = 72.0f;
+	streamer.budget.maxLoadsInFlight = 2u;
+	streamer.budget.maxActivationsPerFrame = 1u;
+	streamer.budget.maxActivationMilliseconds = 1000.0;
+
+	const std::vector<glm::vec3> path = {
+		{ 32.0f, 0.0f, 32.0f },
+		{ 96.0f, 0.0f, 32.0f },
+		{ 150.0f, 0.0f, 60.0f },
+		{ 150.0f, 0.0f, -100.0f },
+		{ -200.0f, 0.0f, -200.0f },
+		{ 1000.0f, 0.0f, 1000.0f },
+		{ 0.0f, 0.0f, 0.0f }
+	};
+
+	CellSet expected;
+	for (const glm::vec3& camera : path)
+	{
+		for (const PartitionCell& cell : partition.cells)
+		{
+			const float distance = partition.DistanceTo(camera, cell.coordinates);
+			if (distance <= streamer.budget.loadRadius)
+				expected.emplace(cell.coordinates.x, cell.coordinates.z);
+			else if (distance > streamer.budget.unloadRadius)
+				expected.erase({ cell.coordinates.x, cell.coordinates.z });
+		}
+
+		// The cells are read by the jobs and handed over one per update
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		streamer.Update(camera);
+		while (ToSet(streamer.ResidentCells()) != expected && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			streamer.Update(camera);
+		}
+
+		OG_CHECK(ToSet(streamer.ResidentCells()) == expected);
+		OG_CHECK(active == expected);
+		for (const auto& [x, z] : expected)
+			OG_CHECK(streamer.IsResident({ x, z }));
+	}
+
+	// The last point is back at the origin, with the four cells around it
+	OG_CHECK(expected.size() == 4u);
+	OG_CHECK(activations - deactivations == active.size());
+
+	// Far from every cell, nothing stays resident nor counted in the budget
+	for (uint32_t i = 0u; i < 4u; ++i)
+		streamer.Update({ 10000.0f, 0.0f, 10000.0f });
+	OG_CHECK(active.empty());
+	OG_CHECK(streamer.ResidentBytes() == 0u);
+}
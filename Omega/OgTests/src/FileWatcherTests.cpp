@@ -0,0 +1,88 @@
+#include "Tests.h"
+#include <OgRendering/Utils/FileWatcher.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace OgEngine::Utils;
+
+namespace
+{
+	constexpr std::chrono::milliseconds DEBOUNCE{ 300 };
+	// Between the two writes of a file, well within the debounce time
+	constexpr std::chrono::milliseconds REWRITE_DELAY{ 30 };
+	constexpr std::chrono::seconds TIMEOUT{ 5 };
+
+	void WriteFile(const std::string& p_file, const std::string& p_content)
+	{
+		std::ofstream file(p_file, std::ios::binary | std::ios::trunc);
+		file << p_content;
+	}
+
+	/**
+	 * @brief The batches given to the callback, written by the thread of the watcher.
+	 */
+	struct Batches
+	{
+		std::mutex mutex;
+		std::vector<std::vector<std::string>> files;
+
+		size_t Count()
+		{
+			std::lock_guard lock(mutex);
+			return files.size();
+		}
+	};
+}
+
+/**
+ * Files written twice within the debounce time, in a subfolder of the temporary directory, are reported once and sorted.
+ */
+OG_SUITE(FileWatcher)
+{
+	const std::string directory = OgTests::TemporaryDirectory("FileWatcher");
+	std::filesystem::create_directories(directory + "/sub");
+
+	FileWatcher watcher;
+	OG_CHECK(!watcher.Start(directory + "/missing", [](const std::vector<std::string>&) {}));
+	OG_CHECK(!watcher.IsWatching());
+
+	Batches batches;
+	const bool isStarted = watcher.Start(directory, [&batches](const std::vector<std::string>& p_files)
+	{
+		std::lock_guard lock(batches.mutex);
+		batches.files.emplace_back(p_files);
+	}, DEBOUNCE);
+	OG_CHECK(isStarted);
+	OG_CHECK(watcher.IsWatching());
+	if (!isStarted)
+		return;
+
+	// Written out of order, each one twice
+	const std::vector<std::string> written = { directory + "/z.txt", directory + "/sub/b.txt", directory + "/a.txt" };
+	for (const std::string& file : written)
+		WriteFile(file, "first");
+	std::this_thread::sleep_for(REWRITE_DELAY);
+	for (const std::string& file : written)
+		WriteFile(file, "second");
+
+	const auto start = std::chrono::steady_clock::now();
+	while (batches.Count() == 0u && std::chrono::steady_clock::now() - start < TIMEOUT)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	// Long enough for a second batch to come, if the rewrites were reported apart
+	std::this_thread::sleep_for(DEBOUNCE * 3);
+	watcher.Stop();
+	OG_CHECK(!watcher.IsWatching());
+
+	std::vector<std::string> expected = written;
+	std::sort(expected.begin(), expected.end());
+
+	std::lock_guard lock(batches.mutex);
+	OG_CHECK(batches.files.size() == 1u);
+	if (batches.files.size() == 1u)
+		OG_CHECK(batches.files.front() == expected);
+}
@@ -0,0 +1,144 @@
+#include "Tests.h"
+#include <OgRendering/Utils/MeshOptimizer.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+
+using namespace OgEngine;
+using namespace OgEngine::Utils;
+
+namespace
+{
+	using Triangle = std::array<uint32_t, 3>;
+
+	/**
+	 * @brief A grid on XY whose triangles are in random order, the worst order for the cache.
+	 * Each vertex keeps its original index in texCoord.x, OptimizeVertexFetch moves the vertices.
+	 */
+	void ShuffledGrid(const uint32_t p_columns, const uint32_t p_rows, const uint32_t p_seed, std::vector<Vertex>& p_vertices,
+		std::vector<uint32_t>& p_indices)
+	{
+		for (uint32_t y = 0u; y <= p_rows; ++y)
+		{
+			for (uint32_t x = 0u; x <= p_columns; ++x)
+			{
+				Vertex& vertex = p_vertices.emplace_back();
+				vertex.position = GPM::Vector3F(static_cast<float>(x), static_cast<float>(y), 0.0f);
+				vertex.normal = GPM::Vector3F(0.0f, 0.0f, 1.0f);
+				vertex.texCoord.x = static_cast<float>(p_vertices.size() - 1u);
+			}
+		}
+
+		std::vector<Triangle> triangles;
+		for (uint32_t y = 0u; y < p_rows; ++y)
+		{
+			for (uint32_t x = 0u; x < p_columns; ++x)
+			{
+				const uint32_t corner = y * (p_columns + 1u) + x;
+				triangles.push_back({ corner, corner + 1u, corner + p_columns + 1u });
+				triangles.push_back({ corner + 1u, corner + p_columns + 2u, corner + p_columns + 1u });
+			}
+		}
+
+		std::shuffle(triangles.begin(), triangles.end(), std::mt19937(p_seed));
+		for (const Triangle& triangle : triangles)
+			p_indices.insert(p_indices.end(), triangle.begin(), triangle.end());
+	}
+
+	/**
+	 * @brief The triangles named by the original index of their vertices, each one starting from its smallest corner so the winding is kept.
+	 */
+	std::vector<Triangle> SortedTriangles(const std::vector<Vertex>& p_vertices, const std::vector<uint32_t>& p_indices)
+	{
+		std::vector<Triangle> triangles(p_indices.size() / 3u);
+		for (size_t i = 0u; i < triangles.size(); ++i)
+		{
+			for (size_t corner = 0u; corner < 3u; ++corner)
+				triangles[i][corner] = static_cast<uint32_t>(p_vertices[p_indices[i * 3u + corner]].texCoord.x);
+
+			std::rotate(triangles[i].begin(), std::min_element(triangles[i].begin(), triangles[i].end()), triangles[i].end());
+		}
+
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	void CheckPasses()
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		ShuffledGrid(64u, 48u, 11u, vertices, indices);
+
+		const std::vector<Triangle> expected = SortedTriangles(vertices, indices);
+		const CacheStatistics shuffled = MeshOptimizer::Analyze(indices, vertices.size());
+
+		// Each pass draws the same triangles, with the same winding
+		MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+		OG_CHECK(SortedTriangles(vertices, indices) == expected);
+		const CacheStatistics cached = MeshOptimizer::Analyze(indices, vertices.size());
+
+		MeshOptimizer::OptimizeOverdraw(indices, vertices);
+		OG_CHECK(SortedTriangles(vertices, indices) == expected);
+		const CacheStatistics overdrawn = MeshOptimizer::Analyze(indices, vertices.size());
+
+		const size_t vertexCount = vertices.size();
+		MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+		OG_CHECK(vertices.size() == vertexCount);
+		OG_CHECK(SortedTriangles(vertices, indices) == expected);
+
+		// The vertices follow the order of their first use
+		uint32_t next = 0u;
+		bool inFetchOrder = true;
+		for (const uint32_t index : indices)
+		{
+			inFetchOrder = inFetchOrder && index <= next;
+			next = std::max(next, index + 1u);
+		}
+		OG_CHECK(inFetchOrder);
+
+		// The shuffled grid misses nearly every vertex, the cache order shares most of them, the overdraw order keeps most of that
+		const std::string statistics = "ACMR " + std::to_string(shuffled.acmr) + " -> " + std::to_string(cached.acmr) + " -> " + std::to_string(overdrawn.acmr)
+			+ ", ATVR " + std::to_string(shuffled.atvr) + " -> " + std::to_string(cached.atvr) + " -> " + std::to_string(overdrawn.atvr);
+		if (!(cached.acmr < shuffled.acmr && cached.atvr < shuffled.atvr && cached.acmr < 1.0f))
+			OgTests::Fail(__FILE__, __LINE__, "the vertex cache order doesn't share the vertices: " + statistics);
+		if (!(overdrawn.acmr < shuffled.acmr && overdrawn.atvr < shuffled.atvr && overdrawn.acmr < cached.acmr * 1.25f))
+			OgTests::Fail(__FILE__, __LINE__, "the overdraw order loses the cache order: " + statistics);
+	}
+
+	void CheckOptimize()
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		ShuffledGrid(40u, 40u, 5u, vertices, indices);
+
+		// A vertex no triangle uses is removed
+		Vertex& unused = vertices.emplace_back();
+		unused.texCoord.x = static_cast<float>(vertices.size() - 1u);
+		const size_t usedVertices = vertices.size() - 1u;
+
+		const std::vector<Triangle> expected = SortedTriangles(vertices, indices);
+		const CacheStatistics before = MeshOptimizer::Analyze(indices, vertices.size());
+		MeshOptimizer::Optimize(vertices, indices);
+		const CacheStatistics after = MeshOptimizer::Analyze(indices, vertices.size());
+
+		OG_CHECK(vertices.size() == usedVertices);
+		OG_CHECK(SortedTriangles(vertices, indices) == expected);
+		OG_CHECK(after.acmr < before.acmr);
+		OG_CHECK(after.atvr < before.atvr);
+
+		// The statistics of a single triangle, every vertex missed once
+		const CacheStatistics single = MeshOptimizer::Analyze({ 0u, 1u, 2u }, 3u);
+		OG_CHECK(single.acmr == 3.0f);
+		OG_CHECK(single.atvr == 1.0f);
+	}
+}
+
+/**
+ * The passes of the optimizer on a shuffled grid: the triangles kept, the vertex cache statistics lowered.
+ */
+OG_SUITE(MeshOptimizer)
+{
+	CheckPasses();
+	CheckOptimize();
+}
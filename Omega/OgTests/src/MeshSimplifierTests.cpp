@@ -0,0 +1,294 @@
+#include "Tests.h"
+#include <OgRendering/Utils/MeshSimplifier.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+using namespace OgEngine;
+using namespace OgEngine::Utils;
+
+namespace
+{
+	constexpr uint32_t COLUMNS = 48u;
+	constexpr uint32_t ROWS = 32u;
+	// The column of vertices split in two, the texture coordinates jump there
+	constexpr uint32_t SEAM_COLUMN = COLUMNS / 2u;
+
+	struct TestMesh
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	/**
+	 * @brief A grid on XY with its height on Z, split along the seam column: the vertices left of it have texCoord.x 0, the ones right of it 1.
+	 */
+	template<typename Height>
+	TestMesh SeamGrid(Height&& p_height)
+	{
+		TestMesh mesh;
+		std::vector<uint32_t> left((COLUMNS + 1u) * (ROWS + 1u)), right(left.size());
+		for (uint32_t y = 0u; y <= ROWS; ++y)
+		{
+			for (uint32_t x = 0u; x <= COLUMNS; ++x)
+			{
+				Vertex vertex;
+				vertex.position = GPM::Vector3F(static_cast<float>(x), static_cast<float>(y), p_height(static_cast<float>(x), static_cast<float>(y)));
+				vertex.normal = GPM::Vector3F(0.0f, 0.0f, 1.0f);
+
+				const uint32_t cell = y * (COLUMNS + 1u) + x;
+				if (x <= SEAM_COLUMN)
+				{
+					left[cell] = static_cast<uint32_t>(mesh.vertices.size());
+					mesh.vertices.emplace_back(vertex);
+				}
+				if (x >= SEAM_COLUMN)
+				{
+					vertex.texCoord.x = 1.0f;
+					right[cell] = static_cast<uint32_t>(mesh.vertices.size());
+					mesh.vertices.emplace_back(vertex);
+				}
+			}
+		}
+
+		for (uint32_t y = 0u; y < ROWS; ++y)
+		{
+			for (uint32_t x = 0u; x < COLUMNS; ++x)
+			{
+				const std::vector<uint32_t>& side = x < SEAM_COLUMN ? left : right;
+				const uint32_t corner = y * (COLUMNS + 1u) + x;
+				mesh.indices.insert(mesh.indices.end(), { side[corner], side[corner + 1u], side[corner + COLUMNS + 1u] });
+				mesh.indices.insert(mesh.indices.end(), { side[corner + 1u], side[corner + COLUMNS + 2u], side[corner + COLUMNS + 1u] });
+			}
+		}
+
+		return mesh;
+	}
+
+	TestMesh FlatGrid()
+	{
+		return SeamGrid([](float, float) { return 0.0f; });
+	}
+
+	TestMesh Hills()
+	{
+		return SeamGrid([](const float p_x, const float p_y) { return 2.0f * std::sin(p_x * 0.2f) * std::cos(p_y * 0.15f); });
+	}
+
+	float Cross2D(const Vertex& p_a, const Vertex& p_b, const Vertex& p_c)
+	{
+		return (p_b.position.x - p_a.position.x) * (p_c.position.y - p_a.position.y) - (p_b.position.y - p_a.position.y) * (p_c.position.x - p_a.position.x);
+	}
+
+	/**
+	 * @brief Indices in range, triangles with an area, none flipped: seen from above, like the grid, they all turn the same way.
+	 * A triangle standing on its edge is allowed, the grid may be steep.
+	 */
+	bool IsValidLevel(const TestMesh& p_mesh, const std::vector<uint32_t>& p_indices)
+	{
+		if (p_indices.empty() || p_indices.size() % 3u != 0u)
+			return false;
+
+		for (size_t i = 0u; i < p_indices.size(); i += 3u)
+		{
+			if (p_indices[i] >= p_mesh.vertices.size() || p_indices[i + 1u] >= p_mesh.vertices.size() || p_indices[i + 2u] >= p_mesh.vertices.size())
+				return false;
+
+			const GPM::Vector3F& a = p_mesh.vertices[p_indices[i]].position;
+			const GPM::Vector3F& b = p_mesh.vertices[p_indices[i + 1u]].position;
+			const GPM::Vector3F& c = p_mesh.vertices[p_indices[i + 2u]].position;
+			const float x = (b.y - a.y) * (c.z - a.z) - (b.z - a.z) * (c.y - a.y);
+			const float y = (b.z - a.z) * (c.x - a.x) - (b.x - a.x) * (c.z - a.z);
+			const float z = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+			if (x * x + y * y + z * z <= 0.0f || z < 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief The borders and the seam only collapse along themselves:
+	 * the edges of the level with no opposite lie on a side of the grid, the four corners and the ends of the seam are kept,
+	 * no triangle crosses the seam and both sides keep the same vertices on it.
+	 */
+	bool KeepsBordersAndSeam(const TestMesh& p_mesh, const std::vector<uint32_t>& p_indices)
+	{
+		using Position = std::pair<float, float>;
+		const auto position = [&p_mesh](const uint32_t p_index)
+		{
+			return Position(p_mesh.vertices[p_index].position.x, p_mesh.vertices[p_index].position.y);
+		};
+
+		std::map<std::pair<Position, Position>, int> edges;
+		std::set<Position> used, leftSeam, rightSeam;
+		for (size_t i = 0u; i < p_indices.size(); i += 3u)
+		{
+			const float side = p_mesh.vertices[p_indices[i]].texCoord.x;
+			for (size_t corner = 0u; corner < 3u; ++corner)
+			{
+				const uint32_t index = p_indices[i + corner];
+				if (p_mesh.vertices[index].texCoord.x != side)
+					return false;
+
+				used.insert(position(index));
+				if (p_mesh.vertices[index].position.x == static_cast<float>(SEAM_COLUMN))
+					(side == 0.0f ? leftSeam : rightSeam).insert(position(index));
+
+				++edges[{ position(index), position(p_indices[i + (corner + 1u) % 3u]) }];
+			}
+		}
+
+		if (leftSeam != rightSeam)
+			return false;
+
+		const auto width = static_cast<float>(COLUMNS), height = static_cast<float>(ROWS), seam = static_cast<float>(SEAM_COLUMN);
+		for (const Position& kept : { Position(0.0f, 0.0f), Position(width, 0.0f), Position(0.0f, height), Position(width, height),
+			Position(seam, 0.0f), Position(seam, height) })
+		{
+			if (used.count(kept) == 0u)
+				return false;
+		}
+
+		for (const auto& [edge, count] : edges)
+		{
+			if (edges.count({ edge.second, edge.first }) != 0u)
+				continue;
+
+			const Position& from = edge.first;
+			const Position& to = edge.second;
+			const bool alongSide = (from.first == to.first && (from.first == 0.0f || from.first == width))
+				|| (from.second == to.second && (from.second == 0.0f || from.second == height));
+			if (!alongSide)
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Largest vertical distance between the grid vertices and the level, found from the triangle of the level above each of them.
+	 */
+	float LargestDeviation(const TestMesh& p_mesh, const std::vector<uint32_t>& p_indices)
+	{
+		float largest = 0.0f;
+		for (const Vertex& vertex : p_mesh.vertices)
+		{
+			for (size_t i = 0u; i < p_indices.size(); i += 3u)
+			{
+				const Vertex& a = p_mesh.vertices[p_indices[i]];
+				const Vertex& b = p_mesh.vertices[p_indices[i + 1u]];
+				const Vertex& c = p_mesh.vertices[p_indices[i + 2u]];
+				const float area = Cross2D(a, b, c);
+				if (area <= 0.0f)
+					continue;
+
+				const float u = Cross2D(vertex, b, c) / area, v = Cross2D(a, vertex, c) / area, w = Cross2D(a, b, vertex) / area;
+				if (u < -1e-5f || v < -1e-5f || w < -1e-5f)
+					continue;
+
+				largest = std::max(largest, std::abs(u * a.position.z + v * b.position.z + w * c.position.z - vertex.position.z));
+				break;
+			}
+		}
+
+		return largest;
+	}
+
+	void CheckFlatGrid()
+	{
+		const TestMesh mesh = FlatGrid();
+		const size_t triangleCount = mesh.indices.size() / 3u;
+
+		// A flat grid costs nothing to simplify, every level reaches its ratio
+		const std::vector<MeshLod> lods = MeshSimplifier::BuildLods(mesh.vertices, mesh.indices);
+		OG_CHECK(lods.size() == MeshSimplifier::DEFAULT_RATIOS.size());
+		for (size_t level = 0u; level < lods.size() && level < MeshSimplifier::DEFAULT_RATIOS.size(); ++level)
+		{
+			const std::vector<uint32_t>& indices = lods[level].indices;
+			const auto target = static_cast<size_t>(static_cast<float>(triangleCount) * MeshSimplifier::DEFAULT_RATIOS[level]);
+			const std::string name = "level " + std::to_string(level) + " of the flat grid";
+
+			if (!IsValidLevel(mesh, indices))
+				OgTests::Fail(__FILE__, __LINE__, name + " isn't a valid triangle list");
+			if (indices.size() > target * 3u || indices.size() * 10u < target * 3u * 9u)
+				OgTests::Fail(__FILE__, __LINE__, name + " has " + std::to_string(indices.size() / 3u) + " triangles for " + std::to_string(target));
+			if (!KeepsBordersAndSeam(mesh, indices))
+				OgTests::Fail(__FILE__, __LINE__, name + " moved its borders or its seam");
+			if (LargestDeviation(mesh, indices) > 1e-5f || lods[level].error > 1e-3f)
+				OgTests::Fail(__FILE__, __LINE__, name + " left the plane");
+		}
+
+		// As far as it goes, down to the corners and the ends of the seam
+		const MeshLod coarsest = MeshSimplifier::Simplify(mesh.vertices, mesh.indices, 0u, MeshSimplifier::DEFAULT_MAX_ERROR);
+		OG_CHECK(IsValidLevel(mesh, coarsest.indices));
+		OG_CHECK(KeepsBordersAndSeam(mesh, coarsest.indices));
+		OG_CHECK(coarsest.indices.size() < mesh.indices.size() / 20u);
+	}
+
+	void CheckErrorBound()
+	{
+		const TestMesh mesh = Hills();
+		const float extent = static_cast<float>(COLUMNS);
+
+		size_t previousIndexCount = 0u;
+		for (const float maxError : { 0.001f, 0.005f, 0.02f })
+		{
+			const MeshLod lod = MeshSimplifier::Simplify(mesh.vertices, mesh.indices, 0u, maxError);
+			const std::string name = "the hills simplified to " + std::to_string(maxError);
+
+			if (!IsValidLevel(mesh, lod.indices) || !KeepsBordersAndSeam(mesh, lod.indices))
+				OgTests::Fail(__FILE__, __LINE__, name + " aren't a valid level");
+			// The reported error stays under the bound. It averages the squared distances to the planes around the collapsed vertices,
+			// a single vertex of the surface strays a few times further but never far past it
+			if (lod.error > maxError * extent * 1.0001f)
+				OgTests::Fail(__FILE__, __LINE__, name + " report an error of " + std::to_string(lod.error));
+			if (LargestDeviation(mesh, lod.indices) > 5.0f * maxError * extent)
+				OgTests::Fail(__FILE__, __LINE__, name + " stray " + std::to_string(LargestDeviation(mesh, lod.indices)) + " from the surface");
+
+			// A larger error allows fewer triangles
+			if (previousIndexCount != 0u && lod.indices.size() >= previousIndexCount)
+				OgTests::Fail(__FILE__, __LINE__, name + " have no fewer triangles than with a smaller error");
+			previousIndexCount = lod.indices.size();
+		}
+
+		// The levels get coarser and their error never goes down
+		const std::vector<MeshLod> lods = MeshSimplifier::BuildLods(mesh.vertices, mesh.indices);
+		OG_CHECK(!lods.empty());
+		for (size_t level = 0u; level < lods.size(); ++level)
+		{
+			OG_CHECK(IsValidLevel(mesh, lods[level].indices));
+			OG_CHECK(lods[level].error <= MeshSimplifier::DEFAULT_MAX_ERROR * extent * 1.0001f);
+			if (level > 0u)
+			{
+				OG_CHECK(lods[level].indices.size() < lods[level - 1u].indices.size());
+				OG_CHECK(lods[level].error >= lods[level - 1u].error);
+			}
+		}
+	}
+
+	void CheckInvalidInput()
+	{
+		// Not a triangle list, or an index out of the vertices: nothing simplified
+		TestMesh mesh = FlatGrid();
+		mesh.indices.pop_back();
+		OG_CHECK(MeshSimplifier::Simplify(mesh.vertices, mesh.indices, 0u, 1.0f).indices == mesh.indices);
+		OG_CHECK(MeshSimplifier::BuildLods(mesh.vertices, mesh.indices).empty());
+
+		mesh.indices.emplace_back(static_cast<uint32_t>(mesh.vertices.size()));
+		OG_CHECK(MeshSimplifier::Simplify(mesh.vertices, mesh.indices, 0u, 1.0f).indices == mesh.indices);
+	}
+}
+
+/**
+ * The levels of detail: valid triangle lists at their target ratios, within their error, the borders and the seams in place.
+ */
+OG_SUITE(MeshSimplifier)
+{
+	CheckFlatGrid();
+	CheckErrorBound();
+	CheckInvalidInput();
+}
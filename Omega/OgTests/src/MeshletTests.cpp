@@ -0,0 +1,269 @@
+#include "Tests.h"
+#include <OgRendering/Utils/MeshletBuilder.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+
+using namespace OgEngine;
+using namespace OgEngine::Utils;
+
+namespace
+{
+	struct TestMesh
+	{
+		const char* name;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	Vertex MakeVertex(const float p_x, const float p_y, const float p_z)
+	{
+		Vertex vertex;
+		vertex.position = GPM::Vector3F(p_x, p_y, p_z);
+		vertex.normal = GPM::Vector3F(0.0f, 0.0f, 1.0f);
+		return vertex;
+	}
+
+	TestMesh Grid(const uint32_t p_columns, const uint32_t p_rows)
+	{
+		TestMesh mesh{ "grid", {}, {} };
+		for (uint32_t y = 0u; y <= p_rows; ++y)
+			for (uint32_t x = 0u; x <= p_columns; ++x)
+				mesh.vertices.emplace_back(MakeVertex(static_cast<float>(x), static_cast<float>(y), 0.0f));
+
+		for (uint32_t y = 0u; y < p_rows; ++y)
+		{
+			for (uint32_t x = 0u; x < p_columns; ++x)
+			{
+				const uint32_t corner = y * (p_columns + 1u) + x;
+				mesh.indices.insert(mesh.indices.end(), { corner, corner + 1u, corner + p_columns + 1u });
+				mesh.indices.insert(mesh.indices.end(), { corner + 1u, corner + p_columns + 2u, corner + p_columns + 1u });
+			}
+		}
+
+		return mesh;
+	}
+
+	TestMesh Sphere(const uint32_t p_slices, const uint32_t p_stacks)
+	{
+		TestMesh mesh{ "sphere", {}, {} };
+		for (uint32_t stack = 0u; stack <= p_stacks; ++stack)
+		{
+			const float theta = 3.14159265f * static_cast<float>(stack) / static_cast<float>(p_stacks);
+			for (uint32_t slice = 0u; slice <= p_slices; ++slice)
+			{
+				const float phi = 6.28318531f * static_cast<float>(slice) / static_cast<float>(p_slices);
+				mesh.vertices.emplace_back(MakeVertex(std::sin(theta) * std::cos(phi) * 3.0f, std::cos(theta) * 3.0f, std::sin(theta) * std::sin(phi) * 3.0f));
+			}
+		}
+
+		for (uint32_t stack = 0u; stack < p_stacks; ++stack)
+		{
+			for (uint32_t slice = 0u; slice < p_slices; ++slice)
+			{
+				const uint32_t corner = stack * (p_slices + 1u) + slice;
+				mesh.indices.insert(mesh.indices.end(), { corner, corner + p_slices + 1u, corner + 1u });
+				mesh.indices.insert(mesh.indices.end(), { corner + 1u, corner + p_slices + 1u, corner + p_slices + 2u });
+			}
+		}
+
+		return mesh;
+	}
+
+	// A grid with its triangles in random order, the meshlets can't follow the order they are given in
+	TestMesh ShuffledGrid(const uint32_t p_columns, const uint32_t p_rows, const uint32_t p_seed)
+	{
+		TestMesh mesh = Grid(p_columns, p_rows);
+		mesh.name = "shuffled grid";
+
+		std::vector<uint32_t> order(mesh.indices.size() / 3u);
+		std::iota(order.begin(), order.end(), 0u);
+		std::shuffle(order.begin(), order.end(), std::mt19937(p_seed));
+
+		std::vector<uint32_t> indices;
+		indices.reserve(mesh.indices.size());
+		for (const uint32_t triangle : order)
+			indices.insert(indices.end(), mesh.indices.begin() + triangle * 3u, mesh.indices.begin() + triangle * 3u + 3u);
+		mesh.indices.swap(indices);
+
+		return mesh;
+	}
+
+	// Every triangle around one vertex, more than a meshlet can hold
+	TestMesh Fan(const uint32_t p_triangles)
+	{
+		TestMesh mesh{ "fan", {}, {} };
+		mesh.vertices.emplace_back(MakeVertex(0.0f, 0.0f, 0.0f));
+		for (uint32_t i = 0u; i <= p_triangles; ++i)
+		{
+			const float angle = 6.28318531f * static_cast<float>(i) / static_cast<float>(p_triangles);
+			mesh.vertices.emplace_back(MakeVertex(std::cos(angle), std::sin(angle), 0.0f));
+		}
+
+		for (uint32_t i = 0u; i < p_triangles; ++i)
+			mesh.indices.insert(mesh.indices.end(), { 0u, i + 1u, i + 2u });
+
+		return mesh;
+	}
+
+	// Triangles sharing no vertex, and random ones between a few vertices, degenerate ones included
+	TestMesh Soup(const uint32_t p_separate, const uint32_t p_random, const uint32_t p_seed)
+	{
+		TestMesh mesh{ "soup", {}, {} };
+		std::mt19937 random(p_seed);
+		std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+
+		for (uint32_t i = 0u; i < p_separate * 3u; ++i)
+		{
+			mesh.vertices.emplace_back(MakeVertex(coordinate(random), coordinate(random), coordinate(random)));
+			mesh.indices.emplace_back(i);
+		}
+
+		const uint32_t shared = static_cast<uint32_t>(mesh.vertices.size());
+		for (uint32_t i = 0u; i < 40u; ++i)
+			mesh.vertices.emplace_back(MakeVertex(coordinate(random), coordinate(random), coordinate(random)));
+
+		std::uniform_int_distribution<uint32_t> vertex(shared, shared + 39u);
+		for (uint32_t i = 0u; i < p_random * 3u; ++i)
+			mesh.indices.emplace_back(vertex(random));
+
+		return mesh;
+	}
+
+	using Triangle = std::array<uint32_t, 3>;
+
+	uint32_t Id(const Vertex& p_vertex)
+	{
+		return static_cast<uint32_t>(p_vertex.texCoord.x);
+	}
+
+	/**
+	 * @brief The triangles of a mesh, named by the original index of their vertices, stored in texCoord.x since the copies of a vertex drop its dummy.
+	 */
+	std::vector<Triangle> SortedTriangles(const std::vector<Vertex>& p_vertices, const std::vector<uint32_t>& p_indices)
+	{
+		std::vector<Triangle> triangles(p_indices.size() / 3u);
+		for (size_t i = 0u; i < triangles.size(); ++i)
+			for (size_t corner = 0u; corner < 3u; ++corner)
+				triangles[i][corner] = Id(p_vertices[p_indices[i * 3u + corner]]);
+
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	float Distance(const float* p_center, const GPM::Vector3F& p_position)
+	{
+		const float x = p_position.x - p_center[0];
+		const float y = p_position.y - p_center[1];
+		const float z = p_position.z - p_center[2];
+		return std::sqrt(x * x + y * y + z * z);
+	}
+}
+
+/**
+ * The limits, the triangles and the bounds of the meshlets, on regular, shuffled, high valence and scattered meshes.
+ */
+OG_SUITE(Meshlet)
+{
+	std::vector<TestMesh> meshes;
+	meshes.emplace_back(Grid(1u, 1u));
+	meshes.emplace_back(Grid(97u, 53u));
+	meshes.emplace_back(Sphere(48u, 31u));
+	meshes.emplace_back(ShuffledGrid(64u, 40u, 7u));
+	meshes.emplace_back(Fan(500u));
+	meshes.emplace_back(Soup(300u, 200u, 3u));
+
+	for (TestMesh& mesh : meshes)
+	{
+		for (size_t i = 0u; i < mesh.vertices.size(); ++i)
+			mesh.vertices[i].texCoord.x = static_cast<float>(i);
+
+		const std::vector<Triangle> expected = SortedTriangles(mesh.vertices, mesh.indices);
+		const MeshletData data = MeshletBuilder::Build(mesh.vertices, mesh.indices);
+
+		if (data.Empty())
+		{
+			OgTests::Fail(__FILE__, __LINE__, std::string("no meshlet built for the ") + mesh.name);
+			continue;
+		}
+		OG_CHECK(MeshletBuilder::Validate(data, mesh.vertices.size(), mesh.indices));
+
+		// Every triangle exactly once, through the local indices of the meshlets
+		std::vector<Triangle> triangles;
+		bool inLimits = true, inSpheres = true;
+		for (const Meshlet& meshlet : data.meshlets)
+		{
+			inLimits = inLimits && meshlet.vertexCount <= MeshletBuilder::MAX_VERTICES && meshlet.triangleCount <= MeshletBuilder::MAX_TRIANGLES
+				&& meshlet.vertexCount > 0u && meshlet.triangleCount > 0u;
+
+			for (uint32_t triangle = meshlet.triangleOffset; triangle < meshlet.triangleOffset + meshlet.triangleCount; ++triangle)
+			{
+				Triangle& named = triangles.emplace_back();
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					const uint8_t local = data.triangles[triangle * 3u + corner];
+					named[corner] = local < meshlet.vertexCount
+						? Id(mesh.vertices[data.vertices[meshlet.vertexOffset + local]]) : ~0u;
+				}
+			}
+
+			// The sphere holds every vertex, up to the rounding of its radius
+			for (uint32_t vertex = meshlet.vertexOffset; vertex < meshlet.vertexOffset + meshlet.vertexCount; ++vertex)
+				inSpheres = inSpheres && Distance(meshlet.center, mesh.vertices[data.vertices[vertex]].position) <= meshlet.radius * 1.0001f + 1e-5f;
+		}
+
+		std::sort(triangles.begin(), triangles.end());
+		if (!inLimits)
+			OgTests::Fail(__FILE__, __LINE__, std::string("a meshlet of the ") + mesh.name + " is empty or over the limits");
+		if (triangles != expected)
+			OgTests::Fail(__FILE__, __LINE__, std::string("the meshlets of the ") + mesh.name + " don't hold every triangle exactly once");
+		if (!inSpheres)
+			OgTests::Fail(__FILE__, __LINE__, std::string("a vertex of the ") + mesh.name + " is out of the sphere of its meshlet");
+
+		// The index buffer draws the same triangles as before
+		OG_CHECK(SortedTriangles(mesh.vertices, mesh.indices) == expected);
+	}
+
+	// Not a triangle list: nothing built, nothing changed
+	TestMesh invalid = Grid(2u, 2u);
+	invalid.indices.pop_back();
+	const std::vector<uint32_t> indices = invalid.indices;
+	OG_CHECK(MeshletBuilder::Build(invalid.vertices, invalid.indices).Empty());
+	OG_CHECK(invalid.indices == indices);
+
+	invalid.indices.emplace_back(static_cast<uint32_t>(invalid.vertices.size()));
+	OG_CHECK(MeshletBuilder::Build(invalid.vertices, invalid.indices).Empty());
+}
+
+OG_BENCHMARK(MeshletBenchmark)
+{
+	std::printf("%-16s %10s %10s %12s %14s %10s %10s\n", "mesh", "triangles", "meshlets", "best ms", "Mtriangles/s", "vertices", "triangles");
+
+	for (const TestMesh& mesh : { Grid(512u, 512u), Sphere(1024u, 512u), ShuffledGrid(512u, 512u, 1u) })
+	{
+		const size_t triangleCount = mesh.indices.size() / 3u;
+		double best = 0.0;
+		MeshletData data;
+		for (uint32_t i = 0u; i < 5u; ++i)
+		{
+			// Build reorders the buffers, every run starts from the mesh as given
+			std::vector<Vertex> vertices = mesh.vertices;
+			std::vector<uint32_t> indices = mesh.indices;
+
+			const auto start = std::chrono::steady_clock::now();
+			data = MeshletBuilder::Build(vertices, indices);
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			best = i == 0u ? elapsed : std::min(best, elapsed);
+		}
+
+		// Average fill of the meshlets, against the limits of 64 vertices and 124 triangles
+		const double meshlets = static_cast<double>(std::max<size_t>(1u, data.meshlets.size()));
+		std::printf("%-16s %10zu %10zu %12.3f %14.2f %10.1f %10.1f\n", mesh.name, triangleCount, data.meshlets.size(), best * 1000.0,
+			best > 0.0 ? static_cast<double>(triangleCount) / best / 1e6 : 0.0,
+			static_cast<double>(data.vertices.size()) / meshlets, static_cast<double>(triangleCount) / meshlets);
+	}
+}
@@ -0,0 +1,243 @@
+#include "Tests.h"
+#include <OgRendering/Utils/MipGenerator.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+
+using namespace OgEngine;
+using namespace OgEngine::Utils;
+
+namespace
+{
+	std::vector<uint8_t> RandomImage(const uint32_t p_width, const uint32_t p_height, const uint32_t p_channels, const uint32_t p_seed)
+	{
+		std::mt19937 random(p_seed);
+		std::vector<uint8_t> image(static_cast<size_t>(p_width) * p_height * p_channels);
+		for (uint8_t& value : image)
+			value = static_cast<uint8_t>(random());
+
+		return image;
+	}
+
+	/**
+	 * @brief Pixel by pixel box filter, what the SSE2 and AVX2 rows must give to the bit.
+	 */
+	std::vector<uint8_t> ReferenceBox(const std::vector<uint8_t>& p_source, const uint32_t p_width, const uint32_t p_height, const uint32_t p_channels)
+	{
+		const uint32_t width = std::max(1u, p_width / 2u);
+		const uint32_t height = std::max(1u, p_height / 2u);
+		std::vector<uint8_t> result(static_cast<size_t>(width) * height * p_channels);
+
+		for (uint32_t y = 0u; y < height; ++y)
+		{
+			const uint32_t y0 = std::min(y * 2u, p_height - 1u);
+			const uint32_t y1 = std::min(y * 2u + 1u, p_height - 1u);
+			for (uint32_t x = 0u; x < width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2u, p_width - 1u);
+				const uint32_t x1 = std::min(x * 2u + 1u, p_width - 1u);
+				for (uint32_t channel = 0u; channel < p_channels; ++channel)
+				{
+					const auto at = [&](const uint32_t p_x, const uint32_t p_y) { return p_source[(static_cast<size_t>(p_y) * p_width + p_x) * p_channels + channel]; };
+					const uint32_t sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+					result[(static_cast<size_t>(y) * width + x) * p_channels + channel] = static_cast<uint8_t>((sum + 2u) / 4u);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	float ToLinear(const uint8_t p_value)
+	{
+		const float srgb = static_cast<float>(p_value) / 255.0f;
+		return srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float ToSrgb(const float p_linear)
+	{
+		const float srgb = p_linear <= 0.0031308f ? p_linear * 12.92f : 1.055f * std::pow(p_linear, 1.0f / 2.4f) - 0.055f;
+		return std::clamp(srgb, 0.0f, 1.0f) * 255.0f;
+	}
+
+	uint32_t Difference(const uint8_t p_a, const uint8_t p_b)
+	{
+		return static_cast<uint32_t>(std::abs(static_cast<int>(p_a) - static_cast<int>(p_b)));
+	}
+
+	/**
+	 * @return The best time of a few runs, in seconds
+	 */
+	double BestTime(const std::function<void()>& p_run)
+	{
+		double best = 0.0;
+		for (uint32_t i = 0u; i < 5u; ++i)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			p_run();
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			best = i == 0u ? elapsed : std::min(best, elapsed);
+		}
+
+		return best;
+	}
+
+	// Odd sides, sides of 1 pixel and rows shorter or longer than a vector
+	const std::vector<std::pair<uint32_t, uint32_t>> SIZES = {
+		{ 1u, 1u }, { 2u, 2u }, { 1u, 9u }, { 9u, 1u }, { 3u, 5u }, { 16u, 16u }, { 17u, 33u }, { 64u, 3u }, { 129u, 70u }, { 256u, 256u }
+	};
+}
+
+/**
+ * Every filter against a scalar reference, on random images of every channel count and of awkward sizes.
+ */
+OG_SUITE(MipGenerator)
+{
+	OG_CHECK(MipGenerator::LevelCount(1u, 1u) == 1u);
+	OG_CHECK(MipGenerator::LevelCount(256u, 256u) == 9u);
+	OG_CHECK(MipGenerator::LevelCount(257u, 3u) == 9u);
+
+	for (const auto& [width, height] : SIZES)
+	{
+		const uint32_t destinationWidth = std::max(1u, width / 2u);
+		const uint32_t destinationHeight = std::max(1u, height / 2u);
+		for (uint32_t channels = 1u; channels <= 4u; ++channels)
+		{
+			const std::vector<uint8_t> image = RandomImage(width, height, channels, width * 131u + height * 7u + channels);
+			std::vector<uint8_t> result(static_cast<size_t>(destinationWidth) * destinationHeight * channels);
+
+			// Linear box: exactly the reference, whatever the instruction set
+			MipSettings settings;
+			settings.channels = channels;
+			MipGenerator::Downsample(image.data(), width, height, result.data(), settings);
+			OG_CHECK(result == ReferenceBox(image, width, height, channels));
+
+			// sRGB box: averaged in linear space, the alpha channel excepted, within the rounding of the tables
+			settings.srgb = true;
+			MipGenerator::Downsample(image.data(), width, height, result.data(), settings);
+			const std::vector<uint8_t> linearBox = ReferenceBox(image, width, height, channels);
+			uint32_t srgbError = 0u;
+			for (uint32_t y = 0u; y < destinationHeight; ++y)
+			{
+				for (uint32_t x = 0u; x < destinationWidth; ++x)
+				{
+					for (uint32_t channel = 0u; channel < channels; ++channel)
+					{
+						const size_t index = (static_cast<size_t>(y) * destinationWidth + x) * channels + channel;
+						const bool isColor = channels < 3u ? channel == 0u : channel < 3u;
+						if (!isColor)
+						{
+							srgbError = std::max(srgbError, Difference(result[index], linearBox[index]));
+							continue;
+						}
+
+						float sum = 0.0f;
+						for (const uint32_t sourceY : { std::min(y * 2u, height - 1u), std::min(y * 2u + 1u, height - 1u) })
+						{
+							for (const uint32_t sourceX : { std::min(x * 2u, width - 1u), std::min(x * 2u + 1u, width - 1u) })
+								sum += ToLinear(image[(static_cast<size_t>(sourceY) * width + sourceX) * channels + channel]);
+						}
+						const uint8_t expected = static_cast<uint8_t>(ToSrgb(sum * 0.25f) + 0.5f);
+						srgbError = std::max(srgbError, Difference(result[index], expected));
+					}
+				}
+			}
+			OG_CHECK(srgbError <= 1u);
+
+			// Kaiser: a flat image stays flat, its weights sum to 1
+			settings.srgb = false;
+			settings.filter = MIP_FILTER::KAISER;
+			const std::vector<uint8_t> flat(image.size(), static_cast<uint8_t>(37u * channels));
+			MipGenerator::Downsample(flat.data(), width, height, result.data(), settings);
+			OG_CHECK(std::all_of(result.begin(), result.end(), [channels](const uint8_t p_value) { return Difference(p_value, static_cast<uint8_t>(37u * channels)) <= 1u; }));
+		}
+
+		// 16 bits and floats are box filtered as they are stored
+		std::vector<uint16_t> wide(static_cast<size_t>(width) * height);
+		std::vector<float> floats(wide.size());
+		for (size_t i = 0u; i < wide.size(); ++i)
+		{
+			wide[i] = static_cast<uint16_t>((i * 2654435761u) >> 8u);
+			floats[i] = static_cast<float>(wide[i]) / 65535.0f;
+		}
+
+		std::vector<uint16_t> wideResult(static_cast<size_t>(destinationWidth) * destinationHeight);
+		std::vector<float> floatResult(wideResult.size());
+		MipSettings wideSettings;
+		wideSettings.channels = 1u;
+		wideSettings.channelBytes = 2u;
+		MipGenerator::Downsample(reinterpret_cast<const uint8_t*>(wide.data()), width, height, reinterpret_cast<uint8_t*>(wideResult.data()), wideSettings);
+		wideSettings.channelBytes = 4u;
+		MipGenerator::Downsample(reinterpret_cast<const uint8_t*>(floats.data()), width, height, reinterpret_cast<uint8_t*>(floatResult.data()), wideSettings);
+
+		for (uint32_t y = 0u; y < destinationHeight; ++y)
+		{
+			for (uint32_t x = 0u; x < destinationWidth; ++x)
+			{
+				const size_t i00 = static_cast<size_t>(std::min(y * 2u, height - 1u)) * width + std::min(x * 2u, width - 1u);
+				const size_t i01 = static_cast<size_t>(std::min(y * 2u, height - 1u)) * width + std::min(x * 2u + 1u, width - 1u);
+				const size_t i10 = static_cast<size_t>(std::min(y * 2u + 1u, height - 1u)) * width + std::min(x * 2u, width - 1u);
+				const size_t i11 = static_cast<size_t>(std::min(y * 2u + 1u, height - 1u)) * width + std::min(x * 2u + 1u, width - 1u);
+				const size_t index = static_cast<size_t>(y) * destinationWidth + x;
+
+				const float wideAverage = (static_cast<float>(wide[i00]) + wide[i01] + wide[i10] + wide[i11]) * 0.25f;
+				OG_CHECK(std::abs(static_cast<float>(wideResult[index]) - wideAverage) <= 0.5f);
+				const float floatAverage = (floats[i00] + floats[i01] + floats[i10] + floats[i11]) * 0.25f;
+				OG_CHECK(std::abs(floatResult[index] - floatAverage) <= 1e-6f);
+			}
+		}
+	}
+
+	// A chain is each level downsampled from the previous one, down to 1x1
+	const std::vector<uint8_t> image = RandomImage(100u, 36u, 4u, 5u);
+	std::vector<MipLevel> levels;
+	const std::vector<uint8_t> chain = MipGenerator::BuildChain(image.data(), 100u, 36u, levels);
+	OG_CHECK(levels.size() == MipGenerator::LevelCount(100u, 36u));
+	OG_CHECK(levels.back().width == 1u && levels.back().height == 1u);
+	OG_CHECK(std::equal(image.begin(), image.end(), chain.begin()));
+	for (size_t level = 1u; level < levels.size(); ++level)
+	{
+		const MipLevel& parent = levels[level - 1u];
+		const std::vector<uint8_t> previous(chain.begin() + static_cast<ptrdiff_t>(parent.offset), chain.begin() + static_cast<ptrdiff_t>(parent.offset + parent.size));
+		const std::vector<uint8_t> expected = ReferenceBox(previous, parent.width, parent.height, 4u);
+		OG_CHECK(levels[level].size == expected.size());
+		OG_CHECK(std::equal(expected.begin(), expected.end(), chain.begin() + static_cast<ptrdiff_t>(levels[level].offset)));
+	}
+}
+
+/**
+ * Throughput of each filter on a 2048x2048 RGBA image, with the scalar reference as the baseline of the vectorized box filter.
+ */
+OG_BENCHMARK(MipGeneratorBenchmark)
+{
+	constexpr uint32_t size = 2048u;
+	const std::vector<uint8_t> image = RandomImage(size, size, 4u, 1u);
+	std::vector<uint8_t> result(image.size() / 4u);
+	const double megabytes = static_cast<double>(image.size()) / (1024.0 * 1024.0);
+
+	std::printf("%-16s %12s %12s\n", "filter", "best ms", "MB/s");
+	const auto print = [megabytes](const char* p_name, const double p_seconds)
+	{
+		std::printf("%-16s %12.3f %12.1f\n", p_name, p_seconds * 1000.0, p_seconds > 0.0 ? megabytes / p_seconds : 0.0);
+	};
+
+	const double scalar = BestTime([&]() { result = ReferenceBox(image, size, size, 4u); });
+	print("box scalar", scalar);
+
+	MipSettings settings;
+	const double box = BestTime([&]() { MipGenerator::Downsample(image.data(), size, size, result.data(), settings); });
+	print("box", box);
+	std::printf("%-16s %11.1fx\n", "box speed-up", box > 0.0 ? scalar / box : 0.0);
+
+	settings.srgb = true;
+	print("box sRGB", BestTime([&]() { MipGenerator::Downsample(image.data(), size, size, result.data(), settings); }));
+
+	settings.filter = MIP_FILTER::KAISER;
+	print("kaiser sRGB", BestTime([&]() { MipGenerator::Downsample(image.data(), size, size, result.data(), settings); }));
+
+	std::vector<MipLevel> levels;
+	print("chain box", BestTime([&]() { [[maybe_unused]] const std::vector<uint8_t> chain = MipGenerator::BuildChain(image.data(), size, size, levels); }));
+}
@@ -0,0 +1,214 @@
+#include "Tests.h"
+#include <OgRendering/Utils/Lz4.h>
+#include <OgRendering/Utils/PackArchive.h>
+#include <OgRendering/Utils/VirtualFileSystem.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace OgEngine::Utils;
+
+namespace
+{
+	const std::string PACK = "Resources.ogpack";
+	// Long runs, packed in LZ4
+	const std::string REPEATED = "Resources/textures/repeated.bin";
+	// Noise, LZ4 can't make it smaller so it is stored as is
+	const std::string NOISE = "Resources/models/noise.bin";
+	const std::string SMALL = "Resources/small.txt";
+	const std::string EMPTY = "Resources/empty.txt";
+	// Left out of the archive, read from the disk
+	const std::string LOOSE = "Resources/loose.txt";
+
+	std::vector<uint8_t> Repeated(const size_t p_size)
+	{
+		std::vector<uint8_t> data(p_size);
+		for (size_t i = 0u; i < p_size; ++i)
+			data[i] = static_cast<uint8_t>("omega pack "[i % 11u] + i / 1000u);
+
+		return data;
+	}
+
+	std::vector<uint8_t> Noise(const size_t p_size, const uint32_t p_seed)
+	{
+		std::mt19937 random(p_seed);
+		std::vector<uint8_t> data(p_size);
+		for (uint8_t& value : data)
+			value = static_cast<uint8_t>(random());
+
+		return data;
+	}
+
+	void WriteFile(const std::string& p_file, const std::vector<uint8_t>& p_content)
+	{
+		std::filesystem::create_directories(std::filesystem::path(p_file).parent_path());
+		std::ofstream file(p_file, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(p_content.data()), static_cast<std::streamsize>(p_content.size()));
+	}
+
+	bool HasContent(const FileView& p_view, const std::vector<uint8_t>& p_content)
+	{
+		return p_view.IsOpen() && p_view.Size() == p_content.size() && std::memcmp(p_view.Data(), p_content.data(), p_content.size()) == 0;
+	}
+
+	/**
+	 * @brief Blocks of every kind round-trip, and a block cut short or given the wrong size is refused.
+	 */
+	void CheckLz4()
+	{
+		for (const size_t size : { size_t{ 1u }, size_t{ 12u }, size_t{ 13u }, size_t{ 100u }, size_t{ 70000u }, size_t{ 300000u } })
+		{
+			for (const std::vector<uint8_t>& block : { Repeated(size), Noise(size, static_cast<uint32_t>(size)), std::vector<uint8_t>(size, 7u) })
+			{
+				const std::vector<uint8_t> compressed = Lz4::Compress(block.data(), block.size());
+				OG_CHECK(compressed.size() <= Lz4::Bound(block.size()));
+
+				std::vector<uint8_t> result(block.size());
+				OG_CHECK(Lz4::Decompress(compressed.data(), compressed.size(), result.data(), result.size()));
+				OG_CHECK(result == block);
+
+				std::vector<uint8_t> larger(block.size() + 1u);
+				OG_CHECK(!Lz4::Decompress(compressed.data(), compressed.size(), larger.data(), larger.size()));
+				OG_CHECK(!Lz4::Decompress(compressed.data(), compressed.size() - 1u, result.data(), result.size()));
+			}
+		}
+
+		// A single value repeated shrinks to almost nothing
+		const std::vector<uint8_t> flat(70000u, 7u);
+		OG_CHECK(Lz4::Compress(flat.data(), flat.size()).size() < 1000u);
+	}
+
+	/**
+	 * @brief The header and the table of an archive: the alignment of the header, every payload aligned on it, what is compressed.
+	 */
+	void CheckLayout(const std::vector<uint8_t>& p_repeated)
+	{
+		const PackArchive archive(PACK);
+		OG_CHECK(archive.IsOpen());
+		OG_CHECK(archive.EntryCount() == 4u);
+
+		PackHeader header;
+		{
+			std::ifstream file(PACK, std::ios::in | std::ios::binary);
+			file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		}
+		OG_CHECK(header.version == PackArchive::VERSION);
+		OG_CHECK(header.alignment == PackArchive::ALIGNMENT);
+		OG_CHECK(header.entryCount == archive.EntryCount());
+		OG_CHECK(header.tableOffset % header.alignment == 0u);
+
+		for (uint64_t i = 0u; i < archive.EntryCount(); ++i)
+		{
+			const PackEntry& entry = archive.Entries()[i];
+			OG_CHECK(entry.offset % header.alignment == 0u);
+			OG_CHECK(reinterpret_cast<uintptr_t>(archive.Payload(entry)) % header.alignment == 0u);
+			OG_CHECK(archive.Find(archive.Name(entry)) == &entry);
+		}
+
+		const PackEntry* repeated = archive.Find(REPEATED);
+		const PackEntry* noise = archive.Find(NOISE);
+		OG_CHECK(repeated && repeated->compression == PACK_COMPRESSION::LZ4 && repeated->storedSize < repeated->size);
+		OG_CHECK(repeated && repeated->size == p_repeated.size());
+		OG_CHECK(noise && noise->compression == PACK_COMPRESSION::NONE && noise->storedSize == noise->size);
+
+		// Found whichever way the path is written, and only for the files packed
+		OG_CHECK(archive.Find("Resources/./textures/../textures/repeated.bin") == repeated);
+		OG_CHECK(!archive.Find(LOOSE));
+		OG_CHECK(!archive.Find("Resources/textures"));
+	}
+
+	/**
+	 * @brief The files of the archive mounted read back byte for byte, the others from the disk, until it is unmounted.
+	 */
+	void CheckFileSystem(const std::vector<std::vector<uint8_t>>& p_contents, const std::vector<uint8_t>& p_loose)
+	{
+		VirtualFileSystem& fileSystem = VirtualFileSystem::Instance();
+		OG_CHECK(!fileSystem.Mount("Missing.ogpack"));
+		OG_CHECK(fileSystem.Mount(PACK));
+
+		const std::vector<std::string> files = { REPEATED, NOISE, SMALL };
+		for (size_t i = 0u; i < files.size(); ++i)
+		{
+			const FileView view = fileSystem.Open(files[i]);
+			OG_CHECK(HasContent(view, p_contents[i]));
+			OG_CHECK(view.IsPacked());
+			OG_CHECK(view.ContentHash() == MappedFile::HashBytes(p_contents[i].data(), p_contents[i].size()));
+			OG_CHECK(fileSystem.Exists(files[i]));
+			OG_CHECK(fileSystem.PackedHash(files[i]) == view.ContentHash());
+		}
+
+		// Packed empty, never open like an empty loose file
+		OG_CHECK(!fileSystem.Open(EMPTY).IsOpen());
+		OG_CHECK(fileSystem.Exists(EMPTY));
+
+		// The loose file isn't in the archive, it is read from the disk
+		const FileView loose = fileSystem.Open(LOOSE);
+		OG_CHECK(HasContent(loose, p_loose));
+		OG_CHECK(!loose.IsPacked());
+		OG_CHECK(!fileSystem.PackedHash(LOOSE).has_value());
+		OG_CHECK(!fileSystem.Open("Resources/missing.txt").IsOpen());
+		OG_CHECK(!fileSystem.Exists("Resources/missing.txt"));
+
+		// Changed on the disk since it was packed, the archive still wins
+		const std::vector<uint8_t> changed = Noise(100u, 99u);
+		WriteFile(SMALL, changed);
+		OG_CHECK(HasContent(fileSystem.Open(SMALL), p_contents[2]));
+
+		// A view keeps the archive alive once unmounted, the next ones read the disk
+		const FileView kept = fileSystem.Open(REPEATED);
+		OG_CHECK(fileSystem.Unmount(PACK));
+		OG_CHECK(!fileSystem.Unmount(PACK));
+		OG_CHECK(HasContent(kept, p_contents[0]));
+
+		const FileView unpacked = fileSystem.Open(SMALL);
+		OG_CHECK(HasContent(unpacked, changed));
+		OG_CHECK(!unpacked.IsPacked());
+	}
+}
+
+/**
+ * LZ4 blocks, then an archive built from a few files: its layout, and its files read through the VirtualFileSystem with the disk behind it.
+ */
+OG_SUITE(PackArchive)
+{
+	CheckLz4();
+
+	const std::filesystem::path previousDirectory = std::filesystem::current_path();
+	std::filesystem::current_path(OgTests::TemporaryDirectory("PackArchive"));
+
+	const std::vector<std::vector<uint8_t>> contents = { Repeated(200000u), Noise(5000u, 3u), { 'o', 'm', 'e', 'g', 'a' } };
+	const std::vector<uint8_t> loose = Repeated(300u);
+	WriteFile(REPEATED, contents[0]);
+	WriteFile(NOISE, contents[1]);
+	WriteFile(SMALL, contents[2]);
+	WriteFile(EMPTY, {});
+	WriteFile(LOOSE, loose);
+
+	std::vector<PackInput> inputs = { { REPEATED, "" }, { NOISE, "" }, { SMALL, "" }, { EMPTY, "" } };
+	OG_CHECK(PackArchive::Write(PACK, inputs, true));
+	CheckLayout(contents[0]);
+	CheckFileSystem(contents, loose);
+
+	// Without compression every entry is stored as is, and still aligned
+	WriteFile(SMALL, contents[2]);
+	OG_CHECK(PackArchive::Write(PACK, inputs, false));
+	{
+		const PackArchive archive(PACK);
+		OG_CHECK(archive.IsOpen());
+		for (uint64_t i = 0u; i < archive.EntryCount(); ++i)
+		{
+			OG_CHECK(archive.Entries()[i].compression == PACK_COMPRESSION::NONE);
+			OG_CHECK(archive.Entries()[i].offset % PackArchive::ALIGNMENT == 0u);
+		}
+	}
+
+	VirtualFileSystem& fileSystem = VirtualFileSystem::Instance();
+	OG_CHECK(fileSystem.Mount(PACK));
+	OG_CHECK(HasContent(fileSystem.Open(REPEATED), contents[0]));
+	OG_CHECK(HasContent(fileSystem.Open(NOISE), contents[1]));
+	OG_CHECK(fileSystem.Open(REPEATED).IsPacked());
+	fileSystem.UnmountAll();
+
+	std::filesystem::current_path(previousDirectory);
+}
@@ -0,0 +1,226 @@
+#include "Tests.h"
+#include <OgRendering/Managers/Loaders/MeshCache.h>
+#include <OgRendering/Managers/Services/MeshService.h>
+#include <OgRendering/Managers/Services/TextureService.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <thread>
+
+using namespace OgEngine;
+
+namespace
+{
+	constexpr uint32_t TEXTURE_COUNT = 32u;
+	constexpr uint32_t TEXTURE_SIZE = 8u;
+	constexpr uint32_t MESH_COUNT = 16u;
+	constexpr uint32_t THREAD_COUNT = 8u;
+	constexpr uint32_t OPERATIONS_PER_THREAD = 400u;
+
+	/**
+	 * @brief Swallow what is written without any state, so the threads can all write to it at once.
+	 */
+	class DiscardBuffer final : public std::streambuf
+	{
+	protected:
+		int_type overflow(const int_type p_character) override { return traits_type::not_eof(p_character); }
+		std::streamsize xsputn(const char*, const std::streamsize p_count) override { return p_count; }
+	};
+
+	/**
+	 * @brief Write an uncompressed 32 bits TGA, filled with one color.
+	 */
+	void WriteTexture(const std::string& p_file, const uint8_t p_shade)
+	{
+		uint8_t header[18]{};
+		header[2] = 2u;
+		header[12] = static_cast<uint8_t>(TEXTURE_SIZE);
+		header[14] = static_cast<uint8_t>(TEXTURE_SIZE);
+		header[16] = 32u;
+		header[17] = 8u;
+
+		std::ofstream file(p_file, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		const uint8_t pixel[4] = { p_shade, p_shade, p_shade, 255u };
+		for (uint32_t i = 0u; i < TEXTURE_SIZE * TEXTURE_SIZE; ++i)
+			file.write(reinterpret_cast<const char*>(pixel), sizeof(pixel));
+	}
+
+	/**
+	 * @brief Write a source file and the cooked file of its mesh, a quad of p_index + 1 units, so the mesh is read without Assimp.
+	 * The source is never imported, only its hash names the cooked file.
+	 */
+	void WriteCookedMesh(const std::string& p_file, const uint32_t p_index)
+	{
+		{
+			std::ofstream source(p_file, std::ios::out | std::ios::binary | std::ios::trunc);
+			source << "stress mesh " << p_index << '\n';
+		}
+
+		const float size = static_cast<float>(p_index + 1u);
+		std::vector<Vertex> vertices(4u);
+		vertices[1].position = GPM::Vector3F(size, 0.0f, 0.0f);
+		vertices[2].position = GPM::Vector3F(size, size, 0.0f);
+		vertices[3].position = GPM::Vector3F(0.0f, size, 0.0f);
+
+		const auto mesh = std::make_shared<Mesh>(std::move(vertices), std::vector<uint32_t>{ 0u, 1u, 2u, 0u, 2u, 3u });
+		MeshCache::Write(MeshCache::HashFile(p_file), mesh);
+	}
+}
+
+/**
+ * Threads add, request, release, get and wait for the same textures at once while the jobs load them.
+ * Run it in the OMEGA_TSAN build: ThreadSanitizer reports any unsynchronized access to the registry or the handles.
+ */
+OG_SUITE(ResourceStress)
+{
+	// The services read and cook under Resources/ relative to the working directory
+	const std::filesystem::path previousDirectory = std::filesystem::current_path();
+	std::filesystem::current_path(OgTests::TemporaryDirectory("ResourceStress"));
+	std::filesystem::create_directories("Resources/textures");
+
+	std::vector<std::string> names;
+	for (uint32_t i = 0u; i < TEXTURE_COUNT; ++i)
+	{
+		names.emplace_back("stress_" + std::to_string(i) + ".tga");
+		WriteTexture("Resources/textures/" + names.back(), static_cast<uint8_t>(i * 7u));
+	}
+
+	// Adding an existing texture warns on std::cout, from every thread
+	DiscardBuffer discard;
+	std::streambuf* const output = std::cout.rdbuf(&discard);
+	{
+		Services::TextureService service;
+		std::atomic<uint32_t> badTextures{ 0u };
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0u; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&service, &names, &badTextures, t]()
+			{
+				std::mt19937 random(t);
+				for (uint32_t i = 0u; i < OPERATIONS_PER_THREAD; ++i)
+				{
+					const std::string& name = names[random() % names.size()];
+					const std::string path = "Resources/textures/" + name;
+					switch (random() % 5u)
+					{
+					case 0u:
+						service.Add(path);
+						break;
+					case 1u:
+					{
+						// Released at once, the loading may be cancelled while the other threads use it
+						const ResourceReference<Texture> reference = service.Request(path, LOAD_PRIORITY::PREFETCH);
+						break;
+					}
+					case 2u:
+						if (const std::shared_ptr<Texture> texture = service.Get(name); texture && texture->Width() != TEXTURE_SIZE)
+							++badTextures;
+						break;
+					case 3u:
+						if (const ResourceHandle<Texture> handle = service.GetHandle(name); handle.IsValid())
+							handle.Wait();
+						break;
+					default:
+						[[maybe_unused]] const bool loading = service.IsLoading(name);
+						break;
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (const std::string& name : names)
+			service.Add("Resources/textures/" + name);
+		service.WaitForAll();
+
+		OG_CHECK(badTextures.load() == 0u);
+		for (const std::string& name : names)
+		{
+			const std::shared_ptr<Texture> texture = service.Get(name);
+			OG_CHECK(texture && texture->Width() == TEXTURE_SIZE && texture->Height() == TEXTURE_SIZE);
+		}
+	}
+	std::cout.rdbuf(output);
+
+	std::filesystem::current_path(previousDirectory);
+}
+
+/**
+ * Threads add, get and wait for the same meshes at once while the jobs read their cooked files.
+ * Run it in the OMEGA_TSAN build, like ResourceStress.
+ */
+OG_SUITE(MeshStress)
+{
+	const std::filesystem::path previousDirectory = std::filesystem::current_path();
+	std::filesystem::current_path(OgTests::TemporaryDirectory("MeshStress"));
+	std::filesystem::create_directories("Resources/models");
+	std::filesystem::create_directories(MeshCache::DIRECTORY);
+
+	std::vector<std::string> names;
+	for (uint32_t i = 0u; i < MESH_COUNT; ++i)
+	{
+		names.emplace_back("stress_" + std::to_string(i) + ".obj");
+		WriteCookedMesh("Resources/models/" + names.back(), i);
+	}
+
+	DiscardBuffer discard;
+	std::streambuf* const output = std::cout.rdbuf(&discard);
+	{
+		Services::MeshService service;
+		std::atomic<uint32_t> badMeshes{ 0u };
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0u; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&service, &names, &badMeshes, t]()
+			{
+				std::mt19937 random(t);
+				for (uint32_t i = 0u; i < OPERATIONS_PER_THREAD; ++i)
+				{
+					const std::string& name = names[random() % names.size()];
+					switch (random() % 4u)
+					{
+					case 0u:
+						service.Add("Resources/models/" + name);
+						break;
+					case 1u:
+						if (const std::shared_ptr<Mesh> mesh = service.Get(name); mesh && mesh->Vertices().size() != 4u)
+							++badMeshes;
+						break;
+					case 2u:
+						if (const ResourceHandle<Mesh> handle = service.GetHandle(name); handle.IsValid())
+							handle.Wait();
+						break;
+					default:
+						[[maybe_unused]] const bool loading = service.IsLoading(name);
+						break;
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (const std::string& name : names)
+			service.Add("Resources/models/" + name);
+		service.WaitForAll();
+
+		OG_CHECK(badMeshes.load() == 0u);
+		for (uint32_t i = 0u; i < MESH_COUNT; ++i)
+		{
+			const std::shared_ptr<Mesh> mesh = service.Get(names[i]);
+			OG_CHECK(mesh && mesh->Vertices().size() == 4u && mesh->Indices().size() == 6u);
+			if (mesh)
+				OG_CHECK(mesh->LocalBox().maximum.x == static_cast<float>(i + 1u));
+		}
+	}
+	std::cout.rdbuf(output);
+
+	std::filesystem::current_path(previousDirectory);
+}
@@ -0,0 +1,87 @@
+#include "Tests.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+namespace
+{
+	uint32_t failures = 0u;
+}
+
+std::vector<OgTests::Suite>& OgTests::Suites()
+{
+	static std::vector<Suite> suites;
+	return suites;
+}
+
+OgTests::Registration::Registration(std::string p_name, std::function<void()> p_run, const bool p_isBenchmark)
+{
+	Suites().push_back({ std::move(p_name), std::move(p_run), p_isBenchmark });
+}
+
+void OgTests::Fail(const char* p_file, const int p_line, const std::string& p_message)
+{
+	std::cerr << p_file << "(" << p_line << "): check failed: " << p_message << '\n';
+	++failures;
+}
+
+std::string OgTests::TemporaryDirectory(const std::string& p_suite)
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "OgTests" / p_suite;
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	return directory.generic_string();
+}
+
+/**
+ * Usage: OgTests [suite...]
+ * Without any name, every suite but the benchmarks is run.
+ */
+int main(const int p_argc, char** p_argv)
+{
+	std::vector<const OgTests::Suite*> selected;
+	for (int i = 1; i < p_argc; ++i)
+	{
+		const std::string name = p_argv[i];
+		const auto& suites = OgTests::Suites();
+		const auto found = std::find_if(suites.begin(), suites.end(), [&name](const OgTests::Suite& p_suite) { return p_suite.name == name; });
+		if (found == suites.end())
+		{
+			std::cerr << "Unknown suite " << name << ".\n";
+			return EXIT_FAILURE;
+		}
+		selected.emplace_back(&*found);
+	}
+
+	if (selected.empty())
+	{
+		for (const OgTests::Suite& suite : OgTests::Suites())
+		{
+			if (!suite.isBenchmark)
+				selected.emplace_back(&suite);
+		}
+	}
+
+	uint32_t failedSuites = 0u;
+	for (const OgTests::Suite* suite : selected)
+	{
+		const uint32_t previousFailures = failures;
+		try
+		{
+			suite->run();
+		}
+		catch (const std::exception& p_exception)
+		{
+			OgTests::Fail(__FILE__, __LINE__, suite->name + " threw: " + p_exception.what());
+		}
+
+		const bool failed = failures != previousFailures;
+		failedSuites += failed ? 1u : 0u;
+		std::cout << (failed ? "[FAILED] " : "[  OK  ] ") << suite->name << '\n';
+	}
+
+	return failedSuites == 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OgTests
+{
+	/**
+	 * @brief A named group of checks, each suite lives in its own file and registers itself with OG_SUITE.
+	 */
+	struct Suite
+	{
+		std::string name;
+		std::function<void()> run;
+		/**
+		 * @brief Benchmarks only print timings, they are run when named on the command line and never by ctest.
+		 */
+		bool isBenchmark{ false };
+	};
+
+	/**
+	 * @brief Return the suites compiled in, in registration order.
+	 */
+	std::vector<Suite>& Suites();
+
+	struct Registration
+	{
+		Registration(std::string p_name, std::function<void()> p_run, const bool p_isBenchmark);
+	};
+
+	/**
+	 * @brief Report a failed check, the suite goes on with its other checks.
+	 * @param p_file The file of the check
+	 * @param p_line The line of the check
+	 * @param p_message What was expected
+	 */
+	void Fail(const char* p_file, const int p_line, const std::string& p_message);
+
+	/**
+	 * @brief Return an empty directory in the temporary directory of the system, for the files written by a suite.
+	 * @param p_suite The name of the suite
+	 */
+	[[nodiscard]] std::string TemporaryDirectory(const std::string& p_suite);
+}
+
+#define OG_CONCAT_IMPL(p_a, p_b) p_a##p_b
+#define OG_CONCAT(p_a, p_b) OG_CONCAT_IMPL(p_a, p_b)
+#define OG_REGISTER(p_name, p_isBenchmark) \
+	static void OG_CONCAT(Run, p_name)(); \
+	static const OgTests::Registration OG_CONCAT(registration, p_name)(#p_name, &OG_CONCAT(Run, p_name), p_isBenchmark); \
+	static void OG_CONCAT(Run, p_name)()
+
+/**
+ * @brief Define a test suite, run by ctest: OG_SUITE(Name) { OG_CHECK(...); }
+ */
+#define OG_SUITE(p_name) OG_REGISTER(p_name, false)
+/**
+ * @brief Define a benchmark, only run when named: OgTests Name
+ */
+#define OG_BENCHMARK(p_name) OG_REGISTER(p_name, true)
+
+#define OG_CHECK(p_condition) \
+	do { if (!(p_condition)) OgTests::Fail(__FILE__, __LINE__, #p_condition); } while (false)
@@ -0,0 +1,241 @@
+#include "Tests.h"
+#include <OgRendering/Managers/TextureResidency.h>
+#include <algorithm>
+
+using namespace OgEngine;
+
+namespace
+{
+	constexpr uint32_t LEVEL_COUNT = 11u;
+	// Level of the 1024x1024 textures whose side is 64, with the default tail size
+	constexpr uint32_t TAIL_LEVEL = 4u;
+
+	/**
+	 * @brief The size of each level of a whole mip chain, 4 bytes per texel.
+	 */
+	std::vector<uint64_t> LevelSizes(uint32_t p_width, uint32_t p_height)
+	{
+		std::vector<uint64_t> sizes;
+		while (true)
+		{
+			sizes.push_back(static_cast<uint64_t>(p_width) * p_height * 4u);
+			if (p_width == 1u && p_height == 1u)
+				return sizes;
+
+			p_width = std::max(1u, p_width / 2u);
+			p_height = std::max(1u, p_height / 2u);
+		}
+	}
+
+	/**
+	 * @brief The size of the levels from p_level to the last one, what a texture resident from p_level holds.
+	 */
+	uint64_t BytesFrom(const std::vector<uint64_t>& p_sizes, const uint32_t p_level)
+	{
+		uint64_t bytes = 0u;
+		for (size_t level = p_level; level < p_sizes.size(); ++level)
+			bytes += p_sizes[level];
+
+		return bytes;
+	}
+
+	bool IsRequested(const std::vector<TextureStreamingRequest>& p_requests, const std::string& p_name, const uint32_t p_level)
+	{
+		return std::any_of(p_requests.begin(), p_requests.end(), [&](const TextureStreamingRequest& p_request)
+		{
+			return p_request.name == p_name && p_request.firstLevel == p_level;
+		});
+	}
+
+	void CheckLevels()
+	{
+		OG_CHECK(TextureResidency::TailLevel(1024u, 1024u, LEVEL_COUNT, 64u) == TAIL_LEVEL);
+		// The larger side counts, and a chain too short stops at its last level
+		OG_CHECK(TextureResidency::TailLevel(1024u, 256u, LEVEL_COUNT, 64u) == TAIL_LEVEL);
+		OG_CHECK(TextureResidency::TailLevel(1024u, 1024u, 3u, 64u) == 2u);
+		OG_CHECK(TextureResidency::TailLevel(32u, 32u, 6u, 64u) == 0u);
+
+		// The smallest level still as large as the size on screen
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 2048.0f) == 0u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 1024.0f) == 0u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 1000.0f) == 0u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 512.0f) == 1u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 300.0f) == 1u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 64.0f) == 4u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 1.0f) == 10u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, LEVEL_COUNT, 0.0f) == 10u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(256u, 1024u, LEVEL_COUNT, 512.0f) == 1u);
+		OG_CHECK(TextureResidency::LevelForScreenSize(1024u, 1024u, 3u, 1.0f) == 2u);
+	}
+
+	/**
+	 * @brief A texture loaded with its last level only is read up to its tail, used or not, before its larger levels.
+	 */
+	void CheckTailFirst()
+	{
+		const std::vector<uint64_t> sizes = LevelSizes(1024u, 1024u);
+		TextureResidency residency;
+		residency.Add("unused", sizes, 1024u, 1024u, LEVEL_COUNT - 1u);
+		OG_CHECK(residency.Contains("unused"));
+		OG_CHECK(residency.ResidentLevel("unused") == LEVEL_COUNT - 1u);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(sizes, LEVEL_COUNT - 1u));
+
+		std::vector<TextureStreamingRequest> requests = residency.Update();
+		OG_CHECK(requests.size() == 1u);
+		OG_CHECK(IsRequested(requests, "unused", TAIL_LEVEL));
+		OG_CHECK(residency.LoadsInFlight() == 1u);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(sizes, TAIL_LEVEL));
+		// No other request until it is answered
+		OG_CHECK(residency.Update().empty());
+
+		residency.OnLoaded("unused", true);
+		OG_CHECK(residency.ResidentLevel("unused") == TAIL_LEVEL);
+		OG_CHECK(residency.LoadsInFlight() == 0u);
+		OG_CHECK(residency.Update().empty());
+
+		// Drawn at full size, a budget with no room past the tails still gets the tail
+		TextureResidency tight;
+		tight.budget.maxResidentBytes = 1u;
+		tight.Add("drawn", sizes, 1024u, 1024u, LEVEL_COUNT - 1u);
+		tight.ReportUsage("drawn", 1024.0f);
+
+		requests = tight.Update();
+		OG_CHECK(tight.DesiredLevel("drawn") == 0u);
+		OG_CHECK(requests.size() == 1u);
+		OG_CHECK(IsRequested(requests, "drawn", TAIL_LEVEL));
+
+		// With a single load at a time, a texture missing one level of its tail goes before one drawn at full size
+		TextureResidency single;
+		single.budget.maxLoadsInFlight = 1u;
+		single.Add("drawn", sizes, 1024u, 1024u, TAIL_LEVEL);
+		single.ReportUsage("drawn", 1024.0f);
+		single.Add("untailed", LevelSizes(128u, 128u), 128u, 128u, 2u);
+
+		requests = single.Update();
+		OG_CHECK(requests.size() == 1u);
+		OG_CHECK(IsRequested(requests, "untailed", 1u));
+
+		single.OnLoaded("untailed", true);
+		single.ReportUsage("drawn", 1024.0f);
+		OG_CHECK(IsRequested(single.Update(), "drawn", 0u));
+	}
+
+	/**
+	 * @brief Over the budget, the largest level of all the textures goes first, and no texture goes under its tail.
+	 */
+	void CheckBudget()
+	{
+		const std::vector<uint64_t> large = LevelSizes(1024u, 1024u);
+		const std::vector<uint64_t> small = LevelSizes(256u, 256u);
+		const uint32_t smallTail = TextureResidency::TailLevel(256u, 256u, static_cast<uint32_t>(small.size()), 64u);
+
+		// Room for everything but the largest level of the large texture
+		TextureResidency residency;
+		residency.budget.maxResidentBytes = BytesFrom(large, 1u) + BytesFrom(small, 0u);
+		residency.Add("large", large, 1024u, 1024u, TAIL_LEVEL);
+		residency.Add("small", small, 256u, 256u, smallTail);
+		residency.ReportUsage("large", 1024.0f);
+		residency.ReportUsage("small", 256.0f);
+
+		std::vector<TextureStreamingRequest> requests = residency.Update();
+		OG_CHECK(requests.size() == 2u);
+		OG_CHECK(IsRequested(requests, "large", 1u));
+		OG_CHECK(IsRequested(requests, "small", 0u));
+		OG_CHECK(residency.ResidentBytes() == residency.budget.maxResidentBytes);
+
+		residency.OnLoaded("large", true);
+		residency.OnLoaded("small", true);
+		OG_CHECK(residency.ResidentLevel("large") == 1u);
+		OG_CHECK(residency.ResidentLevel("small") == 0u);
+
+		// A budget smaller than the tails sends both textures back to them, and keeps them
+		residency.budget.maxResidentBytes = 1u;
+		residency.ReportUsage("large", 1024.0f);
+		residency.ReportUsage("small", 256.0f);
+		requests = residency.Update();
+		OG_CHECK(requests.size() == 2u);
+		OG_CHECK(IsRequested(requests, "large", TAIL_LEVEL));
+		OG_CHECK(IsRequested(requests, "small", smallTail));
+
+		// Dropping levels isn't a load
+		OG_CHECK(residency.LoadsInFlight() == 0u);
+		residency.OnLoaded("large", true);
+		residency.OnLoaded("small", true);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(large, TAIL_LEVEL) + BytesFrom(small, smallTail));
+	}
+
+	/**
+	 * @brief A texture no longer drawn keeps its levels for unusedUpdatesBeforeDrop updates, then goes back to its tail.
+	 */
+	void CheckUnusedDrop()
+	{
+		const std::vector<uint64_t> sizes = LevelSizes(1024u, 1024u);
+		TextureResidency residency;
+		residency.budget.unusedUpdatesBeforeDrop = 3u;
+		residency.Add("texture", sizes, 1024u, 1024u, TAIL_LEVEL);
+		residency.ReportUsage("texture", 1024.0f);
+
+		OG_CHECK(IsRequested(residency.Update(), "texture", 0u));
+		residency.OnLoaded("texture", true);
+		OG_CHECK(residency.ResidentLevel("texture") == 0u);
+
+		for (uint32_t update = 0u; update < residency.budget.unusedUpdatesBeforeDrop; ++update)
+			OG_CHECK(residency.Update().empty());
+
+		const std::vector<TextureStreamingRequest> requests = residency.Update();
+		OG_CHECK(requests.size() == 1u);
+		OG_CHECK(IsRequested(requests, "texture", TAIL_LEVEL));
+		residency.OnLoaded("texture", true);
+		OG_CHECK(residency.ResidentLevel("texture") == TAIL_LEVEL);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(sizes, TAIL_LEVEL));
+
+		// Drawn again, it is read again
+		residency.ReportUsage("texture", 512.0f);
+		OG_CHECK(IsRequested(residency.Update(), "texture", 1u));
+	}
+
+	/**
+	 * @brief A failed load keeps the levels resident, frees its slot and its bytes, and the texture isn't streamed anymore.
+	 */
+	void CheckFailedLoad()
+	{
+		const std::vector<uint64_t> sizes = LevelSizes(1024u, 1024u);
+		TextureResidency residency;
+		residency.Add("texture", sizes, 1024u, 1024u, TAIL_LEVEL);
+		residency.ReportUsage("texture", 1024.0f);
+
+		OG_CHECK(IsRequested(residency.Update(), "texture", 0u));
+		OG_CHECK(residency.LoadsInFlight() == 1u);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(sizes, 0u));
+
+		// Answers for textures unknown are ignored
+		residency.OnLoaded("unknown", true);
+		OG_CHECK(residency.LoadsInFlight() == 1u);
+
+		residency.OnLoaded("texture", false);
+		OG_CHECK(residency.ResidentLevel("texture") == TAIL_LEVEL);
+		OG_CHECK(residency.LoadsInFlight() == 0u);
+		OG_CHECK(residency.ResidentBytes() == BytesFrom(sizes, TAIL_LEVEL));
+
+		residency.ReportUsage("texture", 1024.0f);
+		OG_CHECK(residency.Update().empty());
+		residency.budget.maxResidentBytes = 1u;
+		OG_CHECK(residency.Update().empty());
+
+		residency.Remove("texture");
+		OG_CHECK(!residency.Contains("texture"));
+		OG_CHECK(residency.ResidentBytes() == 0u);
+	}
+}
+
+/**
+ * The levels the residency chooses: tails first, the size on screen, the budget, the textures left unused and the failed loads.
+ */
+OG_SUITE(TextureResidency)
+{
+	CheckLevels();
+	CheckTailFirst();
+	CheckBudget();
+	CheckUnusedDrop();
+	CheckFailedLoad();
+}
@@ -21,6 +21,8 @@ set BINARIES_FOLDER="bin/"
 
 :: rasterizer shaders
 %GLSL_COMPILER% -t -V %SOURCE_FOLDER%rast_vert.vert -o %BINARIES_FOLDER%rast_vert.spv
+:: PackedVertex layout, without bin/rast_vert_packed.spv the meshes are drawn with their full vertices
+%GLSL_COMPILER% -t -V %SOURCE_FOLDER%rast_vert_packed.vert -o %BINARIES_FOLDER%rast_vert_packed.spv
 %GLSL_COMPILER% -t -V %SOURCE_FOLDER%rast_frag.frag -o %BINARIES_FOLDER%rast_frag.spv
 
 pause
\ No newline at end of file